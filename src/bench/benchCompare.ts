@@ -0,0 +1,159 @@
+/**
+ * Benchmark results as JSON and comparison against a baseline
+ * A benchmark regresses when its samples are significantly slower than the
+ * baseline's (one-sided Mann-Whitney U test) and its median is slower by more
+ * than the tolerance; the test alone would flag tiny but consistent changes.
+ * Baseline samples are scaled by a calibration workload timed in both runs,
+ * so a baseline recorded on another machine stays usable.
+ */
+
+import { BenchResult } from './benchUtils';
+
+export const BENCH_FILE_VERSION = 1;
+
+export interface BenchFile {
+    version: number;
+    /** Median time of the calibration workload in milliseconds */
+    calibration: number;
+    results: BenchResult[];
+}
+
+export interface CompareOptions {
+    /** Significance level of the Mann-Whitney test */
+    alpha?: number;
+    /** Allowed median slowdown, 0.2 = 20% */
+    tolerance?: number;
+}
+
+/**
+ * - regressed: significantly slower beyond tolerance
+ * - improved: significantly faster beyond tolerance
+ * - unchanged: anything else
+ * - new: not in the baseline
+ * - missing: in the baseline but not in this run, fails the check like a
+ *   regression so a renamed or dropped benchmark cannot slip through
+ */
+export type CompareStatus = 'regressed' | 'improved' | 'unchanged' | 'new' | 'missing';
+
+export interface BenchComparison {
+    name: string;
+    status: CompareStatus;
+    /** Current median / scaled baseline median */
+    ratio: number;
+    /** One-sided p-value that the current run is slower */
+    pValue: number;
+}
+
+export interface MannWhitneyResult {
+    /** U statistic of the first sample */
+    u: number;
+    /** Standardized U, positive when the first sample tends to be larger */
+    z: number;
+    /** One-sided p-value for the first sample being larger */
+    pValue: number;
+}
+
+/**
+ * Standard normal cumulative distribution (Abramowitz and Stegun 7.1.26)
+ */
+function normalCdf(z: number): number {
+    const x = Math.abs(z) / Math.SQRT2;
+    const t = 1 / (1 + 0.3275911 * x);
+    const erf = 1 - t * (0.254829592 + t * (-0.284496736 + t * (1.421413741 + t * (-1.453152027 + t * 1.061405429)))) * Math.exp(-x * x);
+    return z >= 0 ? (1 + erf) / 2 : (1 - erf) / 2;
+}
+
+/**
+ * Mann-Whitney U test with the normal approximation, corrected for ties and
+ * continuity; fine from about 8 samples each
+ */
+export function mannWhitneyU(a: readonly number[], b: readonly number[]): MannWhitneyResult {
+    const n1 = a.length;
+    const n2 = b.length;
+    const values = [...a.map(value => ({ value, first: true })), ...b.map(value => ({ value, first: false }))]
+        .sort((x, y) => x.value - y.value);
+    const n = values.length;
+
+    let rankSum = 0;
+    let tieTerm = 0;
+    for (let i = 0; i < n;) {
+        let j = i;
+        while (j + 1 < n && values[j + 1].value === values[i].value) {
+            j++;
+        }
+        // Tied values share the average of their ranks
+        const rank = (i + j) / 2 + 1;
+        for (let k = i; k <= j; k++) {
+            if (values[k].first) {
+                rankSum += rank;
+            }
+        }
+        const ties = j - i + 1;
+        tieTerm += ties * ties * ties - ties;
+        i = j + 1;
+    }
+
+    const u = rankSum - (n1 * (n1 + 1)) / 2;
+    const mean = (n1 * n2) / 2;
+    const variance = ((n1 * n2) / 12) * ((n + 1) - tieTerm / (n * (n - 1)));
+    if (!(variance > 0)) {
+        return { u, z: 0, pValue: 0.5 };
+    }
+    const difference = u - mean;
+    const z = (difference - Math.sign(difference) * 0.5) / Math.sqrt(variance);
+    return { u, z, pValue: 1 - normalCdf(z) };
+}
+
+function median(values: readonly number[]): number {
+    const sorted = [...values].sort((a, b) => a - b);
+    return sorted[Math.floor(sorted.length / 2)];
+}
+
+/**
+ * Compare a run with a baseline, benchmark by benchmark
+ */
+export function compareBenchFiles(baseline: BenchFile, current: BenchFile, options: CompareOptions = {}): BenchComparison[] {
+    const alpha = options.alpha ?? 0.01;
+    const tolerance = options.tolerance ?? 0.2;
+    const scale = baseline.calibration > 0 && current.calibration > 0 ? current.calibration / baseline.calibration : 1;
+    const baselineResults = new Map(baseline.results.map(result => [result.name, result]));
+    const currentNames = new Set(current.results.map(result => result.name));
+
+    const comparisons: BenchComparison[] = current.results.map(result => {
+        const base = baselineResults.get(result.name);
+        if (!base) {
+            return { name: result.name, status: 'new', ratio: NaN, pValue: NaN };
+        }
+        const baseSamples = base.samples.map(sample => sample * scale);
+        const ratio = median(result.samples) / median(baseSamples);
+        const slower = mannWhitneyU(result.samples, baseSamples).pValue;
+        const faster = mannWhitneyU(baseSamples, result.samples).pValue;
+        let status: CompareStatus = 'unchanged';
+        if (slower < alpha && ratio > 1 + tolerance) {
+            status = 'regressed';
+        } else if (faster < alpha && ratio < 1 / (1 + tolerance)) {
+            status = 'improved';
+        }
+        return { name: result.name, status, ratio, pValue: slower };
+    });
+    for (const base of baseline.results) {
+        if (!currentNames.has(base.name)) {
+            comparisons.push({ name: base.name, status: 'missing', ratio: NaN, pValue: NaN });
+        }
+    }
+    return comparisons;
+}
+
+/**
+ * Format comparisons as an aligned table
+ */
+export function formatComparisons(comparisons: readonly BenchComparison[]): string {
+    const width = Math.max(...comparisons.map(comparison => comparison.name.length), 4);
+    const lines = [`${'name'.padEnd(width)}  ${'ratio'.padStart(8)}  ${'p'.padStart(8)}  status`];
+    for (const comparison of comparisons) {
+        const ratio = Number.isNaN(comparison.ratio) ? '-' : `${comparison.ratio.toFixed(2)}x`;
+        const pValue = Number.isNaN(comparison.pValue) ? '-' : comparison.pValue.toFixed(4);
+        lines.push(`${comparison.name.padEnd(width)}  ${ratio.padStart(8)}  ${pValue.padStart(8)}  ${comparison.status}`);
+    }
+    return lines.join('\n');
+}
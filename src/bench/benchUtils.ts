@@ -0,0 +1,126 @@
+/**
+ * Minimal benchmark runner
+ * Times a function over several iterations after a warm-up and reports
+ * per-iteration statistics in milliseconds, throughput and allocation.
+ */
+
+import { formatBytes } from '../utils/memoryEstimate';
+
+export interface BenchOptions {
+    /** Untimed iterations run first */
+    warmup?: number;
+    /** Timed iterations */
+    iterations?: number;
+}
+
+export interface BenchResult {
+    name: string;
+    /** Per-iteration times in milliseconds */
+    samples: number[];
+    min: number;
+    median: number;
+    mean: number;
+    /** 50th percentile in milliseconds (same as median) */
+    p50: number;
+    /** 99th percentile in milliseconds */
+    p99: number;
+    /** Iterations per second, from the mean */
+    opsPerSec: number;
+    /**
+     * Median heap growth per iteration in bytes; only meaningful when the
+     * process runs with --expose-gc, otherwise collections may hide it
+     */
+    allocatedBytes: number;
+}
+
+/**
+ * Value at the given percentile (0-100) of sorted values, nearest rank
+ */
+export function percentile(sorted: readonly number[], p: number): number {
+    if (sorted.length === 0) {
+        return NaN;
+    }
+    const rank = Math.ceil((p / 100) * sorted.length);
+    return sorted[Math.min(sorted.length, Math.max(1, rank)) - 1];
+}
+
+/**
+ * global.gc when the process was started with --expose-gc
+ */
+const collectGarbage = (globalThis as { gc?: () => void }).gc;
+
+/**
+ * Run a benchmark
+ * @param name Benchmark name
+ * @param fn Function to time
+ */
+export function runBench(name: string, fn: () => unknown, options: BenchOptions = {}): BenchResult {
+    const warmup = options.warmup ?? 3;
+    const iterations = options.iterations ?? 20;
+
+    for (let i = 0; i < warmup; i++) {
+        fn();
+    }
+
+    const samples: number[] = [];
+    const allocations: number[] = [];
+    for (let i = 0; i < iterations; i++) {
+        collectGarbage?.();
+        const heapBefore = process.memoryUsage().heapUsed;
+        const start = process.hrtime.bigint();
+        // Keep the result alive until the heap is measured
+        const result = fn();
+        const elapsed = Number(process.hrtime.bigint() - start) / 1e6;
+        allocations.push(Math.max(0, process.memoryUsage().heapUsed - heapBefore));
+        samples.push(elapsed);
+        void result;
+    }
+
+    const sorted = [...samples].sort((a, b) => a - b);
+    const mean = samples.reduce((sum, value) => sum + value, 0) / samples.length;
+    const median = sorted[Math.floor(sorted.length / 2)];
+    return {
+        name,
+        samples,
+        min: sorted[0],
+        median,
+        mean,
+        p50: median,
+        p99: percentile(sorted, 99),
+        opsPerSec: mean > 0 ? 1000 / mean : Infinity,
+        allocatedBytes: [...allocations].sort((a, b) => a - b)[Math.floor(allocations.length / 2)]
+    };
+}
+
+/**
+ * Time a fixed CPU and allocation workload
+ * Comparing it between two runs gives the relative speed of the machines.
+ * @returns Median time in milliseconds
+ */
+export function calibrate(): number {
+    const numbers = Array.from({ length: 100000 }, (_, i) => (i * 7919) % 100003);
+    return runBench('calibration', () => {
+        const words = numbers.map(value => `item${value}`);
+        return [...words].sort().join(' ').length;
+    }, { iterations: 15 }).median;
+}
+
+/**
+ * Format results as an aligned table
+ */
+export function formatResults(results: readonly BenchResult[]): string {
+    const width = Math.max(...results.map(result => result.name.length), 4);
+    const columns = ['ops/s', 'p50 ms', 'p99 ms', 'min ms', 'alloc'];
+    const lines = [`${'name'.padEnd(width)}${columns.map(column => `  ${column.padStart(10)}`).join('')}`];
+    for (const result of results) {
+        const values = [
+            result.opsPerSec >= 100 ? result.opsPerSec.toFixed(0) : result.opsPerSec.toFixed(2),
+            result.p50.toFixed(3),
+            result.p99.toFixed(3),
+            result.min.toFixed(3),
+            formatBytes(result.allocatedBytes)
+        ];
+        lines.push(`${result.name.padEnd(width)}${values.map(value => `  ${value.padStart(10)}`).join('')}`);
+    }
+    return lines.join('\n');
+}
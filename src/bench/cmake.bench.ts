@@ -0,0 +1,61 @@
+/**
+ * CMake language benchmarks on the synthetic corpus: path and set() parsing,
+ * variable resolution, formatting, folding and block diagnostics
+ */
+
+import { parsePaths } from '../parsers/cmakeVariableParser';
+import { parseSetCommands } from '../parsers/cmakeListsParser';
+import { CoreVariableResolver } from '../services/coreVariableResolver';
+import { findUnmatchedBlocks } from '../utils/diagnosticUtils';
+import { findBlockPairs, findCommentBlocks, findMultiLineCommands } from '../utils/foldingUtils';
+import { DEFAULT_OPTIONS, formatCMakeDocument } from '../utils/formattingUtils';
+import { BenchResult, runBench } from './benchUtils';
+import { BenchCorpus } from './corpus';
+
+const WORKSPACE = '/workspace/project';
+
+/**
+ * All three folding passes, as the folding range provider runs them
+ */
+function computeFolding(lines: string[]): number {
+    const ranges = [...findMultiLineCommands(lines), ...findCommentBlocks(lines)];
+    return ranges.length + findBlockPairs(lines, ranges).length;
+}
+
+export function run(corpus: BenchCorpus): BenchResult[] {
+    const mediumLines = corpus.medium.split('\n');
+    const hugeLines = corpus.huge.split('\n');
+
+    const resolver = new CoreVariableResolver();
+    resolver.initialize([WORKSPACE]);
+    resolver.parseFileContent(corpus.denseVariables, `${WORKSPACE}/CMakeLists.txt`);
+    const expressions = parsePaths(corpus.denseVariables)
+        .filter(match => match.variables.length > 0)
+        .map(match => match.fullPath);
+
+    return [
+        runBench('parsePaths medium', () => parsePaths(corpus.medium)),
+        runBench('parsePaths dense ${}', () => parsePaths(corpus.denseVariables)),
+        runBench('parsePaths 5k-arg command', () => parsePaths(corpus.longCommand)),
+        runBench('parseSetCommands medium', () => parseSetCommands(corpus.medium, `${WORKSPACE}/CMakeLists.txt`)),
+        runBench('parseSetCommands huge', () => parseSetCommands(corpus.huge, `${WORKSPACE}/CMakeLists.txt`), { iterations: 8 }),
+        runBench(`parseSetCommands include tree (${corpus.includeTree.size} files)`, () => {
+            for (const [file, content] of corpus.includeTree) {
+                parseSetCommands(content, `${WORKSPACE}/${file}`);
+            }
+        }),
+        runBench(`resolvePath ${expressions.length} paths`, () => {
+            for (const expression of expressions) {
+                resolver.resolvePath(expression);
+            }
+        }),
+        runBench('formatCMakeDocument small', () => formatCMakeDocument(corpus.small, DEFAULT_OPTIONS)),
+        runBench('formatCMakeDocument medium', () => formatCMakeDocument(corpus.medium, DEFAULT_OPTIONS)),
+        runBench('formatCMakeDocument 5k-arg command', () => formatCMakeDocument(corpus.longCommand, DEFAULT_OPTIONS)),
+        runBench('folding medium', () => computeFolding(mediumLines)),
+        // 8 iterations is the least the regression gate's Mann-Whitney test needs
+        runBench('folding huge', () => computeFolding(hugeLines), { iterations: 8 }),
+        runBench('findUnmatchedBlocks medium', () => findUnmatchedBlocks(corpus.medium)),
+        runBench('findUnmatchedBlocks huge', () => findUnmatchedBlocks(corpus.huge), { iterations: 8 })
+    ];
+}
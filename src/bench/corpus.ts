@@ -0,0 +1,175 @@
+/**
+ * Synthetic benchmark corpus
+ * Generates CMake files and project files from a seeded random generator,
+ * so every run (and every machine) measures the same input.
+ */
+
+import { makePbxproj } from './xcodeproj.bench';
+import { makeVcxproj } from './vcxproj.bench';
+
+/**
+ * Seed used by npm run bench
+ */
+export const CORPUS_SEED = 0x5eed;
+
+/**
+ * Seeded random number generator (mulberry32)
+ * @returns Function returning numbers in [0, 1)
+ */
+export function createRandom(seed: number): () => number {
+    let state = seed >>> 0;
+    return () => {
+        state = (state + 0x6d2b79f5) >>> 0;
+        let t = state;
+        t = Math.imul(t ^ (t >>> 15), t | 1);
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+}
+
+export interface BenchCorpus {
+    /** About 50 commands */
+    small: string;
+    /** About 2,000 commands */
+    medium: string;
+    /** About 50,000 commands */
+    huge: string;
+    /** include() tree: root file first, keyed by path */
+    includeTree: Map<string, string>;
+    /** target_sources() with 5,000 arguments */
+    longCommand: string;
+    /** Paths made of nested ${} references, with the set() calls defining them */
+    denseVariables: string;
+    vcxproj: string;
+    pbxproj: string;
+}
+
+const COMMON_VARIABLES = ['CMAKE_SOURCE_DIR', 'CMAKE_CURRENT_SOURCE_DIR', 'PROJECT_SOURCE_DIR', 'CMAKE_BINARY_DIR'];
+
+/**
+ * CMakeLists.txt with a realistic mix of commands: variables, nested if and
+ * foreach blocks, functions, targets with source lists, comments
+ */
+function makeCMakeLists(random: () => number, commandCount: number): string {
+    const pick = <T>(items: readonly T[]) => items[Math.floor(random() * items.length)];
+    const lines: string[] = ['cmake_minimum_required(VERSION 3.16)', 'project(Bench LANGUAGES C CXX)', ''];
+    let depth = 0;
+    const closers: string[] = [];
+    for (let i = 0; i < commandCount; i++) {
+        const indent = '  '.repeat(depth);
+        const roll = random();
+        if (roll < 0.08 && depth < 6) {
+            lines.push(`${indent}if(ENABLE_FEATURE_${i % 40} AND NOT \${VAR_${i % 13}} STREQUAL "off")`);
+            closers.push('endif()');
+            depth++;
+        } else if (roll < 0.11 && depth < 6) {
+            lines.push(`${indent}foreach(item IN LISTS SOURCES_${i % 17})`);
+            closers.push('endforeach()');
+            depth++;
+        } else if (roll < 0.13 && depth === 0) {
+            lines.push(`function(helper_${i} name)`);
+            closers.push('endfunction()');
+            depth++;
+        } else if (roll < 0.22 && depth > 0) {
+            depth--;
+            lines.push(`${'  '.repeat(depth)}${closers.pop()}`);
+        } else if (roll < 0.45) {
+            lines.push(`${indent}set(VAR_${i} "\${${pick(COMMON_VARIABLES)}}/src/module${i % 97}/file${i}.cpp")`);
+        } else if (roll < 0.55) {
+            const count = 2 + Math.floor(random() * 30);
+            lines.push(`${indent}add_library(lib${i} STATIC`);
+            for (let j = 0; j < count; j++) {
+                lines.push(`${indent}  src/lib${i}/file${j}.cpp`);
+            }
+            lines.push(`${indent})`);
+        } else if (roll < 0.65) {
+            lines.push(`${indent}target_include_directories(lib${i % 500} PRIVATE \${CMAKE_CURRENT_SOURCE_DIR}/include \${VAR_${i % 200}}/include)`);
+        } else if (roll < 0.75) {
+            lines.push(`${indent}# Comment ${i}: ${'x'.repeat(Math.floor(random() * 60))}`);
+        } else if (roll < 0.85) {
+            lines.push(`${indent}list(APPEND SOURCES_${i % 17} file${i}.cpp file${i + 1}.cpp)`);
+        } else {
+            lines.push(`${indent}message(STATUS "Configuring \${PROJECT_NAME} step ${i}")`);
+        }
+    }
+    while (closers.length > 0) {
+        depth--;
+        lines.push(`${'  '.repeat(depth)}${closers.pop()}`);
+    }
+    lines.push('');
+    return lines.join('\n');
+}
+
+/**
+ * include() tree with the given depth and fan-out; each file defines variables
+ */
+function makeIncludeTree(random: () => number, depth: number, fanout: number): Map<string, string> {
+    const files = new Map<string, string>();
+    const addFile = (filePath: string, level: number) => {
+        const lines = [`set(LEVEL_${level}_VALUE "\${CMAKE_CURRENT_LIST_DIR}/level${level}")`];
+        for (let i = 0; i < 10; i++) {
+            lines.push(`set(${filePath.replace(/\W/g, '_').toUpperCase()}_${i} "\${LEVEL_${level}_VALUE}/item${Math.floor(random() * 1000)}")`);
+        }
+        const children: string[] = [];
+        if (level < depth) {
+            for (let i = 0; i < fanout; i++) {
+                const child = `cmake/level${level + 1}/module${files.size}_${i}.cmake`;
+                lines.push(`include(\${CMAKE_SOURCE_DIR}/${child})`);
+                children.push(child);
+            }
+        }
+        files.set(filePath, lines.join('\n') + '\n');
+        for (const child of children) {
+            addFile(child, level + 1);
+        }
+    };
+    addFile('CMakeLists.txt', 0);
+    return files;
+}
+
+/**
+ * target_sources() call with the given number of arguments
+ */
+function makeLongCommand(random: () => number, count: number): string {
+    const files: string[] = [];
+    for (let i = 0; i < count; i++) {
+        files.push(`src/module${Math.floor(random() * 97)}/file${i}.cpp`);
+    }
+    const half = Math.floor(count / 2);
+    return `target_sources(app\n  PRIVATE ${files.slice(0, half).join(' ')}\n  PUBLIC ${files.slice(half).join(' ')})\n`;
+}
+
+/**
+ * set() chains whose values reference each other, and paths using them
+ */
+function makeDenseVariables(random: () => number, count: number): string {
+    const lines = ['set(ROOT "/workspace/project")'];
+    for (let i = 0; i < 100; i++) {
+        const base = i === 0 ? '${ROOT}' : `\${DIR_${Math.floor(random() * i)}}`;
+        lines.push(`set(DIR_${i} "${base}/part${i}")`);
+    }
+    for (let i = 0; i < count; i++) {
+        const a = Math.floor(random() * 100);
+        const b = Math.floor(random() * 100);
+        lines.push(`include_directories("\${DIR_${a}}/\${DIR_${b}}/include/file${i}.h" \${CMAKE_SOURCE_DIR}/third_party/lib${i % 31})`);
+    }
+    lines.push('');
+    return lines.join('\n');
+}
+
+/**
+ * Generate the whole corpus
+ */
+export function generateCorpus(seed = CORPUS_SEED): BenchCorpus {
+    const random = createRandom(seed);
+    return {
+        small: makeCMakeLists(random, 50),
+        medium: makeCMakeLists(random, 2000),
+        huge: makeCMakeLists(random, 50000),
+        includeTree: makeIncludeTree(random, 5, 3),
+        longCommand: makeLongCommand(random, 5000),
+        denseVariables: makeDenseVariables(random, 2000),
+        vcxproj: makeVcxproj(4000),
+        pbxproj: makePbxproj(4000)
+    };
+}
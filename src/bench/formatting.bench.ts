@@ -0,0 +1,45 @@
+/**
+ * Formatter benchmarks: wrapping very long argument lists
+ */
+
+import { formatCMakeLines, GOOGLE_STYLE_OPTIONS } from '../utils/formattingUtils';
+import { packLines } from '../utils/wrapUtils';
+import { BenchResult, runBench } from './benchUtils';
+
+/**
+ * target_sources() call with the given number of source files
+ */
+function makeTargetSources(count: number): string {
+    const files: string[] = [];
+    for (let i = 0; i < count; i++) {
+        files.push(`src/module${i % 97}/file${i}.cpp`);
+    }
+    const half = Math.floor(count / 2);
+    return `target_sources(app\n  PRIVATE ${files.slice(0, half).join(' ')}\n  PUBLIC ${files.slice(half).join(' ')})\n`;
+}
+
+/**
+ * add_custom_command() with a long COMMAND line and comments between arguments
+ */
+function makeCustomCommand(count: number): string {
+    const args: string[] = ['OUTPUT out.txt', 'COMMAND tool'];
+    for (let i = 0; i < count; i++) {
+        args.push(i % 500 === 0 ? `--flag${i} # option ${i}\n` : `--flag${i}`);
+    }
+    args.push('DEPENDS in.txt');
+    return `add_custom_command(${args.join(' ')})\n`;
+}
+
+export function run(): BenchResult[] {
+    const sources5k = makeTargetSources(5000);
+    const sources50k = makeTargetSources(50000);
+    const command5k = makeCustomCommand(5000);
+    const words = Array.from({ length: 5000 }, (_, i) => `item${i}`);
+
+    return [
+        runBench('packLines 5k items', () => packLines(words, 76)),
+        runBench('format target_sources 5k args', () => formatCMakeLines(sources5k, GOOGLE_STYLE_OPTIONS)),
+        runBench('format add_custom_command 5k args', () => formatCMakeLines(command5k, GOOGLE_STYLE_OPTIONS)),
+        runBench('format target_sources 50k args', () => formatCMakeLines(sources50k, GOOGLE_STYLE_OPTIONS), { iterations: 5 })
+    ];
+}
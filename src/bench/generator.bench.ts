@@ -0,0 +1,21 @@
+/**
+ * Parser and CMake generator benchmarks on the corpus vcxproj and pbxproj
+ */
+
+import { generateCMakeLists, generateCMakeListsFromXcode } from '../parsers/cmakeGenerator';
+import { parseVcxproj } from '../parsers/vcxprojParser';
+import { parseXcodeproj } from '../parsers/xcodeprojParser';
+import { BenchResult, runBench } from './benchUtils';
+import { BenchCorpus } from './corpus';
+
+export function run(corpus: BenchCorpus): BenchResult[] {
+    const vcxproj = parseVcxproj(corpus.vcxproj, 'App.vcxproj');
+    const xcodeproj = parseXcodeproj(corpus.pbxproj, 'App.xcodeproj');
+
+    return [
+        runBench('parseVcxproj corpus', () => parseVcxproj(corpus.vcxproj, 'App.vcxproj')),
+        runBench('parseXcodeproj corpus', () => parseXcodeproj(corpus.pbxproj, 'App.xcodeproj')),
+        runBench('generateCMakeLists vcxproj', () => generateCMakeLists(vcxproj)),
+        runBench('generateCMakeListsFromXcode', () => generateCMakeListsFromXcode(xcodeproj))
+    ];
+}
@@ -0,0 +1,98 @@
+/**
+ * Benchmark entry point (npm run bench)
+ * Pass suite names to run only those, e.g. npm run bench -- cmake generator
+ *
+ * --json <file>   also write the results as JSON (npm run bench:baseline)
+ * --check <file>  compare with a baseline written by --json and exit with 1
+ *                 if a benchmark regressed or is missing from the run
+ *                 (npm run bench:check)
+ */
+
+import * as fs from 'fs';
+import { BENCH_FILE_VERSION, BenchFile, compareBenchFiles, formatComparisons } from './benchCompare';
+import { BenchResult, calibrate, formatResults } from './benchUtils';
+import * as cmake from './cmake.bench';
+import { CORPUS_SEED, generateCorpus } from './corpus';
+import * as formatting from './formatting.bench';
+import * as generator from './generator.bench';
+import * as vcxproj from './vcxproj.bench';
+import * as xcodeproj from './xcodeproj.bench';
+
+const corpus = generateCorpus(CORPUS_SEED);
+
+const suites = [
+    { name: 'cmake', run: () => cmake.run(corpus) },
+    { name: 'generator', run: () => generator.run(corpus) },
+    { name: 'formatting', run: formatting.run },
+    { name: 'vcxproj', run: vcxproj.run },
+    { name: 'xcodeproj', run: xcodeproj.run }
+];
+
+const selected: string[] = [];
+let jsonPath: string | undefined;
+let baselinePath: string | undefined;
+const args = process.argv.slice(2);
+for (let i = 0; i < args.length; i++) {
+    if (args[i] === '--json') {
+        jsonPath = args[++i];
+    } else if (args[i] === '--check') {
+        baselinePath = args[++i];
+    } else {
+        selected.push(args[i]);
+    }
+}
+
+const results: BenchResult[] = [];
+for (const suite of suites) {
+    if (selected.length > 0 && !selected.includes(suite.name)) {
+        continue;
+    }
+    console.log(`\n${suite.name}`);
+    const suiteResults = suite.run();
+    console.log(formatResults(suiteResults));
+    results.push(...suiteResults);
+}
+
+const run: BenchFile = { version: BENCH_FILE_VERSION, calibration: calibrate(), results };
+
+if (jsonPath) {
+    // Rounded to keep a committed baseline readable
+    const round = (value: number) => Math.round(value * 1e4) / 1e4;
+    const file: BenchFile = {
+        ...run,
+        calibration: round(run.calibration),
+        results: results.map(result => ({
+            ...result,
+            samples: result.samples.map(round),
+            min: round(result.min),
+            median: round(result.median),
+            mean: round(result.mean),
+            p50: round(result.p50),
+            p99: round(result.p99),
+            opsPerSec: round(result.opsPerSec)
+        }))
+    };
+    fs.writeFileSync(jsonPath, JSON.stringify(file, null, 2) + '\n', 'utf8');
+    console.log(`\nWrote ${jsonPath}`);
+}
+
+if (baselinePath) {
+    const baseline = JSON.parse(fs.readFileSync(baselinePath, 'utf8')) as BenchFile;
+    if (baseline.version !== BENCH_FILE_VERSION) {
+        console.error(`${baselinePath}: unsupported version ${baseline.version}`);
+        process.exit(2);
+    }
+    const comparisons = compareBenchFiles(baseline, run);
+    console.log(`\nCompared with ${baselinePath} (machine speed ${(run.calibration / baseline.calibration).toFixed(2)}x baseline)`);
+    console.log(formatComparisons(comparisons));
+    const regressed = comparisons.filter(comparison => comparison.status === 'regressed');
+    if (regressed.length > 0) {
+        console.error(`\n${regressed.length} benchmark(s) regressed: ${regressed.map(comparison => comparison.name).join(', ')}`);
+        process.exitCode = 1;
+    }
+    const missing = comparisons.filter(comparison => comparison.status === 'missing');
+    if (missing.length > 0) {
+        console.error(`\n${missing.length} baseline benchmark(s) missing from this run: ${missing.map(comparison => comparison.name).join(', ')}`);
+        process.exitCode = 1;
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * vcxproj parser benchmarks: generated projects with tens of thousands of items
+ */
+
+import { parseVcxproj } from '../parsers/vcxprojParser';
+import { BenchResult, runBench } from './benchUtils';
+
+/**
+ * Project with the given number of ClCompile items (every 7th with per-file
+ * metadata) plus half as many headers, and Debug/Release definition groups
+ */
+export function makeVcxproj(count: number): string {
+    const parts: string[] = [
+        '<?xml version="1.0" encoding="utf-8"?>',
+        '<Project DefaultTargets="Build" xmlns="http://schemas.microsoft.com/developer/msbuild/2003">'
+    ];
+    for (const config of ['Debug', 'Release']) {
+        parts.push(
+            `  <ItemDefinitionGroup Condition="'$(Configuration)|$(Platform)'=='${config}|x64'">`,
+            '    <ClCompile>',
+            `      <PreprocessorDefinitions>${config.toUpperCase()};WIN32;%(PreprocessorDefinitions)</PreprocessorDefinitions>`,
+            '      <AdditionalIncludeDirectories>include;third_party;%(AdditionalIncludeDirectories)</AdditionalIncludeDirectories>',
+            '      <PrecompiledHeader>Use</PrecompiledHeader>',
+            '    </ClCompile>',
+            '  </ItemDefinitionGroup>'
+        );
+    }
+    parts.push('  <ItemGroup>');
+    for (let i = 0; i < count; i++) {
+        const file = `src\\module${i % 97}\\file${i}.cpp`;
+        parts.push(i % 7 === 0
+            ? `    <ClCompile Include="${file}">\n      <PrecompiledHeader>NotUsing</PrecompiledHeader>\n    </ClCompile>`
+            : `    <ClCompile Include="${file}" />`);
+    }
+    for (let i = 0; i < count / 2; i++) {
+        parts.push(`    <ClInclude Include="include\\module${i % 97}\\file${i}.h" />`);
+    }
+    parts.push('  </ItemGroup>', '</Project>', '');
+    return parts.join('\n');
+}
+
+export function run(): BenchResult[] {
+    const project4k = makeVcxproj(4000);
+    const project40k = makeVcxproj(40000);
+
+    return [
+        runBench('parse vcxproj 4k items', () => parseVcxproj(project4k, 'App.vcxproj')),
+        runBench('parse vcxproj 40k items', () => parseVcxproj(project40k, 'App.vcxproj'), { iterations: 5 })
+    ];
+}
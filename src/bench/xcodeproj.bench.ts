@@ -0,0 +1,88 @@
+/**
+ * xcodeproj parser benchmarks: generated pbxproj files up to app-sized (10+ MB)
+ */
+
+import { parseXcodeproj } from '../parsers/xcodeprojParser';
+import { BenchResult, runBench } from './benchUtils';
+
+/**
+ * 24-digit object ID, like the ones Xcode generates
+ */
+function id(kind: number, index: number): string {
+    return `${kind.toString(16).toUpperCase().padStart(4, '0')}${index.toString(16).toUpperCase().padStart(20, '0')}`;
+}
+
+/**
+ * Project with one native target compiling the given number of files, a
+ * header reference per file, and Debug/Release configurations
+ */
+export function makePbxproj(count: number): string {
+    const parts: string[] = ['// !$*UTF8*$!', '{', '\tarchiveVersion = 1;', '\tobjectVersion = 56;', '\tobjects = {', ''];
+
+    parts.push('/* Begin PBXBuildFile section */');
+    for (let i = 0; i < count; i++) {
+        parts.push(`\t\t${id(1, i)} /* file${i}.mm in Sources */ = {isa = PBXBuildFile; fileRef = ${id(2, i)} /* file${i}.mm */; };`);
+    }
+    parts.push('/* End PBXBuildFile section */', '', '/* Begin PBXFileReference section */');
+    for (let i = 0; i < count; i++) {
+        parts.push(
+            `\t\t${id(2, i)} /* file${i}.mm */ = {isa = PBXFileReference; lastKnownFileType = sourcecode.cpp.objcpp; path = "Sources/Module${i % 97}/file${i}.mm"; sourceTree = "<group>"; };`,
+            `\t\t${id(3, i)} /* file${i}.h */ = {isa = PBXFileReference; lastKnownFileType = sourcecode.c.h; path = "Sources/Module${i % 97}/file${i}.h"; sourceTree = "<group>"; };`
+        );
+    }
+    parts.push('/* End PBXFileReference section */', '');
+
+    parts.push(
+        `\t\t${id(4, 0)} /* App */ = {`,
+        '\t\t\tisa = PBXNativeTarget;',
+        `\t\t\tbuildConfigurationList = ${id(5, 0)} /* Build configuration list for PBXNativeTarget "App" */;`,
+        `\t\t\tbuildPhases = (\n\t\t\t\t${id(6, 0)} /* Sources */,\n\t\t\t);`,
+        '\t\t\tdependencies = (\n\t\t\t);',
+        '\t\t\tname = App;',
+        '\t\t\tproductType = "com.apple.product-type.application";',
+        '\t\t};',
+        `\t\t${id(6, 0)} /* Sources */ = {`,
+        '\t\t\tisa = PBXSourcesBuildPhase;',
+        '\t\t\tfiles = ('
+    );
+    for (let i = 0; i < count; i++) {
+        parts.push(`\t\t\t\t${id(1, i)} /* file${i}.mm in Sources */,`);
+    }
+    parts.push('\t\t\t);', '\t\t};');
+
+    const configIds = [id(7, 0), id(7, 1)];
+    ['Debug', 'Release'].forEach((name, index) => {
+        parts.push(
+            `\t\t${configIds[index]} /* ${name} */ = {`,
+            '\t\t\tisa = XCBuildConfiguration;',
+            '\t\t\tbuildSettings = {',
+            '\t\t\t\tCLANG_CXX_LANGUAGE_STANDARD = "gnu++17";',
+            `\t\t\t\tGCC_PREPROCESSOR_DEFINITIONS = (\n\t\t\t\t\t"${name.toUpperCase()}=1",\n\t\t\t\t\t"$(inherited)",\n\t\t\t\t);`,
+            '\t\t\t\tHEADER_SEARCH_PATHS = (\n\t\t\t\t\tSources,\n\t\t\t\t\t"third_party/include",\n\t\t\t\t);',
+            '\t\t\t};',
+            `\t\t\tname = ${name};`,
+            '\t\t};'
+        );
+    });
+    parts.push(
+        `\t\t${id(5, 0)} = {`,
+        '\t\t\tisa = XCConfigurationList;',
+        `\t\t\tbuildConfigurations = (\n\t\t\t\t${configIds[0]} /* Debug */,\n\t\t\t\t${configIds[1]} /* Release */,\n\t\t\t);`,
+        '\t\t};',
+        '\t};',
+        `\trootObject = ${id(8, 0)} /* Project object */;`,
+        '}',
+        ''
+    );
+    return parts.join('\n');
+}
+
+export function run(): BenchResult[] {
+    const project4k = makePbxproj(4000);
+    const project40k = makePbxproj(40000);
+
+    return [
+        runBench('parse pbxproj 4k files', () => parseXcodeproj(project4k, 'App.xcodeproj')),
+        runBench(`parse pbxproj 40k files (${(project40k.length / 1e6).toFixed(1)} MB)`, () => parseXcodeproj(project40k, 'App.xcodeproj'), { iterations: 5 })
+    ];
+}
@@ -0,0 +1,605 @@
+/**
+ * Command-line formatting and lint helpers
+ * Argument parsing, file discovery, per-file processing, the content-hash
+ * result cache and report rendering. Only Node built-ins and the pure
+ * utilities are used, so everything here runs outside VS Code.
+ */
+
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as path from 'path';
+import {
+    CMakeFormattingOptions,
+    CMakeFormattingStyle,
+    STYLE_PRESETS,
+    formatCMakeLines
+} from '../utils/formattingUtils';
+import { diffLines } from '../utils/diffUtils';
+import { lintCMakeText, LintIssue, LintOptions, LintSeverity } from '../utils/lintUtils';
+
+export type CliCommand = 'fmt' | 'lint';
+export type OutputFormat = 'text' | 'json' | 'sarif';
+
+export interface CliOptions {
+    command: CliCommand;
+    /** Files and directories to process */
+    paths: string[];
+    /** Report instead of writing; fail when anything would change */
+    check: boolean;
+    /** Print unified diffs instead of writing */
+    diff: boolean;
+    format: OutputFormat;
+    /** Worker threads (1 = process in the main thread) */
+    jobs: number;
+    cache: boolean;
+    cacheFile: string;
+    /** Directory or file names to skip while walking */
+    exclude: string[];
+    /** Lint fails when there are more warnings than this (-1 = no limit) */
+    maxWarnings: number;
+    formatting: CMakeFormattingOptions;
+    lint: LintOptions;
+}
+
+export interface FileTask {
+    path: string;
+    text: string;
+    /** Whether the file is the top-level CMakeLists.txt of a given directory */
+    isSourceRoot: boolean;
+}
+
+export interface FileResult {
+    path: string;
+    /** fmt: whether formatting changes the file */
+    changed: boolean;
+    /** fmt: the formatted text, when changed */
+    formatted?: string;
+    issues: LintIssue[];
+}
+
+/**
+ * Data passed to each worker thread
+ */
+export interface WorkerData {
+    command: CliCommand;
+    formatting: CMakeFormattingOptions;
+    lint: LintOptions;
+}
+
+export const DEFAULT_CACHE_FILE = '.cmake-companion-cache.json';
+
+/**
+ * Directories never descended into while collecting files
+ */
+const SKIPPED_DIRECTORIES = new Set(['node_modules', '.git', '.svn', '.hg']);
+
+export const USAGE = `Usage: cmake-companion <fmt|lint> [options] <paths...>
+
+Commands:
+  fmt                       Format CMakeLists.txt and *.cmake files in place
+  lint                      Report diagnostics
+
+Options:
+  --check                   Do not write; exit with 1 if any file needs formatting
+  --diff                    Print unified diffs instead of writing files
+  --format <text|json|sarif>
+                            Report format (default: text)
+  -j, --jobs <n>            Worker threads (default: CPU count - 1)
+  --no-cache                Do not read or write the result cache
+  --cache-file <path>       Cache location (default: ${DEFAULT_CACHE_FILE})
+  --exclude <name>          Skip files or directories with this name (repeatable)
+  --settings <file>         Read cmake-companion.* options from a VS Code settings.json
+  --style <name>            Formatting style preset (default: google)
+  --max-line-length <n>     Override the style's line limit (0 = no limit)
+  --max-warnings <n>        Fail lint when there are more warnings than this
+  --no-undefined-variables  Skip the undefined-variable check
+  -h, --help                Show this help
+`;
+
+/**
+ * Whether a file name is a CMake script
+ */
+export function isCMakeFile(fileName: string): boolean {
+    const base = path.basename(fileName);
+    return base === 'CMakeLists.txt' || base.toLowerCase().endsWith('.cmake');
+}
+
+/**
+ * Remove // and /* *\/ comments and trailing commas from JSONC text
+ */
+export function stripJsonComments(text: string): string {
+    let result = '';
+    let inString = false;
+    for (let i = 0; i < text.length; i++) {
+        const ch = text[i];
+        if (inString) {
+            result += ch;
+            if (ch === '\\') {
+                result += text[++i] ?? '';
+            } else if (ch === '"') {
+                inString = false;
+            }
+        } else if (ch === '"') {
+            inString = true;
+            result += ch;
+        } else if (ch === '/' && text[i + 1] === '/') {
+            while (i < text.length && text[i] !== '\n') {
+                i++;
+            }
+            result += '\n';
+        } else if (ch === '/' && text[i + 1] === '*') {
+            const end = text.indexOf('*/', i + 2);
+            i = end < 0 ? text.length : end + 1;
+        } else {
+            result += ch;
+        }
+    }
+    return result.replace(/,(\s*[}\]])/g, '$1');
+}
+
+/**
+ * Apply cmake-companion.formatting.* and cmake-companion.diagnostics.* settings
+ * @param settings Parsed settings.json object
+ */
+export function applySettings(options: CliOptions, settings: Record<string, unknown>): void {
+    const get = (key: string) => settings[`cmake-companion.${key}`];
+    const style = get('formatting.style');
+    if (typeof style === 'string' && style in STYLE_PRESETS) {
+        options.formatting = { ...STYLE_PRESETS[style as CMakeFormattingStyle] };
+    }
+    const formattingKeys: Array<keyof CMakeFormattingOptions> = [
+        'maxLineLength', 'spaceAfterOpenParen', 'spaceBeforeCloseParen', 'uppercaseCommands', 'danglingParenthesis'
+    ];
+    for (const key of formattingKeys) {
+        const value = get(`formatting.${key}`);
+        if (value !== undefined && typeof value === typeof options.formatting[key]) {
+            (options.formatting as unknown as Record<string, unknown>)[key] = value;
+        }
+    }
+
+    const lintKeys: Array<'undefinedVariables' | 'unmatchedBlocks' | 'deprecatedCommands'> = [
+        'undefinedVariables', 'unmatchedBlocks', 'deprecatedCommands'
+    ];
+    for (const key of lintKeys) {
+        const value = get(`diagnostics.${key}`);
+        if (typeof value === 'boolean') {
+            options.lint[key] = value;
+        }
+    }
+    const buildPerformance = get('diagnostics.buildPerformance');
+    if (buildPerformance && typeof buildPerformance === 'object') {
+        options.lint.buildPerformance = buildPerformance as Record<string, string>;
+    }
+    const largeTargetSources = get('diagnostics.largeTargetSources');
+    if (typeof largeTargetSources === 'number') {
+        options.lint.largeTargetSources = largeTargetSources;
+    }
+}
+
+/**
+ * Parse command-line arguments
+ * @param argv Arguments after the executable and script
+ * @param defaultJobs Worker count used when --jobs is not given
+ * @throws Error with a user-facing message on invalid arguments
+ */
+export function parseCliArgs(argv: readonly string[], defaultJobs = 1): CliOptions {
+    const args: string[] = [];
+    for (const arg of argv) {
+        const eq = arg.startsWith('--') ? arg.indexOf('=') : -1;
+        if (eq > 0) {
+            args.push(arg.substring(0, eq), arg.substring(eq + 1));
+        } else if (/^-j\d+$/.test(arg)) {
+            args.push('-j', arg.substring(2));
+        } else {
+            args.push(arg);
+        }
+    }
+
+    const command = args.shift();
+    if (command !== 'fmt' && command !== 'lint') {
+        throw new Error(command ? `Unknown command '${command}'` : 'Missing command');
+    }
+
+    const options: CliOptions = {
+        command,
+        paths: [],
+        check: false,
+        diff: false,
+        format: 'text',
+        jobs: defaultJobs,
+        cache: true,
+        cacheFile: DEFAULT_CACHE_FILE,
+        exclude: [],
+        maxWarnings: -1,
+        formatting: { ...STYLE_PRESETS.google },
+        lint: {}
+    };
+    let settingsFile: string | undefined;
+    let style: string | undefined;
+    let maxLineLength: number | undefined;
+    let undefinedVariables = true;
+
+    const value = (flag: string): string => {
+        const next = args.shift();
+        if (next === undefined) {
+            throw new Error(`Missing value for ${flag}`);
+        }
+        return next;
+    };
+    const numberValue = (flag: string): number => {
+        const text = value(flag);
+        const parsed = Number(text);
+        if (!Number.isInteger(parsed) || parsed < 0) {
+            throw new Error(`Invalid value for ${flag}: ${text}`);
+        }
+        return parsed;
+    };
+
+    while (args.length > 0) {
+        const arg = args.shift()!;
+        switch (arg) {
+            case '--check': options.check = true; break;
+            case '--diff': options.diff = true; break;
+            case '--no-cache': options.cache = false; break;
+            case '--cache-file': options.cacheFile = value(arg); break;
+            case '--exclude': options.exclude.push(value(arg)); break;
+            case '--settings': settingsFile = value(arg); break;
+            case '--style': style = value(arg); break;
+            case '--max-line-length': maxLineLength = numberValue(arg); break;
+            case '--max-warnings': options.maxWarnings = numberValue(arg); break;
+            case '--no-undefined-variables': undefinedVariables = false; break;
+            case '-j':
+            case '--jobs':
+                options.jobs = Math.max(1, numberValue(arg));
+                break;
+            case '--format': {
+                const format = value(arg);
+                if (format !== 'text' && format !== 'json' && format !== 'sarif') {
+                    throw new Error(`Unknown format '${format}'`);
+                }
+                options.format = format;
+                break;
+            }
+            default:
+                if (arg.startsWith('-') && arg !== '-') {
+                    throw new Error(`Unknown option '${arg}'`);
+                }
+                options.paths.push(arg);
+        }
+    }
+
+    if (settingsFile) {
+        const settings = JSON.parse(stripJsonComments(fs.readFileSync(settingsFile, 'utf8')));
+        applySettings(options, settings);
+    }
+    if (style !== undefined) {
+        if (!(style in STYLE_PRESETS)) {
+            throw new Error(`Unknown style '${style}'`);
+        }
+        options.formatting = { ...STYLE_PRESETS[style as CMakeFormattingStyle] };
+    }
+    if (maxLineLength !== undefined) {
+        options.formatting.maxLineLength = maxLineLength;
+    }
+    if (!undefinedVariables) {
+        options.lint.undefinedVariables = false;
+    }
+    if (options.paths.length === 0) {
+        options.paths.push('.');
+    }
+    return options;
+}
+
+/**
+ * Collect CMake files under the given paths, in a stable order
+ * Explicitly named files are included whatever their name.
+ * @returns Tasks without text (read separately)
+ */
+export function collectFiles(paths: readonly string[], exclude: readonly string[] = []): Array<Omit<FileTask, 'text'>> {
+    const skipped = new Set([...SKIPPED_DIRECTORIES, ...exclude]);
+    const files: Array<Omit<FileTask, 'text'>> = [];
+    const seen = new Set<string>();
+
+    const add = (file: string, isSourceRoot: boolean) => {
+        const resolved = path.resolve(file);
+        if (!seen.has(resolved)) {
+            seen.add(resolved);
+            files.push({ path: file, isSourceRoot });
+        }
+    };
+
+    const walk = (dir: string, isRoot: boolean) => {
+        const entries = fs.readdirSync(dir, { withFileTypes: true })
+            .sort((a, b) => (a.name < b.name ? -1 : a.name > b.name ? 1 : 0));
+        // Build trees are generated; their CMake files are not sources
+        if (!isRoot && entries.some(entry => entry.name === 'CMakeCache.txt')) {
+            return;
+        }
+        for (const entry of entries) {
+            if (skipped.has(entry.name)) {
+                continue;
+            }
+            const full = path.join(dir, entry.name);
+            if (entry.isDirectory()) {
+                walk(full, false);
+            } else if (entry.isFile() && isCMakeFile(entry.name)) {
+                add(full, isRoot && entry.name === 'CMakeLists.txt');
+            }
+        }
+    };
+
+    for (const target of paths) {
+        const stat = fs.statSync(target);
+        if (stat.isDirectory()) {
+            walk(target, true);
+        } else {
+            add(target, false);
+        }
+    }
+    return files;
+}
+
+/**
+ * Hash of everything a result depends on: command, options and file content
+ */
+export function hashTask(command: CliCommand, options: CliOptions, task: FileTask): string {
+    const relevant = command === 'fmt'
+        ? options.formatting
+        : { lint: { ...options.lint, definedVariables: undefined }, isSourceRoot: task.isSourceRoot };
+    return crypto.createHash('sha1')
+        .update(command)
+        .update('\0')
+        .update(JSON.stringify(relevant))
+        .update('\0')
+        .update(task.text)
+        .digest('hex');
+}
+
+/**
+ * Format or lint one file
+ */
+export function processFile(
+    command: CliCommand,
+    task: FileTask,
+    formatting: CMakeFormattingOptions,
+    lint: LintOptions
+): FileResult {
+    if (command === 'lint') {
+        return {
+            path: task.path,
+            changed: false,
+            issues: lintCMakeText(task.text, { ...lint, isSourceRoot: task.isSourceRoot })
+        };
+    }
+
+    const eol = task.text.includes('\r\n') ? '\r\n' : '\n';
+    const formatted = formatCMakeLines(task.text, formatting).join(eol);
+    if (formatted === task.text) {
+        return { path: task.path, changed: false, issues: [] };
+    }
+    const hunks = diffLines(task.text.split(/\r?\n/), formatted.split(/\r?\n/));
+    const line = hunks.length > 0 ? hunks[0].oldStart : 0;
+    return {
+        path: task.path,
+        changed: true,
+        formatted,
+        issues: [{
+            rule: 'format',
+            severity: 'warning',
+            message: 'File is not formatted',
+            line,
+            column: 0,
+            endLine: line,
+            endColumn: 0
+        }]
+    };
+}
+
+interface CacheEntry {
+    hash: string;
+    changed: boolean;
+    issues: LintIssue[];
+}
+
+/**
+ * Results keyed by file path and content hash, persisted as JSON
+ * The file records the tool version that wrote it; an upgrade can change
+ * formatter or lint output, so a cache from another version is discarded.
+ */
+export class ResultCache {
+    private static readonly VERSION = 1;
+    private entries: Record<string, CacheEntry> = {};
+    private dirty = false;
+    private readonly file: string;
+    private readonly toolVersion: string;
+
+    /**
+     * @param file Cache file path
+     * @param toolVersion Package version of the running tool
+     */
+    constructor(file: string, toolVersion: string) {
+        this.file = file;
+        this.toolVersion = toolVersion;
+    }
+
+    /**
+     * Load the cache file, starting empty when it is missing or unreadable
+     */
+    load(): void {
+        try {
+            const data = JSON.parse(fs.readFileSync(this.file, 'utf8'));
+            if (data && data.version === ResultCache.VERSION && data.toolVersion === this.toolVersion && data.entries) {
+                this.entries = data.entries;
+            }
+        } catch {
+            this.entries = {};
+        }
+    }
+
+    /**
+     * Cached result for a file, if its hash matches
+     */
+    get(filePath: string, hash: string): FileResult | undefined {
+        const entry = this.entries[path.resolve(filePath)];
+        if (!entry || entry.hash !== hash) {
+            return undefined;
+        }
+        return { path: filePath, changed: entry.changed, issues: entry.issues };
+    }
+
+    set(filePath: string, hash: string, result: FileResult): void {
+        this.entries[path.resolve(filePath)] = { hash, changed: result.changed, issues: result.issues };
+        this.dirty = true;
+    }
+
+    /**
+     * Write the cache file if anything changed
+     */
+    save(): void {
+        if (this.dirty) {
+            fs.writeFileSync(this.file, JSON.stringify({
+                version: ResultCache.VERSION,
+                toolVersion: this.toolVersion,
+                entries: this.entries
+            }));
+            this.dirty = false;
+        }
+    }
+}
+
+/**
+ * Render a unified diff between two texts
+ * @param fileName Name shown in the header
+ * @param context Unchanged lines around each change
+ */
+export function createUnifiedDiff(fileName: string, oldText: string, newText: string, context = 3): string {
+    const oldLines = oldText.split(/\r?\n/);
+    const newLines = newText.split(/\r?\n/);
+    const hunks = diffLines(oldLines, newLines);
+    if (hunks.length === 0) {
+        return '';
+    }
+
+    const name = fileName.split(path.sep).join('/');
+    const output = [`--- a/${name}`, `+++ b/${name}`];
+    let i = 0;
+    while (i < hunks.length) {
+        // Merge hunks whose context would overlap
+        let j = i;
+        while (j + 1 < hunks.length && hunks[j + 1].oldStart - hunks[j].oldEnd <= context * 2) {
+            j++;
+        }
+        const oldStart = Math.max(0, hunks[i].oldStart - context);
+        const oldEnd = Math.min(oldLines.length, hunks[j].oldEnd + context);
+        const newStart = hunks[i].newStart - (hunks[i].oldStart - oldStart);
+        const newEnd = hunks[j].newEnd + (oldEnd - hunks[j].oldEnd);
+
+        const lines: string[] = [];
+        let oldLine = oldStart;
+        for (let k = i; k <= j; k++) {
+            const hunk = hunks[k];
+            for (; oldLine < hunk.oldStart; oldLine++) {
+                lines.push(' ' + oldLines[oldLine]);
+            }
+            for (let line = hunk.oldStart; line < hunk.oldEnd; line++) {
+                lines.push('-' + oldLines[line]);
+            }
+            for (let line = hunk.newStart; line < hunk.newEnd; line++) {
+                lines.push('+' + newLines[line]);
+            }
+            oldLine = hunk.oldEnd;
+        }
+        for (; oldLine < oldEnd; oldLine++) {
+            lines.push(' ' + oldLines[oldLine]);
+        }
+
+        const range = (start: number, count: number) => `${count === 0 ? start : start + 1},${count}`;
+        output.push(`@@ -${range(oldStart, oldEnd - oldStart)} +${range(newStart, newEnd - newStart)} @@`);
+        output.push(...lines);
+        i = j + 1;
+    }
+    return output.join('\n') + '\n';
+}
+
+/**
+ * Render results as compiler-style text lines
+ */
+export function formatTextReport(results: readonly FileResult[], command: CliCommand, check: boolean): string {
+    const lines: string[] = [];
+    for (const result of results) {
+        if (command === 'fmt') {
+            if (result.changed) {
+                lines.push(check ? `${result.path}: not formatted` : `Formatted ${result.path}`);
+            }
+            continue;
+        }
+        for (const issue of result.issues) {
+            lines.push(`${result.path}:${issue.line + 1}:${issue.column + 1}: ${issue.severity}: ${issue.message} [${issue.rule}]`);
+        }
+    }
+    return lines.join('\n');
+}
+
+/**
+ * Render results as JSON
+ */
+export function formatJsonReport(results: readonly FileResult[]): string {
+    return JSON.stringify(results.map(result => ({
+        path: result.path.split(path.sep).join('/'),
+        changed: result.changed,
+        issues: result.issues
+    })), null, 2);
+}
+
+const SARIF_LEVELS: Record<LintSeverity, string> = {
+    error: 'error',
+    warning: 'warning',
+    information: 'note',
+    hint: 'note'
+};
+
+/**
+ * Render results as a SARIF 2.1.0 log
+ * @param version Tool version reported in the log
+ */
+export function formatSarifReport(results: readonly FileResult[], version: string): string {
+    const rules = new Set<string>();
+    const sarifResults: object[] = [];
+    for (const result of results) {
+        for (const issue of result.issues) {
+            rules.add(issue.rule);
+            sarifResults.push({
+                ruleId: issue.rule,
+                level: SARIF_LEVELS[issue.severity],
+                message: { text: issue.message },
+                locations: [{
+                    physicalLocation: {
+                        artifactLocation: { uri: result.path.split(path.sep).join('/') },
+                        region: {
+                            startLine: issue.line + 1,
+                            startColumn: issue.column + 1,
+                            endLine: issue.endLine + 1,
+                            endColumn: issue.endColumn + 1
+                        }
+                    }
+                }]
+            });
+        }
+    }
+
+    return JSON.stringify({
+        $schema: 'https://json.schemastore.org/sarif-2.1.0.json',
+        version: '2.1.0',
+        runs: [{
+            tool: {
+                driver: {
+                    name: 'cmake-companion',
+                    version,
+                    informationUri: 'https://github.com/appledragon/cmake-companion',
+                    rules: [...rules].sort().map(id => ({ id }))
+                }
+            },
+            results: sarifResults
+        }]
+    }, null, 2);
+}
@@ -0,0 +1,163 @@
+#!/usr/bin/env node
+/**
+ * cmake-companion command-line entry point
+ *   cmake-companion fmt [--check] [--diff] <paths...>
+ *   cmake-companion lint [--format text|json|sarif] <paths...>
+ * Files are sharded across worker threads; unchanged files are answered from
+ * a cache keyed by content hash.
+ */
+
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import {
+    CliOptions,
+    FileResult,
+    FileTask,
+    ResultCache,
+    WorkerData,
+    USAGE,
+    collectFiles,
+    createUnifiedDiff,
+    formatJsonReport,
+    formatSarifReport,
+    formatTextReport,
+    hashTask,
+    parseCliArgs,
+    processFile
+} from './cliUtils';
+import { runWorkerPool, BATCH_SIZE } from '../utils/workerPool';
+
+/**
+ * Below this many uncached files, starting workers costs more than it saves
+ */
+const IN_PROCESS_LIMIT = BATCH_SIZE * 2;
+
+function readVersion(): string {
+    try {
+        const pkg = JSON.parse(fs.readFileSync(path.join(__dirname, '..', '..', 'package.json'), 'utf8'));
+        return String(pkg.version);
+    } catch {
+        return '0.0.0';
+    }
+}
+
+/**
+ * Process tasks, from the cache where possible
+ */
+async function processTasks(options: CliOptions, tasks: FileTask[], cache: ResultCache | undefined): Promise<FileResult[]> {
+    const results: FileResult[] = new Array(tasks.length);
+    const hashes: string[] = [];
+    const missing: number[] = [];
+    // Writing and diffing need the formatted text, which is not cached
+    const needsText = options.command === 'fmt' && (options.diff || !options.check);
+
+    tasks.forEach((task, i) => {
+        hashes.push(hashTask(options.command, options, task));
+        const cached = cache?.get(task.path, hashes[i]);
+        if (cached && !(needsText && cached.changed)) {
+            results[i] = cached;
+        } else {
+            missing.push(i);
+        }
+    });
+
+    const pending = missing.map(i => tasks[i]);
+    let computed: FileResult[];
+    if (options.jobs <= 1 || pending.length < IN_PROCESS_LIMIT) {
+        computed = pending.map(task => processFile(options.command, task, options.formatting, options.lint));
+    } else {
+        // The worker sits next to this file (.js when compiled, .ts under ts-node,
+        // whose --require is inherited through the default execArgv)
+        const workerFile = path.join(__dirname, `worker${path.extname(__filename)}`);
+        const data: WorkerData = {
+            command: options.command,
+            formatting: options.formatting,
+            lint: options.lint
+        };
+        computed = await runWorkerPool<FileTask, FileResult>(workerFile, pending, { jobs: options.jobs, data });
+    }
+
+    missing.forEach((taskIndex, i) => {
+        results[taskIndex] = computed[i];
+        cache?.set(tasks[taskIndex].path, hashes[taskIndex], computed[i]);
+    });
+    return results;
+}
+
+/**
+ * Run the CLI
+ * @returns Process exit code: 0 success, 1 check/lint failure, 2 usage error
+ */
+export async function main(argv: string[]): Promise<number> {
+    if (argv.length === 0 || argv.includes('-h') || argv.includes('--help')) {
+        process.stdout.write(USAGE);
+        return argv.length === 0 ? 2 : 0;
+    }
+
+    let options: CliOptions;
+    let tasks: FileTask[];
+    try {
+        options = parseCliArgs(argv, Math.max(1, os.cpus().length - 1));
+        tasks = collectFiles(options.paths, options.exclude).map(file => ({
+            ...file,
+            text: fs.readFileSync(file.path, 'utf8')
+        }));
+    } catch (error) {
+        process.stderr.write(`cmake-companion: ${error instanceof Error ? error.message : String(error)}\n\n${USAGE}`);
+        return 2;
+    }
+
+    const cache = options.cache ? new ResultCache(options.cacheFile, readVersion()) : undefined;
+    cache?.load();
+    const results = await processTasks(options, tasks, cache);
+
+    // Write formatted files (formatted text is dropped once applied)
+    if (options.command === 'fmt' && !options.check && !options.diff) {
+        for (const result of results) {
+            if (result.changed && result.formatted !== undefined) {
+                fs.writeFileSync(result.path, result.formatted);
+                cache?.set(result.path, hashTask('fmt', options, { path: result.path, text: result.formatted, isSourceRoot: false }),
+                    { path: result.path, changed: false, issues: [] });
+            }
+        }
+    }
+    cache?.save();
+
+    if (options.diff) {
+        results.forEach((result, i) => {
+            if (result.changed && result.formatted !== undefined) {
+                process.stdout.write(createUnifiedDiff(path.relative('.', result.path), tasks[i].text, result.formatted));
+            }
+        });
+    }
+
+    let report: string;
+    switch (options.format) {
+        case 'json': report = formatJsonReport(results); break;
+        case 'sarif': report = formatSarifReport(results, readVersion()); break;
+        default: report = options.diff ? '' : formatTextReport(results, options.command, options.check);
+    }
+    if (report) {
+        process.stdout.write(report + '\n');
+    }
+
+    if (options.command === 'fmt') {
+        return (options.check || options.diff) && results.some(result => result.changed) ? 1 : 0;
+    }
+    const issues = results.flatMap(result => result.issues);
+    const warnings = issues.filter(issue => issue.severity === 'warning').length;
+    const failed = issues.some(issue => issue.severity === 'error')
+        || (options.maxWarnings >= 0 && warnings > options.maxWarnings);
+    return failed ? 1 : 0;
+}
+
+if (require.main === module) {
+    main(process.argv.slice(2)).then(
+        (code) => { process.exitCode = code; },
+        (error) => {
+            process.stderr.write(`cmake-companion: ${error instanceof Error ? error.stack : String(error)}\n`);
+            process.exitCode = 2;
+        }
+    );
+}
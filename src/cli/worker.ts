@@ -0,0 +1,11 @@
+/**
+ * CLI worker thread: formats or lints batches of files sent by the pool
+ */
+
+import { workerData } from 'worker_threads';
+import { processFile, FileTask, WorkerData } from './cliUtils';
+import { serveWorkerTasks } from '../utils/workerPool';
+
+const data = workerData as WorkerData;
+
+serveWorkerTasks((task: FileTask) => processFile(data.command, task, data.formatting, data.lint));
@@ -5,7 +5,9 @@
 
 import * as vscode from 'vscode';
 import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
+import * as v8 from 'v8';
 import { 
     CMakeDocumentLinkProvider, 
     CMakeHoverProvider, 
@@ -16,12 +18,45 @@ import {
     CMakeOnTypeFormattingProvider,
     CMakeCompletionProvider,
     CMakeFoldingRangeProvider,
+    CMakeTargetTreeProvider,
     getDiagnosticProvider,
     disposeDiagnosticProvider,
     legend
 } from './providers';
-import { getVariableResolver, getFileWatcher, disposeFileWatcher } from './services';
-import { parseVcxproj, generateCMakeLists, parseXcodeproj, generateCMakeListsFromXcode } from './parsers';
+import {
+    getVariableResolver,
+    getFileWatcher,
+    disposeFileWatcher,
+    getTargetIndex,
+    getIndentModelService,
+    disposeIndentModelService,
+    CMakeLanguageClient,
+    convertSolution,
+    SolutionConversion,
+    getPropertySheetCache,
+    convertXcodeproj,
+    XcodeprojConversion,
+    convertXcworkspace,
+    XcworkspaceConversion,
+    planResync,
+    planResyncFiles,
+    writeResyncPlans,
+    ResyncPlan,
+    getPerformanceMonitor,
+    getTracer,
+    getMemoryRegistry,
+    getXcconfigCache
+} from './services';
+import { WorkerPoolCancelledError } from './utils/workerPool';
+import { parseVcxproj, writeCMakeLists, generateFencedCMakeLists, FastBuildProfile } from './parsers';
+import { StreamLineWriter } from './utils/lineWriter';
+import { FencedLineWriter, hasFencedSections } from './utils/fencedSections';
+
+// Client for the out-of-process language server, when enabled
+let languageClient: CMakeLanguageClient | undefined;
+
+// Output channel for the performance report, created on first use
+let performanceChannel: vscode.OutputChannel | undefined;
 
 // Supported language IDs and file patterns
 // Only support CMake files - C/C++ path resolution is handled by other extensions
@@ -36,16 +71,32 @@ const SUPPORTED_LANGUAGES = [
  * @param context Extension context
  */
 export async function activate(context: vscode.ExtensionContext): Promise<void> {
+    // Enabled first so that the activation phases are traced
+    const tracer = getTracer();
+    tracer.setEnabled(vscode.workspace.getConfiguration('cmake-companion').get<boolean>('tracing.enabled', false));
+    await tracer.span('activate', 'activation', () => activateExtension(context));
+}
+
+/**
+ * Activation proper, traced as the activate span
+ * @param context Extension context
+ */
+async function activateExtension(context: vscode.ExtensionContext): Promise<void> {
     console.log('CMake Path Resolver is now active!');
+    const tracer = getTracer();
     const statusBar = vscode.window.createStatusBarItem(vscode.StatusBarAlignment.Left, 100);
     statusBar.tooltip = 'CMake Path Resolver';
     statusBar.show();
     context.subscriptions.push(statusBar);
     let lastRefreshed = new Date();
     
+    // Latency histograms for the performance report, off unless configured
+    const monitor = getPerformanceMonitor();
+    monitor.setEnabled(vscode.workspace.getConfiguration('cmake-companion').get<boolean>('performance.monitoring', false));
+    
     // Initialize variable resolver (but don't scan workspace yet)
     const resolver = getVariableResolver();
-    resolver.initializeFromVSCode(vscode.workspace.workspaceFolders);
+    tracer.span('initializeResolver', 'activation', () => resolver.initializeFromVSCode(vscode.workspace.workspaceFolders));
     
     // Initialize file watcher (files will be added to watch list when opened)
     const fileWatcher = getFileWatcher();
@@ -59,50 +110,80 @@ export async function activate(context: vscode.ExtensionContext): Promise<void>
     context.subscriptions.push(
         vscode.languages.registerDocumentLinkProvider(
             SUPPORTED_LANGUAGES,
-            new CMakeDocumentLinkProvider()
+            monitor.instrument(new CMakeDocumentLinkProvider(), { provideDocumentLinks: 'links' })
         )
     );
     
+    const hoverProvider = new CMakeHoverProvider();
     context.subscriptions.push(
+        hoverProvider,
         vscode.languages.registerHoverProvider(
             SUPPORTED_LANGUAGES,
-            new CMakeHoverProvider()
+            monitor.instrument(hoverProvider, { provideHover: 'hover' })
         )
     );
     
     context.subscriptions.push(
         vscode.languages.registerDefinitionProvider(
             SUPPORTED_LANGUAGES,
-            new CMakeDefinitionProvider()
+            monitor.instrument(new CMakeDefinitionProvider(), { provideDefinition: 'definition' })
         )
     );
     
     context.subscriptions.push(
         vscode.languages.registerDocumentSemanticTokensProvider(
             SUPPORTED_LANGUAGES,
-            new CMakeSemanticTokensProvider(),
+            monitor.instrument(new CMakeSemanticTokensProvider(), { provideDocumentSemanticTokens: 'semanticTokens' }),
             legend
         )
     );
     
-    context.subscriptions.push(
-        vscode.languages.registerDocumentFormattingEditProvider(
-            SUPPORTED_LANGUAGES,
-            new CMakeDocumentFormattingProvider()
-        )
-    );
+    // Per-document indentation models used by range and on-type formatting
+    getIndentModelService();
+    context.subscriptions.push({ dispose: () => disposeIndentModelService() });
     
-    context.subscriptions.push(
-        vscode.languages.registerDocumentRangeFormattingEditProvider(
-            SUPPORTED_LANGUAGES,
-            new CMakeDocumentRangeFormattingProvider()
-        )
-    );
+    // Diagnostics, formatting and folding run either in a language-server
+    // process or in the extension host
+    const useLanguageServer = vscode.workspace.getConfiguration('cmake-companion')
+        .get<boolean>('languageServer.enabled', false);
+    if (useLanguageServer) {
+        const client = new CMakeLanguageClient(context.asAbsolutePath(path.join('dist', 'server', 'index.js')));
+        languageClient = client;
+        // Measured from the extension host, so the times include the round trip
+        monitor.instrument(client, {
+            provideDocumentFormattingEdits: 'formatting',
+            provideDocumentRangeFormattingEdits: 'formatting.range',
+            provideFoldingRanges: 'folding'
+        });
+        context.subscriptions.push(
+            languageClient,
+            vscode.languages.registerDocumentFormattingEditProvider(SUPPORTED_LANGUAGES, languageClient),
+            vscode.languages.registerDocumentRangeFormattingEditProvider(SUPPORTED_LANGUAGES, languageClient),
+            vscode.languages.registerFoldingRangeProvider(SUPPORTED_LANGUAGES, languageClient)
+        );
+        tracer.span('languageServer.start', 'activation', () => client.start()).catch((error) => {
+            console.error('Failed to start the CMake language server:', error);
+        });
+    } else {
+        context.subscriptions.push(
+            vscode.languages.registerDocumentFormattingEditProvider(
+                SUPPORTED_LANGUAGES,
+                monitor.instrument(new CMakeDocumentFormattingProvider(), { provideDocumentFormattingEdits: 'formatting' })
+            )
+        );
+        
+        context.subscriptions.push(
+            vscode.languages.registerDocumentRangeFormattingEditProvider(
+                SUPPORTED_LANGUAGES,
+                monitor.instrument(new CMakeDocumentRangeFormattingProvider(), { provideDocumentRangeFormattingEdits: 'formatting.range' })
+            )
+        );
+    }
     
     context.subscriptions.push(
         vscode.languages.registerOnTypeFormattingEditProvider(
             SUPPORTED_LANGUAGES,
-            new CMakeOnTypeFormattingProvider(),
+            monitor.instrument(new CMakeOnTypeFormattingProvider(), { provideOnTypeFormattingEdits: 'formatting.onType' }),
             CMakeOnTypeFormattingProvider.triggerCharacters[0],
             ...CMakeOnTypeFormattingProvider.triggerCharacters.slice(1)
         )
@@ -111,21 +192,53 @@ export async function activate(context: vscode.ExtensionContext): Promise<void>
     context.subscriptions.push(
         vscode.languages.registerCompletionItemProvider(
             SUPPORTED_LANGUAGES,
-            new CMakeCompletionProvider(),
+            monitor.instrument(new CMakeCompletionProvider(), { provideCompletionItems: 'completion' }),
             '$', '{'
         )
     );
     
+    if (!useLanguageServer) {
+        context.subscriptions.push(
+            vscode.languages.registerFoldingRangeProvider(
+                SUPPORTED_LANGUAGES,
+                monitor.instrument(new CMakeFoldingRangeProvider(), { provideFoldingRanges: 'folding' })
+            )
+        );
+    }
+    
+    // Target dependency tree in the explorer
+    const targetTreeProvider = new CMakeTargetTreeProvider();
     context.subscriptions.push(
-        vscode.languages.registerFoldingRangeProvider(
-            SUPPORTED_LANGUAGES,
-            new CMakeFoldingRangeProvider()
-        )
+        targetTreeProvider,
+        vscode.window.registerTreeDataProvider('cmake-companion.targets', targetTreeProvider)
     );
     
     // Initialize diagnostic provider (singleton with its own lifecycle management)
-    const diagnosticProvider = getDiagnosticProvider();
-    context.subscriptions.push({ dispose: () => disposeDiagnosticProvider() });
+    if (!useLanguageServer) {
+        monitor.instrument(getDiagnosticProvider(), { updateDiagnostics: 'diagnostics' }, 'diagnostics');
+        context.subscriptions.push({ dispose: () => disposeDiagnosticProvider() });
+    }
+    
+    // Entry counts and approximate sizes of caches and indexes, for the memory report
+    const memory = getMemoryRegistry();
+    context.subscriptions.push(
+        memory.register('resolver.variables', () => resolver.getMemoryUsage().variables),
+        memory.register('resolver.lists', () => resolver.getMemoryUsage().lists),
+        memory.register('resolver.definitions', () => resolver.getMemoryUsage().definitions),
+        memory.register('resolver.contributors', () => resolver.getMemoryUsage().contributors),
+        memory.register('resolver.environment', () => resolver.getMemoryUsage().environment),
+        memory.register('targetIndex', () => getTargetIndex().getMemoryUsage()),
+        memory.register('fileWatcher', () => fileWatcher.getMemoryUsage()),
+        memory.register('indentModels', () => getIndentModelService().getMemoryUsage()),
+        memory.register('hover.generatorExpressions', () => hoverProvider.getMemoryUsage()),
+        memory.register('propertySheetCache', () => getPropertySheetCache().getMemoryUsage()),
+        memory.register('xcconfigCache', () => getXcconfigCache().getMemoryUsage()),
+        memory.register('performanceMonitor', () => monitor.getMemoryUsage()),
+        memory.register('tracer', () => tracer.getMemoryUsage())
+    );
+    if (!useLanguageServer) {
+        context.subscriptions.push(memory.register('diagnostics', () => getDiagnosticProvider().getMemoryUsage()));
+    }
     
     // Register commands
     const resolvePathCommand = vscode.commands.registerCommand(
@@ -154,6 +267,13 @@ export async function activate(context: vscode.ExtensionContext): Promise<void>
     );
     context.subscriptions.push(convertVcxprojCommand);
     
+    // Command to convert every project of a Visual Studio solution
+    const convertSolutionCommand = vscode.commands.registerCommand(
+        'cmake-companion.convertSolutionToCMake',
+        convertSolutionToCMakeHandler
+    );
+    context.subscriptions.push(convertSolutionCommand);
+    
     // Command to convert Xcode project to CMake
     const convertXcodeprojCommand = vscode.commands.registerCommand(
         'cmake-companion.convertXcodeprojToCMake',
@@ -161,11 +281,49 @@ export async function activate(context: vscode.ExtensionContext): Promise<void>
     );
     context.subscriptions.push(convertXcodeprojCommand);
     
+    // Command to convert every project of an Xcode workspace
+    const convertXcworkspaceCommand = vscode.commands.registerCommand(
+        'cmake-companion.convertXcworkspaceToCMake',
+        convertXcworkspaceToCMakeHandler
+    );
+    context.subscriptions.push(convertXcworkspaceCommand);
+    
+    // Command to show what a target depends on and what depends on it
+    const showTargetDependenciesCommand = vscode.commands.registerCommand(
+        'cmake-companion.showTargetDependencies',
+        showTargetDependenciesHandler
+    );
+    context.subscriptions.push(showTargetDependenciesCommand);
+    
+    // Command to show latency percentiles recorded by the performance monitor
+    const showPerformanceReportCommand = vscode.commands.registerCommand(
+        'cmake-companion.showPerformanceReport',
+        showPerformanceReportHandler
+    );
+    context.subscriptions.push(showPerformanceReportCommand);
+    
+    // Command to write recorded trace spans to the extension's log directory
+    const saveTraceCommand = vscode.commands.registerCommand(
+        'cmake-companion.saveTrace',
+        () => saveTraceHandler(context.logUri.fsPath)
+    );
+    context.subscriptions.push(saveTraceCommand);
+    
+    // Command to show memory held by caches and indexes, with an optional heap snapshot
+    const showMemoryReportCommand = vscode.commands.registerCommand(
+        'cmake-companion.showMemoryReport',
+        () => showMemoryReportHandler(context.logUri.fsPath)
+    );
+    context.subscriptions.push(showMemoryReportCommand);
+    
     // Internal command to refresh decorations (used by file watcher)
     const internalRefreshCommand = vscode.commands.registerCommand(
         'cmake-companion.internal.refreshDecorations',
         () => {
             // Trigger re-validation of open documents
+            if (languageClient) {
+                return;
+            }
             const diagnosticProvider = getDiagnosticProvider();
             for (const document of vscode.workspace.textDocuments) {
                 if (isCMakeFile(document)) {
@@ -193,7 +351,10 @@ export async function activate(context: vscode.ExtensionContext): Promise<void>
             // Only parse CMake files
             if (isCMakeFile(document)) {
                 const filePath = document.uri.fsPath;
-                await resolver.parseFile(filePath);
+                await tracer.span('openDocument', 'indexing', async () => {
+                    await resolver.parseFile(filePath);
+                    await indexTargets([filePath]);
+                }, { file: filePath });
                 // Add to file watcher list
                 fileWatcher.addFile(filePath);
                 lastRefreshed = new Date();
@@ -203,27 +364,36 @@ export async function activate(context: vscode.ExtensionContext): Promise<void>
     );
     
     // Also parse any already-open CMake files at activation
-    for (const document of vscode.workspace.textDocuments) {
-        if (isCMakeFile(document)) {
-            await resolver.parseFile(document.uri.fsPath);
+    await tracer.span('parseOpenDocuments', 'activation', async () => {
+        const filePaths = openCMakeFilePaths();
+        for (const filePath of filePaths) {
+            await resolver.parseFile(filePath);
             // Add to file watcher list
-            fileWatcher.addFile(document.uri.fsPath);
+            fileWatcher.addFile(filePath);
         }
-    }
+        await indexTargets(filePaths);
+    });
     lastRefreshed = new Date();
     updateStatusBar();
     
     // Listen for configuration changes
     context.subscriptions.push(
         vscode.workspace.onDidChangeConfiguration(async (e) => {
+            if (e.affectsConfiguration('cmake-companion.tracing.enabled')) {
+                tracer.setEnabled(vscode.workspace.getConfiguration('cmake-companion').get<boolean>('tracing.enabled', false));
+            }
+            if (e.affectsConfiguration('cmake-companion.performance.monitoring')) {
+                monitor.setEnabled(vscode.workspace.getConfiguration('cmake-companion').get<boolean>('performance.monitoring', false));
+            }
             if (e.affectsConfiguration('cmake-companion')) {
                 resolver.clear();
+                getTargetIndex().clear();
                 // Reparse only currently open CMake files
-                for (const document of vscode.workspace.textDocuments) {
-                    if (isCMakeFile(document)) {
-                        await resolver.parseFile(document.uri.fsPath);
-                    }
+                const filePaths = openCMakeFilePaths();
+                for (const filePath of filePaths) {
+                    await resolver.parseFile(filePath);
                 }
+                await indexTargets(filePaths);
                 lastRefreshed = new Date();
                 updateStatusBar();
             }
@@ -258,12 +428,36 @@ function isCMakeFile(document: vscode.TextDocument): boolean {
     return false;
 }
 
+/**
+ * Paths of the open CMake documents
+ */
+function openCMakeFilePaths(): string[] {
+    return vscode.workspace.textDocuments.filter(isCMakeFile).map(document => document.uri.fsPath);
+}
+
+/**
+ * Index the targets of CMake files, expanding list variables with the resolver
+ * Listeners of the index are notified once for the whole batch.
+ * @param filePaths The file paths
+ */
+async function indexTargets(filePaths: string[]): Promise<void> {
+    const resolver = getVariableResolver();
+    await getTracer().span('indexTargets', 'indexing', () =>
+        getTargetIndex().indexFiles(filePaths, value => resolver.expandList(value)),
+        filePaths.length === 1 ? { file: filePaths[0] } : { files: filePaths.length });
+}
+
 /**
  * Extension deactivation
  */
-export function deactivate(): void {
+export async function deactivate(): Promise<void> {
+    await languageClient?.stop();
+    languageClient = undefined;
     disposeFileWatcher();
     disposeDiagnosticProvider();
+    disposeIndentModelService();
+    performanceChannel?.dispose();
+    performanceChannel = undefined;
     console.log('CMake Companion is now deactivated.');
 }
 
@@ -313,50 +507,198 @@ async function convertVcxprojToCMakeHandler(uri?: vscode.Uri): Promise<void> {
     // Parse the vcxproj file
     let project;
     try {
-        project = parseVcxproj(vcxprojContent, vcxprojPath);
+        // Imported property sheets are resolved relative to the project
+        project = parseVcxproj(vcxprojContent, vcxprojPath, getPropertySheetCache().getParseOptions());
     } catch (error) {
         const message = error instanceof Error ? error.message : String(error);
         vscode.window.showErrorMessage(`Failed to parse vcxproj file: ${message}`);
         return;
     }
     
-    // Generate CMakeLists.txt content
-    const cmakeContent = generateCMakeLists(project);
-    
     // Determine output path (same directory as vcxproj)
     const vcxprojDir = path.dirname(vcxprojPath);
     const cmakeListsPath = path.join(vcxprojDir, 'CMakeLists.txt');
     
-    // Check if CMakeLists.txt already exists
-    if (fs.existsSync(cmakeListsPath)) {
-        const overwrite = await vscode.window.showWarningMessage(
-            `CMakeLists.txt already exists in ${vcxprojDir}. Overwrite?`,
-            'Yes',
-            'No'
-        );
+    // A file from an earlier conversion is updated section by section, keeping hand edits
+    let existing: string | undefined;
+    try {
+        existing = await fs.promises.readFile(cmakeListsPath, 'utf8');
+    } catch {
+        existing = undefined;
+    }
+    let resultMessage = `Successfully converted ${path.basename(vcxprojPath)} to CMakeLists.txt`;
+    if (existing !== undefined && hasFencedSections(existing)) {
+        const plan = planResync(cmakeListsPath, existing, generateFencedCMakeLists(project, undefined, getFastBuildProfile()));
+        if (plan.action === 'unchanged') {
+            resultMessage = `CMakeLists.txt is up to date with ${path.basename(vcxprojPath)}`;
+        } else {
+            try {
+                await writeResyncPlans([plan], false);
+            } catch (error) {
+                const message = error instanceof Error ? error.message : String(error);
+                vscode.window.showErrorMessage(`Failed to write CMakeLists.txt: ${message}`);
+                return;
+            }
+            resultMessage = `Updated ${plan.updated.length} section(s) of CMakeLists.txt from ${path.basename(vcxprojPath)}`;
+        }
+        if (plan.kept.length > 0) {
+            resultMessage += `; kept edited section(s): ${plan.kept.join(', ')}`;
+        }
+    } else {
+        if (existing !== undefined) {
+            const overwrite = await vscode.window.showWarningMessage(
+                `CMakeLists.txt already exists in ${vcxprojDir}. Overwrite?`,
+                'Yes',
+                'No'
+            );
+            
+            if (overwrite !== 'Yes') {
+                return;
+            }
+        }
         
-        if (overwrite !== 'Yes') {
+        // Stream into a temporary file next to CMakeLists.txt, fenced for later
+        // re-conversion, and replace the original only once generation succeeded
+        const tempPath = `${cmakeListsPath}.${process.pid}.tmp`;
+        const stream = fs.createWriteStream(tempPath, 'utf8');
+        try {
+            const writer = new StreamLineWriter(stream);
+            const fenced = new FencedLineWriter(writer);
+            writeCMakeLists(fenced, project, undefined, getFastBuildProfile());
+            fenced.close();
+            await writer.end();
+            await fs.promises.rename(tempPath, cmakeListsPath);
+        } catch (error) {
+            stream.destroy();
+            await fs.promises.rm(tempPath, { force: true });
+            const message = error instanceof Error ? error.message : String(error);
+            vscode.window.showErrorMessage(`Failed to write CMakeLists.txt: ${message}`);
             return;
         }
     }
     
-    // Write the CMakeLists.txt file
+    // Show success message and open the file
+    const action = await vscode.window.showInformationMessage(resultMessage, 'Open CMakeLists.txt');
+    
+    if (action === 'Open CMakeLists.txt') {
+        const doc = await vscode.workspace.openTextDocument(cmakeListsPath);
+        await vscode.window.showTextDocument(doc);
+    }
+}
+
+/**
+ * Fast build profile from settings, or undefined when it is disabled
+ */
+function getFastBuildProfile(): FastBuildProfile | undefined {
+    const config = vscode.workspace.getConfiguration('cmake-companion.conversion.fastBuild');
+    if (!config.get<boolean>('enabled', false)) {
+        return undefined;
+    }
+    const launcher = config.get<string>('compilerLauncher', 'ccache');
+    return {
+        compilerLauncher: launcher === 'none' ? undefined : launcher
+    };
+}
+
+/**
+ * Command handler: Convert Solution to CMake
+ * Converts every C++ project of a .sln in parallel and writes a top-level
+ * CMakeLists.txt that adds each project directory
+ * @param uri Optional URI passed when invoked from explorer context menu
+ */
+async function convertSolutionToCMakeHandler(uri?: vscode.Uri): Promise<void> {
+    let slnPath: string | undefined;
+    if (uri && uri.fsPath.toLowerCase().endsWith('.sln')) {
+        slnPath = uri.fsPath;
+    } else {
+        const fileUri = await vscode.window.showOpenDialog({
+            canSelectMany: false,
+            openLabel: 'Select solution file',
+            filters: {
+                'Visual Studio Solution': ['sln']
+            }
+        });
+        if (!fileUri || fileUri.length === 0) {
+            return;
+        }
+        slnPath = fileUri[0].fsPath;
+    }
+    const solutionPath = slnPath;
+
+    let conversion: SolutionConversion | undefined;
     try {
-        fs.writeFileSync(cmakeListsPath, cmakeContent, 'utf8');
+        conversion = await vscode.window.withProgress({
+            location: vscode.ProgressLocation.Notification,
+            title: `Converting ${path.basename(solutionPath)}`,
+            cancellable: true
+        }, (progress, token) => {
+            let reported = 0;
+            return convertSolution(solutionPath, {
+                jobs: Math.max(1, os.cpus().length - 1),
+                token,
+                fenced: true,
+                fastBuild: getFastBuildProfile(),
+                onProgress: (finished, total) => {
+                    progress.report({
+                        message: `${finished}/${total} projects`,
+                        increment: (finished - reported) / total * 100
+                    });
+                    reported = finished;
+                }
+            });
+        });
+    } catch (error) {
+        if (error instanceof WorkerPoolCancelledError) {
+            return;
+        }
+        const message = error instanceof Error ? error.message : String(error);
+        vscode.window.showErrorMessage(`Failed to convert solution: ${message}`);
+        return;
+    }
+
+    // Files from an earlier conversion are merged; only other existing files need permission
+    const plans = await planResyncFiles(conversion.files);
+    const overwrites = plans.filter(plan => plan.action === 'overwrite');
+    let overwrite = false;
+    if (overwrites.length > 0) {
+        overwrite = await vscode.window.showWarningMessage(
+            `${overwrites.length} CMakeLists.txt file(s) already exist. Overwrite?`,
+            'Yes',
+            'No'
+        ) === 'Yes';
+    }
+
+    let written: ResyncPlan[];
+    try {
+        written = await writeResyncPlans(plans, overwrite);
     } catch (error) {
         const message = error instanceof Error ? error.message : String(error);
         vscode.window.showErrorMessage(`Failed to write CMakeLists.txt: ${message}`);
         return;
     }
-    
-    // Show success message and open the file
-    const action = await vscode.window.showInformationMessage(
-        `Successfully converted ${path.basename(vcxprojPath)} to CMakeLists.txt`,
-        'Open CMakeLists.txt'
-    );
-    
+
+    const projectCount = conversion.files.length - 1;
+    let summary = `Converted ${projectCount} project(s) of ${path.basename(solutionPath)} to CMake`;
+    const updatedCount = written.filter(plan => plan.action === 'update').length;
+    const unchangedCount = plans.filter(plan => plan.action === 'unchanged').length;
+    if (updatedCount > 0 || unchangedCount > 0) {
+        summary += ` (${updatedCount} updated, ${unchangedCount} unchanged)`;
+    }
+    const kept = plans.filter(plan => plan.kept.length > 0);
+    if (kept.length > 0) {
+        summary += `; kept edited sections in ${kept.length} file(s)`;
+    }
+    if (overwrites.length > 0 && !overwrite) {
+        summary += `; did not overwrite ${overwrites.length} existing file(s)`;
+    }
+    if (conversion.skipped.length > 0) {
+        summary += `; skipped ${conversion.skipped.length}: ` +
+            conversion.skipped.map(item => `${item.name} (${item.reason})`).join(', ');
+    }
+    const rootPath = conversion.files[conversion.files.length - 1].path;
+    const action = await vscode.window.showInformationMessage(summary, 'Open CMakeLists.txt');
     if (action === 'Open CMakeLists.txt') {
-        const doc = await vscode.workspace.openTextDocument(cmakeListsPath);
+        const doc = await vscode.workspace.openTextDocument(rootPath);
         await vscode.window.showTextDocument(doc);
     }
 }
@@ -401,32 +743,40 @@ async function convertXcodeprojToCMakeHandler(uri?: vscode.Uri): Promise<void> {
         return;
     }
     
-    // Read the project.pbxproj file
-    let pbxprojContent: string;
+    // Parse the Xcode project file and convert every native target
+    const projectPath = xcodeprojPath;
+    let conversion: XcodeprojConversion;
     try {
-        pbxprojContent = fs.readFileSync(pbxprojPath, 'utf8');
-    } catch (error) {
-        const message = error instanceof Error ? error.message : String(error);
-        vscode.window.showErrorMessage(`Failed to read project.pbxproj file: ${message}`);
-        return;
-    }
-    
-    // Parse the Xcode project file
-    let project;
-    try {
-        project = parseXcodeproj(pbxprojContent, xcodeprojPath);
+        conversion = await vscode.window.withProgress({
+            location: vscode.ProgressLocation.Notification,
+            title: `Converting ${path.basename(projectPath)}`,
+            cancellable: true
+        }, (progress, token) => {
+            let reported = 0;
+            return convertXcodeproj(projectPath, {
+                token,
+                onProgress: (finished, total) => {
+                    progress.report({
+                        message: `${finished}/${total} targets`,
+                        increment: (finished - reported) / total * 100
+                    });
+                    reported = finished;
+                }
+            });
+        });
     } catch (error) {
+        if (error instanceof WorkerPoolCancelledError) {
+            return;
+        }
         const message = error instanceof Error ? error.message : String(error);
         vscode.window.showErrorMessage(`Failed to parse Xcode project file: ${message}`);
         return;
     }
-    
-    // Generate CMakeLists.txt content
-    const cmakeContent = generateCMakeListsFromXcode(project);
+    const cmakeContent = conversion.content;
     
     // Determine output path (parent directory of .xcodeproj)
     const projectDir = path.dirname(xcodeprojPath);
-    const cmakeListsPath = path.join(projectDir, 'CMakeLists.txt');
+    const cmakeListsPath = conversion.path;
     
     // Check if CMakeLists.txt already exists
     if (fs.existsSync(cmakeListsPath)) {
@@ -443,7 +793,7 @@ async function convertXcodeprojToCMakeHandler(uri?: vscode.Uri): Promise<void> {
     
     // Write the CMakeLists.txt file
     try {
-        fs.writeFileSync(cmakeListsPath, cmakeContent, 'utf8');
+        await fs.promises.writeFile(cmakeListsPath, cmakeContent, 'utf8');
     } catch (error) {
         const message = error instanceof Error ? error.message : String(error);
         vscode.window.showErrorMessage(`Failed to write CMakeLists.txt: ${message}`);
@@ -452,7 +802,9 @@ async function convertXcodeprojToCMakeHandler(uri?: vscode.Uri): Promise<void> {
     
     // Show success message and open the file
     const action = await vscode.window.showInformationMessage(
-        `Successfully converted ${path.basename(xcodeprojPath)} to CMakeLists.txt`,
+        conversion.projects.length > 1
+            ? `Successfully converted ${conversion.projects.length} targets of ${path.basename(xcodeprojPath)} to CMakeLists.txt`
+            : `Successfully converted ${path.basename(xcodeprojPath)} to CMakeLists.txt`,
         'Open CMakeLists.txt'
     );
     
@@ -462,6 +814,97 @@ async function convertXcodeprojToCMakeHandler(uri?: vscode.Uri): Promise<void> {
     }
 }
 
+/**
+ * Command handler: Convert Xcode workspace to CMake
+ * Converts every project of an .xcworkspace and writes a top-level
+ * CMakeLists.txt that adds each project directory
+ * @param uri Optional URI passed when invoked from explorer context menu
+ */
+async function convertXcworkspaceToCMakeHandler(uri?: vscode.Uri): Promise<void> {
+    let xcworkspacePath: string | undefined;
+    if (uri && uri.fsPath.endsWith('.xcworkspace')) {
+        xcworkspacePath = uri.fsPath;
+    } else {
+        const fileUri = await vscode.window.showOpenDialog({
+            canSelectMany: false,
+            canSelectFolders: true,
+            openLabel: 'Select Xcode workspace',
+            filters: {}
+        });
+        if (!fileUri || fileUri.length === 0) {
+            return;
+        }
+        xcworkspacePath = fileUri[0].fsPath;
+        if (!xcworkspacePath.endsWith('.xcworkspace')) {
+            vscode.window.showErrorMessage('Please select an .xcworkspace directory');
+            return;
+        }
+    }
+    const workspacePath = xcworkspacePath;
+
+    let conversion: XcworkspaceConversion | undefined;
+    try {
+        conversion = await vscode.window.withProgress({
+            location: vscode.ProgressLocation.Notification,
+            title: `Converting ${path.basename(workspacePath)}`,
+            cancellable: true
+        }, (progress, token) => {
+            let reported = 0;
+            return convertXcworkspace(workspacePath, {
+                token,
+                onProgress: (finished, total) => {
+                    progress.report({
+                        message: `${finished}/${total} targets`,
+                        increment: (finished - reported) / total * 100
+                    });
+                    reported = finished;
+                }
+            });
+        });
+    } catch (error) {
+        if (error instanceof WorkerPoolCancelledError) {
+            return;
+        }
+        const message = error instanceof Error ? error.message : String(error);
+        vscode.window.showErrorMessage(`Failed to convert Xcode workspace: ${message}`);
+        return;
+    }
+
+    const existing = conversion.files.filter(file => fs.existsSync(file.path));
+    if (existing.length > 0) {
+        const overwrite = await vscode.window.showWarningMessage(
+            `${existing.length} CMakeLists.txt file(s) already exist. Overwrite?`,
+            'Yes',
+            'No'
+        );
+        if (overwrite !== 'Yes') {
+            return;
+        }
+    }
+
+    try {
+        await Promise.all(conversion.files.map(file => fs.promises.writeFile(file.path, file.content, 'utf8')));
+    } catch (error) {
+        const message = error instanceof Error ? error.message : String(error);
+        vscode.window.showErrorMessage(`Failed to write CMakeLists.txt: ${message}`);
+        return;
+    }
+
+    const projectCount = conversion.files.length - 1;
+    let summary = `Converted ${conversion.targetCount} target(s) in ${projectCount} project(s) of ` +
+        `${path.basename(workspacePath)} to CMake`;
+    if (conversion.skipped.length > 0) {
+        summary += `; skipped ${conversion.skipped.length}: ` +
+            conversion.skipped.map(item => `${item.name} (${item.reason})`).join(', ');
+    }
+    const rootPath = conversion.files[conversion.files.length - 1].path;
+    const action = await vscode.window.showInformationMessage(summary, 'Open CMakeLists.txt');
+    if (action === 'Open CMakeLists.txt') {
+        const doc = await vscode.workspace.openTextDocument(rootPath);
+        await vscode.window.showTextDocument(doc);
+    }
+}
+
 /**
  * Command handler: Resolve CMake Path
  * Shows an input box to resolve a CMake path expression
@@ -527,12 +970,13 @@ async function refreshVariablesCommandHandler(): Promise<void> {
         },
         async () => {
             resolver.clear();
+            getTargetIndex().clear();
             // Only reparse currently open CMake files
-            for (const document of vscode.workspace.textDocuments) {
-                if (isCMakeFile(document)) {
-                    await resolver.parseFile(document.uri.fsPath);
-                }
+            const filePaths = openCMakeFilePaths();
+            for (const filePath of filePaths) {
+                await resolver.parseFile(filePath);
             }
+            await indexTargets(filePaths);
         }
     );
     
@@ -547,11 +991,13 @@ async function refreshVariablesCommandHandler(): Promise<void> {
  * Intelligently opens files or directories
  * For files: opens in editor
  * For directories: reveals in explorer if in workspace, opens new window if outside
+ * For lists: shows a quick pick of the items
  */
-async function openPathCommandHandler(targetPath: string): Promise<void> {
-    // Handle CMake list (semicolon-separated paths)
-    if (targetPath.includes(';')) {
-        const items = targetPath.split(';').map(p => p.trim()).filter(p => p.length > 0);
+async function openPathCommandHandler(targetPath: string | readonly string[]): Promise<void> {
+    // Handle CMake list (list items, or a semicolon-separated string)
+    if (typeof targetPath !== 'string' || targetPath.includes(';')) {
+        const listItems = typeof targetPath === 'string' ? targetPath.split(';') : targetPath;
+        const items = listItems.map(p => p.trim()).filter(p => p.length > 0);
         const pickItems = items.map(p => {
             let exists = false;
             let isDir = false;
@@ -628,3 +1074,157 @@ async function openPathCommandHandler(targetPath: string): Promise<void> {
         }
     }
 }
+
+/**
+ * Command handler: Show target dependencies
+ * Lists direct dependencies and dependents of a target (the word under the
+ * cursor, or one picked from the index) and navigates to the chosen target
+ * @param item Optional target name, or the item invoked from the target tree
+ */
+async function showTargetDependenciesHandler(item?: string | { targetName: string }): Promise<void> {
+    const index = getTargetIndex();
+    let targetName = typeof item === 'string' ? item : item?.targetName;
+    
+    const editor = vscode.window.activeTextEditor;
+    if (!targetName && editor) {
+        const range = editor.document.getWordRangeAtPosition(editor.selection.active, /[A-Za-z0-9_.+:-]+/);
+        const word = range ? editor.document.getText(range) : undefined;
+        if (word && index.hasTarget(word)) {
+            targetName = word;
+        }
+    }
+    
+    if (!targetName) {
+        const names = index.getTargetNames();
+        if (names.length === 0) {
+            vscode.window.showInformationMessage('No CMake targets found in open files');
+            return;
+        }
+        targetName = await vscode.window.showQuickPick(names, { placeHolder: 'Select a CMake target' });
+        if (!targetName) {
+            return;
+        }
+    }
+    
+    const describe = (target: string): vscode.QuickPickItem => {
+        const info = index.getTarget(target);
+        return {
+            label: target,
+            description: info ? info.kind : 'external',
+            detail: info ? `${info.file}:${info.line}` : undefined
+        };
+    };
+    const section = (label: string, targets: ReadonlySet<string>): vscode.QuickPickItem[] => [
+        { label, kind: vscode.QuickPickItemKind.Separator },
+        ...Array.from(targets).sort().map(describe)
+    ];
+    
+    const items = [
+        ...section(`Depends on (${index.getTransitiveDependencies(targetName).size} transitively)`, index.getDependencies(targetName)),
+        ...section(`Used by (${index.getTransitiveDependents(targetName).size} transitively)`, index.getDependents(targetName))
+    ];
+    
+    const cycle = index.getCycle(targetName);
+    if (cycle) {
+        vscode.window.showWarningMessage(`Dependency cycle: ${cycle.concat(cycle[0]).join(' -> ')}`);
+    }
+    
+    const picked = await vscode.window.showQuickPick(items, { placeHolder: `Dependencies of ${targetName}` });
+    const target = picked ? index.getTarget(picked.label) : undefined;
+    if (target) {
+        const doc = await vscode.workspace.openTextDocument(target.file);
+        const position = new vscode.Position(target.line - 1, 0);
+        await vscode.window.showTextDocument(doc, { selection: new vscode.Range(position, position) });
+    }
+}
+
+/**
+ * Command handler: Show performance report
+ * Writes p50/p95/p99 latencies per operation and document size to an output channel
+ */
+function showPerformanceReportHandler(): void {
+    showReport('performance report', getPerformanceMonitor().formatReport());
+}
+
+/**
+ * Replace the performance output channel's content with a report and show it
+ */
+function showReport(title: string, report: string): void {
+    if (!performanceChannel) {
+        performanceChannel = vscode.window.createOutputChannel('CMake Companion Performance');
+    }
+    performanceChannel.clear();
+    performanceChannel.appendLine(`CMake Companion ${title}, ${new Date().toLocaleString()}`);
+    performanceChannel.appendLine('');
+    performanceChannel.appendLine(report);
+    performanceChannel.show(true);
+}
+
+/**
+ * Command handler: Save performance trace
+ * Writes the recorded spans as Chrome Trace Event JSON, for chrome://tracing
+ * or https://ui.perfetto.dev
+ * @param logDirectory The extension's log directory
+ */
+async function saveTraceHandler(logDirectory: string): Promise<void> {
+    const tracer = getTracer();
+    if (tracer.getEventCount() === 0) {
+        vscode.window.showInformationMessage(tracer.isEnabled()
+            ? 'No trace spans recorded yet'
+            : 'Tracing is off. Enable "cmake-companion.tracing.enabled" and reload the window to trace activation.');
+        return;
+    }
+    let tracePath: string;
+    try {
+        tracePath = await tracer.writeTrace(logDirectory);
+    } catch (error) {
+        const message = error instanceof Error ? error.message : String(error);
+        vscode.window.showErrorMessage(`Failed to write trace: ${message}`);
+        return;
+    }
+    const action = await vscode.window.showInformationMessage(
+        `Wrote ${tracer.getEventCount()} trace events to ${tracePath}`,
+        'Reveal File'
+    );
+    if (action === 'Reveal File') {
+        await vscode.commands.executeCommand('revealFileInOS', vscode.Uri.file(tracePath));
+    }
+}
+
+/**
+ * Command handler: Show memory report
+ * Lists process memory and what each cache and index holds, and offers a
+ * heap snapshot (for the Memory tab of Chrome DevTools) in the log directory
+ * @param logDirectory The extension's log directory
+ */
+async function showMemoryReportHandler(logDirectory: string): Promise<void> {
+    showReport('memory report', getMemoryRegistry().formatReport());
+    const action = await vscode.window.showInformationMessage(
+        'A heap snapshot shows what holds memory in detail, but pauses the extension host while it is written.',
+        'Write Heap Snapshot'
+    );
+    if (action !== 'Write Heap Snapshot') {
+        return;
+    }
+    let snapshotPath: string;
+    try {
+        await fs.promises.mkdir(logDirectory, { recursive: true });
+        const stamp = new Date().toISOString().replace(/[:.]/g, '-');
+        snapshotPath = await vscode.window.withProgress({
+            location: vscode.ProgressLocation.Notification,
+            title: 'Writing heap snapshot...'
+        }, async () => {
+            // Let the notification render before the synchronous write blocks
+            await new Promise(resolve => setTimeout(resolve, 50));
+            return v8.writeHeapSnapshot(path.join(logDirectory, `cmake-companion-${stamp}.heapsnapshot`));
+        });
+    } catch (error) {
+        const message = error instanceof Error ? error.message : String(error);
+        vscode.window.showErrorMessage(`Failed to write heap snapshot: ${message}`);
+        return;
+    }
+    const reveal = await vscode.window.showInformationMessage(`Wrote heap snapshot to ${snapshotPath}`, 'Reveal File');
+    if (reveal === 'Reveal File') {
+        await vscode.commands.executeCommand('revealFileInOS', vscode.Uri.file(snapshotPath));
+    }
+}
@@ -0,0 +1,247 @@
+/**
+ * CMake Command Parser
+ * Tokenizes CMake source into command invocations with their arguments
+ */
+
+export type CMakeArgumentKind = 'unquoted' | 'quoted' | 'bracket';
+
+export interface CMakeArgument {
+    /** Argument value (quotes and bracket delimiters removed, escapes kept) */
+    value: string;
+    /** How the argument was written */
+    kind: CMakeArgumentKind;
+    /** Start index of the argument (including delimiters) in the original text */
+    startIndex: number;
+    /** End index of the argument (including delimiters) in the original text */
+    endIndex: number;
+    /** 0-based line where the argument starts */
+    line: number;
+}
+
+export interface CMakeComment {
+    /** Comment text including the leading '#' */
+    text: string;
+    /** Start index in the original text */
+    startIndex: number;
+    /** End index in the original text */
+    endIndex: number;
+    /** 0-based line where the comment starts */
+    line: number;
+}
+
+export interface CMakeCommand {
+    /** Command name as written */
+    name: string;
+    /** Arguments in source order (nested parentheses appear as '(' and ')' arguments) */
+    arguments: CMakeArgument[];
+    /** Comments found between the parentheses */
+    comments: CMakeComment[];
+    /** Start index of the command name */
+    startIndex: number;
+    /** Index just past the closing ')' (or end of text if unterminated) */
+    endIndex: number;
+    /** 0-based line of the command name */
+    line: number;
+    /** 0-based line of the closing ')' */
+    endLine: number;
+    /** Whether the closing ')' was found */
+    closed: boolean;
+}
+
+/**
+ * Match the opening of a bracket (e.g. "[[" or "[==[") at a position
+ * @returns Number of '=' characters, or -1 if there is no bracket opening
+ */
+function bracketLevelAt(text: string, index: number): number {
+    if (text[index] !== '[') {
+        return -1;
+    }
+    let i = index + 1;
+    while (text[i] === '=') {
+        i++;
+    }
+    return text[i] === '[' ? i - index - 1 : -1;
+}
+
+/**
+ * Parse all command invocations in CMake source
+ * Runs in a single linear pass and skips line comments, bracket comments
+ * and the contents of quoted/bracket arguments.
+ * @param text The file content
+ * @returns Commands in source order
+ */
+export function parseCommands(text: string): CMakeCommand[] {
+    const commands: CMakeCommand[] = [];
+    const length = text.length;
+    let i = 0;
+    let line = 0;
+
+    /** Skip a comment starting at i ('#'), returning the comment */
+    const readComment = (): CMakeComment => {
+        const start = i;
+        const startLine = line;
+        const level = bracketLevelAt(text, i + 1);
+        if (level >= 0) {
+            const close = ']' + '='.repeat(level) + ']';
+            const end = text.indexOf(close, i + level + 3);
+            const stop = end < 0 ? length : end + close.length;
+            for (let j = i; j < stop; j++) {
+                if (text.charCodeAt(j) === 10) {
+                    line++;
+                }
+            }
+            i = stop;
+        } else {
+            const end = text.indexOf('\n', i);
+            i = end < 0 ? length : end;
+        }
+        return { text: text.substring(start, i), startIndex: start, endIndex: i, line: startLine };
+    };
+
+    while (i < length) {
+        const ch = text[i];
+
+        if (ch === '\n') {
+            line++;
+            i++;
+            continue;
+        }
+
+        if (ch === '#') {
+            readComment();
+            continue;
+        }
+
+        if (!/[A-Za-z_]/.test(ch)) {
+            i++;
+            continue;
+        }
+
+        // Identifier - possibly a command name
+        const nameStart = i;
+        while (i < length && /[A-Za-z0-9_]/.test(text[i])) {
+            i++;
+        }
+        const name = text.substring(nameStart, i);
+        let j = i;
+        while (j < length && (text[j] === ' ' || text[j] === '\t')) {
+            j++;
+        }
+        if (text[j] !== '(') {
+            continue;
+        }
+
+        const command: CMakeCommand = {
+            name,
+            arguments: [],
+            comments: [],
+            startIndex: nameStart,
+            endIndex: length,
+            line,
+            endLine: line,
+            closed: false
+        };
+        i = j + 1;
+        let depth = 1;
+
+        while (i < length && depth > 0) {
+            const c = text[i];
+
+            if (c === '\n') {
+                line++;
+                i++;
+            } else if (c === ' ' || c === '\t' || c === '\r') {
+                i++;
+            } else if (c === '#') {
+                command.comments.push(readComment());
+            } else if (c === '(' || c === ')') {
+                if (c === '(') {
+                    depth++;
+                } else if (--depth === 0) {
+                    i++;
+                    command.closed = true;
+                    break;
+                }
+                command.arguments.push({ value: c, kind: 'unquoted', startIndex: i, endIndex: i + 1, line });
+                i++;
+            } else if (c === '"') {
+                const start = i;
+                const startLine = line;
+                i++;
+                while (i < length && text[i] !== '"') {
+                    if (text[i] === '\\') {
+                        i++;
+                    }
+                    if (text[i] === '\n') {
+                        line++;
+                    }
+                    i++;
+                }
+                command.arguments.push({
+                    value: text.substring(start + 1, Math.min(i, length)),
+                    kind: 'quoted',
+                    startIndex: start,
+                    endIndex: Math.min(i + 1, length),
+                    line: startLine
+                });
+                i++;
+            } else if (bracketLevelAt(text, i) >= 0) {
+                const level = bracketLevelAt(text, i);
+                const start = i;
+                const startLine = line;
+                const close = ']' + '='.repeat(level) + ']';
+                const contentStart = i + level + 2;
+                const end = text.indexOf(close, contentStart);
+                const stop = end < 0 ? length : end;
+                for (let k = i; k < stop; k++) {
+                    if (text.charCodeAt(k) === 10) {
+                        line++;
+                    }
+                }
+                let value = text.substring(contentStart, stop);
+                // A newline directly after the opening bracket is not part of the value
+                if (value.startsWith('\r\n')) {
+                    value = value.substring(2);
+                } else if (value.startsWith('\n')) {
+                    value = value.substring(1);
+                }
+                i = end < 0 ? length : end + close.length;
+                command.arguments.push({ value, kind: 'bracket', startIndex: start, endIndex: i, line: startLine });
+            } else {
+                const start = i;
+                while (i < length) {
+                    const u = text[i];
+                    if (u === ' ' || u === '\t' || u === '\r' || u === '\n' || u === '(' || u === ')' || u === '#') {
+                        break;
+                    }
+                    if (u === '\\') {
+                        i += 2;
+                        continue;
+                    }
+                    if (u === '"') {
+                        // Legacy unquoted argument with an embedded quoted section (e.g. -DX="a b")
+                        i++;
+                        while (i < length && text[i] !== '"') {
+                            if (text[i] === '\\') {
+                                i++;
+                            }
+                            if (text[i] === '\n') {
+                                line++;
+                            }
+                            i++;
+                        }
+                    }
+                    i++;
+                }
+                i = Math.min(i, length);
+                command.arguments.push({ value: text.substring(start, i), kind: 'unquoted', startIndex: start, endIndex: i, line });
+            }
+        }
+
+        command.endIndex = i;
+        command.endLine = line;
+        commands.push(command);
+    }
+
+    return commands;
+}
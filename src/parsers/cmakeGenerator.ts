@@ -6,14 +6,93 @@
 import { VcxprojProject } from './vcxprojParser';
 import { XcodeprojProject } from './xcodeprojParser';
 import { uniqueArray } from '../utils/arrayUtils';
+import { LineWriter, StringLineWriter } from '../utils/lineWriter';
+import { FencedLineWriter } from '../utils/fencedSections';
+
+/**
+ * Target of another project converted in the same solution
+ */
+export interface SolutionTarget {
+    name: string;
+    type: VcxprojProject['type'];
+}
+
+/**
+ * How a project's references resolve within a converted solution
+ */
+export interface SolutionLinkContext {
+    /** Target of each entry of projectReferences, in order; undefined if not in the solution */
+    referenceTargets: Array<SolutionTarget | undefined>;
+    /** Build-order dependencies declared in the solution (ProjectDependencies) */
+    dependencyTargets: string[];
+    /** Target of the solution whose precompiled header this project reuses (fast build profile) */
+    pchReuseFrom?: string;
+}
+
+/**
+ * Opt-in settings that make the generated build faster than a plain conversion
+ */
+export interface FastBuildProfile {
+    /** Program for CMAKE_<LANG>_COMPILER_LAUNCHER, e.g. 'ccache' or 'sccache' */
+    compilerLauncher?: string;
+}
+
+/**
+ * Fewest compiled sources for which a unity build is generated
+ */
+const UNITY_MIN_SOURCES = 8;
+
+/**
+ * Largest unity batch; bigger batches rebuild more code on every change
+ */
+const UNITY_MAX_BATCH_SIZE = 16;
+
+const COMPILED_SOURCE_REGEX = /\.(c|cc|cpp|cxx|c\+\+)$/i;
 
 /**
  * Generate CMakeLists.txt content from vcxproj project data
  * @param project The parsed project data
+ * @param solution Resolved references when converting a whole solution
+ * @param profile Fast build profile, when enabled
  * @returns CMakeLists.txt content as a string
  */
-export function generateCMakeLists(project: VcxprojProject): string {
-    const lines: string[] = [];
+export function generateCMakeLists(project: VcxprojProject, solution?: SolutionLinkContext, profile?: FastBuildProfile): string {
+    const writer = new StringLineWriter();
+    writeCMakeLists(writer, project, solution, profile);
+    return writer.toString();
+}
+
+/**
+ * Generate CMakeLists.txt content with each section fenced and hashed, for
+ * updating it later with mergeFencedSections
+ * @param project The parsed project data
+ * @param solution Resolved references when converting a whole solution
+ * @param profile Fast build profile, when enabled
+ */
+export function generateFencedCMakeLists(project: VcxprojProject, solution?: SolutionLinkContext, profile?: FastBuildProfile): string {
+    const writer = new StringLineWriter();
+    const fenced = new FencedLineWriter(writer);
+    writeCMakeLists(fenced, project, solution, profile);
+    fenced.close();
+    return writer.toString();
+}
+
+/**
+ * Write CMakeLists.txt content from vcxproj project data, line by line
+ * Sections (sources, include directories, definitions, options, ...) are
+ * marked for writers that fence them, so re-conversion can update them one by one.
+ * @param lines Destination, e.g. a StreamLineWriter on the output file
+ * @param project The parsed project data
+ * @param solution Resolved references when converting a whole solution
+ * @param profile Fast build profile, when enabled
+ */
+export function writeCMakeLists(
+    lines: LineWriter,
+    project: VcxprojProject,
+    solution?: SolutionLinkContext,
+    profile?: FastBuildProfile
+): void {
+    lines.section?.('project');
 
     // CMake minimum version - use higher versions for features
     const usesPch = project.pchConfig && project.pchConfig.enabled && project.pchConfig.headerFile;
@@ -24,11 +103,12 @@ export function generateCMakeLists(project: VcxprojProject): string {
         project.generateMapFile || project.wholeProgramOptimization ||
         project.controlFlowGuard ||
         hasConfigLinkOptions(project);
+    const unityBatchSize = profile ? getUnityBatchSize(project) : undefined;
     const cmakeMinVersion = getMaxCMakeVersion([
         '3.10',
         usesLinkOptions ? '3.13' : '3.10',
         usesRuntimeLibrary ? '3.15' : '3.10',
-        usesPch ? '3.16' : '3.10'
+        usesPch || unityBatchSize !== undefined ? '3.16' : '3.10'
     ]);
     lines.push(`cmake_minimum_required(VERSION ${cmakeMinVersion})`);
     lines.push('');
@@ -44,6 +124,10 @@ export function generateCMakeLists(project: VcxprojProject): string {
     lines.push('set(CMAKE_CXX_STANDARD_REQUIRED ON)');
     lines.push('');
 
+    if (profile?.compilerLauncher) {
+        appendCompilerLauncher(lines, profile.compilerLauncher, project);
+    }
+
     // Windows SDK version (if specified)
     if (project.windowsSdkVersion) {
         lines.push('# Windows SDK version');
@@ -69,6 +153,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     }
 
     // Collect all source files (both .cpp and .h)
+    lines.section?.('sources');
     const allFiles = [...project.sourceFiles, ...project.headerFiles];
     
     if (allFiles.length > 0) {
@@ -93,6 +178,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     }
 
     // Add executable or library
+    lines.section?.('target');
     const hasResources = project.resourceFiles.length > 0;
     const resourceSuffix = hasResources ? ' ${RESOURCE_FILES}' : '';
     switch (project.type) {
@@ -127,11 +213,12 @@ export function generateCMakeLists(project: VcxprojProject): string {
     lines.push('');
 
     // Include directories
+    lines.section?.('include-directories');
     if (project.includeDirectories.length > 0) {
         lines.push('# Include directories');
         lines.push('target_include_directories(${PROJECT_NAME} PRIVATE');
         for (const dir of project.includeDirectories) {
-            lines.push(`    ${dir}`);
+            lines.push(`    ${convertMsBuildVarsToCMake(dir)}`);
         }
         lines.push(')');
         lines.push('');
@@ -140,6 +227,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     appendConfigSpecificIncludeDirectories(lines, project);
 
     // Preprocessor definitions
+    lines.section?.('definitions');
     if (project.preprocessorDefinitions.length > 0) {
         lines.push('# Preprocessor definitions');
         lines.push('target_compile_definitions(${PROJECT_NAME} PRIVATE');
@@ -153,6 +241,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     appendConfigSpecificPreprocessorDefinitions(lines, project);
 
     // Libraries
+    lines.section?.('libraries');
     if (project.libraries.length > 0) {
         lines.push('# Link libraries');
         lines.push('target_link_libraries(${PROJECT_NAME} PRIVATE');
@@ -166,6 +255,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     appendConfigSpecificLibraries(lines, project);
 
     // Additional library directories (warn about MSBuild variables)
+    lines.section?.('link-directories');
     if (project.additionalLibraryDirectories && project.additionalLibraryDirectories.length > 0) {
         lines.push('# Additional library directories');
         const hasMsBuildVars = project.additionalLibraryDirectories.some(d => /\$\([A-Za-z]+\)/.test(d));
@@ -185,7 +275,9 @@ export function generateCMakeLists(project: VcxprojProject): string {
     appendConfigSpecificLinkDirectories(lines, project);
 
     // Compiler options
-    const compileOptions = collectCompileOptions(project);
+    lines.section?.('compile-options');
+    // The fast build profile adds /MP for Visual Studio generators only
+    const compileOptions = collectCompileOptions(project).filter(option => !profile || option !== '/MP');
     if (compileOptions.length > 0) {
         lines.push('# Compiler options');
         lines.push('target_compile_options(${PROJECT_NAME} PRIVATE');
@@ -196,9 +288,14 @@ export function generateCMakeLists(project: VcxprojProject): string {
         lines.push('');
     }
 
-    appendConfigSpecificCompileOptions(lines, project);
+    appendConfigSpecificCompileOptions(lines, project, profile !== undefined);
+
+    if (profile && usesMultiProcessorCompilation(project)) {
+        appendMultiProcessorCompilation(lines);
+    }
 
     // Linker options (from project-level settings + additionalLinkOptions)
+    lines.section?.('link-options');
     const linkOptions = collectLinkOptions(project);
     if (linkOptions.length > 0) {
         lines.push('# Linker options');
@@ -213,6 +310,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     appendConfigSpecificLinkOptions(lines, project);
 
     // MSVC runtime library (requires CMake 3.15+)
+    lines.section?.('target-properties');
     const runtimeLibraryExpression = buildRuntimeLibraryExpression(project);
     if (runtimeLibraryExpression) {
         lines.push('# MSVC runtime library');
@@ -222,8 +320,13 @@ export function generateCMakeLists(project: VcxprojProject): string {
 
     // Precompiled headers (requires CMake 3.16+)
     if (project.pchConfig && project.pchConfig.enabled && project.pchConfig.headerFile) {
-        lines.push('# Precompiled headers (requires CMake 3.16+)');
-        lines.push(`target_precompile_headers(\${PROJECT_NAME} PRIVATE ${project.pchConfig.headerFile})`);
+        if (solution?.pchReuseFrom) {
+            lines.push(`# Precompiled headers, shared with ${solution.pchReuseFrom} (requires CMake 3.16+)`);
+            lines.push(`target_precompile_headers(\${PROJECT_NAME} REUSE_FROM ${solution.pchReuseFrom})`);
+        } else {
+            lines.push('# Precompiled headers (requires CMake 3.16+)');
+            lines.push(`target_precompile_headers(\${PROJECT_NAME} PRIVATE ${project.pchConfig.headerFile})`);
+        }
         lines.push('');
 
         // Handle files excluded from PCH
@@ -246,6 +349,10 @@ export function generateCMakeLists(project: VcxprojProject): string {
         }
     }
 
+    if (unityBatchSize !== undefined) {
+        appendUnityBuild(lines, project, unityBatchSize);
+    }
+
     // Whole program optimization (LTCG)
     if (project.wholeProgramOptimization) {
         lines.push('# Whole program optimization (LTCG)');
@@ -254,6 +361,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     }
 
     // Build events (pre-build, post-build, custom commands)
+    lines.section?.('build-events');
     if (project.buildEvents && project.buildEvents.length > 0) {
         const enabledEvents = project.buildEvents.filter(e => e.enabled !== false);
         if (enabledEvents.length > 0) {
@@ -316,7 +424,10 @@ export function generateCMakeLists(project: VcxprojProject): string {
     }
 
     // Project dependencies (references to other projects)
-    if (project.projectReferences.length > 0) {
+    lines.section?.('dependencies');
+    if (solution) {
+        appendSolutionDependencies(lines, project, solution);
+    } else if (project.projectReferences.length > 0) {
         lines.push('# Project dependencies');
         for (const ref of project.projectReferences) {
             const depName = ref.name || ref.path.replace(/.*[/\\]/, '').replace(/\.vcxproj$/, '');
@@ -327,6 +438,7 @@ export function generateCMakeLists(project: VcxprojProject): string {
     }
 
     // Subsystem (Windows-specific linker flag)
+    lines.section?.('subsystem');
     if (project.subsystem && project.type === 'Application') {
         lines.push('# Windows subsystem');
         if (project.subsystem === 'Windows') {
@@ -338,8 +450,6 @@ export function generateCMakeLists(project: VcxprojProject): string {
         }
         lines.push('');
     }
-
-    return lines.join('\n');
 }
 
 /**
@@ -668,21 +778,210 @@ function mapBasicRuntimeChecksToFlag(value: string): string | undefined {
     }
 }
 
+/**
+ * MSBuild directory properties and their CMake equivalents
+ */
+const MSBUILD_DIRECTORY_VARIABLES: Record<string, string> = {
+    SolutionDir: '${CMAKE_SOURCE_DIR}',
+    ProjectDir: '${CMAKE_CURRENT_SOURCE_DIR}',
+    MSBuildProjectDirectory: '${CMAKE_CURRENT_SOURCE_DIR}',
+    MSBuildThisFileDirectory: '${CMAKE_CURRENT_SOURCE_DIR}'
+};
+
 /**
  * Convert common MSBuild variables to CMake equivalents
+ * $(SolutionDir) and $(ProjectDir) end in a separator in MSBuild, so
+ * "$(SolutionDir)include" becomes "${CMAKE_SOURCE_DIR}/include".
  */
 function convertMsBuildVarsToCMake(path: string): string {
     return path
         .replace(/\$\(OutDir\)/g, '${CMAKE_BINARY_DIR}/${CMAKE_CFG_INTDIR}')
         .replace(/\$\(IntDir\)/g, '${CMAKE_BINARY_DIR}/${CMAKE_CFG_INTDIR}')
-        .replace(/\$\(SolutionDir\)/g, '${CMAKE_SOURCE_DIR}')
-        .replace(/\$\(ProjectDir\)/g, '${CMAKE_CURRENT_SOURCE_DIR}')
+        .replace(/\$\((SolutionDir|ProjectDir|MSBuildProjectDirectory|MSBuildThisFileDirectory)\)[/\\]?(?=(.?))/g,
+            (_match, name: string, next: string) => MSBUILD_DIRECTORY_VARIABLES[name] + (next ? '/' : ''))
         .replace(/\$\(Configuration\)/g, '${CMAKE_CFG_INTDIR}')
         .replace(/\$\(Platform\)/g, '${CMAKE_VS_PLATFORM_NAME}')
         .replace(/\$\(TargetName\)/g, '${PROJECT_NAME}')
         .replace(/\$\(TargetDir\)/g, '$<TARGET_FILE_DIR:${PROJECT_NAME}>');
 }
 
+/**
+ * Unity batch size for a project, or undefined if it is too small to benefit
+ * Batches are sized for about eight per target, so a unity build still
+ * compiles in parallel, and capped to keep incremental rebuilds cheap.
+ */
+function getUnityBatchSize(project: VcxprojProject): number | undefined {
+    const excluded = new Set(project.pchConfig?.excludedFiles ?? []);
+    const count = project.sourceFiles.filter(file => COMPILED_SOURCE_REGEX.test(file) && !excluded.has(file)).length;
+    if (count < UNITY_MIN_SOURCES) {
+        return undefined;
+    }
+    return Math.min(UNITY_MAX_BATCH_SIZE, Math.max(2, Math.ceil(count / 8)));
+}
+
+function appendUnityBuild(lines: LineWriter, project: VcxprojProject, batchSize: number): void {
+    lines.push('# Unity build (requires CMake 3.16+)');
+    lines.push('set_target_properties(${PROJECT_NAME} PROPERTIES');
+    lines.push('    UNITY_BUILD ON');
+    lines.push(`    UNITY_BUILD_BATCH_SIZE ${batchSize}`);
+    lines.push(')');
+    lines.push('');
+
+    // Files built without the PCH were singled out in the original project; keep them separate
+    const excluded = project.pchConfig?.excludedFiles ?? [];
+    if (excluded.length > 0) {
+        lines.push('# Files excluded from precompiled headers stay out of unity batches');
+        lines.push('set_source_files_properties(');
+        for (const file of excluded) {
+            lines.push(`    ${file}`);
+        }
+        lines.push('    PROPERTIES SKIP_UNITY_BUILD_INCLUSION ON');
+        lines.push(')');
+        lines.push('');
+    }
+}
+
+function appendCompilerLauncher(lines: LineWriter, launcher: string, project: VcxprojProject): void {
+    const variable = `${launcher.replace(/\W/g, '_').toUpperCase()}_PROGRAM`;
+    lines.push(`# Compiler launcher (${launcher})`);
+    if (project.debugInformationFormat === 'ProgramDatabase' || project.debugInformationFormat === 'EditAndContinue') {
+        lines.push('# NOTE: With MSVC, compiler caches need embedded debug information (/Z7) instead of a PDB (/Zi)');
+    }
+    lines.push(`find_program(${variable} ${launcher})`);
+    lines.push(`if(${variable})`);
+    lines.push(`    set(CMAKE_C_COMPILER_LAUNCHER \${${variable}})`);
+    lines.push(`    set(CMAKE_CXX_COMPILER_LAUNCHER \${${variable}})`);
+    lines.push('endif()');
+    lines.push('');
+}
+
+function usesMultiProcessorCompilation(project: VcxprojProject): boolean {
+    return !!project.multiProcessorCompilation ||
+        Object.values(project.configurations ?? {}).some(settings => settings.multiProcessorCompilation);
+}
+
+/**
+ * /MP for Visual Studio generators only; Ninja and Makefile generators
+ * already run one compiler process per source in parallel
+ */
+function appendMultiProcessorCompilation(lines: LineWriter): void {
+    lines.push('# /MP only matters for Visual Studio generators; others already compile sources in parallel');
+    lines.push('if(CMAKE_GENERATOR MATCHES "Visual Studio")');
+    lines.push('    target_compile_options(${PROJECT_NAME} PRIVATE /MP)');
+    lines.push('endif()');
+    lines.push('');
+}
+
+/**
+ * Settings that must match for a project to reuse another's precompiled header
+ * The target type is part of the key: CMake compiles shared libraries with
+ * <name>_EXPORTS and position-independent code, so their PCH cannot be shared
+ * with executables or static libraries.
+ * @param resolveIncludeDirectory Maps an include directory to a form comparable
+ *        across projects (relative directories differ per project directory)
+ * @returns undefined if the project has no precompiled header
+ */
+export function getPchCompatibilityKey(
+    project: VcxprojProject,
+    resolveIncludeDirectory: (dir: string) => string = dir => dir
+): string | undefined {
+    if (!project.pchConfig?.enabled || !project.pchConfig.headerFile) {
+        return undefined;
+    }
+    return JSON.stringify([
+        project.type,
+        project.pchConfig.sourceFile?.replace(/\\/g, '/') ?? null,
+        project.includeDirectories.map(resolveIncludeDirectory),
+        project.cxxStandard,
+        project.characterSet,
+        project.runtimeLibrary,
+        project.preprocessorDefinitions,
+        collectCompileOptions(project).filter(option => option !== '/MP'),
+        Object.entries(project.configurations ?? {}).map(([config, settings]) => [
+            config,
+            settings.preprocessorDefinitions,
+            settings.runtimeLibrary,
+            (settings.includeDirectories ?? []).map(resolveIncludeDirectory),
+            collectCompileOptionsFromConfig(settings).filter(option => option !== '/MP')
+        ])
+    ]);
+}
+
+/**
+ * Link library references and order the rest when the referenced projects
+ * are converted alongside this one
+ */
+function appendSolutionDependencies(lines: LineWriter, project: VcxprojProject, solution: SolutionLinkContext): void {
+    const linked: string[] = [];
+    const ordered: string[] = [];
+    const unresolved: string[] = [];
+
+    project.projectReferences.forEach((ref, index) => {
+        const target = solution.referenceTargets[index];
+        if (!target) {
+            unresolved.push(`# Dependency not in solution: ${ref.name || ref.path} (${ref.path})`);
+        } else if (target.type === 'Application') {
+            ordered.push(target.name);
+        } else {
+            linked.push(target.name);
+        }
+    });
+    ordered.push(...solution.dependencyTargets);
+
+    const linkedTargets = uniqueArray(linked);
+    const orderedTargets = uniqueArray(ordered).filter(name => !linkedTargets.includes(name) && name !== project.name);
+    if (linkedTargets.length === 0 && orderedTargets.length === 0 && unresolved.length === 0) {
+        return;
+    }
+
+    lines.push('# Project dependencies');
+    if (linkedTargets.length > 0) {
+        lines.push('target_link_libraries(${PROJECT_NAME} PRIVATE');
+        for (const name of linkedTargets) {
+            lines.push(`    ${name}`);
+        }
+        lines.push(')');
+    }
+    if (orderedTargets.length > 0) {
+        lines.push(`add_dependencies(\${PROJECT_NAME} ${orderedTargets.join(' ')})`);
+    }
+    lines.push(...unresolved);
+    lines.push('');
+}
+
+/**
+ * Generate the top-level CMakeLists.txt of a converted solution
+ * @param name Solution name
+ * @param subdirectories Project directories relative to the solution, in solution order
+ * @param minVersion Highest cmake_minimum_required of the project files
+ */
+export function generateSolutionCMakeLists(name: string, subdirectories: string[], minVersion: string): string {
+    const lines: string[] = [];
+    lines.push(`cmake_minimum_required(VERSION ${getMaxCMakeVersion(['3.10', minVersion])})`);
+    lines.push('');
+    lines.push(`project(${name})`);
+    lines.push('');
+    lines.push('# Projects');
+    for (const directory of subdirectories) {
+        if (directory.startsWith('../')) {
+            // Directories outside the source tree need an explicit binary directory
+            const binaryDir = directory.replace(/^(\.\.\/)+/, '').replace(/\//g, '_');
+            lines.push(`add_subdirectory(${directory} ${binaryDir})`);
+        } else {
+            lines.push(`add_subdirectory(${directory})`);
+        }
+    }
+    lines.push('');
+    return lines.join('\n');
+}
+
+/**
+ * Read the cmake_minimum_required version of generated content
+ */
+export function getGeneratedCMakeVersion(content: string): string | undefined {
+    return content.match(/^cmake_minimum_required\(VERSION ([\d.]+)\)/m)?.[1];
+}
+
 /**
  * Extract config name from a condition string like "Release|Win32" or "Debug"
  */
@@ -707,7 +1006,7 @@ function wrapConfigExpression(config: string, value: string): string {
     return `$<$<CONFIG:${config}>:${value}>`;
 }
 
-function appendConfigSpecificIncludeDirectories(lines: string[], project: VcxprojProject): void {
+function appendConfigSpecificIncludeDirectories(lines: LineWriter, project: VcxprojProject): void {
     if (!project.configurations) {
         return;
     }
@@ -720,14 +1019,14 @@ function appendConfigSpecificIncludeDirectories(lines: string[], project: Vcxpro
         lines.push(`# Include directories (${config})`);
         lines.push('target_include_directories(${PROJECT_NAME} PRIVATE');
         for (const dir of settings.includeDirectories) {
-            lines.push(`    ${wrapConfigExpression(config, dir)}`);
+            lines.push(`    ${wrapConfigExpression(config, convertMsBuildVarsToCMake(dir))}`);
         }
         lines.push(')');
         lines.push('');
     }
 }
 
-function appendConfigSpecificPreprocessorDefinitions(lines: string[], project: VcxprojProject): void {
+function appendConfigSpecificPreprocessorDefinitions(lines: LineWriter, project: VcxprojProject): void {
     if (!project.configurations) {
         return;
     }
@@ -747,7 +1046,7 @@ function appendConfigSpecificPreprocessorDefinitions(lines: string[], project: V
     }
 }
 
-function appendConfigSpecificLibraries(lines: string[], project: VcxprojProject): void {
+function appendConfigSpecificLibraries(lines: LineWriter, project: VcxprojProject): void {
     if (!project.configurations) {
         return;
     }
@@ -767,7 +1066,7 @@ function appendConfigSpecificLibraries(lines: string[], project: VcxprojProject)
     }
 }
 
-function appendConfigSpecificLinkDirectories(lines: string[], project: VcxprojProject): void {
+function appendConfigSpecificLinkDirectories(lines: LineWriter, project: VcxprojProject): void {
     if (!project.configurations) {
         return;
     }
@@ -792,13 +1091,13 @@ function appendConfigSpecificLinkDirectories(lines: string[], project: VcxprojPr
     }
 }
 
-function appendConfigSpecificCompileOptions(lines: string[], project: VcxprojProject): void {
+function appendConfigSpecificCompileOptions(lines: LineWriter, project: VcxprojProject, omitMultiProcessor: boolean): void {
     if (!project.configurations) {
         return;
     }
 
     for (const [config, settings] of Object.entries(project.configurations)) {
-        const options = collectCompileOptionsFromConfig(settings);
+        const options = collectCompileOptionsFromConfig(settings).filter(option => !omitMultiProcessor || option !== '/MP');
         if (options.length === 0) {
             continue;
         }
@@ -813,7 +1112,7 @@ function appendConfigSpecificCompileOptions(lines: string[], project: VcxprojPro
     }
 }
 
-function appendConfigSpecificLinkOptions(lines: string[], project: VcxprojProject): void {
+function appendConfigSpecificLinkOptions(lines: LineWriter, project: VcxprojProject): void {
     if (!project.configurations) {
         return;
     }
@@ -873,7 +1172,10 @@ function hasConfigLinkOptions(project: VcxprojProject): boolean {
     );
 }
 
-function getMaxCMakeVersion(versions: string[]): string {
+/**
+ * Highest of several "major.minor" versions
+ */
+export function getMaxCMakeVersion(versions: string[]): string {
     let maxMajor = 0;
     let maxMinor = 0;
     for (const version of versions) {
@@ -889,76 +1191,87 @@ function getMaxCMakeVersion(versions: string[]): string {
 }
 
 /**
- * Generate CMakeLists.txt content from Xcode project data
- * @param project The parsed Xcode project data
- * @returns CMakeLists.txt content as a string
+ * Another native target converted from the same Xcode project
  */
-export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
-    const lines: string[] = [];
+export interface XcodeTarget {
+    name: string;
+    type: XcodeprojProject['type'];
+}
 
-    // CMake minimum version
+/**
+ * How a target's dependencies resolve when every target of a project is converted
+ */
+export interface XcodeTargetLinkContext {
+    /** Target of each entry of targetDependencies, in order; undefined if not converted */
+    dependencyTargets: Array<XcodeTarget | undefined>;
+}
+
+/**
+ * cmake_minimum_required version needed by the output for an Xcode target
+ */
+export function getXcodeCMakeVersion(project: XcodeprojProject): string {
     const usesLinkOptions = (project.additionalLinkOptions && project.additionalLinkOptions.length > 0) ||
         (project.additionalLibraryDirectories && project.additionalLibraryDirectories.length > 0) ||
         project.deadCodeStripping ||
         hasXcodeConfigLinkOptions(project);
     const needsBundle = project.type === 'Framework' || project.type === 'Bundle' ||
         (project.type === 'Application' && project.infoPlistFile);
-    const cmakeMinVersion = needsBundle ? '3.14' : usesLinkOptions ? '3.13' : '3.10';
-    lines.push(`cmake_minimum_required(VERSION ${cmakeMinVersion})`);
-    lines.push('');
+    return needsBundle ? '3.14' : usesLinkOptions ? '3.13' : '3.10';
+}
 
-    // Project declaration
-    lines.push(`project(${project.name})`);
-    lines.push('');
+/**
+ * Generate CMakeLists.txt content from Xcode project data
+ * @param project The parsed Xcode project data
+ * @param targets Resolved dependencies when converting every target of a project;
+ *        the output is then the target's section for generateXcodeProjectCMakeLists
+ * @returns CMakeLists.txt content as a string
+ */
+export function generateCMakeListsFromXcode(project: XcodeprojProject, targets?: XcodeTargetLinkContext): string {
+    const writer = new StringLineWriter();
+    writeCMakeListsFromXcode(writer, project, targets);
+    return writer.toString();
+}
 
-    // C++ standard (use parsed value or default to 17)
-    const cxxStandard = project.cxxStandard ?? 17;
-    lines.push('# Set C++ standard');
-    lines.push(`set(CMAKE_CXX_STANDARD ${cxxStandard})`);
-    lines.push('set(CMAKE_CXX_STANDARD_REQUIRED ON)');
-    lines.push('');
+/**
+ * Write CMakeLists.txt content from Xcode project data, line by line
+ * @param lines Destination, e.g. a StreamLineWriter on the output file
+ * @param project The parsed Xcode project data
+ * @param targets Resolved dependencies, as for generateCMakeListsFromXcode
+ */
+export function writeCMakeListsFromXcode(lines: LineWriter, project: XcodeprojProject, targets?: XcodeTargetLinkContext): void {
+    // A whole-project file has one section per target, so targets are named explicitly
+    const target = targets ? project.name : '${PROJECT_NAME}';
 
-    // C standard (if specified)
-    if (project.cStandard) {
-        lines.push('# Set C standard');
-        lines.push(`set(CMAKE_C_STANDARD ${project.cStandard})`);
-        lines.push('set(CMAKE_C_STANDARD_REQUIRED ON)');
+    if (targets) {
+        lines.push(`# Target: ${project.name}`);
         lines.push('');
-    }
-
-    // SDK root (if specified)
-    if (project.sdkRoot) {
-        lines.push('# SDK root');
-        lines.push(`set(CMAKE_OSX_SYSROOT ${project.sdkRoot})`);
+    } else {
+        // CMake minimum version
+        lines.push(`cmake_minimum_required(VERSION ${getXcodeCMakeVersion(project)})`);
         lines.push('');
-    }
 
-    // macOS deployment target (if specified)
-    if (project.deploymentTarget) {
-        lines.push('# macOS deployment target');
-        lines.push(`set(CMAKE_OSX_DEPLOYMENT_TARGET ${project.deploymentTarget})`);
+        // Project declaration
+        lines.push(`project(${project.name})`);
         lines.push('');
     }
 
-    // iOS deployment target (if specified)
-    if (project.iosDeploymentTarget) {
-        lines.push('# iOS deployment target');
-        lines.push(`set(CMAKE_OSX_DEPLOYMENT_TARGET ${project.iosDeploymentTarget})`);
+    // C++ standard (use parsed value or default to 17)
+    const cxxStandard = project.cxxStandard ?? 17;
+    if (!targets) {
+        lines.push('# Set C++ standard');
+        lines.push(`set(CMAKE_CXX_STANDARD ${cxxStandard})`);
+        lines.push('set(CMAKE_CXX_STANDARD_REQUIRED ON)');
         lines.push('');
-    }
 
-    // Architecture (if specified)
-    if (project.architecture) {
-        lines.push('# Architecture');
-        lines.push(`set(CMAKE_OSX_ARCHITECTURES ${project.architecture})`);
-        lines.push('');
-    }
+        // C standard (if specified)
+        if (project.cStandard) {
+            lines.push('# Set C standard');
+            lines.push(`set(CMAKE_C_STANDARD ${project.cStandard})`);
+            lines.push('set(CMAKE_C_STANDARD_REQUIRED ON)');
+            lines.push('');
+        }
 
-    // C++ standard library (if specified)
-    if (project.cxxLibrary) {
-        lines.push('# C++ standard library');
-        lines.push(`set(CMAKE_CXX_FLAGS "\${CMAKE_CXX_FLAGS} -stdlib=${project.cxxLibrary}")`);
-        lines.push('');
+        appendXcodeToolchainSettings(lines, project);
     }
 
     // Collect all source files (both .cpp/.m and .h)
@@ -994,48 +1307,48 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
                 // macOS/iOS app bundle
                 if (allFiles.length > 0) {
                     lines.push('# Create application bundle');
-                    lines.push(`add_executable(\${PROJECT_NAME} MACOSX_BUNDLE \${SOURCES}${resourceSuffix})`);
+                    lines.push(`add_executable(${target} MACOSX_BUNDLE \${SOURCES}${resourceSuffix})`);
                 } else {
                     lines.push('# Create application bundle');
-                    lines.push(`add_executable(\${PROJECT_NAME} MACOSX_BUNDLE main.cpp${resourceSuffix})`);
+                    lines.push(`add_executable(${target} MACOSX_BUNDLE main.cpp${resourceSuffix})`);
                 }
             } else {
                 if (allFiles.length > 0) {
                     lines.push('# Create executable');
-                    lines.push(`add_executable(\${PROJECT_NAME} \${SOURCES}${resourceSuffix})`);
+                    lines.push(`add_executable(${target} \${SOURCES}${resourceSuffix})`);
                 } else {
                     lines.push('# Create executable');
-                    lines.push(`add_executable(\${PROJECT_NAME} main.cpp${resourceSuffix})`);
+                    lines.push(`add_executable(${target} main.cpp${resourceSuffix})`);
                 }
             }
             break;
         case 'StaticLibrary':
             if (allFiles.length > 0) {
                 lines.push('# Create static library');
-                lines.push(`add_library(\${PROJECT_NAME} STATIC \${SOURCES})`);
+                lines.push(`add_library(${target} STATIC \${SOURCES})`);
             } else {
                 lines.push('# Create static library');
-                lines.push(`add_library(\${PROJECT_NAME} STATIC lib.cpp)`);
+                lines.push(`add_library(${target} STATIC lib.cpp)`);
             }
             break;
         case 'DynamicLibrary':
             if (allFiles.length > 0) {
                 lines.push('# Create shared library');
-                lines.push(`add_library(\${PROJECT_NAME} SHARED \${SOURCES})`);
+                lines.push(`add_library(${target} SHARED \${SOURCES})`);
             } else {
                 lines.push('# Create shared library');
-                lines.push(`add_library(\${PROJECT_NAME} SHARED lib.cpp)`);
+                lines.push(`add_library(${target} SHARED lib.cpp)`);
             }
             break;
         case 'Framework':
             if (allFiles.length > 0) {
                 lines.push('# Create framework');
-                lines.push(`add_library(\${PROJECT_NAME} SHARED \${SOURCES}${resourceSuffix})`);
+                lines.push(`add_library(${target} SHARED \${SOURCES}${resourceSuffix})`);
             } else {
                 lines.push('# Create framework');
-                lines.push(`add_library(\${PROJECT_NAME} SHARED lib.cpp)`);
+                lines.push(`add_library(${target} SHARED lib.cpp)`);
             }
-            lines.push('set_target_properties(${PROJECT_NAME} PROPERTIES');
+            lines.push(`set_target_properties(${target} PROPERTIES`);
             lines.push('    FRAMEWORK TRUE');
             lines.push('    MACOSX_FRAMEWORK_IDENTIFIER ${BUNDLE_ID}');
             lines.push(')');
@@ -1043,12 +1356,12 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
         case 'Bundle':
             if (allFiles.length > 0) {
                 lines.push('# Create bundle');
-                lines.push(`add_library(\${PROJECT_NAME} MODULE \${SOURCES}${resourceSuffix})`);
+                lines.push(`add_library(${target} MODULE \${SOURCES}${resourceSuffix})`);
             } else {
                 lines.push('# Create bundle');
-                lines.push(`add_library(\${PROJECT_NAME} MODULE lib.cpp)`);
+                lines.push(`add_library(${target} MODULE lib.cpp)`);
             }
-            lines.push('set_target_properties(${PROJECT_NAME} PROPERTIES BUNDLE TRUE)');
+            lines.push(`set_target_properties(${target} PROPERTIES BUNDLE TRUE)`);
             break;
     }
     lines.push('');
@@ -1064,6 +1377,13 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
 
     // Target properties (product name, bundle identifier, Info.plist)
     const targetProps: string[] = [];
+    if (targets) {
+        // Language standards are per target when several share the file
+        targetProps.push(`    CXX_STANDARD ${cxxStandard}`, '    CXX_STANDARD_REQUIRED ON');
+        if (project.cStandard) {
+            targetProps.push(`    C_STANDARD ${project.cStandard}`, '    C_STANDARD_REQUIRED ON');
+        }
+    }
     if (project.productName && project.productName !== project.name) {
         targetProps.push(`    OUTPUT_NAME "${project.productName}"`);
     }
@@ -1075,7 +1395,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     }
     if (targetProps.length > 0) {
         lines.push('# Target properties');
-        lines.push('set_target_properties(${PROJECT_NAME} PROPERTIES');
+        lines.push(`set_target_properties(${target} PROPERTIES`);
         for (const prop of targetProps) {
             lines.push(prop);
         }
@@ -1086,7 +1406,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     // Include directories
     if (project.includeDirectories.length > 0) {
         lines.push('# Include directories');
-        lines.push('target_include_directories(${PROJECT_NAME} PRIVATE');
+        lines.push(`target_include_directories(${target} PRIVATE`);
         for (const dir of project.includeDirectories) {
             lines.push(`    ${dir}`);
         }
@@ -1099,7 +1419,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
         for (const [config, settings] of Object.entries(project.configurations)) {
             if (settings.includeDirectories && settings.includeDirectories.length > 0) {
                 lines.push(`# Include directories (${config})`);
-                lines.push('target_include_directories(${PROJECT_NAME} PRIVATE');
+                lines.push(`target_include_directories(${target} PRIVATE`);
                 for (const dir of settings.includeDirectories) {
                     lines.push(`    $<$<CONFIG:${config}>:${dir}>`);
                 }
@@ -1112,7 +1432,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     // Preprocessor definitions
     if (project.preprocessorDefinitions.length > 0) {
         lines.push('# Preprocessor definitions');
-        lines.push('target_compile_definitions(${PROJECT_NAME} PRIVATE');
+        lines.push(`target_compile_definitions(${target} PRIVATE`);
         for (const def of project.preprocessorDefinitions) {
             lines.push(`    ${def}`);
         }
@@ -1125,7 +1445,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
         for (const [config, settings] of Object.entries(project.configurations)) {
             if (settings.preprocessorDefinitions && settings.preprocessorDefinitions.length > 0) {
                 lines.push(`# Preprocessor definitions (${config})`);
-                lines.push('target_compile_definitions(${PROJECT_NAME} PRIVATE');
+                lines.push(`target_compile_definitions(${target} PRIVATE`);
                 for (const def of settings.preprocessorDefinitions) {
                     lines.push(`    $<$<CONFIG:${config}>:${def}>`);
                 }
@@ -1135,11 +1455,17 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
         }
     }
 
-    // Link libraries and frameworks
-    const allLibraries = [...project.libraries, ...project.frameworks.map(f => `-framework ${f}`)];
+    // Link libraries and frameworks; products of targets converted alongside are linked as targets
+    const linkedTargets = new Set(targets?.dependencyTargets
+        .filter((dep): dep is XcodeTarget => dep !== undefined && isXcodeLinkableTarget(dep))
+        .map(dep => dep.name));
+    const allLibraries = [
+        ...project.libraries.filter(lib => !linkedTargets.has(lib)),
+        ...project.frameworks.filter(f => !linkedTargets.has(f)).map(f => `-framework ${f}`)
+    ];
     if (allLibraries.length > 0) {
         lines.push('# Link libraries');
-        lines.push('target_link_libraries(${PROJECT_NAME} PRIVATE');
+        lines.push(`target_link_libraries(${target} PRIVATE`);
         for (const lib of allLibraries) {
             lines.push(`    ${lib}`);
         }
@@ -1150,7 +1476,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     // Additional library directories
     if (project.additionalLibraryDirectories && project.additionalLibraryDirectories.length > 0) {
         lines.push('# Additional library directories');
-        lines.push('target_link_directories(${PROJECT_NAME} PRIVATE');
+        lines.push(`target_link_directories(${target} PRIVATE`);
         for (const dir of project.additionalLibraryDirectories) {
             lines.push(`    ${dir}`);
         }
@@ -1161,7 +1487,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     // Framework search paths
     if (project.frameworkSearchPaths && project.frameworkSearchPaths.length > 0) {
         lines.push('# Framework search paths');
-        lines.push('target_link_directories(${PROJECT_NAME} PRIVATE');
+        lines.push(`target_link_directories(${target} PRIVATE`);
         for (const dir of project.frameworkSearchPaths) {
             lines.push(`    ${dir}`);
         }
@@ -1174,7 +1500,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     const allCompileOptions = [...compileOptions, ...(project.additionalCompileOptions ?? [])];
     if (allCompileOptions.length > 0) {
         lines.push('# Compiler options');
-        lines.push('target_compile_options(${PROJECT_NAME} PRIVATE');
+        lines.push(`target_compile_options(${target} PRIVATE`);
         for (const opt of allCompileOptions) {
             lines.push(`    ${opt}`);
         }
@@ -1189,7 +1515,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
             const allConfigOpts = [...configCompileOpts, ...(settings.additionalCompileOptions ?? [])];
             if (allConfigOpts.length > 0) {
                 lines.push(`# Compiler options (${config})`);
-                lines.push('target_compile_options(${PROJECT_NAME} PRIVATE');
+                lines.push(`target_compile_options(${target} PRIVATE`);
                 for (const opt of allConfigOpts) {
                     lines.push(`    $<$<CONFIG:${config}>:${opt}>`);
                 }
@@ -1204,7 +1530,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     const allLinkOptions = [...linkOptions, ...(project.additionalLinkOptions ?? [])];
     if (allLinkOptions.length > 0) {
         lines.push('# Linker options');
-        lines.push('target_link_options(${PROJECT_NAME} PRIVATE');
+        lines.push(`target_link_options(${target} PRIVATE`);
         for (const opt of allLinkOptions) {
             lines.push(`    ${opt}`);
         }
@@ -1219,7 +1545,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
             const allConfigLinkOpts = [...configLinkOpts, ...(settings.additionalLinkOptions ?? [])];
             if (allConfigLinkOpts.length > 0) {
                 lines.push(`# Linker options (${config})`);
-                lines.push('target_link_options(${PROJECT_NAME} PRIVATE');
+                lines.push(`target_link_options(${target} PRIVATE`);
                 for (const opt of allConfigLinkOpts) {
                     lines.push(`    $<$<CONFIG:${config}>:${opt}>`);
                 }
@@ -1234,7 +1560,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
         for (const [config, settings] of Object.entries(project.configurations)) {
             if (settings.frameworkSearchPaths && settings.frameworkSearchPaths.length > 0) {
                 lines.push(`# Framework search paths (${config})`);
-                lines.push('target_link_directories(${PROJECT_NAME} PRIVATE');
+                lines.push(`target_link_directories(${target} PRIVATE`);
                 for (const dir of settings.frameworkSearchPaths) {
                     lines.push(`    $<$<CONFIG:${config}>:${dir}>`);
                 }
@@ -1249,7 +1575,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
         for (const [config, settings] of Object.entries(project.configurations)) {
             if (settings.additionalLibraryDirectories && settings.additionalLibraryDirectories.length > 0) {
                 lines.push(`# Additional library directories (${config})`);
-                lines.push('target_link_directories(${PROJECT_NAME} PRIVATE');
+                lines.push(`target_link_directories(${target} PRIVATE`);
                 for (const dir of settings.additionalLibraryDirectories) {
                     lines.push(`    $<$<CONFIG:${config}>:${dir}>`);
                 }
@@ -1262,7 +1588,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     // Runpath search paths
     if (project.runpathSearchPaths && project.runpathSearchPaths.length > 0) {
         lines.push('# Runpath search paths');
-        lines.push('set_target_properties(${PROJECT_NAME} PROPERTIES');
+        lines.push(`set_target_properties(${target} PROPERTIES`);
         lines.push(`    BUILD_RPATH "${project.runpathSearchPaths.join(';')}"`);
         lines.push(`    INSTALL_RPATH "${project.runpathSearchPaths.join(';')}"`);
         lines.push(')');
@@ -1278,7 +1604,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
             }
             const dstPath = copyPhase.dstPath || '${CMAKE_BINARY_DIR}';
             for (const file of copyPhase.files) {
-                lines.push('add_custom_command(TARGET ${PROJECT_NAME} POST_BUILD');
+                lines.push(`add_custom_command(TARGET ${target} POST_BUILD`);
                 lines.push(`    COMMAND \${CMAKE_COMMAND} -E copy_if_different ${file} ${dstPath}`);
                 if (copyPhase.name) {
                     lines.push(`    COMMENT "${copyPhase.name}"`);
@@ -1312,7 +1638,7 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
                 lines.push(')');
             } else {
                 // No outputs, use POST_BUILD (most common for Run Script phases)
-                lines.push('add_custom_command(TARGET ${PROJECT_NAME} POST_BUILD');
+                lines.push(`add_custom_command(TARGET ${target} POST_BUILD`);
                 lines.push(`    COMMAND ${script.shellPath || '/bin/sh'} -c "${script.shellScript.replace(/"/g, '\\"')}"`);
                 if (script.name) {
                     lines.push(`    COMMENT "${script.name}"`);
@@ -1324,18 +1650,136 @@ export function generateCMakeListsFromXcode(project: XcodeprojProject): string {
     }
 
     // Target dependencies
-    if (project.targetDependencies && project.targetDependencies.length > 0) {
+    if (targets) {
+        appendXcodeTargetDependencies(lines, project, targets);
+    } else if (project.targetDependencies && project.targetDependencies.length > 0) {
         lines.push('# Target dependencies');
         lines.push('# NOTE: Dependent targets must be defined in the same CMake project or imported');
         for (const dep of project.targetDependencies) {
-            lines.push(`add_dependencies(\${PROJECT_NAME} ${dep})`);
+            lines.push(`add_dependencies(${target} ${dep})`);
         }
         lines.push('');
     }
+}
 
+/**
+ * Whether a target's product can be linked
+ */
+function isXcodeLinkableTarget(target: XcodeTarget): boolean {
+    return target.type === 'StaticLibrary' || target.type === 'DynamicLibrary' || target.type === 'Framework';
+}
+
+/**
+ * Link library and framework targets of the same project and order the rest
+ */
+function appendXcodeTargetDependencies(lines: LineWriter, project: XcodeprojProject, targets: XcodeTargetLinkContext): void {
+    const linked: string[] = [];
+    const ordered: string[] = [];
+    const unresolved: string[] = [];
+
+    (project.targetDependencies ?? []).forEach((name, index) => {
+        const dep = targets.dependencyTargets[index];
+        if (!dep) {
+            unresolved.push(`# Dependency not converted: ${name}`);
+        } else if (dep.name === project.name) {
+            return;
+        } else if (isXcodeLinkableTarget(dep)) {
+            linked.push(dep.name);
+        } else {
+            ordered.push(dep.name);
+        }
+    });
+    if (linked.length === 0 && ordered.length === 0 && unresolved.length === 0) {
+        return;
+    }
+
+    lines.push('# Target dependencies');
+    if (linked.length > 0) {
+        lines.push(`target_link_libraries(${project.name} PRIVATE`);
+        for (const name of uniqueArray(linked)) {
+            lines.push(`    ${name}`);
+        }
+        lines.push(')');
+    }
+    if (ordered.length > 0) {
+        lines.push(`add_dependencies(${project.name} ${uniqueArray(ordered).join(' ')})`);
+    }
+    lines.push(...unresolved);
+    lines.push('');
+}
+
+/**
+ * Generate the CMakeLists.txt of an Xcode project with several native targets
+ * @param name Project name
+ * @param projects Every target, in project order
+ * @param sections Output of generateCMakeListsFromXcode with a link context, for each target
+ */
+export function generateXcodeProjectCMakeLists(name: string, projects: XcodeprojProject[], sections: string[]): string {
+    const lines: string[] = [];
+    lines.push(`cmake_minimum_required(VERSION ${getMaxCMakeVersion(projects.map(getXcodeCMakeVersion))})`);
+    lines.push('');
+
+    // Build-wide settings come from the first target that has them
+    const first = <K extends keyof XcodeprojProject>(key: K) => projects.find(project => project[key] !== undefined)?.[key];
+    appendXcodeToolchainSettings(lines, {
+        sdkRoot: first('sdkRoot'),
+        deploymentTarget: first('deploymentTarget'),
+        iosDeploymentTarget: first('iosDeploymentTarget'),
+        architecture: first('architecture'),
+        cxxLibrary: first('cxxLibrary')
+    });
+
+    lines.push(`project(${name})`);
+    lines.push('');
+    for (const section of sections) {
+        lines.push(section.replace(/\n+$/, ''));
+        lines.push('');
+    }
     return lines.join('\n');
 }
 
+/**
+ * SDK, deployment target, architectures and C++ library; these apply to the
+ * whole build, so a multi-target project sets them once
+ */
+function appendXcodeToolchainSettings(lines: LineWriter, project: Pick<XcodeprojProject,
+    'sdkRoot' | 'deploymentTarget' | 'iosDeploymentTarget' | 'architecture' | 'cxxLibrary'>): void {
+    // SDK root (if specified)
+    if (project.sdkRoot) {
+        lines.push('# SDK root');
+        lines.push(`set(CMAKE_OSX_SYSROOT ${project.sdkRoot})`);
+        lines.push('');
+    }
+
+    // macOS deployment target (if specified)
+    if (project.deploymentTarget) {
+        lines.push('# macOS deployment target');
+        lines.push(`set(CMAKE_OSX_DEPLOYMENT_TARGET ${project.deploymentTarget})`);
+        lines.push('');
+    }
+
+    // iOS deployment target (if specified)
+    if (project.iosDeploymentTarget) {
+        lines.push('# iOS deployment target');
+        lines.push(`set(CMAKE_OSX_DEPLOYMENT_TARGET ${project.iosDeploymentTarget})`);
+        lines.push('');
+    }
+
+    // Architecture (if specified)
+    if (project.architecture) {
+        lines.push('# Architecture');
+        lines.push(`set(CMAKE_OSX_ARCHITECTURES ${project.architecture})`);
+        lines.push('');
+    }
+
+    // C++ standard library (if specified)
+    if (project.cxxLibrary) {
+        lines.push('# C++ standard library');
+        lines.push(`set(CMAKE_CXX_FLAGS "\${CMAKE_CXX_FLAGS} -stdlib=${project.cxxLibrary}")`);
+        lines.push('');
+    }
+}
+
 /**
  * Collect compiler options derived from Xcode project settings
  */
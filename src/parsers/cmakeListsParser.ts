@@ -3,6 +3,8 @@
  * Parses set() commands to extract variable definitions
  */
 
+import { CMakeCommand, parseCommands } from './cmakeCommandParser';
+
 export interface CMakeVariableDefinition {
     /** Variable name */
     name: string;
@@ -16,135 +18,99 @@ export interface CMakeVariableDefinition {
     isCache: boolean;
 }
 
+const VARIABLE_NAME_REGEX = /^[A-Za-z_][A-Za-z0-9_]*$/;
+
 /**
- * Parse multi-line set() commands from content
- * This handles cases like:
- * set(SOURCES
- *     file1.cpp
- *     file2.cpp
- * )
- * @param content The file content
+ * Variable name given as a command's first argument, if it is a plain name
+ */
+function variableNameOf(command: CMakeCommand): string | undefined {
+    const first = command.arguments[0];
+    return first && first.kind === 'unquoted' && VARIABLE_NAME_REGEX.test(first.value) ? first.value : undefined;
+}
+
+/**
+ * Definition made by a parsed set() command
+ * A leading quoted argument is the value; otherwise the arguments before
+ * CACHE or PARENT_SCOPE form a CMake list (semicolon-separated).
+ * @param command A command named set (any case)
  * @param filePath The file path for reference
- * @returns Array of variable definitions
+ * @returns undefined for set() without a value or with a non-literal name
+ */
+export function setCommandDefinition(command: CMakeCommand, filePath: string): CMakeVariableDefinition | undefined {
+    const name = variableNameOf(command);
+    if (!name) {
+        return undefined;
+    }
+    const args = command.arguments.slice(1);
+    const keywordIndex = args.findIndex(arg => arg.kind === 'unquoted' && (arg.value === 'CACHE' || arg.value === 'PARENT_SCOPE'));
+    const valueArgs = keywordIndex >= 0 ? args.slice(0, keywordIndex) : args;
+    const value = valueArgs.length > 0 && valueArgs[0].kind === 'quoted'
+        ? valueArgs[0].value
+        : valueArgs.map(arg => arg.value).filter(item => item.length > 0).join(';');
+    if (!value) {
+        return undefined;
+    }
+    return {
+        name,
+        value,
+        file: filePath,
+        line: command.line + 1,
+        isCache: keywordIndex >= 0 && args[keywordIndex].value === 'CACHE'
+    };
+}
+
+/**
+ * Definition made by a parsed option() command: NAME "description" [ON|OFF]
+ * @param command A command named option (any case)
+ * @param filePath The file path for reference
+ * @returns The option as an ON/OFF cache variable, OFF by default
  */
-function parseMultiLineSetCommands(content: string, filePath: string): CMakeVariableDefinition[] {
+export function optionCommandDefinition(command: CMakeCommand, filePath: string): CMakeVariableDefinition | undefined {
+    const name = variableNameOf(command);
+    if (!name) {
+        return undefined;
+    }
+    const initial = command.arguments[2];
+    return {
+        name,
+        value: initial && initial.value.toUpperCase() === 'ON' ? 'ON' : 'OFF',
+        file: filePath,
+        line: command.line + 1,
+        isCache: true
+    };
+}
+
+/**
+ * Apply a definition function to every command with the given name
+ */
+function collectDefinitions(
+    content: string,
+    filePath: string,
+    commandName: string,
+    define: (command: CMakeCommand, filePath: string) => CMakeVariableDefinition | undefined
+): CMakeVariableDefinition[] {
     const definitions: CMakeVariableDefinition[] = [];
-    
-    // Match set commands that may span multiple lines
-    // This regex uses the 's' flag to make . match newlines
-    const multiLineSetRegex = /set\s*\(\s*([A-Za-z_][A-Za-z0-9_]*)([\s\S]*?)\)/gi;
-    
-    let match: RegExpExecArray | null;
-    while ((match = multiLineSetRegex.exec(content)) !== null) {
-        const name = match[1];
-        let valueSection = match[2].trim();
-        
-        // Skip if this is a CACHE-only variable with no value before CACHE
-        if (valueSection.toUpperCase().startsWith('CACHE')) {
+    for (const command of parseCommands(content)) {
+        if (command.name.toLowerCase() !== commandName) {
             continue;
         }
-        
-        // Find the line number where this set() starts
-        const beforeMatch = content.substring(0, match.index);
-        const lineNumber = (beforeMatch.match(/\n/g) || []).length + 1;
-        
-        // Check if the set() is inside a comment
-        // Find the start of the line containing the match
-        const lastNewline = beforeMatch.lastIndexOf('\n');
-        const lineStart = lastNewline >= 0 ? lastNewline + 1 : 0;
-        const lineContent = content.substring(lineStart, match.index + match[0].length);
-        const beforeSet = lineContent.substring(0, match.index - lineStart);
-        
-        // If there's a # before the set() on the same line (not in a string), skip it
-        if (beforeSet.includes('#')) {
-            continue;
-        }
-        
-        // Check if it's a cache variable
-        const isCache = valueSection.toUpperCase().includes('CACHE');
-        
-        // Remove CACHE and subsequent parts
-        const cacheIndex = valueSection.toUpperCase().indexOf('CACHE');
-        if (cacheIndex > 0) {
-            valueSection = valueSection.substring(0, cacheIndex).trim();
-        }
-        
-        // Remove PARENT_SCOPE if present
-        const parentScopeIndex = valueSection.toUpperCase().indexOf('PARENT_SCOPE');
-        if (parentScopeIndex > 0) {
-            valueSection = valueSection.substring(0, parentScopeIndex).trim();
-        }
-        
-        // Parse the value - could be quoted string, single value, or list of values
-        let value: string;
-        
-        if (valueSection.startsWith('"')) {
-            // Quoted string value
-            const endQuote = valueSection.indexOf('"', 1);
-            if (endQuote > 0) {
-                value = valueSection.substring(1, endQuote);
-            } else {
-                value = valueSection.substring(1);
-            }
-        } else {
-            // Unquoted value(s) - could be a list separated by whitespace/newlines
-            // First, split by lines and filter out comment lines
-            const lines = valueSection.split('\n');
-            const filteredLines: string[] = [];
-            
-            for (const line of lines) {
-                const trimmedLine = line.trim();
-                // Skip empty lines and comment lines
-                if (trimmedLine.length === 0 || trimmedLine.startsWith('#')) {
-                    continue;
-                }
-                // Remove inline comments (everything after # on the line)
-                const commentIndex = trimmedLine.indexOf('#');
-                if (commentIndex > 0) {
-                    filteredLines.push(trimmedLine.substring(0, commentIndex).trim());
-                } else {
-                    filteredLines.push(trimmedLine);
-                }
-            }
-            
-            // Now parse the items from the filtered content
-            const items = filteredLines
-                .join(' ')
-                .split(/\s+/)
-                .map(s => s.trim())
-                .filter(s => s.length > 0);
-            
-            if (items.length === 1) {
-                value = items[0];
-            } else {
-                // Multiple items become a CMake list (semicolon-separated)
-                value = items.join(';');
-            }
-        }
-        
-        if (value) {
-            definitions.push({
-                name,
-                value,
-                file: filePath,
-                line: lineNumber,
-                isCache
-            });
+        const definition = define(command, filePath);
+        if (definition) {
+            definitions.push(definition);
         }
     }
-    
     return definitions;
 }
 
 /**
  * Parse CMakeLists.txt content to extract variable definitions
+ * Handles single and multi-line set() commands; commented-out commands are skipped.
  * @param content The file content
  * @param filePath The file path for reference
  * @returns Array of variable definitions
  */
 export function parseSetCommands(content: string, filePath: string): CMakeVariableDefinition[] {
-    // Use the multi-line parser which handles both single and multi-line set() commands
-    return parseMultiLineSetCommands(content, filePath);
+    return collectDefinitions(content, filePath, 'set', setCommandDefinition);
 }
 
 /**
@@ -223,72 +189,5 @@ export function parseIncludes(content: string): string[] {
  * @returns Array of option definitions as variables (ON/OFF)
  */
 export function parseOptions(content: string, filePath: string): CMakeVariableDefinition[] {
-    const options: CMakeVariableDefinition[] = [];
-    // Match option commands that may span multiple lines
-    const optionRegex = /option\s*\(([\s\S]*?)\)/gi;
-    
-    let match: RegExpExecArray | null;
-    while ((match = optionRegex.exec(content)) !== null) {
-        // Check if this option() is inside a comment
-        const beforeMatch = content.substring(0, match.index);
-        const lastNewline = beforeMatch.lastIndexOf('\n');
-        const lineStart = lastNewline >= 0 ? lastNewline + 1 : 0;
-        const beforeOption = content.substring(lineStart, match.index);
-        
-        // Skip if there's a # before the option() on the same line
-        if (beforeOption.includes('#')) {
-            continue;
-        }
-        
-        // Find the line number where this option() starts
-        const lineNumber = (beforeMatch.match(/\n/g) || []).length + 1;
-        
-        let valueSection = match[1].trim();
-        
-        // Remove comments from the value section
-        const lines = valueSection.split('\n');
-        const filteredLines: string[] = [];
-        for (const line of lines) {
-            const trimmedLine = line.trim();
-            if (trimmedLine.length === 0 || trimmedLine.startsWith('#')) {
-                continue;
-            }
-            const commentIndex = trimmedLine.indexOf('#');
-            if (commentIndex > 0) {
-                filteredLines.push(trimmedLine.substring(0, commentIndex).trim());
-            } else {
-                filteredLines.push(trimmedLine);
-            }
-        }
-        
-        valueSection = filteredLines.join(' ').trim();
-        
-        // Parse: NAME "description" [ON|OFF]
-        // First, extract the variable name
-        const nameMatch = valueSection.match(/^([A-Za-z_][A-Za-z0-9_]*)/);
-        if (!nameMatch) {
-            continue;
-        }
-        
-        const name = nameMatch[1];
-        const rest = valueSection.substring(name.length).trim();
-        
-        // Check for ON/OFF at the end
-        let optionValue = 'OFF'; // Default
-        if (rest.toUpperCase().endsWith('ON')) {
-            optionValue = 'ON';
-        } else if (rest.toUpperCase().endsWith('OFF')) {
-            optionValue = 'OFF';
-        }
-        
-        options.push({
-            name,
-            value: optionValue,
-            file: filePath,
-            line: lineNumber,
-            isCache: true
-        });
-    }
-    
-    return options;
+    return collectDefinitions(content, filePath, 'option', optionCommandDefinition);
 }
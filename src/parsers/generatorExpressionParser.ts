@@ -0,0 +1,505 @@
+/**
+ * Generator Expression Parser
+ * Parses CMake generator expressions ($<...>) and evaluates them per configuration
+ */
+
+import { estimateBytes, estimateStringBytes, MemoryUsage } from '../utils/memoryEstimate';
+
+export interface GenexText {
+    kind: 'text';
+    value: string;
+}
+
+export interface GenexExpression {
+    kind: 'genex';
+    /** Expression name (e.g. CONFIG, IF); empty when the head is itself an expression */
+    name: string;
+    /** Head nodes before the first ':' (a condition for $<$<CONFIG:Debug>:...>) */
+    head: GenexNode[];
+    /** Comma-separated arguments after the first ':' */
+    arguments: GenexNode[][];
+    /** Whether a ':' separated the head from the arguments */
+    hasArguments: boolean;
+    /** Original source text of the expression */
+    source: string;
+}
+
+export type GenexNode = GenexText | GenexExpression;
+
+export interface GeneratorExpressionMatch {
+    /** The full expression text including $< and > */
+    expression: string;
+    /** Start index in the original text */
+    startIndex: number;
+    /** End index in the original text */
+    endIndex: number;
+}
+
+/**
+ * Default configurations shown when CMAKE_CONFIGURATION_TYPES is not known
+ */
+export const DEFAULT_CONFIGURATIONS = ['Debug', 'Release', 'RelWithDebInfo', 'MinSizeRel'];
+
+/**
+ * Find top-level generator expressions in text
+ * @param text The text to scan
+ * @returns Expression spans in source order
+ */
+export function findGeneratorExpressions(text: string): GeneratorExpressionMatch[] {
+    const matches: GeneratorExpressionMatch[] = [];
+    let i = text.indexOf('$<');
+
+    while (i >= 0) {
+        let depth = 0;
+        let j = i;
+        for (; j < text.length; j++) {
+            if (text[j] === '$' && text[j + 1] === '<') {
+                depth++;
+                j++;
+            } else if (text[j] === '>') {
+                if (--depth === 0) {
+                    break;
+                }
+            } else if (text[j] === '\n') {
+                break;
+            }
+        }
+        if (depth !== 0 || j >= text.length) {
+            // Unterminated - skip this opener
+            i = text.indexOf('$<', i + 2);
+            continue;
+        }
+        matches.push({ expression: text.substring(i, j + 1), startIndex: i, endIndex: j + 1 });
+        i = text.indexOf('$<', j + 1);
+    }
+
+    return matches;
+}
+
+/**
+ * Parse text containing generator expressions into nodes
+ * Unterminated expressions are kept as plain text.
+ * @param text The text to parse
+ * @returns Parsed nodes
+ */
+export function parseGeneratorExpression(text: string): GenexNode[] {
+    let pos = 0;
+
+    const pushText = (nodes: GenexNode[], value: string) => {
+        if (!value) {
+            return;
+        }
+        const last = nodes[nodes.length - 1];
+        if (last && last.kind === 'text') {
+            last.value += value;
+        } else {
+            nodes.push({ kind: 'text', value });
+        }
+    };
+
+    /** Parse nodes until one of the stop characters (or end of text) */
+    const parseSequence = (stops: string): GenexNode[] => {
+        const nodes: GenexNode[] = [];
+        let textStart = pos;
+        while (pos < text.length) {
+            const ch = text[pos];
+            if (stops.includes(ch)) {
+                break;
+            }
+            if (ch === '$' && text[pos + 1] === '<') {
+                const start = pos;
+                const expression = parseExpression();
+                if (expression) {
+                    pushText(nodes, text.substring(textStart, start));
+                    nodes.push(expression);
+                    textStart = pos;
+                }
+                // Otherwise "$<" stays part of the pending text
+                continue;
+            }
+            pos++;
+        }
+        pushText(nodes, text.substring(textStart, pos));
+        return nodes;
+    };
+
+    /** Parse an expression at pos ("$<"); returns null and consumes "$<" as text if unterminated */
+    const parseExpression = (): GenexExpression | null => {
+        const start = pos;
+        pos += 2;
+        const head = parseSequence(':>');
+        const args: GenexNode[][] = [];
+        let hasArguments = false;
+        if (text[pos] === ':') {
+            hasArguments = true;
+            pos++;
+            for (;;) {
+                args.push(parseSequence(',>'));
+                if (text[pos] !== ',') {
+                    break;
+                }
+                pos++;
+            }
+        }
+        if (text[pos] !== '>') {
+            // Unterminated: re-read everything after "$<" as text
+            pos = start + 2;
+            return null;
+        }
+        pos++;
+        const name = head.length === 1 && head[0].kind === 'text' ? head[0].value : '';
+        return {
+            kind: 'genex',
+            name,
+            head,
+            arguments: args,
+            hasArguments,
+            source: text.substring(start, pos)
+        };
+    };
+
+    return parseSequence('');
+}
+
+/**
+ * Context used when evaluating generator expressions
+ */
+export interface GenexEvaluationContext {
+    /** Active build configuration (e.g. Debug) */
+    config: string;
+    /** Look up a target property for $<TARGET_PROPERTY:tgt,prop> */
+    getTargetProperty?: (target: string, property: string) => string | undefined;
+    /** Compiler id for $<C_COMPILER_ID:...>/$<CXX_COMPILER_ID:...> */
+    compilerId?: string;
+    /** Platform id for $<PLATFORM_ID:...> */
+    platformId?: string;
+}
+
+/**
+ * Marker for a value that cannot be determined statically
+ */
+class UnknownValue {
+    readonly source: string;
+
+    constructor(source: string) {
+        this.source = source;
+    }
+}
+
+type EvalResult = string | UnknownValue;
+
+const FALSE_CONSTANTS = new Set(['', '0', 'OFF', 'NO', 'FALSE', 'N', 'IGNORE', 'NOTFOUND']);
+
+function isTruthy(value: string): boolean {
+    const upper = value.toUpperCase();
+    return !FALSE_CONSTANTS.has(upper) && !upper.endsWith('-NOTFOUND');
+}
+
+/**
+ * Evaluate parsed nodes
+ * Parts that cannot be determined (unknown targets, compilers, ...) are kept as written.
+ */
+function evaluateNodes(nodes: GenexNode[], context: GenexEvaluationContext): EvalResult {
+    let result = '';
+    for (const node of nodes) {
+        const value = node.kind === 'text' ? node.value : evaluateExpression(node, context);
+        if (value instanceof UnknownValue) {
+            return new UnknownValue(nodes.map(n => n.kind === 'text' ? n.value : n.source).join(''));
+        }
+        result += value;
+    }
+    return result;
+}
+
+/**
+ * Evaluate top-level nodes, keeping undeterminable expressions as written
+ * while still substituting the ones that can be evaluated.
+ */
+function evaluateTopLevel(nodes: GenexNode[], context: GenexEvaluationContext): string {
+    let result = '';
+    for (const node of nodes) {
+        if (node.kind === 'text') {
+            result += node.value;
+        } else {
+            const value = evaluateExpression(node, context);
+            result += value instanceof UnknownValue ? node.source : value;
+        }
+    }
+    return result;
+}
+
+function evaluateExpression(expr: GenexExpression, context: GenexEvaluationContext): EvalResult {
+    const unknown = new UnknownValue(expr.source);
+
+    // Lazily evaluate arguments so that $<IF:...> only evaluates the chosen branch
+    const arg = (index: number): EvalResult => evaluateNodes(expr.arguments[index] ?? [], context);
+    const joinedArgs = (): EvalResult => {
+        const parts: string[] = [];
+        for (let i = 0; i < expr.arguments.length; i++) {
+            const value = arg(i);
+            if (value instanceof UnknownValue) {
+                return unknown;
+            }
+            parts.push(value);
+        }
+        return parts.join(',');
+    };
+    const allArgs = (): string[] | null => {
+        const values: string[] = [];
+        for (let i = 0; i < expr.arguments.length; i++) {
+            const value = arg(i);
+            if (value instanceof UnknownValue) {
+                return null;
+            }
+            values.push(value);
+        }
+        return values;
+    };
+
+    // Condition form: $<condition:value> where condition evaluates to 0 or 1
+    if (!expr.name) {
+        const condition = evaluateNodes(expr.head, context);
+        if (condition === '1') {
+            return joinedArgs();
+        }
+        return condition === '0' ? '' : unknown;
+    }
+
+    const name = expr.name.trim();
+    switch (name) {
+        case '0':
+            return '';
+        case '1':
+            return joinedArgs();
+        case 'CONFIG': {
+            if (!expr.hasArguments) {
+                return context.config;
+            }
+            const configs = allArgs();
+            if (!configs) {
+                return unknown;
+            }
+            const current = context.config.toUpperCase();
+            return configs.some(c => c.toUpperCase() === current) ? '1' : '0';
+        }
+        case 'IF': {
+            const condition = arg(0);
+            if (condition instanceof UnknownValue) {
+                return unknown;
+            }
+            if (condition !== '0' && condition !== '1') {
+                return unknown;
+            }
+            return arg(condition === '1' ? 1 : 2);
+        }
+        case 'BOOL': {
+            const value = joinedArgs();
+            return value instanceof UnknownValue ? unknown : (isTruthy(value) ? '1' : '0');
+        }
+        case 'NOT': {
+            const value = arg(0);
+            return value instanceof UnknownValue ? unknown : value === '0' ? '1' : value === '1' ? '0' : unknown;
+        }
+        case 'AND':
+        case 'OR': {
+            // Short-circuit on known values; unknown operands only matter if they decide the result
+            const decisive = name === 'AND' ? '0' : '1';
+            let sawUnknown = false;
+            for (let i = 0; i < expr.arguments.length; i++) {
+                const value = arg(i);
+                if (value === decisive) {
+                    return decisive;
+                }
+                if (value instanceof UnknownValue) {
+                    sawUnknown = true;
+                }
+            }
+            return sawUnknown ? unknown : (name === 'AND' ? '1' : '0');
+        }
+        case 'STREQUAL':
+        case 'EQUAL':
+        case 'IN_LIST': {
+            const values = allArgs();
+            if (!values || values.length < 2) {
+                return unknown;
+            }
+            if (name === 'STREQUAL') {
+                return values[0] === values[1] ? '1' : '0';
+            }
+            if (name === 'EQUAL') {
+                return Number(values[0]) === Number(values[1]) ? '1' : '0';
+            }
+            return values[1].split(';').includes(values[0]) ? '1' : '0';
+        }
+        case 'BUILD_INTERFACE':
+        case 'BUILD_LOCAL_INTERFACE':
+            return joinedArgs();
+        case 'INSTALL_INTERFACE':
+            return '';
+        case 'LOWER_CASE':
+        case 'UPPER_CASE': {
+            const value = joinedArgs();
+            if (value instanceof UnknownValue) {
+                return unknown;
+            }
+            return name === 'LOWER_CASE' ? value.toLowerCase() : value.toUpperCase();
+        }
+        case 'ANGLE-R':
+            return '>';
+        case 'COMMA':
+            return ',';
+        case 'SEMICOLON':
+            return ';';
+        case 'TARGET_PROPERTY': {
+            const values = allArgs();
+            if (!values || values.length < 2 || !context.getTargetProperty) {
+                return unknown;
+            }
+            return context.getTargetProperty(values[0], values[1]) ?? unknown;
+        }
+        case 'C_COMPILER_ID':
+        case 'CXX_COMPILER_ID':
+        case 'PLATFORM_ID': {
+            const actual = name === 'PLATFORM_ID' ? context.platformId : context.compilerId;
+            if (actual === undefined) {
+                return unknown;
+            }
+            if (!expr.hasArguments) {
+                return actual;
+            }
+            const values = allArgs();
+            return values ? (values.includes(actual) ? '1' : '0') : unknown;
+        }
+        default:
+            return unknown;
+    }
+}
+
+/**
+ * Evaluate a generator expression for a configuration (no memoization)
+ * @param text Text containing generator expressions
+ * @param context Evaluation context
+ * @returns The evaluated text; undeterminable parts are kept as written
+ */
+export function evaluateGeneratorExpression(text: string, context: GenexEvaluationContext): string {
+    return evaluateTopLevel(parseGeneratorExpression(text), context);
+}
+
+/**
+ * Maximum number of memoized entries per configuration before the cache is reset
+ */
+const MAX_CACHED_EXPRESSIONS = 2000;
+
+/**
+ * Approximate bytes of memoized expressions and results (getMemoryUsage())
+ * above which the whole cache is reset
+ */
+const MAX_CACHED_BYTES = 4 * 1024 * 1024;
+
+/**
+ * Memoizing generator expression evaluator
+ * Parsed expressions and per-(expression, config) results are cached,
+ * so repeated hovers don't re-parse or re-evaluate.
+ */
+export class GeneratorExpressionEvaluator {
+    /** Parsed nodes by expression text */
+    private parsed: Map<string, GenexNode[]> = new Map();
+
+    /** Results by configuration, then expression text */
+    private results: Map<string, Map<string, string>> = new Map();
+
+    /** Approximate bytes of parsed, and of results by configuration */
+    private parsedBytes = 0;
+    private resultBytes: Map<string, number> = new Map();
+
+    private context: Omit<GenexEvaluationContext, 'config'>;
+
+    /**
+     * @param context Evaluation context shared by all configurations
+     */
+    constructor(context: Omit<GenexEvaluationContext, 'config'> = {}) {
+        this.context = context;
+    }
+
+    /**
+     * Evaluate text for a configuration, using memoized results when available
+     */
+    evaluate(text: string, config: string): string {
+        let byConfig = this.results.get(config);
+        if (!byConfig) {
+            byConfig = new Map();
+            this.results.set(config, byConfig);
+        }
+        const cached = byConfig.get(text);
+        if (cached !== undefined) {
+            return cached;
+        }
+
+        let nodes = this.parsed.get(text);
+        if (!nodes) {
+            if (this.parsed.size >= MAX_CACHED_EXPRESSIONS) {
+                this.parsed.clear();
+                this.parsedBytes = 0;
+            }
+            nodes = parseGeneratorExpression(text);
+            this.parsed.set(text, nodes);
+            this.parsedBytes += estimateStringBytes(text) + estimateBytes(nodes);
+        }
+
+        const value = evaluateTopLevel(nodes, { ...this.context, config });
+        if (byConfig.size >= MAX_CACHED_EXPRESSIONS) {
+            byConfig.clear();
+            this.resultBytes.set(config, 0);
+        }
+        byConfig.set(text, value);
+        this.resultBytes.set(config, (this.resultBytes.get(config) ?? 0) + estimateStringBytes(text) + estimateStringBytes(value));
+        if (this.getMemoryUsage().bytes > MAX_CACHED_BYTES) {
+            this.clear();
+        }
+        return value;
+    }
+
+    /**
+     * Evaluate text for several configurations
+     * @returns Map of configuration name to value
+     */
+    evaluateAll(text: string, configs: readonly string[] = DEFAULT_CONFIGURATIONS): Map<string, string> {
+        const values = new Map<string, string>();
+        for (const config of configs) {
+            values.set(config, this.evaluate(text, config));
+        }
+        return values;
+    }
+
+    /**
+     * Number of memoized results (across all configurations)
+     */
+    get size(): number {
+        let size = 0;
+        for (const byConfig of this.results.values()) {
+            size += byConfig.size;
+        }
+        return size;
+    }
+
+    /**
+     * Memoized expressions and results, and their approximate size
+     */
+    getMemoryUsage(): MemoryUsage {
+        let bytes = this.parsedBytes;
+        for (const configBytes of this.resultBytes.values()) {
+            bytes += configBytes;
+        }
+        return { entries: this.parsed.size + this.size, bytes };
+    }
+
+    /**
+     * Drop all memoized results (e.g. when target properties change)
+     */
+    clear(): void {
+        this.parsed.clear();
+        this.results.clear();
+        this.parsedBytes = 0;
+        this.resultBytes.clear();
+    }
+}
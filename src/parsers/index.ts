@@ -1,5 +1,13 @@
 export * from './cmakeVariableParser';
 export * from './cmakeListsParser';
+export * from './cmakeCommandParser';
 export * from './vcxprojParser';
+export * from './plistParser';
+export * from './xcconfigParser';
 export * from './xcodeprojParser';
+export * from './xcworkspaceParser';
 export * from './cmakeGenerator';
+export * from './generatorExpressionParser';
+export * from './xmlTokenizer';
+export * from './msbuildSettingsIndex';
+export * from './slnParser';
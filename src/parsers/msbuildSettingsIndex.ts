@@ -0,0 +1,237 @@
+/**
+ * Per-configuration index of MSBuild item definitions and properties
+ * Filled while a project is tokenized: every setting is filed under its
+ * (Configuration|Platform) key and section, so per-configuration settings are
+ * read from small maps instead of rescanning each group's text.
+ */
+
+/**
+ * Sections indexed for each configuration: tool item definitions and properties
+ */
+export type MsBuildSection = 'ClCompile' | 'Link' | 'Lib' | 'ResourceCompile' | 'PropertyGroup';
+
+export const MSBUILD_SECTIONS: ReadonlySet<string> = new Set<MsBuildSection>([
+    'ClCompile', 'Link', 'Lib', 'ResourceCompile', 'PropertyGroup'
+]);
+
+/**
+ * Settings of one (Configuration|Platform) combination
+ */
+export interface MsBuildConfigurationEntry {
+    /** Configuration name; undefined for unconditional settings */
+    configuration?: string;
+    /** Platform name; undefined for unconditional or configuration-only conditions */
+    platform?: string;
+    /** Raw values of each setting per section, in document order */
+    sections: Map<MsBuildSection, Map<string, string[]>>;
+}
+
+/**
+ * Parse a Condition attribute into its configuration and platform
+ * Recognizes '$(Configuration)|$(Platform)'=='Debug|Win32' and '$(Configuration)'=='Debug'.
+ * @returns undefined for conditions that do not select a configuration
+ */
+export function parseConfigurationCondition(condition: string): { configuration: string; platform?: string } | undefined {
+    const configPlatform = condition.match(/'\$\(Configuration\)\|\$\(Platform\)'\s*==\s*'([^|']+)\|([^']+)'/);
+    if (configPlatform) {
+        return { configuration: configPlatform[1], platform: configPlatform[2] };
+    }
+    const configOnly = condition.match(/'\$\(Configuration\)'\s*==\s*'([^']+)'/);
+    if (configOnly) {
+        return { configuration: configOnly[1] };
+    }
+    return undefined;
+}
+
+export class MsBuildSettingsIndex {
+    private entries = new Map<string, MsBuildConfigurationEntry>();
+    private conditionKeys = new Map<string, string | null>();
+
+    /**
+     * Record a setting
+     * @param condition Effective Condition attribute, or undefined for unconditional settings
+     * @returns false if the condition does not select a configuration and the value was dropped
+     */
+    add(condition: string | undefined, section: MsBuildSection, name: string, value: string): boolean {
+        const entry = this.entryFor(condition);
+        if (!entry) {
+            return false;
+        }
+        appendValue(entry, section, name, value);
+        return true;
+    }
+
+    /**
+     * Append every setting of another index, as if its definitions appeared here
+     * Used for imported property sheets.
+     * @param condition Configuration condition of the import; its unconditional
+     * settings are filed under it, and its other configurations are dropped
+     * @param mapValue Rewrites each value, e.g. to make sheet-relative paths project-relative
+     */
+    merge(other: MsBuildSettingsIndex, condition: string | undefined, mapValue?: (value: string) => string): void {
+        const scope = condition !== undefined ? parseConfigurationCondition(condition) : undefined;
+        for (const [key, source] of other.entries) {
+            let target: MsBuildConfigurationEntry | undefined;
+            if (key === '') {
+                target = this.entryFor(scope ? condition : undefined);
+            } else if (!scope || (source.configuration === scope.configuration &&
+                (scope.platform === undefined || source.platform === undefined || source.platform === scope.platform))) {
+                target = this.entryForKey(key, source.configuration, source.platform);
+            }
+            if (!target) {
+                continue;
+            }
+            for (const [section, settings] of source.sections) {
+                for (const [name, values] of settings) {
+                    for (const value of values) {
+                        appendValue(target, section, name, mapValue ? mapValue(value) : value);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Entries keyed by "Configuration|Platform" ('' for unconditional), for
+     * passing an index between threads; see fromEntries
+     */
+    toEntries(): Array<[string, MsBuildConfigurationEntry]> {
+        return [...this.entries];
+    }
+
+    static fromEntries(entries: Array<[string, MsBuildConfigurationEntry]>): MsBuildSettingsIndex {
+        const index = new MsBuildSettingsIndex();
+        for (const [key, entry] of entries) {
+            index.entries.set(key, entry);
+        }
+        return index;
+    }
+
+    /**
+     * Unconditional settings
+     */
+    getUnconditional(): MsBuildConfigurationEntry | undefined {
+        return this.entries.get('');
+    }
+
+    /**
+     * Configuration names in order of first appearance
+     */
+    getConfigurations(): string[] {
+        const names = new Set<string>();
+        for (const entry of this.entries.values()) {
+            if (entry.configuration !== undefined) {
+                names.add(entry.configuration);
+            }
+        }
+        return [...names];
+    }
+
+    /**
+     * Platform names in order of first appearance
+     */
+    getPlatforms(): string[] {
+        const names = new Set<string>();
+        for (const entry of this.entries.values()) {
+            if (entry.platform !== undefined) {
+                names.add(entry.platform);
+            }
+        }
+        return [...names];
+    }
+
+    /**
+     * Entries of one configuration across all platforms, in order of first appearance
+     */
+    getEntries(configuration: string): MsBuildConfigurationEntry[] {
+        return [...this.entries.values()].filter(entry => entry.configuration === configuration);
+    }
+
+    /**
+     * Entry for an exact (Configuration|Platform) combination
+     */
+    getEntry(configuration: string, platform?: string): MsBuildConfigurationEntry | undefined {
+        return this.entries.get(platform !== undefined ? `${configuration}|${platform}` : configuration);
+    }
+
+    private entryFor(condition: string | undefined): MsBuildConfigurationEntry | undefined {
+        let key: string | null | undefined = condition === undefined ? '' : this.conditionKeys.get(condition);
+        let parsed: ReturnType<typeof parseConfigurationCondition>;
+        if (key === undefined) {
+            parsed = parseConfigurationCondition(condition!);
+            key = parsed ? (parsed.platform !== undefined ? `${parsed.configuration}|${parsed.platform}` : parsed.configuration) : null;
+            this.conditionKeys.set(condition!, key);
+        }
+        if (key === null) {
+            return undefined;
+        }
+
+        const entry = this.entries.get(key);
+        if (entry) {
+            return entry;
+        }
+        parsed ??= condition !== undefined ? parseConfigurationCondition(condition) : undefined;
+        return this.entryForKey(key, parsed?.configuration, parsed?.platform);
+    }
+
+    private entryForKey(key: string, configuration: string | undefined, platform: string | undefined): MsBuildConfigurationEntry {
+        let entry = this.entries.get(key);
+        if (!entry) {
+            entry = { configuration, platform, sections: new Map() };
+            this.entries.set(key, entry);
+        }
+        return entry;
+    }
+}
+
+function appendValue(entry: MsBuildConfigurationEntry, section: MsBuildSection, name: string, value: string): void {
+    let settings = entry.sections.get(section);
+    if (!settings) {
+        settings = new Map();
+        entry.sections.set(section, settings);
+    }
+    const values = settings.get(name);
+    if (values) {
+        values.push(value);
+    } else {
+        settings.set(name, [value]);
+    }
+}
+
+/**
+ * Read settings from one or more entries; later entries override earlier ones
+ */
+export class MsBuildSettingsView {
+    private readonly entries: MsBuildConfigurationEntry[];
+
+    constructor(entries: MsBuildConfigurationEntry[]) {
+        this.entries = entries;
+    }
+
+    /**
+     * Last value of a setting, as MSBuild applies the last definition
+     */
+    get(section: MsBuildSection, name: string): string | undefined {
+        for (let i = this.entries.length - 1; i >= 0; i--) {
+            const values = this.entries[i].sections.get(section)?.get(name);
+            if (values) {
+                return values[values.length - 1];
+            }
+        }
+        return undefined;
+    }
+
+    /**
+     * Every value of a setting, in order
+     */
+    getAll(section: MsBuildSection, name: string): string[] {
+        const result: string[] = [];
+        for (const entry of this.entries) {
+            const values = entry.sections.get(section)?.get(name);
+            if (values) {
+                result.push(...values);
+            }
+        }
+        return result;
+    }
+}
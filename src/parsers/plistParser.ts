@@ -0,0 +1,333 @@
+/**
+ * OpenStep (ASCII) Property List Parser
+ * Parses the old-style plist format used by project.pbxproj in a single
+ * forward pass: dictionaries `{ key = value; }`, arrays `( a, b, )`, quoted
+ * and unquoted strings, `<hex>` data, and comments. PbxObjectGraph indexes the
+ * `objects` dictionary of a pbxproj by ID and by `isa`.
+ */
+
+export type PlistValue = string | PlistValue[] | PlistDictionary;
+
+export interface PlistDictionary {
+    [key: string]: PlistValue;
+}
+
+export class PlistParseError extends Error {
+    readonly offset: number;
+
+    constructor(message: string, offset: number) {
+        super(`${message} at offset ${offset}`);
+        this.name = 'PlistParseError';
+        this.offset = offset;
+    }
+}
+
+/**
+ * Characters allowed in unquoted strings (IDs, identifiers, numbers, paths), by char code
+ */
+const UNQUOTED_CHARS = new Uint8Array(128);
+for (const ch of 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_$+/:.-<>@*!?&|^~%[]\\') {
+    UNQUOTED_CHARS[ch.charCodeAt(0)] = 1;
+}
+
+const ESCAPES: Record<string, string> = {
+    a: '\x07', b: '\b', f: '\f', n: '\n', r: '\r', t: '\t', v: '\v', '"': '"', '\'': '\'', '\\': '\\', '\n': '\n'
+};
+
+class PlistReader {
+    private readonly text: string;
+    private pos = 0;
+
+    constructor(text: string) {
+        this.text = text;
+    }
+
+    parseDocument(): PlistValue {
+        const value = this.parseValue();
+        this.skipTrivia();
+        // A trailing ';' is tolerated after the root value
+        if (this.text[this.pos] === ';') {
+            this.pos++;
+            this.skipTrivia();
+        }
+        if (this.pos < this.text.length) {
+            throw new PlistParseError('Unexpected content after root value', this.pos);
+        }
+        return value;
+    }
+
+    private parseValue(): PlistValue {
+        this.skipTrivia();
+        const ch = this.text[this.pos];
+        if (ch === '{') {
+            return this.parseDictionary();
+        }
+        if (ch === '(') {
+            return this.parseArray();
+        }
+        if (ch === '"' || ch === '\'') {
+            return this.parseQuoted(ch);
+        }
+        if (ch === '<' && this.text[this.pos + 1] !== '>') {
+            return this.parseData();
+        }
+        return this.parseUnquoted();
+    }
+
+    private parseDictionary(): PlistDictionary {
+        const dictionary: PlistDictionary = {};
+        this.pos++;
+        for (;;) {
+            this.skipTrivia();
+            if (this.text[this.pos] === '}') {
+                this.pos++;
+                return dictionary;
+            }
+            const key = this.parseValue();
+            if (typeof key !== 'string') {
+                throw new PlistParseError('Dictionary key must be a string', this.pos);
+            }
+            this.expect('=');
+            dictionary[key] = this.parseValue();
+            this.expect(';');
+        }
+    }
+
+    private parseArray(): PlistValue[] {
+        const array: PlistValue[] = [];
+        this.pos++;
+        for (;;) {
+            this.skipTrivia();
+            if (this.text[this.pos] === ')') {
+                this.pos++;
+                return array;
+            }
+            array.push(this.parseValue());
+            this.skipTrivia();
+            if (this.text[this.pos] === ',') {
+                this.pos++;
+            } else if (this.text[this.pos] !== ')') {
+                throw new PlistParseError('Expected \',\' or \')\'', this.pos);
+            }
+        }
+    }
+
+    private parseQuoted(quote: string): string {
+        const text = this.text;
+        const quoteCode = quote.charCodeAt(0);
+        const start = ++this.pos;
+        let result = '';
+        let chunkStart = start;
+        while (this.pos < text.length) {
+            const code = text.charCodeAt(this.pos);
+            if (code === quoteCode) {
+                result += text.substring(chunkStart, this.pos);
+                this.pos++;
+                return result;
+            }
+            if (code === 92 /* \\ */) {
+                result += text.substring(chunkStart, this.pos);
+                result += this.parseEscape();
+                chunkStart = this.pos;
+            } else {
+                this.pos++;
+            }
+        }
+        throw new PlistParseError('Unterminated string', start - 1);
+    }
+
+    /**
+     * Decode the escape sequence at pos (which is on the backslash)
+     */
+    private parseEscape(): string {
+        const next = this.text[this.pos + 1];
+        if (next === 'U' || next === 'u') {
+            const hex = this.text.substr(this.pos + 2, 4).match(/^[0-9A-Fa-f]{1,4}/)?.[0] ?? '';
+            this.pos += 2 + hex.length;
+            return hex ? String.fromCharCode(parseInt(hex, 16)) : next;
+        }
+        if (next >= '0' && next <= '7') {
+            const octal = this.text.substr(this.pos + 1, 3).match(/^[0-7]{1,3}/)![0];
+            this.pos += 1 + octal.length;
+            return String.fromCharCode(parseInt(octal, 8));
+        }
+        this.pos += 2;
+        return ESCAPES[next] ?? next ?? '';
+    }
+
+    private parseData(): string {
+        const start = this.pos;
+        const end = this.text.indexOf('>', start);
+        if (end < 0) {
+            throw new PlistParseError('Unterminated data', start);
+        }
+        this.pos = end + 1;
+        return this.text.substring(start + 1, end).replace(/\s+/g, '');
+    }
+
+    private parseUnquoted(): string {
+        const start = this.pos;
+        while (this.pos < this.text.length && UNQUOTED_CHARS[this.text.charCodeAt(this.pos)] === 1) {
+            // '//' starts a comment even without surrounding whitespace
+            if (this.text[this.pos] === '/' && (this.text[this.pos + 1] === '/' || this.text[this.pos + 1] === '*')) {
+                break;
+            }
+            this.pos++;
+        }
+        if (this.pos === start) {
+            throw new PlistParseError(
+                this.pos < this.text.length ? `Unexpected '${this.text[this.pos]}'` : 'Unexpected end of input',
+                this.pos
+            );
+        }
+        return this.text.substring(start, this.pos);
+    }
+
+    private expect(ch: string): void {
+        this.skipTrivia();
+        if (this.text[this.pos] !== ch) {
+            throw new PlistParseError(`Expected '${ch}'`, this.pos);
+        }
+        this.pos++;
+    }
+
+    /**
+     * Skip whitespace and comments
+     */
+    private skipTrivia(): void {
+        const text = this.text;
+        while (this.pos < text.length) {
+            const code = text.charCodeAt(this.pos);
+            if (code === 32 || code === 9 || code === 10 || code === 13) {
+                this.pos++;
+            } else if (code === 47 /* / */ && text[this.pos + 1] === '*') {
+                const end = text.indexOf('*/', this.pos + 2);
+                this.pos = end < 0 ? text.length : end + 2;
+            } else if (code === 47 && text[this.pos + 1] === '/') {
+                const end = text.indexOf('\n', this.pos + 2);
+                this.pos = end < 0 ? text.length : end + 1;
+            } else {
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * Parse an OpenStep property list
+ * @throws PlistParseError on malformed input
+ */
+export function parsePlist(text: string): PlistValue {
+    return new PlistReader(text).parseDocument();
+}
+
+/**
+ * pbxproj object: a dictionary with an `isa` class name
+ */
+export interface PbxObject extends PlistDictionary {
+    isa: string;
+}
+
+/**
+ * String value of a key, if it is a string
+ */
+export function plistString(dictionary: PlistDictionary | undefined, key: string): string | undefined {
+    const value = dictionary?.[key];
+    return typeof value === 'string' ? value : undefined;
+}
+
+/**
+ * Array value of a key, if it is an array
+ */
+export function plistArray(dictionary: PlistDictionary | undefined, key: string): PlistValue[] | undefined {
+    const value = dictionary?.[key];
+    return Array.isArray(value) ? value : undefined;
+}
+
+/**
+ * Dictionary value of a key, if it is a dictionary
+ */
+export function plistDictionary(dictionary: PlistDictionary | undefined, key: string): PlistDictionary | undefined {
+    const value = dictionary?.[key];
+    return value !== undefined && typeof value === 'object' && !Array.isArray(value) ? value : undefined;
+}
+
+/**
+ * The objects of a pbxproj, indexed by ID and by class
+ */
+export class PbxObjectGraph {
+    readonly rootObjectId: string | undefined;
+    private readonly objects = new Map<string, PbxObject>();
+    private readonly byIsa = new Map<string, string[]>();
+
+    constructor(document: PlistValue) {
+        const root = typeof document === 'object' && !Array.isArray(document) ? document : {};
+        this.rootObjectId = plistString(root, 'rootObject');
+        const objects = plistDictionary(root, 'objects') ?? {};
+        for (const id of Object.keys(objects)) {
+            const object = objects[id];
+            if (typeof object !== 'object' || Array.isArray(object) || typeof object.isa !== 'string') {
+                continue;
+            }
+            this.objects.set(id, object as PbxObject);
+            const ids = this.byIsa.get(object.isa);
+            if (ids) {
+                ids.push(id);
+            } else {
+                this.byIsa.set(object.isa, [id]);
+            }
+        }
+    }
+
+    /**
+     * Parse project.pbxproj content into an object graph
+     * @throws PlistParseError on malformed input
+     */
+    static parse(content: string): PbxObjectGraph {
+        return new PbxObjectGraph(parsePlist(content));
+    }
+
+    get size(): number {
+        return this.objects.size;
+    }
+
+    get(id: string | undefined): PbxObject | undefined {
+        return id !== undefined ? this.objects.get(id) : undefined;
+    }
+
+    /**
+     * Object referenced by a key, optionally required to be of a class
+     */
+    getRef(object: PlistDictionary | undefined, key: string, isa?: string): PbxObject | undefined {
+        const target = this.get(plistString(object, key));
+        return target && (isa === undefined || target.isa === isa) ? target : undefined;
+    }
+
+    /**
+     * Objects referenced by the IDs in an array-valued key, in order; unknown IDs are skipped
+     */
+    getRefs(object: PlistDictionary | undefined, key: string): PbxObject[] {
+        const result: PbxObject[] = [];
+        for (const id of plistArray(object, key) ?? []) {
+            const target = typeof id === 'string' ? this.objects.get(id) : undefined;
+            if (target) {
+                result.push(target);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * IDs of every object of a class, in document order
+     */
+    getIdsByIsa(isa: string): readonly string[] {
+        return this.byIsa.get(isa) ?? [];
+    }
+
+    /**
+     * Every object of a class, in document order
+     */
+    getByIsa(isa: string): PbxObject[] {
+        return this.getIdsByIsa(isa).map(id => this.objects.get(id)!);
+    }
+}
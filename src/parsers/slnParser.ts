@@ -0,0 +1,95 @@
+/**
+ * Visual Studio Solution (.sln) Parser
+ * Extracts the projects of a solution, their build-order dependencies and
+ * the solution configurations.
+ */
+
+/**
+ * Project type GUID of solution folders, which are not buildable projects
+ */
+export const SOLUTION_FOLDER_TYPE = '2150E333-8FDC-42A3-9474-1A3956D46DE8';
+
+export interface SlnProject {
+    name: string;
+    /** Path relative to the solution directory, with '/' separators */
+    path: string;
+    /** Project GUID, upper case without braces */
+    guid: string;
+    /** Project type GUID, upper case without braces */
+    typeGuid: string;
+    /** GUIDs of projects that must build first (ProjectDependencies section) */
+    dependencies: string[];
+}
+
+export interface SlnSolution {
+    name: string;
+    /** Projects in solution order, without solution folders */
+    projects: SlnProject[];
+    /** Solution configurations (e.g., "Debug|x64") */
+    configurations: string[];
+}
+
+const PROJECT_REGEX = /^Project\("\{([^}]+)\}"\)\s*=\s*"([^"]*)"\s*,\s*"([^"]*)"\s*,\s*"\{([^}]+)\}"/;
+const DEPENDENCY_REGEX = /^\{([^}]+)\}\s*=\s*\{[^}]+\}$/;
+const CONFIGURATION_REGEX = /^([^=]+?)\s*=\s*\1$/;
+
+/**
+ * Normalize a GUID for comparison
+ */
+export function normalizeGuid(guid: string): string {
+    return guid.replace(/[{}]/g, '').trim().toUpperCase();
+}
+
+/**
+ * Parse a .sln file
+ * @param content Solution file content
+ * @param slnPath Path of the solution, used for its name
+ */
+export function parseSln(content: string, slnPath: string): SlnSolution {
+    const nameMatch = slnPath.match(/([^/\\]+)\.sln$/i);
+    const solution: SlnSolution = {
+        name: nameMatch ? nameMatch[1] : 'Solution',
+        projects: [],
+        configurations: []
+    };
+
+    let project: SlnProject | undefined;
+    let section: string | undefined;
+
+    for (const rawLine of content.split(/\r?\n/)) {
+        const line = rawLine.trim();
+
+        if (line.startsWith('Project(')) {
+            const match = line.match(PROJECT_REGEX);
+            project = undefined;
+            if (match && normalizeGuid(match[1]) !== SOLUTION_FOLDER_TYPE) {
+                project = {
+                    name: match[2],
+                    path: match[3].replace(/\\/g, '/'),
+                    guid: normalizeGuid(match[4]),
+                    typeGuid: normalizeGuid(match[1]),
+                    dependencies: []
+                };
+                solution.projects.push(project);
+            }
+        } else if (line === 'EndProject') {
+            project = undefined;
+        } else if (line.startsWith('ProjectSection(') || line.startsWith('GlobalSection(')) {
+            section = line.substring(line.indexOf('(') + 1, line.indexOf(')'));
+        } else if (line === 'EndProjectSection' || line === 'EndGlobalSection') {
+            section = undefined;
+        } else if (section === 'ProjectDependencies' && project) {
+            const match = line.match(DEPENDENCY_REGEX);
+            if (match) {
+                project.dependencies.push(normalizeGuid(match[1]));
+            }
+        } else if (section === 'SolutionConfigurationPlatforms') {
+            const match = line.match(CONFIGURATION_REGEX);
+            if (match) {
+                solution.configurations.push(match[1]);
+            }
+        }
+    }
+
+    return solution;
+}
@@ -3,7 +3,15 @@
  * Parses .vcxproj files to extract project configuration for CMake conversion
  */
 
-import { mergeUnique } from '../utils/arrayUtils';
+import { posix } from 'path';
+import { decodeXmlEntities, tokenizeXml, XmlHandler } from './xmlTokenizer';
+import {
+    MSBUILD_SECTIONS,
+    MsBuildSection,
+    MsBuildSettingsIndex,
+    MsBuildSettingsView,
+    parseConfigurationCondition
+} from './msbuildSettingsIndex';
 
 /**
  * Precompiled header configuration
@@ -167,372 +175,741 @@ export interface VcxprojConfigSettings {
     generateMapFile?: boolean;
 }
 
+/**
+ * Imported property sheet (.props/.targets), read for its item definitions and properties
+ */
+export interface MsBuildPropertySheet {
+    /** Absolute path with '/' separators */
+    path: string;
+    /**
+     * Settings of the sheet and of the sheets it imports, with
+     * $(MSBuildThisFileDirectory) replaced by the defining sheet's directory
+     */
+    settings: MsBuildSettingsIndex;
+    /** Directories of the sheet and of the sheets it imports */
+    directories: string[];
+    /** Paths of the sheets it imports, directly or indirectly */
+    imports: string[];
+    /** Resolved paths of imports that could not be loaded, directly or indirectly */
+    missingImports: string[];
+}
+
+export interface VcxprojParseOptions {
+    /**
+     * Load the property sheet at an absolute path; undefined when it cannot be read
+     * Without a loader, <Import> elements are ignored.
+     */
+    loadImport?: (sheetPath: string) => MsBuildPropertySheet | undefined;
+    /** Solution directory, for $(SolutionDir) in import paths */
+    solutionDir?: string;
+}
+
 /**
  * Parse a vcxproj file content
+ * The document is tokenized once; elements are dispatched to handlers that
+ * track the enclosing ItemDefinitionGroup condition and the current item.
+ * Imported property sheets are merged where their <Import> appears.
  * @param content The XML content of the vcxproj file
  * @param projectPath The path to the vcxproj file (for relative path resolution)
+ * @param options Import resolution
  * @returns Parsed project information
  */
-export function parseVcxproj(content: string, projectPath: string): VcxprojProject {
-    const contentWithoutConditionalItemDefinitionGroups = stripConditionalItemDefinitionGroups(content);
-    const project: VcxprojProject = {
-        name: extractProjectName(content, projectPath),
-        type: 'Application',
-        sourceFiles: [],
-        headerFiles: [],
-        resourceFiles: [],
-        noneFiles: [],
-        includeDirectories: [],
-        preprocessorDefinitions: [],
-        libraries: [],
-        projectReferences: []
-    };
-
-    // Extract configuration type (Application, StaticLibrary, DynamicLibrary)
-    const configTypeMatch = content.match(/<ConfigurationType>(.*?)<\/ConfigurationType>/);
-    if (configTypeMatch) {
-        const configType = configTypeMatch[1];
-        if (configType === 'Application' || configType === 'StaticLibrary' || configType === 'DynamicLibrary') {
-            project.type = configType;
-        }
-    }
-
-    // Extract source files (ClCompile items)
-    const compileMatches = content.matchAll(/<ClCompile\s+Include="([^"]+)"\s*\/>/g);
-    for (const match of compileMatches) {
-        project.sourceFiles.push(normalizePathSeparators(match[1]));
-    }
-
-    // Also handle ClCompile with closing tags
-    const compileBlockMatches = content.matchAll(/<ClCompile\s+Include="([^"]+)"\s*>/g);
-    for (const match of compileBlockMatches) {
-        const file = normalizePathSeparators(match[1]);
-        if (!project.sourceFiles.includes(file)) {
-            project.sourceFiles.push(file);
-        }
-    }
-
-    // Extract header files (ClInclude items)
-    const includeMatches = content.matchAll(/<ClInclude\s+Include="([^"]+)"\s*\/>/g);
-    for (const match of includeMatches) {
-        project.headerFiles.push(normalizePathSeparators(match[1]));
-    }
+export function parseVcxproj(content: string, projectPath: string, options: VcxprojParseOptions = {}): VcxprojProject {
+    const projectDir = posix.dirname(normalizePathSeparators(projectPath));
+    const scanner = new VcxprojScanner(options, projectDir, projectDir);
+    tokenizeXml(content, scanner);
+    return scanner.finish(projectPath);
+}
 
-    // Also handle ClInclude with closing tags
-    const includeBlockMatches = content.matchAll(/<ClInclude\s+Include="([^"]+)"\s*>/g);
-    for (const match of includeBlockMatches) {
-        const file = normalizePathSeparators(match[1]);
-        if (!project.headerFiles.includes(file)) {
-            project.headerFiles.push(file);
-        }
-    }
+/**
+ * Parse a property sheet, merging the sheets it imports
+ * @param content The XML content of the sheet
+ * @param sheetPath Absolute path of the sheet
+ * @param options Import resolution for nested imports
+ */
+export function parsePropertySheet(content: string, sheetPath: string, options: VcxprojParseOptions = {}): MsBuildPropertySheet {
+    const normalized = normalizePathSeparators(sheetPath);
+    const sheetDir = posix.dirname(normalized);
+    const scanner = new VcxprojScanner(options, sheetDir, undefined);
+    tokenizeXml(content, scanner);
+    return scanner.finishSheet(normalized);
+}
 
-    // Extract resource files (ResourceCompile items) - .rc files
-    const resourceMatches = content.matchAll(/<ResourceCompile\s+Include="([^"]+)"\s*\/>/g);
-    for (const match of resourceMatches) {
-        project.resourceFiles.push(normalizePathSeparators(match[1]));
+/**
+ * Expand the Project attribute of an <Import> to an absolute path
+ * $(MSBuildThisFileDirectory), $(ProjectDir), $(MSBuildProjectDirectory) and
+ * $(SolutionDir) are expanded; relative paths resolve against the importing file.
+ * @param baseDir Directory of the importing file, with '/' separators
+ * @returns undefined when other properties or wildcards remain
+ */
+export function resolveImportPath(
+    project: string,
+    baseDir: string,
+    options: { projectDir?: string; solutionDir?: string } = {}
+): string | undefined {
+    const directories: Record<string, string | undefined> = {
+        MSBuildThisFileDirectory: baseDir,
+        ProjectDir: options.projectDir,
+        MSBuildProjectDirectory: options.projectDir,
+        SolutionDir: options.solutionDir !== undefined ? normalizePathSeparators(options.solutionDir) : undefined
+    };
+    let value = normalizePathSeparators(project.trim())
+        .replace(/\$\((\w+)\)\/?/g, (match, name: string) => directories[name] !== undefined ? `${directories[name]}/` : match);
+    if (value.includes('$(') || value.includes('*')) {
+        return undefined;
     }
-    const resourceBlockMatches = content.matchAll(/<ResourceCompile\s+Include="([^"]+)"\s*>/g);
-    for (const match of resourceBlockMatches) {
-        const file = normalizePathSeparators(match[1]);
-        if (!project.resourceFiles.includes(file)) {
-            project.resourceFiles.push(file);
-        }
+    if (!/^([A-Za-z]:)?\//.test(value)) {
+        value = `${baseDir}/${value}`;
     }
+    return posix.normalize(value);
+}
 
-    // Extract None items (files in the project but not compiled)
-    const noneMatches = content.matchAll(/<None\s+Include="([^"]+)"\s*\/>/g);
-    for (const match of noneMatches) {
-        project.noneFiles.push(normalizePathSeparators(match[1]));
+/**
+ * Rewrite absolute sheet directories in a value as paths relative to the project
+ * @param directories Absolute directories, longest first
+ */
+function relativizeSheetPaths(value: string, directories: string[], projectDir: string): string {
+    if (!value.includes('/')) {
+        return value;
     }
-    const noneBlockMatches = content.matchAll(/<None\s+Include="([^"]+)"\s*>/g);
-    for (const match of noneBlockMatches) {
-        const file = normalizePathSeparators(match[1]);
-        if (!project.noneFiles.includes(file)) {
-            project.noneFiles.push(file);
+    for (const directory of directories) {
+        if (value.includes(`${directory}/`)) {
+            const relative = posix.relative(projectDir, directory);
+            value = value.split(`${directory}/`).join(relative ? `${relative}/` : '');
         }
     }
+    return value;
+}
 
-    // Extract project references
-    project.projectReferences = extractProjectReferences(content);
+/**
+ * Item types collected into file lists
+ */
+const ITEM_LISTS: Record<string, 'sourceFiles' | 'headerFiles' | 'resourceFiles' | 'noneFiles'> = {
+    ClCompile: 'sourceFiles',
+    ClInclude: 'headerFiles',
+    ResourceCompile: 'resourceFiles',
+    None: 'noneFiles'
+};
 
-    // Extract include directories from AdditionalIncludeDirectories
-    const includeDirs = extractIncludeDirectories(contentWithoutConditionalItemDefinitionGroups);
-    if (includeDirs.length > 0) {
-        project.includeDirectories = includeDirs;
-    }
+/**
+ * Properties read from their first occurrence anywhere in the project,
+ * including configuration-specific groups
+ */
+const PROJECT_PROPERTIES = new Set([
+    'RootNamespace',
+    'ProjectName',
+    'ConfigurationType',
+    'OutDir',
+    'IntDir',
+    'TargetName',
+    'WindowsTargetPlatformVersion',
+    'PlatformToolset',
+    'CharacterSet',
+    'SubSystem',
+    'WholeProgramOptimization'
+]);
 
-    // Extract preprocessor definitions
-    const definitions = extractPreprocessorDefinitions(contentWithoutConditionalItemDefinitionGroups);
-    if (definitions.length > 0) {
-        project.preprocessorDefinitions = definitions;
-    }
+/**
+ * Build event elements inside an ItemDefinitionGroup
+ */
+const BUILD_EVENT_ELEMENTS: Record<string, BuildEvent['type']> = {
+    PreBuildEvent: 'PreBuild',
+    PreLinkEvent: 'PreLink',
+    PostBuildEvent: 'PostBuild',
+    CustomBuildStep: 'CustomBuild'
+};
 
-    // Extract libraries from AdditionalDependencies
-    const libraries = extractLibraries(contentWithoutConditionalItemDefinitionGroups);
-    if (libraries.length > 0) {
-        project.libraries = libraries;
-    }
+/**
+ * Order in which build events of one group are reported
+ */
+const BUILD_EVENT_ORDER: BuildEvent['type'][] = ['PreBuild', 'PreLink', 'PostBuild', 'CustomBuild'];
 
-    // Extract output directory
-    const outDirMatch = content.match(/<OutDir>(.*?)<\/OutDir>/);
-    if (outDirMatch) {
-        project.outputDirectory = normalizePathSeparators(outDirMatch[1]);
-    }
+interface ElementFrame {
+    name: string;
+    attributes: Record<string, string>;
+    /** Text content; only kept while the element has no child elements */
+    text: string;
+    hasChildren: boolean;
+    /** First value of each child element, for elements read as a record */
+    children?: Map<string, string>;
+}
 
-    // Extract additional compiler options
-    const additionalCompileOptions = extractAdditionalOptions(contentWithoutConditionalItemDefinitionGroups, /<ClCompile>[\s\S]*?<AdditionalOptions>(.*?)<\/AdditionalOptions>[\s\S]*?<\/ClCompile>/g, '%(AdditionalOptions)');
-    if (additionalCompileOptions.length > 0) {
-        project.additionalCompileOptions = additionalCompileOptions;
-    }
+interface DefinitionGroupState {
+    frame: ElementFrame;
+    /** Condition attribute, if the group is configuration-specific */
+    condition?: string;
+    events: BuildEvent[];
+    /** <Type>EventUseInBuild values seen in the group */
+    useInBuild: Map<string, boolean>;
+}
 
-    // Extract additional linker options
-    const additionalLinkOptions = extractAdditionalOptions(contentWithoutConditionalItemDefinitionGroups, /<Link>[\s\S]*?<AdditionalOptions>(.*?)<\/AdditionalOptions>[\s\S]*?<\/Link>/g, '%(AdditionalOptions)');
-    if (additionalLinkOptions.length > 0) {
-        project.additionalLinkOptions = additionalLinkOptions;
-    }
+/**
+ * Split a semicolon-separated list, dropping the inherited-value macro
+ */
+function splitList(value: string, inheritMacro: string): string[] {
+    return value.split(';').map(item => item.trim()).filter(item => item && item !== inheritMacro);
+}
 
-    // Extract additional library directories
-    const additionalLibraryDirectories = extractAdditionalLibraryDirectories(contentWithoutConditionalItemDefinitionGroups);
-    if (additionalLibraryDirectories.length > 0) {
-        project.additionalLibraryDirectories = additionalLibraryDirectories;
+/**
+ * Union of every value of a list setting across sections, in order
+ */
+function collectList(view: MsBuildSettingsView, sections: MsBuildSection[], name: string, map?: (item: string) => string): string[] {
+    const items = new Set<string>();
+    for (const section of sections) {
+        for (const value of view.getAll(section, name)) {
+            for (const item of splitList(value, `%(${name})`)) {
+                items.add(map ? map(item) : item);
+            }
+        }
     }
+    return [...items];
+}
 
-    // Extract C++ language standard
-    const languageStandardMatch = contentWithoutConditionalItemDefinitionGroups.match(/<LanguageStandard>(.*?)<\/LanguageStandard>/);
-    if (languageStandardMatch) {
-        project.cxxStandard = parseLanguageStandard(languageStandardMatch[1]);
-    }
+/**
+ * Boolean settings and the section they are read from
+ */
+const BOOLEAN_SETTINGS: Array<[keyof VcxprojConfigSettings, MsBuildSection, string]> = [
+    ['runtimeTypeInfo', 'ClCompile', 'RuntimeTypeInfo'],
+    ['treatWarningAsError', 'ClCompile', 'TreatWarningAsError'],
+    ['multiProcessorCompilation', 'ClCompile', 'MultiProcessorCompilation'],
+    ['functionLevelLinking', 'ClCompile', 'FunctionLevelLinking'],
+    ['intrinsicFunctions', 'ClCompile', 'IntrinsicFunctions'],
+    ['conformanceMode', 'ClCompile', 'ConformanceMode'],
+    ['enableCOMDATFolding', 'Link', 'EnableCOMDATFolding'],
+    ['optimizeReferences', 'Link', 'OptimizeReferences'],
+    ['generateMapFile', 'Link', 'GenerateMapFile']
+];
 
-    // Extract warning level
-    const warningLevelMatch = contentWithoutConditionalItemDefinitionGroups.match(/<WarningLevel>Level(\d)<\/WarningLevel>/);
-    if (warningLevelMatch) {
-        project.warningLevel = parseInt(warningLevelMatch[1], 10);
-    }
+/**
+ * Trimmed string settings of the compiler
+ */
+const STRING_SETTINGS: Array<[keyof VcxprojConfigSettings, string]> = [
+    ['optimization', 'Optimization'],
+    ['debugInformationFormat', 'DebugInformationFormat'],
+    ['exceptionHandling', 'ExceptionHandling'],
+    ['basicRuntimeChecks', 'BasicRuntimeChecks'],
+    ['favorSizeOrSpeed', 'FavorSizeOrSpeed']
+];
 
-    // Extract optimization level
-    const optimizationMatch = contentWithoutConditionalItemDefinitionGroups.match(/<Optimization>(.*?)<\/Optimization>/);
-    if (optimizationMatch) {
-        project.optimization = optimizationMatch[1].trim();
+/**
+ * Build the settings shared by the project and its configurations from indexed values
+ * Lists accumulate across definitions (as with %(Name) inheritance); scalars take the last value.
+ */
+function settingsFromView(view: MsBuildSettingsView): VcxprojConfigSettings {
+    const settings: VcxprojConfigSettings = {};
+    const lists: Array<[keyof VcxprojConfigSettings, string[]]> = [
+        ['includeDirectories', collectList(view, ['ClCompile'], 'AdditionalIncludeDirectories', normalizePathSeparators)],
+        ['preprocessorDefinitions', collectList(view, ['ClCompile'], 'PreprocessorDefinitions')],
+        ['libraries', collectList(view, ['Link', 'Lib'], 'AdditionalDependencies', lib => lib.replace(/\.lib$/i, ''))],
+        ['additionalCompileOptions', [...new Set(view.getAll('ClCompile', 'AdditionalOptions')
+            .flatMap(value => parseAdditionalOptionsValue(value, '%(AdditionalOptions)')))]],
+        ['additionalLinkOptions', [...new Set(view.getAll('Link', 'AdditionalOptions')
+            .flatMap(value => parseAdditionalOptionsValue(value, '%(AdditionalOptions)')))]],
+        ['additionalLibraryDirectories', collectList(view, ['Link', 'Lib'], 'AdditionalLibraryDirectories', normalizePathSeparators)],
+        ['disableSpecificWarnings', collectList(view, ['ClCompile'], 'DisableSpecificWarnings')]
+    ];
+    for (const [field, items] of lists) {
+        if (items.length > 0) {
+            (settings as Record<string, unknown>)[field] = items;
+        }
+    }
+
+    const warningLevel = view.get('ClCompile', 'WarningLevel')?.match(/^Level(\d)$/);
+    if (warningLevel) {
+        settings.warningLevel = parseInt(warningLevel[1], 10);
+    }
+    for (const [field, element] of STRING_SETTINGS) {
+        const value = view.get('ClCompile', element);
+        if (value !== undefined) {
+            (settings as Record<string, unknown>)[field] = value.trim();
+        }
+    }
+    const runtimeLibrary = view.get('ClCompile', 'RuntimeLibrary');
+    if (runtimeLibrary !== undefined) {
+        settings.runtimeLibrary = parseRuntimeLibrary(runtimeLibrary);
+    }
+    const controlFlowGuard = view.get('ClCompile', 'ControlFlowGuard');
+    if (controlFlowGuard !== undefined) {
+        settings.controlFlowGuard = controlFlowGuard.trim() === 'Guard';
+    }
+
+    for (const [field, section, element] of BOOLEAN_SETTINGS) {
+        const value = view.get(section, element);
+        const parsed = value !== undefined ? parseBooleanValue(value) : undefined;
+        if (parsed !== undefined) {
+            (settings as Record<string, unknown>)[field] = parsed;
+        }
+    }
+    // A compiler setting, or a property of the configuration
+    const wholeProgramOptimization = view.get('ClCompile', 'WholeProgramOptimization') ?? view.get('PropertyGroup', 'WholeProgramOptimization');
+    const wpoValue = wholeProgramOptimization !== undefined ? parseBooleanValue(wholeProgramOptimization) : undefined;
+    if (wpoValue !== undefined) {
+        settings.wholeProgramOptimization = wpoValue;
     }
-
-    // Extract debug information format
-    const debugInfoMatch = contentWithoutConditionalItemDefinitionGroups.match(/<DebugInformationFormat>(.*?)<\/DebugInformationFormat>/);
-    if (debugInfoMatch) {
-        project.debugInformationFormat = debugInfoMatch[1].trim();
+    const generateDebugInformation = view.get('Link', 'GenerateDebugInformation');
+    if (generateDebugInformation !== undefined) {
+        const value = generateDebugInformation.trim();
+        settings.generateDebugInformation = parseBooleanValue(value) ?? value;
     }
+    return settings;
+}
 
-    // Extract runtime library
-    const runtimeLibraryMatch = contentWithoutConditionalItemDefinitionGroups.match(/<RuntimeLibrary>(.*?)<\/RuntimeLibrary>/);
-    if (runtimeLibraryMatch) {
-        project.runtimeLibrary = parseRuntimeLibrary(runtimeLibraryMatch[1]);
-    }
+/**
+ * Streaming handler that assembles a VcxprojProject
+ */
+class VcxprojScanner implements XmlHandler {
+    private readonly options: VcxprojParseOptions;
+    /** Directory of the file being read */
+    private readonly fileDir: string;
+    /** Project directory; undefined while reading a property sheet */
+    private readonly projectDir: string | undefined;
+    private sheetDirectories = new Set<string>();
+    private sheetImports = new Set<string>();
+    private sheetMissingImports = new Set<string>();
+    private stack: ElementFrame[] = [];
+    private properties = new Map<string, string>();
+    private files = {
+        sourceFiles: new Set<string>(),
+        headerFiles: new Set<string>(),
+        resourceFiles: new Set<string>(),
+        noneFiles: new Set<string>()
+    };
+    private projectReferences: ProjectReference[] = [];
+    private referencePaths = new Set<string>();
+    private settings = new MsBuildSettingsIndex();
+    private group: DefinitionGroupState | undefined;
+    /** ItemGroup item (element with Include) currently open */
+    private item: { frame: ElementFrame; path: string } | undefined;
+
+    // Precompiled headers
+    private globalPch: string | undefined;
+    private globalPchFile: string | undefined;
+    private itemPchFile: string | undefined;
+    private pchSourceFile: string | undefined;
+    private pchUsed = false;
+    private pchExcluded = new Set<string>();
+
+    // Build events, reported conditional groups first
+    private conditionalEvents: BuildEvent[] = [];
+    private unconditionalEvents: BuildEvent[] = [];
+
+    constructor(options: VcxprojParseOptions, fileDir: string, projectDir: string | undefined) {
+        this.options = options;
+        this.fileDir = fileDir;
+        this.projectDir = projectDir;
+    }
+
+    onOpenTag(name: string, attributes: Record<string, string>, selfClosing: boolean): void {
+        const parent = this.stack[this.stack.length - 1];
+        if (parent) {
+            parent.hasChildren = true;
+        }
+        const frame: ElementFrame = { name, attributes, text: '', hasChildren: false };
+        this.stack.push(frame);
+
+        if (name === 'Import' && attributes.Project !== undefined && this.options.loadImport && !this.item) {
+            this.importSheet(attributes.Project);
+        } else if (name === 'ItemDefinitionGroup' && !this.group) {
+            this.group = {
+                frame,
+                condition: attributes.Condition,
+                events: [],
+                useInBuild: new Map()
+            };
+        } else if (parent?.name === 'ItemGroup' && attributes.Include !== undefined && !this.item) {
+            const path = normalizePathSeparators(attributes.Include);
+            this.item = { frame, path };
+            const list = ITEM_LISTS[name];
+            if (list) {
+                this.files[list].add(path);
+            }
+            if (name === 'ProjectReference') {
+                frame.children = new Map();
+            }
+        } else if (this.group && !this.item && BUILD_EVENT_ELEMENTS[name]) {
+            frame.children = new Map();
+        }
 
-    // Extract exception handling
-    const exceptionHandlingMatch = contentWithoutConditionalItemDefinitionGroups.match(/<ExceptionHandling>(.*?)<\/ExceptionHandling>/);
-    if (exceptionHandlingMatch) {
-        project.exceptionHandling = exceptionHandlingMatch[1].trim();
+        if (selfClosing) {
+            this.onCloseTag(name);
+        }
     }
 
-    // Extract RTTI setting
-    const rttiMatch = contentWithoutConditionalItemDefinitionGroups.match(/<RuntimeTypeInfo>(.*?)<\/RuntimeTypeInfo>/);
-    const rttiValue = rttiMatch ? parseBooleanValue(rttiMatch[1]) : undefined;
-    if (rttiValue !== undefined) {
-        project.runtimeTypeInfo = rttiValue;
+    onCloseTag(name: string): void {
+        // Tolerate unbalanced markup by closing up to the matching element
+        let index = this.stack.length - 1;
+        while (index >= 0 && this.stack[index].name !== name) {
+            index--;
+        }
+        if (index < 0) {
+            return;
+        }
+        while (this.stack.length > index) {
+            const frame = this.stack.pop()!;
+            this.closeElement(frame, this.stack[this.stack.length - 1]);
+        }
     }
 
-    // Extract treat warnings as errors
-    const treatWarningMatch = contentWithoutConditionalItemDefinitionGroups.match(/<TreatWarningAsError>(.*?)<\/TreatWarningAsError>/);
-    const treatWarningValue = treatWarningMatch ? parseBooleanValue(treatWarningMatch[1]) : undefined;
-    if (treatWarningValue !== undefined) {
-        project.treatWarningAsError = treatWarningValue;
+    onText(text: string): void {
+        const top = this.stack[this.stack.length - 1];
+        if (top && !top.hasChildren) {
+            top.text += text;
+        }
     }
 
-    // Extract multi-processor compilation
-    const mpMatch = contentWithoutConditionalItemDefinitionGroups.match(/<MultiProcessorCompilation>(.*?)<\/MultiProcessorCompilation>/);
-    const mpValue = mpMatch ? parseBooleanValue(mpMatch[1]) : undefined;
-    if (mpValue !== undefined) {
-        project.multiProcessorCompilation = mpValue;
-    }
+    /**
+     * Assemble the project once the whole document has been read
+     */
+    finish(projectPath: string): VcxprojProject {
+        const project: VcxprojProject = {
+            name: this.projectName(projectPath),
+            type: 'Application',
+            sourceFiles: [...this.files.sourceFiles],
+            headerFiles: [...this.files.headerFiles],
+            resourceFiles: [...this.files.resourceFiles],
+            noneFiles: [...this.files.noneFiles],
+            includeDirectories: [],
+            preprocessorDefinitions: [],
+            libraries: [],
+            projectReferences: this.projectReferences
+        };
 
-    // Extract function-level linking
-    const fllMatch = contentWithoutConditionalItemDefinitionGroups.match(/<FunctionLevelLinking>(.*?)<\/FunctionLevelLinking>/);
-    const fllValue = fllMatch ? parseBooleanValue(fllMatch[1]) : undefined;
-    if (fllValue !== undefined) {
-        project.functionLevelLinking = fllValue;
-    }
+        const configType = this.properties.get('ConfigurationType');
+        if (configType === 'Application' || configType === 'StaticLibrary' || configType === 'DynamicLibrary') {
+            project.type = configType;
+        }
 
-    // Extract intrinsic functions
-    const ifMatch = contentWithoutConditionalItemDefinitionGroups.match(/<IntrinsicFunctions>(.*?)<\/IntrinsicFunctions>/);
-    const ifValue = ifMatch ? parseBooleanValue(ifMatch[1]) : undefined;
-    if (ifValue !== undefined) {
-        project.intrinsicFunctions = ifValue;
-    }
+        // Project-wide settings come from the unconditional definitions; whole
+        // program optimization is a project property, read separately below
+        const unconditional = this.settings.getUnconditional();
+        const global = new MsBuildSettingsView(unconditional ? [unconditional] : []);
+        const settings = settingsFromView(global);
+        delete settings.wholeProgramOptimization;
+        Object.assign(project, settings);
 
-    // Extract whole program optimization
-    const wpoMatch = content.match(/<WholeProgramOptimization>(.*?)<\/WholeProgramOptimization>/);
-    const wpoValue = wpoMatch ? parseBooleanValue(wpoMatch[1]) : undefined;
-    if (wpoValue !== undefined) {
-        project.wholeProgramOptimization = wpoValue;
-    }
+        const outDir = this.properties.get('OutDir');
+        if (outDir !== undefined) {
+            project.outputDirectory = normalizePathSeparators(outDir);
+        }
+        const languageStandard = global.get('ClCompile', 'LanguageStandard');
+        if (languageStandard !== undefined) {
+            project.cxxStandard = parseLanguageStandard(languageStandard);
+        }
+        const wholeProgramOptimization = this.properties.get('WholeProgramOptimization');
+        const wpoValue = wholeProgramOptimization !== undefined ? parseBooleanValue(wholeProgramOptimization) : undefined;
+        if (wpoValue !== undefined) {
+            project.wholeProgramOptimization = wpoValue;
+        }
+        const minimalRebuild = parseBooleanValue(global.get('ClCompile', 'MinimalRebuild') ?? '');
+        if (minimalRebuild !== undefined) {
+            project.minimalRebuild = minimalRebuild;
+        }
+        const stringPooling = parseBooleanValue(global.get('ClCompile', 'StringPooling') ?? '');
+        if (stringPooling !== undefined) {
+            project.stringPooling = stringPooling;
+        }
+        const cStandard = global.get('ClCompile', 'LanguageStandard_C');
+        if (cStandard !== undefined) {
+            project.cStandard = parseCLanguageStandard(cStandard);
+        }
+
+        const intDir = this.properties.get('IntDir');
+        if (intDir !== undefined) {
+            project.intermediateDirectory = normalizePathSeparators(intDir);
+        }
+        const stringProperties: Array<[keyof VcxprojProject, string]> = [
+            ['targetName', 'TargetName'],
+            ['windowsSdkVersion', 'WindowsTargetPlatformVersion'],
+            ['platformToolset', 'PlatformToolset'],
+            ['characterSet', 'CharacterSet'],
+            ['subsystem', 'SubSystem']
+        ];
+        for (const [field, element] of stringProperties) {
+            const value = this.properties.get(element);
+            if (value !== undefined) {
+                (project as unknown as Record<string, unknown>)[field] = value;
+            }
+        }
 
-    // Extract generate debug information
-    const genDebugMatch = contentWithoutConditionalItemDefinitionGroups.match(/<GenerateDebugInformation>(.*?)<\/GenerateDebugInformation>/);
-    if (genDebugMatch) {
-        const val = genDebugMatch[1].trim();
-        const boolVal = parseBooleanValue(val);
-        project.generateDebugInformation = boolVal !== undefined ? boolVal : val;
-    }
+        project.pchConfig = this.pchConfig();
 
-    // Extract minimal rebuild
-    const minRebuildMatch = contentWithoutConditionalItemDefinitionGroups.match(/<MinimalRebuild>(.*?)<\/MinimalRebuild>/);
-    const minRebuildValue = minRebuildMatch ? parseBooleanValue(minRebuildMatch[1]) : undefined;
-    if (minRebuildValue !== undefined) {
-        project.minimalRebuild = minRebuildValue;
-    }
+        // Unconditional events repeat those of each configuration; keep one copy
+        const buildEvents = [...this.conditionalEvents];
+        const seen = new Set(buildEvents.filter(e => !e.condition).map(e => `${e.type}\0${e.command}`));
+        for (const event of this.unconditionalEvents) {
+            const key = `${event.type}\0${event.command}`;
+            if (!seen.has(key)) {
+                seen.add(key);
+                buildEvents.push(event);
+            }
+        }
+        project.buildEvents = buildEvents.length > 0 ? buildEvents : undefined;
 
-    // Extract string pooling
-    const stringPoolMatch = contentWithoutConditionalItemDefinitionGroups.match(/<StringPooling>(.*?)<\/StringPooling>/);
-    const stringPoolValue = stringPoolMatch ? parseBooleanValue(stringPoolMatch[1]) : undefined;
-    if (stringPoolValue !== undefined) {
-        project.stringPooling = stringPoolValue;
+        // Each configuration merges its platforms
+        const configurations: Record<string, VcxprojConfigSettings> = {};
+        for (const configuration of this.settings.getConfigurations()) {
+            const configSettings = settingsFromView(new MsBuildSettingsView(this.settings.getEntries(configuration)));
+            if (Object.keys(configSettings).length > 0) {
+                configurations[configuration] = configSettings;
+            }
+        }
+        if (Object.keys(configurations).length > 0) {
+            project.configurations = configurations;
+        }
+        return project;
     }
 
-    // Extract conformance mode
-    const conformanceMatch = contentWithoutConditionalItemDefinitionGroups.match(/<ConformanceMode>(.*?)<\/ConformanceMode>/);
-    const conformanceValue = conformanceMatch ? parseBooleanValue(conformanceMatch[1]) : undefined;
-    if (conformanceValue !== undefined) {
-        project.conformanceMode = conformanceValue;
-    }
+    private closeElement(frame: ElementFrame, parent: ElementFrame | undefined): void {
+        if (this.item?.frame === frame) {
+            if (frame.name === 'ProjectReference') {
+                this.addProjectReference(this.item.path, frame.children!);
+            }
+            this.item = undefined;
+            return;
+        }
+        if (this.group?.frame === frame) {
+            this.finishGroup(this.group);
+            this.group = undefined;
+            return;
+        }
+        if (frame.children && BUILD_EVENT_ELEMENTS[frame.name]) {
+            this.addBuildEvent(BUILD_EVENT_ELEMENTS[frame.name], frame.children);
+            return;
+        }
+        if (frame.hasChildren) {
+            return;
+        }
 
-    // Extract basic runtime checks
-    const rtcMatch = contentWithoutConditionalItemDefinitionGroups.match(/<BasicRuntimeChecks>(.*?)<\/BasicRuntimeChecks>/);
-    if (rtcMatch) {
-        project.basicRuntimeChecks = rtcMatch[1].trim();
-    }
+        // Leaf element: a property or metadata value
+        const name = frame.name;
+        const text = frame.text;
+        if (parent?.children && !parent.children.has(name)) {
+            parent.children.set(name, text);
+        }
 
-    // Extract disabled specific warnings
-    const dswMatch = contentWithoutConditionalItemDefinitionGroups.match(/<DisableSpecificWarnings>(.*?)<\/DisableSpecificWarnings>/);
-    if (dswMatch) {
-        const warnings = dswMatch[1].split(';').map(w => w.trim()).filter(w => w && w !== '%(DisableSpecificWarnings)');
-        if (warnings.length > 0) {
-            project.disableSpecificWarnings = warnings;
+        if (this.item) {
+            // Per-file metadata only matters for precompiled headers; per-configuration
+            // values (Condition on the element) count as well
+            if (this.item.frame.name === 'ClCompile') {
+                this.addItemPchSetting(this.item.path, name, text);
+            }
+            return;
+        }
+        // Tool settings and properties are indexed under their configuration
+        if (parent && MSBUILD_SECTIONS.has(parent.name)) {
+            // Sheets are shared by projects in different directories; pin their own directory
+            const value = this.projectDir === undefined
+                ? text.split('$(MSBuildThisFileDirectory)').join(`${this.fileDir}/`)
+                : text;
+            this.settings.add(this.effectiveCondition(frame), parent.name as MsBuildSection, name, value);
+        }
+        if (frame.attributes.Condition !== undefined) {
+            return;
         }
-    }
 
-    // Extract favor size or speed
-    const fssMatch = contentWithoutConditionalItemDefinitionGroups.match(/<FavorSizeOrSpeed>(.*?)<\/FavorSizeOrSpeed>/);
-    if (fssMatch) {
-        project.favorSizeOrSpeed = fssMatch[1].trim();
+        if (PROJECT_PROPERTIES.has(name) && !this.properties.has(name)) {
+            this.properties.set(name, text);
+        }
+        if (!this.group) {
+            return;
+        }
+        if (parent?.name === 'ClCompile') {
+            if (name === 'PrecompiledHeader' && this.globalPch === undefined) {
+                this.globalPch = text;
+            } else if (name === 'PrecompiledHeaderFile' && this.globalPchFile === undefined) {
+                this.globalPchFile = text;
+            }
+        }
+        const useInBuild = name.match(/^(PreBuild|PreLink|PostBuild)EventUseInBuild$/);
+        if (useInBuild && !this.group.useInBuild.has(useInBuild[1])) {
+            this.group.useInBuild.set(useInBuild[1], parseBooleanValue(text) ?? true);
+        }
     }
 
-    // Extract control flow guard
-    const cfgMatch = contentWithoutConditionalItemDefinitionGroups.match(/<ControlFlowGuard>(.*?)<\/ControlFlowGuard>/);
-    if (cfgMatch) {
-        project.controlFlowGuard = cfgMatch[1].trim() === 'Guard';
+    /**
+     * Settings of the scanned property sheet
+     */
+    finishSheet(sheetPath: string): MsBuildPropertySheet {
+        this.sheetDirectories.add(this.fileDir);
+        return {
+            path: sheetPath,
+            settings: this.settings,
+            directories: [...this.sheetDirectories].sort((a, b) => b.length - a.length),
+            imports: [...this.sheetImports],
+            missingImports: [...this.sheetMissingImports]
+        };
     }
 
-    // Extract enable COMDAT folding (linker)
-    const comdatMatch = contentWithoutConditionalItemDefinitionGroups.match(/<EnableCOMDATFolding>(.*?)<\/EnableCOMDATFolding>/);
-    const comdatValue = comdatMatch ? parseBooleanValue(comdatMatch[1]) : undefined;
-    if (comdatValue !== undefined) {
-        project.enableCOMDATFolding = comdatValue;
-    }
+    /**
+     * Merge an imported sheet's settings at the position of its <Import>
+     */
+    private importSheet(project: string): void {
+        const sheetPath = resolveImportPath(project, this.fileDir, {
+            projectDir: this.projectDir,
+            solutionDir: this.options.solutionDir
+        });
+        const sheet = sheetPath !== undefined ? this.options.loadImport!(sheetPath) : undefined;
+        if (!sheet) {
+            // Recorded so a cached sheet is parsed again once the import appears
+            if (sheetPath !== undefined && this.projectDir === undefined) {
+                this.sheetMissingImports.add(sheetPath);
+            }
+            return;
+        }
 
-    // Extract optimize references (linker)
-    const optRefMatch = contentWithoutConditionalItemDefinitionGroups.match(/<OptimizeReferences>(.*?)<\/OptimizeReferences>/);
-    const optRefValue = optRefMatch ? parseBooleanValue(optRefMatch[1]) : undefined;
-    if (optRefValue !== undefined) {
-        project.optimizeReferences = optRefValue;
-    }
+        // Only configuration conditions scope the import; Exists() and the like
+        // were settled by loading the file
+        let condition: string | undefined;
+        for (let i = this.stack.length - 1; i >= 0 && condition === undefined; i--) {
+            const candidate = this.stack[i].attributes.Condition;
+            if (candidate !== undefined && parseConfigurationCondition(candidate)) {
+                condition = candidate;
+            }
+        }
 
-    // Extract generate map file (linker)
-    const mapFileMatch = contentWithoutConditionalItemDefinitionGroups.match(/<GenerateMapFile>(.*?)<\/GenerateMapFile>/);
-    const mapFileValue = mapFileMatch ? parseBooleanValue(mapFileMatch[1]) : undefined;
-    if (mapFileValue !== undefined) {
-        project.generateMapFile = mapFileValue;
+        if (this.projectDir === undefined) {
+            this.settings.merge(sheet.settings, condition);
+            sheet.directories.forEach(directory => this.sheetDirectories.add(directory));
+            this.sheetImports.add(sheet.path);
+            sheet.imports.forEach(path => this.sheetImports.add(path));
+            sheet.missingImports.forEach(path => this.sheetMissingImports.add(path));
+        } else {
+            const projectDir = this.projectDir;
+            this.settings.merge(sheet.settings, condition, value => relativizeSheetPaths(value, sheet.directories, projectDir));
+        }
     }
 
-    // Extract C language standard
-    const cStandardMatch = contentWithoutConditionalItemDefinitionGroups.match(/<LanguageStandard_C>(.*?)<\/LanguageStandard_C>/);
-    if (cStandardMatch) {
-        project.cStandard = parseCLanguageStandard(cStandardMatch[1]);
+    /**
+     * Innermost Condition applying to a closed element
+     */
+    private effectiveCondition(frame: ElementFrame): string | undefined {
+        if (frame.attributes.Condition !== undefined) {
+            return frame.attributes.Condition;
+        }
+        for (let i = this.stack.length - 1; i >= 0; i--) {
+            const condition = this.stack[i].attributes.Condition;
+            if (condition !== undefined) {
+                return condition;
+            }
+        }
+        return undefined;
     }
 
-    // Extract intermediate directory
-    const intDirMatch = content.match(/<IntDir>(.*?)<\/IntDir>/);
-    if (intDirMatch) {
-        project.intermediateDirectory = normalizePathSeparators(intDirMatch[1]);
-    }
+    private projectName(projectPath: string): string {
+        // Try RootNamespace first (common in VS projects), then ProjectName
+        const rootNamespace = this.properties.get('RootNamespace')?.trim();
+        if (rootNamespace) {
+            return rootNamespace;
+        }
+        const projectName = this.properties.get('ProjectName')?.trim();
+        if (projectName) {
+            return projectName;
+        }
 
-    // Extract target name
-    const targetNameMatch = content.match(/<TargetName>(.*?)<\/TargetName>/);
-    if (targetNameMatch) {
-        project.targetName = targetNameMatch[1];
+        // Fall back to filename
+        const match = projectPath.match(/([^/\\]+)\.vcxproj$/);
+        return match ? match[1] : 'MyProject';
     }
 
-    // Extract Windows SDK version
-    const sdkVersionMatch = content.match(/<WindowsTargetPlatformVersion>(.*?)<\/WindowsTargetPlatformVersion>/);
-    if (sdkVersionMatch) {
-        project.windowsSdkVersion = sdkVersionMatch[1];
+    private addProjectReference(path: string, children: Map<string, string>): void {
+        if (this.referencePaths.has(path)) {
+            return;
+        }
+        this.referencePaths.add(path);
+        const ref: ProjectReference = { path };
+        const guidMatch = children.get('Project')?.match(/^\{?([^}]+)\}?$/);
+        if (guidMatch) {
+            ref.projectGuid = guidMatch[1];
+        }
+        const name = children.get('Name');
+        if (name !== undefined) {
+            ref.name = name;
+        } else {
+            // Infer name from path
+            const pathNameMatch = path.match(/([^/\\]+)\.vcxproj$/);
+            if (pathNameMatch) {
+                ref.name = pathNameMatch[1];
+            }
+        }
+        this.projectReferences.push(ref);
     }
 
-    // Extract platform toolset
-    const platformToolsetMatch = content.match(/<PlatformToolset>(.*?)<\/PlatformToolset>/);
-    if (platformToolsetMatch) {
-        project.platformToolset = platformToolsetMatch[1];
+    private addItemPchSetting(fileName: string, name: string, text: string): void {
+        if (name === 'PrecompiledHeader') {
+            const setting = text.trim().toLowerCase();
+            if (setting === 'create') {
+                // This file creates the PCH
+                this.pchSourceFile = fileName;
+                this.pchUsed = true;
+            } else if (setting === 'notusing') {
+                // This file is excluded from PCH
+                this.pchExcluded.add(fileName);
+            } else if (setting === 'use') {
+                this.pchUsed = true;
+            }
+        } else if (name === 'PrecompiledHeaderFile' && this.itemPchFile === undefined && text.trim()) {
+            this.itemPchFile = text;
+        }
     }
 
-    // Extract character set
-    const characterSetMatch = content.match(/<CharacterSet>(.*?)<\/CharacterSet>/);
-    if (characterSetMatch) {
-        project.characterSet = characterSetMatch[1];
-    }
+    private pchConfig(): PchConfig | undefined {
+        const headerFile = this.globalPchFile?.trim() ? this.globalPchFile : this.itemPchFile;
+        const pchConfig: PchConfig = {
+            enabled: this.pchUsed || this.globalPch?.trim().toLowerCase() === 'use',
+            excludedFiles: [...this.pchExcluded]
+        };
+        if (headerFile !== undefined) {
+            pchConfig.headerFile = normalizePathSeparators(headerFile.trim());
+        }
+        if (this.pchSourceFile !== undefined) {
+            pchConfig.sourceFile = this.pchSourceFile;
+        }
 
-    // Extract subsystem from Link settings
-    const subsystemMatch = content.match(/<SubSystem>(.*?)<\/SubSystem>/);
-    if (subsystemMatch) {
-        project.subsystem = subsystemMatch[1];
+        // Only return PCH config if it's actually used
+        if (pchConfig.enabled || pchConfig.sourceFile || pchConfig.headerFile) {
+            return pchConfig;
+        }
+        return undefined;
     }
 
-    // Parse precompiled header configuration
-    project.pchConfig = parsePchConfig(content);
-
-    // Parse build events (pre-build, post-build, custom build)
-    project.buildEvents = parseBuildEvents(content);
-
-    // Parse configuration-specific settings
-    const configSettings = parseConfigurationSettings(content);
-    if (Object.keys(configSettings).length > 0) {
-        project.configurations = configSettings;
+    private addBuildEvent(type: BuildEvent['type'], children: Map<string, string>): void {
+        const command = children.get('Command')?.trim();
+        if (!command || !this.group) {
+            return;
+        }
+        const message = children.get('Message');
+        const event: BuildEvent = {
+            type,
+            command: decodeXmlEntities(command),
+            message: message !== undefined ? decodeXmlEntities(message.trim()) : undefined
+        };
+        if (type === 'CustomBuild') {
+            const outputs = children.get('Outputs');
+            event.outputs = outputs !== undefined ? outputs.split(';').map(o => o.trim()).filter(o => o) : undefined;
+        }
+        this.group.events.push(event);
     }
 
-    return project;
-}
-
-/**
- * Extract project name from vcxproj content or file path.
- * Tries RootNamespace first, then ProjectName, then falls back to filename.
- * @param content The XML content of the vcxproj file
- * @param projectPath Path to the vcxproj file
- * @returns Project name
- */
-function extractProjectName(content: string, projectPath: string): string {
-    // Try RootNamespace first (common in VS projects)
-    const rootNamespaceMatch = content.match(/<RootNamespace>(.*?)<\/RootNamespace>/);
-    if (rootNamespaceMatch && rootNamespaceMatch[1].trim()) {
-        return rootNamespaceMatch[1].trim();
-    }
+    private finishGroup(group: DefinitionGroupState): void {
+        const conditional = group.condition !== undefined;
+        const selected = conditional ? parseConfigurationCondition(group.condition!) : undefined;
+        const configPlatform = selected && (selected.platform !== undefined
+            ? `${selected.configuration}|${selected.platform}`
+            : selected.configuration);
 
-    // Try ProjectName
-    const projectNameMatch = content.match(/<ProjectName>(.*?)<\/ProjectName>/);
-    if (projectNameMatch && projectNameMatch[1].trim()) {
-        return projectNameMatch[1].trim();
+        for (const type of BUILD_EVENT_ORDER) {
+            for (const event of group.events) {
+                if (event.type !== type) {
+                    continue;
+                }
+                if (conditional) {
+                    event.condition = configPlatform;
+                }
+                event.enabled = type === 'CustomBuild' ? true : group.useInBuild.get(type) ?? true;
+                (conditional ? this.conditionalEvents : this.unconditionalEvents).push(event);
+            }
+        }
     }
-
-    // Fall back to filename
-    const match = projectPath.match(/([^/\\]+)\.vcxproj$/);
-    return match ? match[1] : 'MyProject';
 }
 
 /**
@@ -544,10 +921,6 @@ function normalizePathSeparators(path: string): string {
     return path.replace(/\\/g, '/');
 }
 
-function stripConditionalItemDefinitionGroups(content: string): string {
-    return content.replace(/<ItemDefinitionGroup\s+Condition="[^"]*"[\s\S]*?<\/ItemDefinitionGroup>/g, '');
-}
-
 /**
  * Parse boolean values from vcxproj
  * @param value The string value to parse
@@ -580,95 +953,6 @@ function parseRuntimeLibrary(value: string): string | undefined {
     return allowed.has(normalized) ? normalized : undefined;
 }
 
-function extractIncludeDirectories(content: string): string[] {
-    const includeDirsMatches = content.matchAll(/<AdditionalIncludeDirectories>(.*?)<\/AdditionalIncludeDirectories>/g);
-    const includeDirs: string[] = [];
-    for (const match of includeDirsMatches) {
-        const dirs = match[1].split(';')
-            .map(d => d.trim())
-            .filter(d => d && d !== '%(AdditionalIncludeDirectories)')
-            .map(normalizePathSeparators);
-        for (const dir of dirs) {
-            if (!includeDirs.includes(dir)) {
-                includeDirs.push(dir);
-            }
-        }
-    }
-    return includeDirs;
-}
-
-function extractPreprocessorDefinitions(content: string): string[] {
-    const definesMatches = content.matchAll(/<PreprocessorDefinitions>(.*?)<\/PreprocessorDefinitions>/g);
-    const definitions: string[] = [];
-    for (const match of definesMatches) {
-        const defs = match[1].split(';')
-            .map(d => d.trim())
-            .filter(d => d && d !== '%(PreprocessorDefinitions)');
-        for (const def of defs) {
-            if (!definitions.includes(def)) {
-                definitions.push(def);
-            }
-        }
-    }
-    return definitions;
-}
-
-function extractLibraries(content: string): string[] {
-    const libMatches = content.matchAll(/<AdditionalDependencies>(.*?)<\/AdditionalDependencies>/g);
-    const libraries: string[] = [];
-    for (const match of libMatches) {
-        const libs = match[1].split(';')
-            .map(l => l.trim())
-            .filter(l => l && l !== '%(AdditionalDependencies)');
-        for (const lib of libs) {
-            const libName = lib.replace(/\.lib$/i, '');
-            if (!libraries.includes(libName)) {
-                libraries.push(libName);
-            }
-        }
-    }
-    return libraries;
-}
-
-function extractAdditionalLibraryDirectories(content: string): string[] {
-    const additionalLibraryDirectoriesMatches = content.matchAll(/<AdditionalLibraryDirectories>(.*?)<\/AdditionalLibraryDirectories>/g);
-    const directories: string[] = [];
-    for (const match of additionalLibraryDirectoriesMatches) {
-        const dirs = match[1].split(';')
-            .map(d => d.trim())
-            .filter(d => d && d !== '%(AdditionalLibraryDirectories)')
-            .map(normalizePathSeparators);
-        for (const dir of dirs) {
-            if (!directories.includes(dir)) {
-                directories.push(dir);
-            }
-        }
-    }
-    return directories;
-}
-
-/**
- * Extract additional options from XML content
- * @param content The XML content
- * @param regex The regex to match option blocks
- * @param macroToSkip Macro placeholder to skip
- * @returns List of options
- */
-function extractAdditionalOptions(content: string, regex: RegExp, macroToSkip: string): string[] {
-    const options: string[] = [];
-    const matches = content.matchAll(regex);
-    for (const match of matches) {
-        const value = match[1];
-        const parsed = parseAdditionalOptionsValue(value, macroToSkip);
-        for (const opt of parsed) {
-            if (!options.includes(opt)) {
-                options.push(opt);
-            }
-        }
-    }
-    return options;
-}
-
 /**
  * Parse the AdditionalOptions value into tokens
  * @param value The raw AdditionalOptions value
@@ -682,60 +966,6 @@ function parseAdditionalOptionsValue(value: string, macroToSkip: string): string
         .filter(token => token && token !== macroToSkip);
 }
 
-/**
- * Merge unique strings into an array
- * @param existing Existing list
- * @param incoming Incoming list
- * @returns Merged list
- */
-function mergeUniqueStrings(existing: string[] | undefined, incoming: string[]): string[] {
-    return mergeUnique(existing, incoming);
-}
-
-/**
- * Extract project references from vcxproj content
- * @param content The XML content
- * @returns List of project references
- */
-function extractProjectReferences(content: string): ProjectReference[] {
-    const references: ProjectReference[] = [];
-    const refMatches = content.matchAll(/<ProjectReference\s+Include="([^"]+)"[^>]*>([\s\S]*?)<\/ProjectReference>/g);
-    for (const match of refMatches) {
-        const ref: ProjectReference = {
-            path: normalizePathSeparators(match[1]),
-        };
-        const guidMatch = match[2].match(/<Project>\{?([^}<]+)\}?<\/Project>/);
-        if (guidMatch) {
-            ref.projectGuid = guidMatch[1];
-        }
-        const nameMatch = match[2].match(/<Name>(.*?)<\/Name>/);
-        if (nameMatch) {
-            ref.name = nameMatch[1];
-        } else {
-            // Infer name from path
-            const pathNameMatch = ref.path.match(/([^/\\]+)\.vcxproj$/);
-            if (pathNameMatch) {
-                ref.name = pathNameMatch[1];
-            }
-        }
-        references.push(ref);
-    }
-    // Also handle self-closing ProjectReference tags
-    const selfClosingRefs = content.matchAll(/<ProjectReference\s+Include="([^"]+)"\s*\/>/g);
-    for (const match of selfClosingRefs) {
-        const path = normalizePathSeparators(match[1]);
-        if (!references.some(r => r.path === path)) {
-            const ref: ProjectReference = { path };
-            const pathNameMatch = path.match(/([^/\\]+)\.vcxproj$/);
-            if (pathNameMatch) {
-                ref.name = pathNameMatch[1];
-            }
-            references.push(ref);
-        }
-    }
-    return references;
-}
-
 /**
  * Parse Visual Studio C language standard to numeric version
  * @param languageStandard The LanguageStandard_C value from vcxproj (e.g., "stdc11", "stdc17")
@@ -750,218 +980,6 @@ function parseCLanguageStandard(languageStandard: string): number | undefined {
     return standardMap[languageStandard.toLowerCase()];
 }
 
-function parseConfigurationSettings(content: string): Record<string, VcxprojConfigSettings> {
-    const configMap: Record<string, VcxprojConfigSettings> = {};
-    const conditionalGroups = content.matchAll(/<ItemDefinitionGroup\s+Condition="([^"]+)"[^>]*>([\s\S]*?)<\/ItemDefinitionGroup>/g);
-
-    for (const match of conditionalGroups) {
-        const condition = match[1];
-        const blockContent = match[2];
-        const configName = extractConfigName(condition);
-        if (!configName) {
-            continue;
-        }
-
-        const settings: VcxprojConfigSettings = {};
-        const includeDirs = extractIncludeDirectories(blockContent);
-        if (includeDirs.length > 0) {
-            settings.includeDirectories = includeDirs;
-        }
-
-        const definitions = extractPreprocessorDefinitions(blockContent);
-        if (definitions.length > 0) {
-            settings.preprocessorDefinitions = definitions;
-        }
-
-        const libraries = extractLibraries(blockContent);
-        if (libraries.length > 0) {
-            settings.libraries = libraries;
-        }
-
-        const additionalCompileOptions = extractAdditionalOptions(blockContent, /<ClCompile>[\s\S]*?<AdditionalOptions>(.*?)<\/AdditionalOptions>[\s\S]*?<\/ClCompile>/g, '%(AdditionalOptions)');
-        if (additionalCompileOptions.length > 0) {
-            settings.additionalCompileOptions = additionalCompileOptions;
-        }
-
-        const additionalLinkOptions = extractAdditionalOptions(blockContent, /<Link>[\s\S]*?<AdditionalOptions>(.*?)<\/AdditionalOptions>[\s\S]*?<\/Link>/g, '%(AdditionalOptions)');
-        if (additionalLinkOptions.length > 0) {
-            settings.additionalLinkOptions = additionalLinkOptions;
-        }
-
-        const additionalLibraryDirectories = extractAdditionalLibraryDirectories(blockContent);
-        if (additionalLibraryDirectories.length > 0) {
-            settings.additionalLibraryDirectories = additionalLibraryDirectories;
-        }
-
-        const warningLevelMatch = blockContent.match(/<WarningLevel>Level(\d)<\/WarningLevel>/);
-        if (warningLevelMatch) {
-            settings.warningLevel = parseInt(warningLevelMatch[1], 10);
-        }
-
-        const optimizationMatch = blockContent.match(/<Optimization>(.*?)<\/Optimization>/);
-        if (optimizationMatch) {
-            settings.optimization = optimizationMatch[1].trim();
-        }
-
-        const debugInfoMatch = blockContent.match(/<DebugInformationFormat>(.*?)<\/DebugInformationFormat>/);
-        if (debugInfoMatch) {
-            settings.debugInformationFormat = debugInfoMatch[1].trim();
-        }
-
-        const runtimeLibraryMatch = blockContent.match(/<RuntimeLibrary>(.*?)<\/RuntimeLibrary>/);
-        if (runtimeLibraryMatch) {
-            settings.runtimeLibrary = parseRuntimeLibrary(runtimeLibraryMatch[1]);
-        }
-
-        const exceptionHandlingMatch = blockContent.match(/<ExceptionHandling>(.*?)<\/ExceptionHandling>/);
-        if (exceptionHandlingMatch) {
-            settings.exceptionHandling = exceptionHandlingMatch[1].trim();
-        }
-
-        const rttiMatch = blockContent.match(/<RuntimeTypeInfo>(.*?)<\/RuntimeTypeInfo>/);
-        const rttiValue = rttiMatch ? parseBooleanValue(rttiMatch[1]) : undefined;
-        if (rttiValue !== undefined) {
-            settings.runtimeTypeInfo = rttiValue;
-        }
-
-        const treatWarningMatch = blockContent.match(/<TreatWarningAsError>(.*?)<\/TreatWarningAsError>/);
-        const treatWarningValue = treatWarningMatch ? parseBooleanValue(treatWarningMatch[1]) : undefined;
-        if (treatWarningValue !== undefined) {
-            settings.treatWarningAsError = treatWarningValue;
-        }
-
-        const mpMatch = blockContent.match(/<MultiProcessorCompilation>(.*?)<\/MultiProcessorCompilation>/);
-        const mpValue = mpMatch ? parseBooleanValue(mpMatch[1]) : undefined;
-        if (mpValue !== undefined) {
-            settings.multiProcessorCompilation = mpValue;
-        }
-
-        const fllMatch = blockContent.match(/<FunctionLevelLinking>(.*?)<\/FunctionLevelLinking>/);
-        const fllValue = fllMatch ? parseBooleanValue(fllMatch[1]) : undefined;
-        if (fllValue !== undefined) {
-            settings.functionLevelLinking = fllValue;
-        }
-
-        const ifMatch = blockContent.match(/<IntrinsicFunctions>(.*?)<\/IntrinsicFunctions>/);
-        const ifValue = ifMatch ? parseBooleanValue(ifMatch[1]) : undefined;
-        if (ifValue !== undefined) {
-            settings.intrinsicFunctions = ifValue;
-        }
-
-        const wpoMatch = blockContent.match(/<WholeProgramOptimization>(.*?)<\/WholeProgramOptimization>/);
-        const wpoValue = wpoMatch ? parseBooleanValue(wpoMatch[1]) : undefined;
-        if (wpoValue !== undefined) {
-            settings.wholeProgramOptimization = wpoValue;
-        }
-
-        const genDebugMatch = blockContent.match(/<GenerateDebugInformation>(.*?)<\/GenerateDebugInformation>/);
-        if (genDebugMatch) {
-            const val = genDebugMatch[1].trim();
-            const boolVal = parseBooleanValue(val);
-            settings.generateDebugInformation = boolVal !== undefined ? boolVal : val;
-        }
-
-        const conformanceMatch = blockContent.match(/<ConformanceMode>(.*?)<\/ConformanceMode>/);
-        const conformanceValue = conformanceMatch ? parseBooleanValue(conformanceMatch[1]) : undefined;
-        if (conformanceValue !== undefined) {
-            settings.conformanceMode = conformanceValue;
-        }
-
-        const rtcMatch = blockContent.match(/<BasicRuntimeChecks>(.*?)<\/BasicRuntimeChecks>/);
-        if (rtcMatch) {
-            settings.basicRuntimeChecks = rtcMatch[1].trim();
-        }
-
-        const dswMatch = blockContent.match(/<DisableSpecificWarnings>(.*?)<\/DisableSpecificWarnings>/);
-        if (dswMatch) {
-            const warnings = dswMatch[1].split(';').map(w => w.trim()).filter(w => w && w !== '%(DisableSpecificWarnings)');
-            if (warnings.length > 0) {
-                settings.disableSpecificWarnings = warnings;
-            }
-        }
-
-        const fssMatch = blockContent.match(/<FavorSizeOrSpeed>(.*?)<\/FavorSizeOrSpeed>/);
-        if (fssMatch) {
-            settings.favorSizeOrSpeed = fssMatch[1].trim();
-        }
-
-        const cfgMatch = blockContent.match(/<ControlFlowGuard>(.*?)<\/ControlFlowGuard>/);
-        if (cfgMatch) {
-            settings.controlFlowGuard = cfgMatch[1].trim() === 'Guard';
-        }
-
-        const comdatMatch = blockContent.match(/<EnableCOMDATFolding>(.*?)<\/EnableCOMDATFolding>/);
-        const comdatValue = comdatMatch ? parseBooleanValue(comdatMatch[1]) : undefined;
-        if (comdatValue !== undefined) {
-            settings.enableCOMDATFolding = comdatValue;
-        }
-
-        const optRefMatch = blockContent.match(/<OptimizeReferences>(.*?)<\/OptimizeReferences>/);
-        const optRefValue = optRefMatch ? parseBooleanValue(optRefMatch[1]) : undefined;
-        if (optRefValue !== undefined) {
-            settings.optimizeReferences = optRefValue;
-        }
-
-        const mapFileMatch = blockContent.match(/<GenerateMapFile>(.*?)<\/GenerateMapFile>/);
-        const mapFileValue = mapFileMatch ? parseBooleanValue(mapFileMatch[1]) : undefined;
-        if (mapFileValue !== undefined) {
-            settings.generateMapFile = mapFileValue;
-        }
-
-        if (Object.keys(settings).length > 0) {
-            const existing = configMap[configName];
-            configMap[configName] = existing ? mergeConfigSettings(existing, settings) : settings;
-        }
-    }
-
-    return configMap;
-}
-
-function extractConfigName(condition: string): string | undefined {
-    const configPlatformMatch = condition.match(/'\$\(Configuration\)\|\$\(Platform\)'\s*==\s*'([^|']+)\|[^']+'/);
-    if (configPlatformMatch) {
-        return configPlatformMatch[1];
-    }
-
-    const configOnlyMatch = condition.match(/'\$\(Configuration\)'\s*==\s*'([^']+)'/);
-    if (configOnlyMatch) {
-        return configOnlyMatch[1];
-    }
-
-    return undefined;
-}
-
-function mergeConfigSettings(base: VcxprojConfigSettings, incoming: VcxprojConfigSettings): VcxprojConfigSettings {
-    return {
-        includeDirectories: mergeUniqueStrings(base.includeDirectories, incoming.includeDirectories ?? []),
-        preprocessorDefinitions: mergeUniqueStrings(base.preprocessorDefinitions, incoming.preprocessorDefinitions ?? []),
-        libraries: mergeUniqueStrings(base.libraries, incoming.libraries ?? []),
-        additionalCompileOptions: mergeUniqueStrings(base.additionalCompileOptions, incoming.additionalCompileOptions ?? []),
-        additionalLinkOptions: mergeUniqueStrings(base.additionalLinkOptions, incoming.additionalLinkOptions ?? []),
-        additionalLibraryDirectories: mergeUniqueStrings(base.additionalLibraryDirectories, incoming.additionalLibraryDirectories ?? []),
-        warningLevel: incoming.warningLevel ?? base.warningLevel,
-        optimization: incoming.optimization ?? base.optimization,
-        debugInformationFormat: incoming.debugInformationFormat ?? base.debugInformationFormat,
-        runtimeLibrary: incoming.runtimeLibrary ?? base.runtimeLibrary,
-        exceptionHandling: incoming.exceptionHandling ?? base.exceptionHandling,
-        runtimeTypeInfo: incoming.runtimeTypeInfo ?? base.runtimeTypeInfo,
-        treatWarningAsError: incoming.treatWarningAsError ?? base.treatWarningAsError,
-        multiProcessorCompilation: incoming.multiProcessorCompilation ?? base.multiProcessorCompilation,
-        functionLevelLinking: incoming.functionLevelLinking ?? base.functionLevelLinking,
-        intrinsicFunctions: incoming.intrinsicFunctions ?? base.intrinsicFunctions,
-        wholeProgramOptimization: incoming.wholeProgramOptimization ?? base.wholeProgramOptimization,
-        generateDebugInformation: incoming.generateDebugInformation ?? base.generateDebugInformation,
-        conformanceMode: incoming.conformanceMode ?? base.conformanceMode,
-        basicRuntimeChecks: incoming.basicRuntimeChecks ?? base.basicRuntimeChecks,
-        disableSpecificWarnings: mergeUniqueStrings(base.disableSpecificWarnings, incoming.disableSpecificWarnings ?? []),
-        favorSizeOrSpeed: incoming.favorSizeOrSpeed ?? base.favorSizeOrSpeed,
-        controlFlowGuard: incoming.controlFlowGuard ?? base.controlFlowGuard,
-        enableCOMDATFolding: incoming.enableCOMDATFolding ?? base.enableCOMDATFolding,
-        optimizeReferences: incoming.optimizeReferences ?? base.optimizeReferences,
-        generateMapFile: incoming.generateMapFile ?? base.generateMapFile
-    };
-}
-
 /**
  * Parse Visual Studio language standard to numeric C++ standard version
  * @param languageStandard The LanguageStandard value from vcxproj (e.g., "stdcpp14", "stdcpp17", "stdcpp20", "stdcpplatest")
@@ -980,234 +998,3 @@ function parseLanguageStandard(languageStandard: string): number | undefined {
     const normalized = languageStandard.toLowerCase();
     return standardMap[normalized];
 }
-
-/**
- * Parse precompiled header configuration from vcxproj content
- * @param content The XML content of the vcxproj file
- * @returns PCH configuration or undefined if PCH is not used
- */
-function parsePchConfig(content: string): PchConfig | undefined {
-    const pchConfig: PchConfig = {
-        enabled: false,
-        excludedFiles: []
-    };
-
-    // Extract global PrecompiledHeader setting from ItemDefinitionGroup
-    // This is the default PCH setting applied to all files
-    const globalPchMatch = content.match(/<ItemDefinitionGroup[^>]*>[\s\S]*?<ClCompile>[\s\S]*?<PrecompiledHeader>([^<]+)<\/PrecompiledHeader>/);
-    const hasGlobalPch = globalPchMatch && globalPchMatch[1].trim().toLowerCase() === 'use';
-
-    // Extract global PrecompiledHeaderFile setting
-    const globalPchFileMatch = content.match(/<ItemDefinitionGroup[^>]*>[\s\S]*?<ClCompile>[\s\S]*?<PrecompiledHeaderFile>([^<]+)<\/PrecompiledHeaderFile>/);
-    if (globalPchFileMatch) {
-        pchConfig.headerFile = normalizePathSeparators(globalPchFileMatch[1].trim());
-    }
-
-    // Parse per-file PCH settings from ClCompile elements
-    // Pattern to match ClCompile blocks with Include attribute and content
-    const clCompileBlockRegex = /<ClCompile\s+Include="([^"]+)"\s*>([\s\S]*?)<\/ClCompile>/g;
-    let match;
-
-    while ((match = clCompileBlockRegex.exec(content)) !== null) {
-        const fileName = normalizePathSeparators(match[1]);
-        const blockContent = match[2];
-
-        // Check for PrecompiledHeader setting within this ClCompile block
-        const pchSettingMatch = blockContent.match(/<PrecompiledHeader>([^<]*)<\/PrecompiledHeader>/);
-        if (pchSettingMatch) {
-            const pchSetting = pchSettingMatch[1].trim().toLowerCase();
-
-            if (pchSetting === 'create') {
-                // This file creates the PCH
-                pchConfig.sourceFile = fileName;
-                pchConfig.enabled = true;
-            } else if (pchSetting === 'notusing') {
-                // This file is excluded from PCH
-                if (!pchConfig.excludedFiles.includes(fileName)) {
-                    pchConfig.excludedFiles.push(fileName);
-                }
-            } else if (pchSetting === 'use') {
-                // File explicitly uses PCH
-                pchConfig.enabled = true;
-            }
-        }
-
-        // Also check for per-file PrecompiledHeaderFile setting
-        const pchFileMatch = blockContent.match(/<PrecompiledHeaderFile>([^<]+)<\/PrecompiledHeaderFile>/);
-        if (pchFileMatch && !pchConfig.headerFile) {
-            pchConfig.headerFile = normalizePathSeparators(pchFileMatch[1].trim());
-        }
-    }
-
-    // If global PCH is enabled but no source file found yet, mark as enabled
-    if (hasGlobalPch) {
-        pchConfig.enabled = true;
-    }
-
-    // Only return PCH config if it's actually used
-    if (pchConfig.enabled || pchConfig.sourceFile || pchConfig.headerFile) {
-        return pchConfig;
-    }
-
-    return undefined;
-}
-
-/**
- * Parse build events from vcxproj content
- * @param content The XML content of the vcxproj file
- * @returns Array of build events or undefined if none found
- */
-function parseBuildEvents(content: string): BuildEvent[] | undefined {
-    const buildEvents: BuildEvent[] = [];
-
-    // Helper to extract command text (handles both single-line and multi-line CDATA or plain text)
-    const extractCommand = (eventContent: string): string | undefined => {
-        // Try single-line first
-        const singleLineMatch = eventContent.match(/<Command>(.*?)<\/Command>/);
-        if (singleLineMatch && singleLineMatch[1].trim()) {
-            return decodeXmlEntities(singleLineMatch[1].trim());
-        }
-        // Try multi-line
-        const multiLineMatch = eventContent.match(/<Command>([\s\S]*?)<\/Command>/);
-        if (multiLineMatch && multiLineMatch[1].trim()) {
-            return decodeXmlEntities(multiLineMatch[1].trim());
-        }
-        return undefined;
-    };
-
-    const extractMessage = (eventContent: string): string | undefined => {
-        const match = eventContent.match(/<Message>([\s\S]*?)<\/Message>/);
-        return match ? decodeXmlEntities(match[1].trim()) : undefined;
-    };
-
-    // Helper to check if an event type has UseInBuild=false within an ItemDefinitionGroup
-    const checkUseInBuild = (blockContent: string, eventType: string): boolean | undefined => {
-        const useInBuildMatch = blockContent.match(new RegExp(`<${eventType}EventUseInBuild>(.*?)<\\/${eventType}EventUseInBuild>`));
-        if (useInBuildMatch) {
-            return parseBooleanValue(useInBuildMatch[1]) ?? true;
-        }
-        return undefined;
-    };
-
-    // Parse build events from conditional ItemDefinitionGroups (configuration-specific)
-    const conditionalGroups = content.matchAll(/<ItemDefinitionGroup\s+Condition="([^"]+)"[^>]*>([\s\S]*?)<\/ItemDefinitionGroup>/g);
-    for (const groupMatch of conditionalGroups) {
-        const condition = groupMatch[1];
-        const blockContent = groupMatch[2];
-        const configPlatform = extractConfigPlatformFromCondition(condition);
-
-        for (const eventType of ['PreBuild', 'PreLink', 'PostBuild'] as const) {
-            const eventTag = `${eventType}Event`;
-            const eventRegex = new RegExp(`<${eventTag}>([\\s\\S]*?)<\\/${eventTag}>`, 'g');
-            const eventMatches = blockContent.matchAll(eventRegex);
-            for (const eventMatch of eventMatches) {
-                const command = extractCommand(eventMatch[1]);
-                const message = extractMessage(eventMatch[1]);
-                const useInBuild = checkUseInBuild(blockContent, eventType);
-                if (command) {
-                    const enabled = useInBuild !== undefined ? useInBuild : true;
-                    buildEvents.push({
-                        type: eventType,
-                        command,
-                        message,
-                        condition: configPlatform,
-                        enabled
-                    });
-                }
-            }
-        }
-
-        // CustomBuildStep
-        const customMatches = blockContent.matchAll(/<CustomBuildStep>([\s\S]*?)<\/CustomBuildStep>/g);
-        for (const customMatch of customMatches) {
-            const command = extractCommand(customMatch[1]);
-            const message = extractMessage(customMatch[1]);
-            const outputsMatch = customMatch[1].match(/<Outputs>(.*?)<\/Outputs>/);
-            if (command) {
-                const outputs = outputsMatch
-                    ? outputsMatch[1].split(';').map(o => o.trim()).filter(o => o)
-                    : undefined;
-                buildEvents.push({
-                    type: 'CustomBuild',
-                    command,
-                    message,
-                    outputs,
-                    condition: configPlatform,
-                    enabled: true
-                });
-            }
-        }
-    }
-
-    // Parse build events from unconditional ItemDefinitionGroups
-    const unconditionalGroups = content.matchAll(/<ItemDefinitionGroup\s*>([\s\S]*?)<\/ItemDefinitionGroup>/g);
-    for (const groupMatch of unconditionalGroups) {
-        const blockContent = groupMatch[1];
-
-        for (const eventType of ['PreBuild', 'PreLink', 'PostBuild'] as const) {
-            const eventTag = `${eventType}Event`;
-            const eventRegex = new RegExp(`<${eventTag}>([\\s\\S]*?)<\\/${eventTag}>`, 'g');
-            const eventMatches = blockContent.matchAll(eventRegex);
-            for (const eventMatch of eventMatches) {
-                const command = extractCommand(eventMatch[1]);
-                const message = extractMessage(eventMatch[1]);
-                const useInBuild = checkUseInBuild(blockContent, eventType);
-                if (command) {
-                    const enabled = useInBuild !== undefined ? useInBuild : true;
-                    if (!buildEvents.some(e => e.type === eventType && e.command === command && !e.condition)) {
-                        buildEvents.push({ type: eventType, command, message, enabled });
-                    }
-                }
-            }
-        }
-
-        const customMatches = blockContent.matchAll(/<CustomBuildStep>([\s\S]*?)<\/CustomBuildStep>/g);
-        for (const customMatch of customMatches) {
-            const command = extractCommand(customMatch[1]);
-            const message = extractMessage(customMatch[1]);
-            const outputsMatch = customMatch[1].match(/<Outputs>(.*?)<\/Outputs>/);
-            if (command) {
-                const outputs = outputsMatch
-                    ? outputsMatch[1].split(';').map(o => o.trim()).filter(o => o)
-                    : undefined;
-                if (!buildEvents.some(e => e.type === 'CustomBuild' && e.command === command && !e.condition)) {
-                    buildEvents.push({ type: 'CustomBuild', command, message, outputs, enabled: true });
-                }
-            }
-        }
-    }
-
-    return buildEvents.length > 0 ? buildEvents : undefined;
-}
-
-/**
- * Extract config|platform string from a condition attribute
- */
-function extractConfigPlatformFromCondition(condition: string): string | undefined {
-    const match = condition.match(/'\$\(Configuration\)\|\$\(Platform\)'\s*==\s*'([^']+)'/);
-    if (match) {
-        return match[1];
-    }
-    const configOnly = condition.match(/'\$\(Configuration\)'\s*==\s*'([^']+)'/);
-    if (configOnly) {
-        return configOnly[1];
-    }
-    return undefined;
-}
-
-/**
- * Decode common XML entities
- */
-function decodeXmlEntities(text: string): string {
-    return text
-        .replace(/&amp;/g, '&')
-        .replace(/&lt;/g, '<')
-        .replace(/&gt;/g, '>')
-        .replace(/&quot;/g, '"')
-        .replace(/&apos;/g, "'")
-        .replace(/&#xD;&#xA;/g, '\n')
-        .replace(/&#xD;/g, '\r')
-        .replace(/&#xA;/g, '\n')
-        .replace(/&#x([0-9a-fA-F]+);/g, (_, hex) => String.fromCharCode(parseInt(hex, 16)))
-        .replace(/&#(\d+);/g, (_, dec) => String.fromCharCode(parseInt(dec, 10)));
-}
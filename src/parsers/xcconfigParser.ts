@@ -0,0 +1,247 @@
+/**
+ * Xcode Build Settings
+ * Parses .xcconfig files and evaluates layered build settings the way Xcode
+ * does: each layer (project xcconfig, project buildSettings, target xcconfig,
+ * target buildSettings) overrides the one below, and `$(inherited)` expands
+ * to the value from below.
+ */
+
+/**
+ * `#include "file"` or `#include? "file"` (optional: no error when missing)
+ */
+export interface XcconfigInclude {
+    kind: 'include';
+    /** Path as written; relative paths are relative to the including file */
+    path: string;
+    optional: boolean;
+}
+
+/**
+ * `KEY[condition=value]... = value`
+ */
+export interface XcconfigAssignment {
+    kind: 'assignment';
+    key: string;
+    /** Conditions such as ['config', 'Debug'] or ['sdk', 'iphoneos*'] */
+    conditions: Array<[string, string]>;
+    value: string;
+}
+
+export type XcconfigEntry = XcconfigInclude | XcconfigAssignment;
+
+export interface XcconfigFile {
+    path: string;
+    /** Includes and assignments in file order */
+    entries: XcconfigEntry[];
+}
+
+const INCLUDE_REGEX = /^#include(\?)?\s*"([^"]*)"/;
+const ASSIGNMENT_REGEX = /^([A-Za-z_][A-Za-z0-9_]*)((?:\s*\[[^\]]*\])*)\s*=(.*)$/;
+const CONDITION_REGEX = /\[\s*([^=\]\s]+)\s*=\s*([^\]]*?)\s*\]/g;
+const INHERITED_REGEX = /\$[({]inherited[)}]/g;
+
+/**
+ * Parse an .xcconfig file
+ * Unrecognized lines are ignored, as Xcode only warns about them.
+ */
+export function parseXcconfig(content: string, filePath: string): XcconfigFile {
+    const entries: XcconfigEntry[] = [];
+    for (const rawLine of content.split(/\r?\n/)) {
+        const line = stripComment(rawLine).trim();
+        if (!line) {
+            continue;
+        }
+        const include = INCLUDE_REGEX.exec(line);
+        if (include) {
+            entries.push({ kind: 'include', path: include[2], optional: include[1] === '?' });
+            continue;
+        }
+        const assignment = ASSIGNMENT_REGEX.exec(line);
+        if (assignment) {
+            const conditions: Array<[string, string]> = [];
+            for (const condition of assignment[2].matchAll(CONDITION_REGEX)) {
+                conditions.push([condition[1], condition[2]]);
+            }
+            entries.push({
+                kind: 'assignment',
+                key: assignment[1],
+                conditions,
+                value: assignment[3].trim().replace(/;$/, '').trim()
+            });
+        }
+    }
+    return { path: filePath, entries };
+}
+
+/**
+ * Remove a `//` comment; `//` always starts a comment in xcconfig files
+ */
+function stripComment(line: string): string {
+    const index = line.indexOf('//');
+    return index >= 0 ? line.substring(0, index) : line;
+}
+
+/**
+ * Match an xcconfig condition value, which may use `*` wildcards
+ */
+function matchesPattern(pattern: string, value: string): boolean {
+    if (!pattern.includes('*')) {
+        return pattern === value;
+    }
+    const regex = new RegExp(`^${pattern.split('*').map(part => part.replace(/[.+?^${}()|[\]\\]/g, '\\$&')).join('.*')}$`);
+    return regex.test(value);
+}
+
+/**
+ * Whether an assignment applies to a configuration
+ * Only `config` conditions can be decided statically; assignments conditioned
+ * on sdk, arch or variant are left out.
+ */
+export function appliesToConfiguration(assignment: XcconfigAssignment, configName: string): boolean {
+    return assignment.conditions.every(([name, pattern]) => name === 'config' && matchesPattern(pattern, configName));
+}
+
+/**
+ * Split a setting value into items, honoring quotes and backslash escapes
+ */
+export function splitSettingValue(value: string): string[] {
+    const items: string[] = [];
+    let current = '';
+    let quote: string | undefined;
+    let hasItem = false;
+    for (let i = 0; i < value.length; i++) {
+        const ch = value[i];
+        if (ch === '\\' && i + 1 < value.length) {
+            current += value[++i];
+            hasItem = true;
+        } else if (quote) {
+            if (ch === quote) {
+                quote = undefined;
+            } else {
+                current += ch;
+            }
+        } else if (ch === '"' || ch === '\'') {
+            quote = ch;
+            hasItem = true;
+        } else if (/\s/.test(ch)) {
+            if (hasItem) {
+                items.push(current);
+                current = '';
+                hasItem = false;
+            }
+        } else {
+            current += ch;
+            hasItem = true;
+        }
+    }
+    if (hasItem) {
+        items.push(current);
+    }
+    return items;
+}
+
+/**
+ * Quote a list item so splitSettingValue returns it unchanged
+ */
+function quoteSettingItem(item: string): string {
+    return /[\s"'\\]/.test(item) ? `"${item.replace(/["\\]/g, '\\$&')}"` : item;
+}
+
+/**
+ * An evaluated setting: the string value, and its items for list settings
+ */
+interface SettingValue {
+    value: string;
+    items: string[];
+}
+
+/**
+ * Build settings after evaluating a stack of layers
+ * Layers are added with withAssignments/withDictionary, each returning a new
+ * instance so a shared lower layer (the project's) can be reused by every target.
+ */
+export class XcodeBuildSettings {
+    private readonly values: Map<string, SettingValue>;
+
+    constructor(values?: Map<string, SettingValue>) {
+        this.values = values ?? new Map();
+    }
+
+    /**
+     * String value of a setting
+     */
+    get(key: string): string | undefined {
+        return this.values.get(key)?.value;
+    }
+
+    /**
+     * Items of a list setting
+     * A single value without whitespace is one item, even if it contains quotes.
+     */
+    getList(key: string): string[] | undefined {
+        return this.values.get(key)?.items;
+    }
+
+    has(key: string): boolean {
+        return this.values.has(key);
+    }
+
+    keys(): IterableIterator<string> {
+        return this.values.keys();
+    }
+
+    /**
+     * Add a layer of xcconfig assignments, in order
+     * @param assignments Assignments with includes already inlined
+     * @param configName Configuration used to evaluate `[config=...]` conditions
+     */
+    withAssignments(assignments: readonly XcconfigAssignment[], configName: string): XcodeBuildSettings {
+        const values = new Map(this.values);
+        for (const assignment of assignments) {
+            if (appliesToConfiguration(assignment, configName)) {
+                values.set(assignment.key, evaluateString(assignment.value, values.get(assignment.key)));
+            }
+        }
+        return new XcodeBuildSettings(values);
+    }
+
+    /**
+     * Add a layer from a pbxproj buildSettings dictionary
+     * Array values are lists; `$(inherited)` items splice in the inherited items.
+     */
+    withDictionary(settings: Readonly<Record<string, unknown>>): XcodeBuildSettings {
+        const values = new Map(this.values);
+        for (const key of Object.keys(settings)) {
+            const value = settings[key];
+            const inherited = values.get(key);
+            if (typeof value === 'string') {
+                values.set(key, evaluateString(value, inherited));
+            } else if (Array.isArray(value)) {
+                const items: string[] = [];
+                for (const item of value) {
+                    if (typeof item !== 'string') {
+                        continue;
+                    }
+                    if (item.trim() === '$(inherited)' || item.trim() === '${inherited}') {
+                        items.push(...(inherited?.items ?? []));
+                    } else {
+                        items.push(item.replace(INHERITED_REGEX, inherited?.value ?? ''));
+                    }
+                }
+                values.set(key, { value: items.map(quoteSettingItem).join(' '), items });
+            }
+        }
+        return new XcodeBuildSettings(values);
+    }
+}
+
+/**
+ * Evaluate a string value against the inherited one
+ */
+function evaluateString(raw: string, inherited: SettingValue | undefined): SettingValue {
+    const value = raw.replace(INHERITED_REGEX, inherited?.value ?? '').trim();
+    if (!/\s/.test(value)) {
+        return { value, items: value ? [value] : [] };
+    }
+    return { value, items: splitSettingValue(value) };
+}
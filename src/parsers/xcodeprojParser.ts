@@ -2,7 +2,8 @@
  * Xcode Project (xcodeproj) Parser
  * Parses .xcodeproj/project.pbxproj files to extract project configuration for CMake conversion
  * 
- * Xcode project files use a property list (plist) format with unique object IDs
+ * Xcode project files use an OpenStep property list (plist) format with unique object IDs;
+ * the file is parsed once into an object graph (see plistParser) and queried by ID and isa.
  * The main sections we care about:
  * - PBXProject: Root project configuration
  * - PBXNativeTarget: Build targets (app, library, etc.)
@@ -14,6 +15,9 @@
  */
 
 import { mergeUnique as mergeUniqueUtil } from '../utils/arrayUtils';
+import { posix } from 'path';
+import { PbxObject, PbxObjectGraph, PlistDictionary, plistArray, plistDictionary, plistString } from './plistParser';
+import { XcconfigAssignment, XcodeBuildSettings } from './xcconfigParser';
 
 /**
  * Shell script build phase (Run Script phase in Xcode)
@@ -123,15 +127,191 @@ export interface XcodeprojConfigSettings {
     treatWarningsAsErrors?: boolean;
 }
 
+/**
+ * Options for parsing an Xcode project
+ */
+export interface XcodeprojParseOptions {
+    /**
+     * Load a base configuration (.xcconfig) with its includes inlined; without
+     * it, base configurations are ignored
+     * @param xcconfigPath Absolute path with '/' separators
+     */
+    loadXcconfig?: (xcconfigPath: string) => XcconfigAssignment[] | undefined;
+}
+
 /**
  * Parse an Xcode project file content
+ * Only the first native target is converted; see parseXcodeprojTargets.
  * @param content The content of the project.pbxproj file
  * @param projectPath The path to the .xcodeproj directory (for relative path resolution)
+ * @param options Parse options
  * @returns Parsed project information
+ * @throws PlistParseError if the file is not a valid property list
  */
-export function parseXcodeproj(content: string, projectPath: string): XcodeprojProject {
+export function parseXcodeproj(content: string, projectPath: string, options: XcodeprojParseOptions = {}): XcodeprojProject {
+    const context = new XcodeProjectContext(PbxObjectGraph.parse(content), projectPath, options);
+
+    // Find the native target
+    const target = context.graph.getByIsa('PBXNativeTarget')[0];
+    if (!target) {
+        throw new Error('No native target found in Xcode project');
+    }
+    return parseNativeTarget(context, target);
+}
+
+/**
+ * Parse every native target of an Xcode project
+ * @param content The content of the project.pbxproj file
+ * @param projectPath The path to the .xcodeproj directory
+ * @param options Parse options
+ * @returns One entry per PBXNativeTarget, in the project's target order
+ * @throws PlistParseError if the file is not a valid property list
+ */
+export function parseXcodeprojTargets(content: string, projectPath: string, options: XcodeprojParseOptions = {}): XcodeprojProject[] {
+    const context = new XcodeProjectContext(PbxObjectGraph.parse(content), projectPath, options);
+    return getNativeTargets(context.graph).map(target => parseNativeTarget(context, target));
+}
+
+/**
+ * State shared by every target of a project: the object graph, the headers
+ * it references, and the project-level build settings of each configuration
+ */
+class XcodeProjectContext {
+    readonly graph: PbxObjectGraph;
+    readonly defaultName: string;
+    /** Directory containing the .xcodeproj, with '/' separators */
+    readonly projectDir: string;
+    private readonly options: XcodeprojParseOptions;
+    private headerFiles: string[] | undefined;
+    private readonly projectSettings = new Map<string, XcodeBuildSettings>();
+    /** Enclosing group ID of each group child */
+    private parents: Map<string, string> | undefined;
+
+    constructor(graph: PbxObjectGraph, projectPath: string, options: XcodeprojParseOptions) {
+        this.graph = graph;
+        this.defaultName = extractProjectName(projectPath);
+        this.projectDir = posix.dirname(projectPath.replace(/\\/g, '/'));
+        this.options = options;
+    }
+
+    /**
+     * Header files of every PBXFileReference
+     */
+    getProjectHeaderFiles(): string[] {
+        if (!this.headerFiles) {
+            this.headerFiles = [];
+            for (const fileRef of this.graph.getByIsa('PBXFileReference')) {
+                const filePath = plistString(fileRef, 'path');
+                if (filePath && isHeaderFile(filePath)) {
+                    this.headerFiles.push(filePath);
+                }
+            }
+        }
+        return this.headerFiles;
+    }
+
+    /**
+     * Evaluated settings of a target configuration: project base configuration,
+     * project buildSettings, target base configuration, target buildSettings
+     */
+    getTargetSettings(config: PbxObject, configName: string): XcodeBuildSettings {
+        return this.applyConfiguration(this.getProjectSettings(configName), config, configName);
+    }
+
+    private getProjectSettings(configName: string): XcodeBuildSettings {
+        let settings = this.projectSettings.get(configName);
+        if (!settings) {
+            const configList = this.graph.getRef(this.graph.get(this.graph.rootObjectId), 'buildConfigurationList');
+            const config = this.graph.getRefs(configList, 'buildConfigurations')
+                .find(item => plistString(item, 'name') === configName);
+            settings = config ? this.applyConfiguration(new XcodeBuildSettings(), config, configName) : new XcodeBuildSettings();
+            this.projectSettings.set(configName, settings);
+        }
+        return settings;
+    }
+
+    private applyConfiguration(base: XcodeBuildSettings, config: PbxObject, configName: string): XcodeBuildSettings {
+        let settings = base;
+        const xcconfigId = plistString(config, 'baseConfigurationReference');
+        if (xcconfigId !== undefined && this.options.loadXcconfig) {
+            const xcconfigPath = this.resolveFilePath(xcconfigId);
+            const assignments = xcconfigPath !== undefined ? this.options.loadXcconfig(xcconfigPath) : undefined;
+            if (assignments) {
+                settings = settings.withAssignments(assignments, configName);
+            }
+        }
+        return settings.withDictionary(plistDictionary(config, 'buildSettings') ?? {});
+    }
+
+    /**
+     * Absolute path of a file reference, following its enclosing groups
+     * @returns undefined for paths relative to the SDK, build products and the like
+     */
+    resolveFilePath(id: string, depth = 0): string | undefined {
+        const fileRef = this.graph.get(id);
+        if (!fileRef) {
+            return undefined;
+        }
+        const filePath = plistString(fileRef, 'path') ?? '';
+        const sourceTree = plistString(fileRef, 'sourceTree') ?? '<group>';
+        let baseDir: string | undefined;
+        if (sourceTree === '<absolute>') {
+            baseDir = '/';
+        } else if (sourceTree === 'SOURCE_ROOT') {
+            baseDir = this.getSourceRoot();
+        } else if (sourceTree === '<group>') {
+            // Groups nest; the main group has no parent and sits at the source root
+            const parentId = this.getParentId(id);
+            baseDir = parentId !== undefined && depth < 64 ? this.resolveFilePath(parentId, depth + 1) : this.getSourceRoot();
+        }
+        return baseDir !== undefined ? posix.normalize(posix.join(baseDir, filePath)) : undefined;
+    }
+
+    private getSourceRoot(): string {
+        const dirPath = plistString(this.graph.get(this.graph.rootObjectId), 'projectDirPath');
+        return dirPath ? posix.join(this.projectDir, dirPath) : this.projectDir;
+    }
+
+    private getParentId(id: string): string | undefined {
+        if (!this.parents) {
+            this.parents = new Map();
+            for (const isa of ['PBXGroup', 'PBXVariantGroup', 'XCVersionGroup']) {
+                for (const groupId of this.graph.getIdsByIsa(isa)) {
+                    for (const child of plistArray(this.graph.get(groupId), 'children') ?? []) {
+                        if (typeof child === 'string') {
+                            this.parents.set(child, groupId);
+                        }
+                    }
+                }
+            }
+        }
+        return this.parents.get(id);
+    }
+}
+
+/**
+ * Native targets in the order of PBXProject.targets, then any not listed there
+ */
+function getNativeTargets(graph: PbxObjectGraph): PbxObject[] {
+    const targets = graph.getRefs(graph.get(graph.rootObjectId), 'targets')
+        .filter(target => target.isa === 'PBXNativeTarget');
+    for (const target of graph.getByIsa('PBXNativeTarget')) {
+        if (!targets.includes(target)) {
+            targets.push(target);
+        }
+    }
+    return targets;
+}
+
+/**
+ * Convert one PBXNativeTarget
+ * @param context The project the target belongs to
+ * @param target The PBXNativeTarget object
+ */
+function parseNativeTarget(context: XcodeProjectContext, target: PbxObject): XcodeprojProject {
+    const graph = context.graph;
     const project: XcodeprojProject = {
-        name: extractProjectName(projectPath),
+        name: context.defaultName,
         type: 'Application',
         sourceFiles: [],
         headerFiles: [],
@@ -142,72 +322,41 @@ export function parseXcodeproj(content: string, projectPath: string): XcodeprojP
         frameworks: []
     };
 
-    // Parse the plist structure
-    const objects = extractObjectsSection(content);
-    
-    // Find the native target
-    const targetId = findFirstNativeTarget(objects);
-    if (!targetId) {
-        throw new Error('No native target found in Xcode project');
-    }
-
-    const target = objects[targetId];
-    if (!target) {
-        throw new Error('Target object not found');
-    }
-
     // Extract target name
-    const targetNameMatch = target.match(/name\s*=\s*([^;]+);/);
-    if (targetNameMatch) {
-        const name = unquoteString(targetNameMatch[1].trim());
-        if (name) {
-            project.name = name;
-        }
+    const targetName = plistString(target, 'name');
+    if (targetName) {
+        project.name = targetName;
     }
 
     // Determine product type
-    const productTypeMatch = target.match(/productType\s*=\s*"([^"]+)"/);
-    if (productTypeMatch) {
-        project.type = mapProductType(productTypeMatch[1]);
+    const productType = plistString(target, 'productType');
+    if (productType) {
+        project.type = mapProductType(productType);
     }
 
     // Extract build phases
-    const buildPhasesMatch = target.match(/buildPhases\s*=\s*\(([\s\S]*?)\);/);
-    if (buildPhasesMatch) {
-        const phaseIds = extractListItems(buildPhasesMatch[1]);
-        
-        for (const phaseId of phaseIds) {
-            const phase = objects[phaseId];
-            if (!phase) {
-                continue;
-            }
-
-            // Check if this is a sources build phase
-            if (phase.includes('PBXSourcesBuildPhase')) {
-                const files = extractBuildPhaseFiles(phase, objects);
-                for (const file of files) {
+    for (const phase of graph.getRefs(target, 'buildPhases')) {
+        switch (phase.isa) {
+            case 'PBXSourcesBuildPhase':
+                for (const file of extractBuildPhaseFiles(phase, graph)) {
                     if (isSourceFile(file)) {
                         project.sourceFiles.push(file);
                     } else if (isHeaderFile(file)) {
                         project.headerFiles.push(file);
                     }
                 }
-            }
+                break;
 
-            // Check if this is a headers build phase
-            if (phase.includes('PBXHeadersBuildPhase')) {
-                const files = extractBuildPhaseFiles(phase, objects);
-                for (const file of files) {
+            case 'PBXHeadersBuildPhase':
+                for (const file of extractBuildPhaseFiles(phase, graph)) {
                     if (isHeaderFile(file) && !project.headerFiles.includes(file)) {
                         project.headerFiles.push(file);
                     }
                 }
-            }
+                break;
 
-            // Check if this is a frameworks build phase
-            if (phase.includes('PBXFrameworksBuildPhase')) {
-                const frameworks = extractBuildPhaseFiles(phase, objects);
-                for (const frameworkPath of frameworks) {
+            case 'PBXFrameworksBuildPhase':
+                for (const frameworkPath of extractBuildPhaseFiles(phase, graph)) {
                     // Extract just the filename (basename) from the path
                     const basename = getBasename(frameworkPath);
                     if (basename.endsWith('.framework')) {
@@ -215,52 +364,37 @@ export function parseXcodeproj(content: string, projectPath: string): XcodeprojP
                         if (!project.frameworks.includes(frameworkName)) {
                             project.frameworks.push(frameworkName);
                         }
-                    } else if (basename.endsWith('.tbd')) {
-                        const libName = basename.replace(/^lib/, '').replace(/\.tbd$/, '');
-                        if (!project.libraries.includes(libName)) {
-                            project.libraries.push(libName);
-                        }
-                    } else if (basename.endsWith('.dylib')) {
-                        const libName = basename.replace(/^lib/, '').replace(/\.dylib$/, '');
-                        if (!project.libraries.includes(libName)) {
-                            project.libraries.push(libName);
-                        }
-                    } else if (basename.endsWith('.a')) {
-                        const libName = basename.replace(/^lib/, '').replace(/\.a$/, '');
+                    } else {
+                        const libName = /\.(tbd|dylib|a)$/.test(basename)
+                            ? basename.replace(/^lib/, '').replace(/\.(tbd|dylib|a)$/, '')
+                            : basename;
                         if (!project.libraries.includes(libName)) {
                             project.libraries.push(libName);
                         }
-                    } else {
-                        if (!project.libraries.includes(basename)) {
-                            project.libraries.push(basename);
-                        }
                     }
                 }
-            }
+                break;
 
-            // Check if this is a resources build phase
-            if (phase.includes('PBXResourcesBuildPhase')) {
-                const resources = extractBuildPhaseFiles(phase, objects);
-                for (const resource of resources) {
+            case 'PBXResourcesBuildPhase':
+                for (const resource of extractBuildPhaseFiles(phase, graph)) {
                     if (!project.resourceFiles.includes(resource)) {
                         project.resourceFiles.push(resource);
                     }
                 }
-            }
+                break;
 
-            // Check if this is a copy files build phase
-            if (phase.includes('PBXCopyFilesBuildPhase')) {
+            case 'PBXCopyFilesBuildPhase': {
                 if (!project.copyFilesPhases) {
                     project.copyFilesPhases = [];
                 }
-                const copyPhase = parseCopyFilesPhase(phase, objects);
+                const copyPhase = parseCopyFilesPhase(phase, graph);
                 if (copyPhase) {
                     project.copyFilesPhases.push(copyPhase);
                 }
+                break;
             }
 
-            // Check if this is a shell script build phase
-            if (phase.includes('PBXShellScriptBuildPhase')) {
+            case 'PBXShellScriptBuildPhase': {
                 if (!project.shellScriptPhases) {
                     project.shellScriptPhases = [];
                 }
@@ -268,177 +402,130 @@ export function parseXcodeproj(content: string, projectPath: string): XcodeprojP
                 if (scriptPhase) {
                     project.shellScriptPhases.push(scriptPhase);
                 }
+                break;
             }
         }
     }
 
     // Extract build configurations
-    const buildConfigListMatch = target.match(/buildConfigurationList\s*=\s*([A-F0-9]+)/);
-    if (buildConfigListMatch) {
-        const configListId = buildConfigListMatch[1];
-        const configList = objects[configListId];
-        
-        if (configList) {
-            const buildConfigsMatch = configList.match(/buildConfigurations\s*=\s*\(([\s\S]*?)\);/);
-            if (buildConfigsMatch) {
-                const configIds = extractListItems(buildConfigsMatch[1]);
-                project.configurations = {};
-                
-                for (const configId of configIds) {
-                    const config = objects[configId];
-                    if (!config) {
-                        continue;
-                    }
+    const configList = graph.getRef(target, 'buildConfigurationList');
+    if (configList && plistArray(configList, 'buildConfigurations')) {
+        project.configurations = {};
 
-                    const configNameMatch = config.match(/name\s*=\s*([^;]+);/);
-                    if (!configNameMatch) {
-                        continue;
-                    }
+        for (const config of graph.getRefs(configList, 'buildConfigurations')) {
+            const configName = plistString(config, 'name');
+            if (!configName) {
+                continue;
+            }
 
-                    const configName = unquoteString(configNameMatch[1].trim());
-                    const settings = extractBuildSettings(config);
-                    
-                    // Extract common settings from first config (or merge)
-                    if (!project.cxxStandard && settings.cxxStandard) {
-                        project.cxxStandard = settings.cxxStandard;
-                    }
-                    if (!project.cStandard && settings.cStandard) {
-                        project.cStandard = settings.cStandard;
-                    }
-                    if (!project.deploymentTarget && settings.deploymentTarget) {
-                        project.deploymentTarget = settings.deploymentTarget;
-                    }
-                    if (!project.iosDeploymentTarget && settings.iosDeploymentTarget) {
-                        project.iosDeploymentTarget = settings.iosDeploymentTarget;
-                    }
-                    if (!project.architecture && settings.architecture) {
-                        project.architecture = settings.architecture;
-                    }
-                    if (!project.productName && settings.productName) {
-                        project.productName = settings.productName;
-                    }
-                    if (!project.bundleIdentifier && settings.bundleIdentifier) {
-                        project.bundleIdentifier = settings.bundleIdentifier;
-                    }
-                    if (!project.infoPlistFile && settings.infoPlistFile) {
-                        project.infoPlistFile = settings.infoPlistFile;
-                    }
-                    if (project.enableModules === undefined && settings.enableModules !== undefined) {
-                        project.enableModules = settings.enableModules;
-                    }
-                    if (project.enableARC === undefined && settings.enableARC !== undefined) {
-                        project.enableARC = settings.enableARC;
-                    }
-                    if (!project.sdkRoot && settings.sdkRoot) {
-                        project.sdkRoot = settings.sdkRoot;
-                    }
-                    if (!project.cxxLibrary && settings.cxxLibrary) {
-                        project.cxxLibrary = settings.cxxLibrary;
-                    }
-                    if (project.deadCodeStripping === undefined && settings.deadCodeStripping !== undefined) {
-                        project.deadCodeStripping = settings.deadCodeStripping;
-                    }
-                    if (project.treatWarningsAsErrors === undefined && settings.treatWarningsAsErrors !== undefined) {
-                        project.treatWarningsAsErrors = settings.treatWarningsAsErrors;
-                    }
-                    if (!project.runpathSearchPaths && settings.runpathSearchPaths) {
-                        project.runpathSearchPaths = settings.runpathSearchPaths;
-                    }
+            const settings = extractBuildSettings(context.getTargetSettings(config, configName));
 
-                    // Store config-specific settings
-                    project.configurations[configName] = {
-                        includeDirectories: settings.includeDirectories,
-                        preprocessorDefinitions: settings.preprocessorDefinitions,
-                        additionalCompileOptions: settings.additionalCompileOptions,
-                        additionalLinkOptions: settings.additionalLinkOptions,
-                        additionalLibraryDirectories: settings.additionalLibraryDirectories,
-                        frameworkSearchPaths: settings.frameworkSearchPaths,
-                        optimization: settings.optimization,
-                        debugInformationFormat: settings.debugInformationFormat,
-                        deadCodeStripping: settings.deadCodeStripping,
-                        treatWarningsAsErrors: settings.treatWarningsAsErrors
-                    };
-
-                    // Merge common settings
-                    if (settings.includeDirectories) {
-                        project.includeDirectories = mergeUnique(project.includeDirectories, settings.includeDirectories);
-                    }
-                    if (settings.preprocessorDefinitions) {
-                        project.preprocessorDefinitions = mergeUnique(project.preprocessorDefinitions, settings.preprocessorDefinitions);
-                    }
-                    if (settings.frameworkSearchPaths) {
-                        project.frameworkSearchPaths = mergeUnique(project.frameworkSearchPaths ?? [], settings.frameworkSearchPaths);
-                    }
-                    if (settings.additionalCompileOptions) {
-                        project.additionalCompileOptions = mergeUnique(project.additionalCompileOptions ?? [], settings.additionalCompileOptions);
-                    }
-                    if (settings.additionalLinkOptions) {
-                        project.additionalLinkOptions = mergeUnique(project.additionalLinkOptions ?? [], settings.additionalLinkOptions);
-                    }
-                    if (settings.additionalLibraryDirectories) {
-                        project.additionalLibraryDirectories = mergeUnique(project.additionalLibraryDirectories ?? [], settings.additionalLibraryDirectories);
-                    }
-                }
+            // Extract common settings from first config (or merge)
+            if (!project.cxxStandard && settings.cxxStandard) {
+                project.cxxStandard = settings.cxxStandard;
+            }
+            if (!project.cStandard && settings.cStandard) {
+                project.cStandard = settings.cStandard;
+            }
+            if (!project.deploymentTarget && settings.deploymentTarget) {
+                project.deploymentTarget = settings.deploymentTarget;
+            }
+            if (!project.iosDeploymentTarget && settings.iosDeploymentTarget) {
+                project.iosDeploymentTarget = settings.iosDeploymentTarget;
+            }
+            if (!project.architecture && settings.architecture) {
+                project.architecture = settings.architecture;
+            }
+            if (!project.productName && settings.productName) {
+                project.productName = settings.productName;
+            }
+            if (!project.bundleIdentifier && settings.bundleIdentifier) {
+                project.bundleIdentifier = settings.bundleIdentifier;
+            }
+            if (!project.infoPlistFile && settings.infoPlistFile) {
+                project.infoPlistFile = settings.infoPlistFile;
+            }
+            if (project.enableModules === undefined && settings.enableModules !== undefined) {
+                project.enableModules = settings.enableModules;
+            }
+            if (project.enableARC === undefined && settings.enableARC !== undefined) {
+                project.enableARC = settings.enableARC;
+            }
+            if (!project.sdkRoot && settings.sdkRoot) {
+                project.sdkRoot = settings.sdkRoot;
+            }
+            if (!project.cxxLibrary && settings.cxxLibrary) {
+                project.cxxLibrary = settings.cxxLibrary;
+            }
+            if (project.deadCodeStripping === undefined && settings.deadCodeStripping !== undefined) {
+                project.deadCodeStripping = settings.deadCodeStripping;
+            }
+            if (project.treatWarningsAsErrors === undefined && settings.treatWarningsAsErrors !== undefined) {
+                project.treatWarningsAsErrors = settings.treatWarningsAsErrors;
+            }
+            if (!project.runpathSearchPaths && settings.runpathSearchPaths) {
+                project.runpathSearchPaths = settings.runpathSearchPaths;
+            }
+
+            // Store config-specific settings
+            project.configurations[configName] = {
+                includeDirectories: settings.includeDirectories,
+                preprocessorDefinitions: settings.preprocessorDefinitions,
+                additionalCompileOptions: settings.additionalCompileOptions,
+                additionalLinkOptions: settings.additionalLinkOptions,
+                additionalLibraryDirectories: settings.additionalLibraryDirectories,
+                frameworkSearchPaths: settings.frameworkSearchPaths,
+                optimization: settings.optimization,
+                debugInformationFormat: settings.debugInformationFormat,
+                deadCodeStripping: settings.deadCodeStripping,
+                treatWarningsAsErrors: settings.treatWarningsAsErrors
+            };
+
+            // Merge common settings
+            if (settings.includeDirectories) {
+                project.includeDirectories = mergeUnique(project.includeDirectories, settings.includeDirectories);
+            }
+            if (settings.preprocessorDefinitions) {
+                project.preprocessorDefinitions = mergeUnique(project.preprocessorDefinitions, settings.preprocessorDefinitions);
+            }
+            if (settings.frameworkSearchPaths) {
+                project.frameworkSearchPaths = mergeUnique(project.frameworkSearchPaths ?? [], settings.frameworkSearchPaths);
+            }
+            if (settings.additionalCompileOptions) {
+                project.additionalCompileOptions = mergeUnique(project.additionalCompileOptions ?? [], settings.additionalCompileOptions);
+            }
+            if (settings.additionalLinkOptions) {
+                project.additionalLinkOptions = mergeUnique(project.additionalLinkOptions ?? [], settings.additionalLinkOptions);
+            }
+            if (settings.additionalLibraryDirectories) {
+                project.additionalLibraryDirectories = mergeUnique(project.additionalLibraryDirectories ?? [], settings.additionalLibraryDirectories);
             }
         }
     }
 
-    // Also scan PBXFileReference entries for header files not part of any build phase
-    for (const [, definition] of Object.entries(objects)) {
-        if (definition.includes('isa = PBXFileReference')) {
-            const pathMatch = definition.match(/path\s*=\s*([^;]+);/);
-            if (pathMatch) {
-                const filePath = unquoteString(pathMatch[1].trim());
-                if (isHeaderFile(filePath) && !project.headerFiles.includes(filePath)) {
-                    project.headerFiles.push(filePath);
-                }
-            }
+    // Also add header files not part of any build phase
+    const headerFiles = new Set(project.headerFiles);
+    for (const filePath of context.getProjectHeaderFiles()) {
+        if (!headerFiles.has(filePath)) {
+            headerFiles.add(filePath);
+            project.headerFiles.push(filePath);
         }
     }
 
     // Extract target dependencies
-    const dependenciesMatch = target.match(/dependencies\s*=\s*\(([\s\S]*?)\);/);
-    if (dependenciesMatch) {
-        const depIds = extractListItems(dependenciesMatch[1]);
-        for (const depId of depIds) {
-            const dep = objects[depId];
-            if (!dep || !dep.includes('PBXTargetDependency')) {
-                continue;
+    for (const dep of graph.getRefs(target, 'dependencies')) {
+        if (dep.isa !== 'PBXTargetDependency') {
+            continue;
+        }
+        // Use the dependency name, or resolve the target through its proxy
+        const depName = plistString(dep, 'name')
+            ?? plistString(graph.getRef(graph.getRef(dep, 'targetProxy'), 'remoteGlobalIDString'), 'name');
+        if (depName !== undefined) {
+            if (!project.targetDependencies) {
+                project.targetDependencies = [];
             }
-            // Try to extract name from the dependency
-            const depNameMatch = dep.match(/name\s*=\s*([^;]+);/);
-            if (depNameMatch) {
-                if (!project.targetDependencies) {
-                    project.targetDependencies = [];
-                }
-                const depName = unquoteString(depNameMatch[1].trim());
-                if (depName && !project.targetDependencies.includes(depName)) {
-                    project.targetDependencies.push(depName);
-                }
-            } else {
-                // Try to resolve through the target proxy
-                const proxyMatch = dep.match(/targetProxy\s*=\s*([A-F0-9]+)/);
-                if (proxyMatch) {
-                    const proxy = objects[proxyMatch[1]];
-                    if (proxy) {
-                        const remoteTargetMatch = proxy.match(/remoteGlobalIDString\s*=\s*([A-F0-9]+)/);
-                        if (remoteTargetMatch) {
-                            const remoteTarget = objects[remoteTargetMatch[1]];
-                            if (remoteTarget) {
-                                const rtNameMatch = remoteTarget.match(/name\s*=\s*([^;]+);/);
-                                if (rtNameMatch) {
-                                    if (!project.targetDependencies) {
-                                        project.targetDependencies = [];
-                                    }
-                                    const depName = unquoteString(rtNameMatch[1].trim());
-                                    if (depName && !project.targetDependencies.includes(depName)) {
-                                        project.targetDependencies.push(depName);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
+            if (depName && !project.targetDependencies.includes(depName)) {
+                project.targetDependencies.push(depName);
             }
         }
     }
@@ -456,98 +543,6 @@ function extractProjectName(projectPath: string): string {
     return match ? match[1] : 'MyProject';
 }
 
-/**
- * Extract the objects section from the pbxproj file
- * The objects section is a dictionary mapping object IDs to their definitions
- * @param content The pbxproj file content
- * @returns Map of object ID to object definition
- */
-function extractObjectsSection(content: string): Record<string, string> {
-    // Find "objects = {" and use brace-counting to find the matching closing "}"
-    const objectsStart = content.match(/objects\s*=\s*\{/);
-    if (!objectsStart || objectsStart.index === undefined) {
-        return {};
-    }
-
-    const openBracePos = objectsStart.index + objectsStart[0].length;
-    let braceCount = 1;
-    let pos = openBracePos;
-    while (pos < content.length && braceCount > 0) {
-        if (content[pos] === '{') {
-            braceCount++;
-        } else if (content[pos] === '}') {
-            braceCount--;
-        }
-        pos++;
-    }
-
-    if (braceCount !== 0) {
-        return {};
-    }
-
-    const objectsContent = content.substring(openBracePos, pos - 1);
-    const objects: Record<string, string> = {};
-    
-    // Split by section comments or by object boundaries
-    // More robust: Look for patterns like "ID /* comment */ = { content };"
-    // We need to handle both single-line and multi-line object definitions
-    
-    // Strategy: Find all object IDs first, then extract their content
-    const idMatches = objectsContent.matchAll(/([A-F0-9]+)\s*\/\*.*?\*\/\s*=\s*\{/g);
-    const objectStarts: Array<{id: string; pos: number}> = [];
-    
-    for (const match of idMatches) {
-        if (match.index !== undefined) {
-            objectStarts.push({
-                id: match[1],
-                pos: match.index
-            });
-        }
-    }
-    
-    // For each object, extract its content until the matching closing brace
-    for (let i = 0; i < objectStarts.length; i++) {
-        const start = objectStarts[i];
-        const nextStart = i + 1 < objectStarts.length ? objectStarts[i + 1].pos : objectsContent.length;
-        
-        // Find the position after the opening brace
-        const openBracePos = objectsContent.indexOf('{', start.pos) + 1;
-        
-        // Find the matching closing brace within this object's range
-        let braceCount = 1;
-        let pos = openBracePos;
-        while (pos < nextStart && braceCount > 0) {
-            if (objectsContent[pos] === '{') {
-                braceCount++;
-            } else if (objectsContent[pos] === '}') {
-                braceCount--;
-            }
-            pos++;
-        }
-        
-        if (braceCount === 0) {
-            const definition = objectsContent.substring(openBracePos, pos - 1);
-            objects[start.id] = definition;
-        }
-    }
-
-    return objects;
-}
-
-/**
- * Find the first native target in the objects
- * @param objects The objects dictionary
- * @returns The ID of the first native target, or undefined
- */
-function findFirstNativeTarget(objects: Record<string, string>): string | undefined {
-    for (const [id, definition] of Object.entries(objects)) {
-        if (definition.includes('isa = PBXNativeTarget')) {
-            return id;
-        }
-    }
-    return undefined;
-}
-
 /**
  * Map Xcode product type to our project type
  * @param productType The Xcode product type string
@@ -571,77 +566,33 @@ function mapProductType(productType: string): 'Application' | 'StaticLibrary' |
 }
 
 /**
- * Extract list items from a parenthesized list
- * @param listContent The content between parentheses
- * @returns Array of item IDs or strings
+ * Extract the string items of an array value
+ * @param dictionary The object holding the array
+ * @param key The array key
+ * @returns Array of strings (nested arrays and dictionaries are skipped)
  */
-function extractListItems(listContent: string): string[] {
-    const items: string[] = [];
-    const itemRegex = /([A-F0-9]+|"[^"]*")/g;
-    let match;
-    
-    while ((match = itemRegex.exec(listContent)) !== null) {
-        items.push(match[1].replace(/"/g, ''));
-    }
-    
-    return items;
+function extractListItems(dictionary: PlistDictionary, key: string): string[] {
+    return (plistArray(dictionary, key) ?? []).filter((item): item is string => typeof item === 'string');
 }
 
 /**
  * Extract files from a build phase
- * @param phase The build phase object definition
- * @param objects All objects for reference lookup
+ * @param phase The build phase object
+ * @param graph The project object graph for reference lookup
  * @returns Array of file paths
  */
-function extractBuildPhaseFiles(phase: string, objects: Record<string, string>): string[] {
+function extractBuildPhaseFiles(phase: PbxObject, graph: PbxObjectGraph): string[] {
     const files: string[] = [];
-    const filesMatch = phase.match(/files\s*=\s*\(([\s\S]*?)\);/);
-    
-    if (!filesMatch) {
-        return files;
-    }
-
-    const fileIds = extractListItems(filesMatch[1]);
-    
-    for (const fileId of fileIds) {
-        const buildFile = objects[fileId];
-        if (!buildFile) {
-            continue;
-        }
-
-        // Extract file reference from build file
-        const fileRefMatch = buildFile.match(/fileRef\s*=\s*([A-F0-9]+)/);
-        if (!fileRefMatch) {
-            continue;
-        }
-
-        const fileRef = objects[fileRefMatch[1]];
-        if (!fileRef) {
-            continue;
-        }
-
-        // Extract path from file reference
-        const pathMatch = fileRef.match(/path\s*=\s*([^;]+);/);
-        if (pathMatch) {
-            const path = unquoteString(pathMatch[1].trim());
-            if (path) {
-                files.push(path);
-            }
+    for (const buildFile of graph.getRefs(phase, 'files')) {
+        // PBXBuildFile -> PBXFileReference
+        const filePath = plistString(graph.getRef(buildFile, 'fileRef'), 'path');
+        if (filePath) {
+            files.push(filePath);
         }
     }
-
     return files;
 }
 
-/**
- * Remove quotes from a string value
- * @param str The string that may be quoted
- * @returns The unquoted string
- */
-function unquoteString(str: string): string {
-    return str.replace(/^"(.*)"$/, '$1');
-}
-
 /**
  * Get the basename (last path component) from a file path
  * @param filePath The file path
@@ -671,11 +622,11 @@ function isHeaderFile(filename: string): boolean {
 }
 
 /**
- * Extract build settings from a configuration object
- * @param config The configuration object definition
+ * Extract the settings used for conversion from a configuration's evaluated build settings
+ * @param buildSettings Build settings with every layer applied
  * @returns Build settings
  */
-function extractBuildSettings(config: string): {
+function extractBuildSettings(buildSettings: XcodeBuildSettings): {
     cxxStandard?: number;
     cStandard?: number;
     deploymentTarget?: string;
@@ -701,132 +652,47 @@ function extractBuildSettings(config: string): {
     cxxLibrary?: string;
 } {
     const settings: ReturnType<typeof extractBuildSettings> = {};
+    const get = (key: string) => buildSettings.get(key)?.trim() || undefined;
+    const getBool = (key: string) => {
+        const value = get(key);
+        return value === undefined ? undefined : value === 'YES';
+    };
 
-    // Extract build settings section with flexible whitespace matching
-    const buildSettingsMatch = config.match(/buildSettings\s*=\s*\{([\s\S]*?)\n\s*\};/);
-    if (!buildSettingsMatch) {
-        return settings;
-    }
-
-    const buildSettingsContent = buildSettingsMatch[1];
-
-    // Extract C++ standard (CLANG_CXX_LANGUAGE_STANDARD)
-    const cxxStandardMatch = buildSettingsContent.match(/CLANG_CXX_LANGUAGE_STANDARD\s*=\s*"?([^";]+)"?;/);
-    if (cxxStandardMatch) {
-        settings.cxxStandard = parseCxxStandard(cxxStandardMatch[1].trim());
-    }
-
-    // Extract C standard (GCC_C_LANGUAGE_STANDARD)
-    const cStandardMatch = buildSettingsContent.match(/GCC_C_LANGUAGE_STANDARD\s*=\s*"?([^";]+)"?;/);
-    if (cStandardMatch) {
-        settings.cStandard = parseCStandard(cStandardMatch[1].trim());
-    }
-
-    // Extract deployment target (macOS)
-    const deploymentTargetMatch = buildSettingsContent.match(/MACOSX_DEPLOYMENT_TARGET\s*=\s*([^;]+);/);
-    if (deploymentTargetMatch) {
-        settings.deploymentTarget = unquoteString(deploymentTargetMatch[1].trim());
-    }
-
-    // Extract deployment target (iOS)
-    const iosDeploymentTargetMatch = buildSettingsContent.match(/IPHONEOS_DEPLOYMENT_TARGET\s*=\s*([^;]+);/);
-    if (iosDeploymentTargetMatch) {
-        settings.iosDeploymentTarget = unquoteString(iosDeploymentTargetMatch[1].trim());
-    }
-
-    // Extract architecture
-    const archMatch = buildSettingsContent.match(/ARCHS\s*=\s*([^;]+);/);
-    if (archMatch) {
-        settings.architecture = unquoteString(archMatch[1].trim());
-    }
-
-    // Extract product name
-    const productNameMatch = buildSettingsContent.match(/PRODUCT_NAME\s*=\s*"?([^";]+)"?;/);
-    if (productNameMatch) {
-        settings.productName = unquoteString(productNameMatch[1].trim());
-    }
-
-    // Extract bundle identifier
-    const bundleIdMatch = buildSettingsContent.match(/PRODUCT_BUNDLE_IDENTIFIER\s*=\s*"?([^";]+)"?;/);
-    if (bundleIdMatch) {
-        settings.bundleIdentifier = unquoteString(bundleIdMatch[1].trim());
-    }
-
-    // Extract Info.plist file
-    const infoPlistMatch = buildSettingsContent.match(/INFOPLIST_FILE\s*=\s*"?([^";]+)"?;/);
-    if (infoPlistMatch) {
-        settings.infoPlistFile = unquoteString(infoPlistMatch[1].trim());
-    }
-
-    // Extract enable modules
-    const enableModulesMatch = buildSettingsContent.match(/CLANG_ENABLE_MODULES\s*=\s*([^;]+);/);
-    if (enableModulesMatch) {
-        settings.enableModules = enableModulesMatch[1].trim() === 'YES';
-    }
-
-    // Extract ARC
-    const enableARCMatch = buildSettingsContent.match(/CLANG_ENABLE_OBJC_ARC\s*=\s*([^;]+);/);
-    if (enableARCMatch) {
-        settings.enableARC = enableARCMatch[1].trim() === 'YES';
-    }
-
-    // Extract optimization level (GCC_OPTIMIZATION_LEVEL)
-    const optimizationMatch = buildSettingsContent.match(/GCC_OPTIMIZATION_LEVEL\s*=\s*"?([^";]+)"?;/);
-    if (optimizationMatch) {
-        settings.optimization = optimizationMatch[1].trim();
-    }
-
-    // Extract debug information format
-    const debugInfoMatch = buildSettingsContent.match(/DEBUG_INFORMATION_FORMAT\s*=\s*"?([^";]+)"?;/);
-    if (debugInfoMatch) {
-        settings.debugInformationFormat = debugInfoMatch[1].trim();
-    }
-
-    // Extract header search paths (HEADER_SEARCH_PATHS) - handle both list and single value
-    settings.includeDirectories = extractBuildSettingListOrSingle(buildSettingsContent, 'HEADER_SEARCH_PATHS');
-
-    // Extract preprocessor definitions (GCC_PREPROCESSOR_DEFINITIONS) - handle both list and single value
-    settings.preprocessorDefinitions = extractBuildSettingListOrSingle(buildSettingsContent, 'GCC_PREPROCESSOR_DEFINITIONS');
-
-    // Extract other compiler flags (OTHER_CFLAGS, OTHER_CPLUSPLUSFLAGS)
-    settings.additionalCompileOptions = extractBuildSettingListOrSingle(buildSettingsContent, 'OTHER_CPLUSPLUSFLAGS')
-        ?? extractBuildSettingListOrSingle(buildSettingsContent, 'OTHER_CFLAGS');
-
-    // Extract linker flags (OTHER_LDFLAGS)
-    settings.additionalLinkOptions = extractBuildSettingListOrSingle(buildSettingsContent, 'OTHER_LDFLAGS');
-
-    // Extract library search paths (LIBRARY_SEARCH_PATHS)
-    settings.additionalLibraryDirectories = extractBuildSettingListOrSingle(buildSettingsContent, 'LIBRARY_SEARCH_PATHS');
-
-    // Extract framework search paths (FRAMEWORK_SEARCH_PATHS)
-    settings.frameworkSearchPaths = extractBuildSettingListOrSingle(buildSettingsContent, 'FRAMEWORK_SEARCH_PATHS');
-
-    // Extract SDKROOT
-    const sdkRootMatch = buildSettingsContent.match(/SDKROOT\s*=\s*"?([^";]+)"?;/);
-    if (sdkRootMatch) {
-        settings.sdkRoot = sdkRootMatch[1].trim();
-    }
-
-    // Extract LD_RUNPATH_SEARCH_PATHS
-    settings.runpathSearchPaths = extractBuildSettingListOrSingle(buildSettingsContent, 'LD_RUNPATH_SEARCH_PATHS');
-
-    // Extract DEAD_CODE_STRIPPING
-    const deadCodeMatch = buildSettingsContent.match(/DEAD_CODE_STRIPPING\s*=\s*([^;]+);/);
-    if (deadCodeMatch) {
-        settings.deadCodeStripping = deadCodeMatch[1].trim() === 'YES';
-    }
-
-    // Extract GCC_TREAT_WARNINGS_AS_ERRORS
-    const warningsAsErrorsMatch = buildSettingsContent.match(/GCC_TREAT_WARNINGS_AS_ERRORS\s*=\s*([^;]+);/);
-    if (warningsAsErrorsMatch) {
-        settings.treatWarningsAsErrors = warningsAsErrorsMatch[1].trim() === 'YES';
-    }
-
-    // Extract CLANG_CXX_LIBRARY
-    const cxxLibraryMatch = buildSettingsContent.match(/CLANG_CXX_LIBRARY\s*=\s*"?([^";]+)"?;/);
-    if (cxxLibraryMatch) {
-        settings.cxxLibrary = cxxLibraryMatch[1].trim();
-    }
+    // C++ standard (CLANG_CXX_LANGUAGE_STANDARD) and C standard (GCC_C_LANGUAGE_STANDARD)
+    const cxxStandard = get('CLANG_CXX_LANGUAGE_STANDARD');
+    if (cxxStandard) {
+        settings.cxxStandard = parseCxxStandard(cxxStandard);
+    }
+    const cStandard = get('GCC_C_LANGUAGE_STANDARD');
+    if (cStandard) {
+        settings.cStandard = parseCStandard(cStandard);
+    }
+
+    settings.deploymentTarget = get('MACOSX_DEPLOYMENT_TARGET');
+    settings.iosDeploymentTarget = get('IPHONEOS_DEPLOYMENT_TARGET');
+    settings.architecture = get('ARCHS');
+    settings.productName = get('PRODUCT_NAME');
+    settings.bundleIdentifier = get('PRODUCT_BUNDLE_IDENTIFIER');
+    settings.infoPlistFile = get('INFOPLIST_FILE');
+    settings.enableModules = getBool('CLANG_ENABLE_MODULES');
+    settings.enableARC = getBool('CLANG_ENABLE_OBJC_ARC');
+    settings.optimization = get('GCC_OPTIMIZATION_LEVEL');
+    settings.debugInformationFormat = get('DEBUG_INFORMATION_FORMAT');
+
+    // List settings may be either a list or a single value
+    settings.includeDirectories = extractBuildSettingListOrSingle(buildSettings, 'HEADER_SEARCH_PATHS');
+    settings.preprocessorDefinitions = extractBuildSettingListOrSingle(buildSettings, 'GCC_PREPROCESSOR_DEFINITIONS');
+    settings.additionalCompileOptions = extractBuildSettingListOrSingle(buildSettings, 'OTHER_CPLUSPLUSFLAGS')
+        ?? extractBuildSettingListOrSingle(buildSettings, 'OTHER_CFLAGS');
+    settings.additionalLinkOptions = extractBuildSettingListOrSingle(buildSettings, 'OTHER_LDFLAGS');
+    settings.additionalLibraryDirectories = extractBuildSettingListOrSingle(buildSettings, 'LIBRARY_SEARCH_PATHS');
+    settings.frameworkSearchPaths = extractBuildSettingListOrSingle(buildSettings, 'FRAMEWORK_SEARCH_PATHS');
+
+    settings.sdkRoot = get('SDKROOT');
+    settings.runpathSearchPaths = extractBuildSettingListOrSingle(buildSettings, 'LD_RUNPATH_SEARCH_PATHS');
+    settings.deadCodeStripping = getBool('DEAD_CODE_STRIPPING');
+    settings.treatWarningsAsErrors = getBool('GCC_TREAT_WARNINGS_AS_ERRORS');
+    settings.cxxLibrary = get('CLANG_CXX_LIBRARY');
 
     return settings;
 }
@@ -858,40 +724,24 @@ function parseCStandard(standard: string): number | undefined {
 }
 
 /**
- * Extract a build setting that can be either a list (parenthesized) or a single value
- * @param buildSettingsContent The build settings section content
+ * Extract a list build setting, which may have been written as a list or a single value
+ * @param buildSettings Build settings with every layer applied
  * @param key The setting key name
- * @returns Array of values, or undefined if not found
+ * @returns Array of values, or undefined if not set or empty (e.g. only $(inherited))
  */
-function extractBuildSettingListOrSingle(buildSettingsContent: string, key: string): string[] | undefined {
-    // Try list format first: KEY = (\n"value1",\n"value2",\n);
-    const listMatch = buildSettingsContent.match(new RegExp(key + '\\s*=\\s*\\(([\\s\\S]*?)\\);'));
-    if (listMatch) {
-        const items = extractListItems(listMatch[1]);
-        return items.length > 0 ? items : undefined;
-    }
-    
-    // Try single value format: KEY = "value"; or KEY = value;
-    const singleMatch = buildSettingsContent.match(new RegExp(key + '\\s*=\\s*"?([^";]+)"?;'));
-    if (singleMatch) {
-        const value = singleMatch[1].trim();
-        // Skip inherited values like $(inherited)
-        if (value && value !== '$(inherited)') {
-            return [value];
-        }
-    }
-    
-    return undefined;
+function extractBuildSettingListOrSingle(buildSettings: XcodeBuildSettings, key: string): string[] | undefined {
+    const items = buildSettings.getList(key);
+    return items && items.length > 0 ? items : undefined;
 }
 
 /**
  * Parse a copy files build phase
- * @param phase The copy files build phase object definition
- * @param objects All objects for reference lookup
+ * @param phase The copy files build phase object
+ * @param graph The project object graph for reference lookup
  * @returns Parsed copy files phase or undefined
  */
-function parseCopyFilesPhase(phase: string, objects: Record<string, string>): CopyFilesPhase | undefined {
-    const files = extractBuildPhaseFiles(phase, objects);
+function parseCopyFilesPhase(phase: PbxObject, graph: PbxObjectGraph): CopyFilesPhase | undefined {
+    const files = extractBuildPhaseFiles(phase, graph);
     if (files.length === 0) {
         return undefined;
     }
@@ -900,19 +750,19 @@ function parseCopyFilesPhase(phase: string, objects: Record<string, string>): Co
         files
     };
 
-    const nameMatch = phase.match(/name\s*=\s*([^;]+);/);
-    if (nameMatch) {
-        copyPhase.name = unquoteString(nameMatch[1].trim());
+    const name = plistString(phase, 'name');
+    if (name !== undefined) {
+        copyPhase.name = name;
     }
 
-    const dstSubfolderSpecMatch = phase.match(/dstSubfolderSpec\s*=\s*(\d+);/);
-    if (dstSubfolderSpecMatch) {
-        copyPhase.dstSubfolderSpec = parseInt(dstSubfolderSpecMatch[1], 10);
+    const dstSubfolderSpec = plistString(phase, 'dstSubfolderSpec');
+    if (dstSubfolderSpec !== undefined && /^\d+$/.test(dstSubfolderSpec)) {
+        copyPhase.dstSubfolderSpec = parseInt(dstSubfolderSpec, 10);
     }
 
-    const dstPathMatch = phase.match(/dstPath\s*=\s*"?([^";]*)"?;/);
-    if (dstPathMatch) {
-        copyPhase.dstPath = dstPathMatch[1].trim();
+    const dstPath = plistString(phase, 'dstPath');
+    if (dstPath !== undefined) {
+        copyPhase.dstPath = dstPath.trim();
     }
 
     return copyPhase;
@@ -930,23 +780,12 @@ function mergeUnique(arr1: string[], arr2: string[]): string[] {
 
 /**
  * Parse a shell script build phase
- * @param phase The shell script build phase object definition
+ * @param phase The shell script build phase object
  * @returns Parsed shell script phase or undefined
  */
-function parseShellScriptPhase(phase: string): ShellScriptPhase | undefined {
-    // Extract shell script
-    const shellScriptMatch = phase.match(/shellScript\s*=\s*"([^"\\]*(?:\\.[^"\\]*)*)"/);
-    if (!shellScriptMatch) {
-        return undefined;
-    }
-
-    const shellScript = shellScriptMatch[1]
-        .replace(/\\n/g, '\n')
-        .replace(/\\t/g, '\t')
-        .replace(/\\"/g, '"')
-        .replace(/\\\\/g, '\\')
-        .trim();
-
+function parseShellScriptPhase(phase: PbxObject): ShellScriptPhase | undefined {
+    // The plist parser has already decoded the escape sequences
+    const shellScript = plistString(phase, 'shellScript')?.trim();
     if (!shellScript) {
         return undefined;
     }
@@ -955,40 +794,29 @@ function parseShellScriptPhase(phase: string): ShellScriptPhase | undefined {
         shellScript
     };
 
-    // Extract name (optional)
-    const nameMatch = phase.match(/name\s*=\s*([^;]+);/);
-    if (nameMatch) {
-        scriptPhase.name = unquoteString(nameMatch[1].trim());
+    const name = plistString(phase, 'name');
+    if (name !== undefined) {
+        scriptPhase.name = name;
     }
 
-    // Extract shell path
-    const shellPathMatch = phase.match(/shellPath\s*=\s*([^;]+);/);
-    if (shellPathMatch) {
-        scriptPhase.shellPath = unquoteString(shellPathMatch[1].trim());
+    const shellPath = plistString(phase, 'shellPath');
+    if (shellPath !== undefined) {
+        scriptPhase.shellPath = shellPath;
     }
 
-    // Extract input paths
-    const inputPathsMatch = phase.match(/inputPaths\s*=\s*\(([\s\S]*?)\);/);
-    if (inputPathsMatch) {
-        const paths = extractListItems(inputPathsMatch[1]);
-        if (paths.length > 0) {
-            scriptPhase.inputPaths = paths;
-        }
+    const inputPaths = extractListItems(phase, 'inputPaths');
+    if (inputPaths.length > 0) {
+        scriptPhase.inputPaths = inputPaths;
     }
 
-    // Extract output paths
-    const outputPathsMatch = phase.match(/outputPaths\s*=\s*\(([\s\S]*?)\);/);
-    if (outputPathsMatch) {
-        const paths = extractListItems(outputPathsMatch[1]);
-        if (paths.length > 0) {
-            scriptPhase.outputPaths = paths;
-        }
+    const outputPaths = extractListItems(phase, 'outputPaths');
+    if (outputPaths.length > 0) {
+        scriptPhase.outputPaths = outputPaths;
     }
 
-    // Extract runOnlyForDeploymentPostprocessing
-    const runOnlyMatch = phase.match(/runOnlyForDeploymentPostprocessing\s*=\s*(\d+);/);
-    if (runOnlyMatch) {
-        scriptPhase.runOnlyForDeploymentPostprocessing = runOnlyMatch[1] !== '0';
+    const runOnly = plistString(phase, 'runOnlyForDeploymentPostprocessing');
+    if (runOnly !== undefined && /^\d+$/.test(runOnly)) {
+        scriptPhase.runOnlyForDeploymentPostprocessing = runOnly !== '0';
     }
 
     return scriptPhase;
@@ -0,0 +1,76 @@
+/**
+ * Xcode Workspace (xcworkspace) Parser
+ * Reads .xcworkspace/contents.xcworkspacedata to list the projects a
+ * workspace contains. Locations are `group:` (relative to the enclosing
+ * group), `container:` (relative to the directory holding the workspace),
+ * `absolute:` or `self:` (the project a workspace is embedded in).
+ */
+
+import { posix } from 'path';
+import { decodeXmlEntities, tokenizeXml } from './xmlTokenizer';
+
+/**
+ * Resolve a workspace location against its enclosing group directory
+ * @returns undefined for location types that do not name a file
+ */
+function resolveLocation(location: string, groupDir: string, containerDir: string, workspacePath: string): string | undefined {
+    const separator = location.indexOf(':');
+    if (separator < 0) {
+        return undefined;
+    }
+    const type = location.substring(0, separator);
+    const target = decodeXmlEntities(location.substring(separator + 1)).replace(/\\/g, '/');
+    switch (type) {
+        case 'group':
+            return posix.normalize(posix.join(groupDir, target));
+        case 'container':
+            return posix.normalize(posix.join(containerDir, target));
+        case 'absolute':
+            return posix.normalize(target);
+        case 'self':
+            // project.xcworkspace inside an .xcodeproj refers to that project
+            return posix.dirname(workspacePath);
+        default:
+            return undefined;
+    }
+}
+
+/**
+ * Parse an Xcode workspace
+ * @param content The content of contents.xcworkspacedata
+ * @param workspacePath Path of the .xcworkspace directory
+ * @returns Paths of the .xcodeproj directories in workspace order, with '/' separators
+ */
+export function parseXcworkspace(content: string, workspacePath: string): string[] {
+    const normalizedPath = workspacePath.replace(/\\/g, '/').replace(/\/$/, '');
+    const containerDir = posix.dirname(normalizedPath);
+    const projects: string[] = [];
+    const groupDirs: string[] = [containerDir];
+
+    tokenizeXml(content, {
+        onOpenTag: (name, attributes, selfClosing) => {
+            const groupDir = groupDirs[groupDirs.length - 1];
+            if (name === 'Group') {
+                const location = attributes.location !== undefined
+                    ? resolveLocation(attributes.location, groupDir, containerDir, normalizedPath)
+                    : undefined;
+                if (!selfClosing) {
+                    groupDirs.push(location ?? groupDir);
+                }
+            } else if (name === 'FileRef' && attributes.location !== undefined) {
+                const location = resolveLocation(attributes.location, groupDir, containerDir, normalizedPath);
+                if (location?.endsWith('.xcodeproj') && !projects.includes(location)) {
+                    projects.push(location);
+                }
+            }
+        },
+        onCloseTag: (name) => {
+            if (name === 'Group' && groupDirs.length > 1) {
+                groupDirs.pop();
+            }
+        },
+        onText: () => undefined
+    });
+
+    return projects;
+}
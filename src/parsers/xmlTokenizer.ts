@@ -0,0 +1,96 @@
+/**
+ * Streaming XML tokenizer
+ * A single forward pass over the document that reports start tags, end tags
+ * and text to a handler (SAX-style). Enough XML for MSBuild files: comments,
+ * processing instructions and DOCTYPE are skipped, CDATA is reported as text.
+ * Attribute values and text are passed through undecoded.
+ */
+
+export interface XmlHandler {
+    /**
+     * @param name Element name
+     * @param attributes Attribute values (raw)
+     * @param selfClosing True for `<Name ... />`; no onCloseTag follows
+     */
+    onOpenTag(name: string, attributes: Record<string, string>, selfClosing: boolean): void;
+    onCloseTag(name: string): void;
+    /**
+     * @param text Raw text between tags
+     * @param cdata True when the text came from a CDATA section
+     */
+    onText(text: string, cdata: boolean): void;
+}
+
+/**
+ * Tags, comments, CDATA sections and other markup
+ * Groups: 1 '/', 2 name, 3 attributes, 4 '/', 5 CDATA content
+ */
+const MARKUP_REGEX = /<(?:(\/?)([A-Za-z_][\w.:-]*)((?:[^>"'/]|\/(?!>)|"[^"]*"|'[^']*')*)(\/?)>|!--[\s\S]*?-->|!\[CDATA\[([\s\S]*?)\]\]>|[?!][^>]*>)/g;
+
+const ATTRIBUTE_REGEX = /([^\s=/]+)\s*=\s*(?:"([^"]*)"|'([^']*)')/g;
+
+/**
+ * Parse the attribute part of a start tag
+ * @param source Text between the element name and the closing '>'
+ */
+export function parseXmlAttributes(source: string): Record<string, string> {
+    const attributes: Record<string, string> = {};
+    if (source.indexOf('=') < 0) {
+        return attributes;
+    }
+    ATTRIBUTE_REGEX.lastIndex = 0;
+    let match: RegExpExecArray | null;
+    while ((match = ATTRIBUTE_REGEX.exec(source)) !== null) {
+        attributes[match[1]] = match[2] ?? match[3];
+    }
+    return attributes;
+}
+
+/**
+ * Decode common XML entities
+ */
+export function decodeXmlEntities(text: string): string {
+    return text
+        .replace(/&amp;/g, '&')
+        .replace(/&lt;/g, '<')
+        .replace(/&gt;/g, '>')
+        .replace(/&quot;/g, '"')
+        .replace(/&apos;/g, "'")
+        .replace(/&#xD;&#xA;/g, '\n')
+        .replace(/&#xD;/g, '\r')
+        .replace(/&#xA;/g, '\n')
+        .replace(/&#x([0-9a-fA-F]+);/g, (_, hex) => String.fromCharCode(parseInt(hex, 16)))
+        .replace(/&#(\d+);/g, (_, dec) => String.fromCharCode(parseInt(dec, 10)));
+}
+
+/**
+ * Tokenize an XML document, calling the handler for each token in order
+ * Malformed markup is reported as text rather than rejected.
+ */
+export function tokenizeXml(content: string, handler: XmlHandler): void {
+    const regex = new RegExp(MARKUP_REGEX.source, 'g');
+    let position = 0;
+    let match: RegExpExecArray | null;
+
+    while ((match = regex.exec(content)) !== null) {
+        if (match.index > position) {
+            handler.onText(content.substring(position, match.index), false);
+        }
+        position = regex.lastIndex;
+
+        const name = match[2];
+        if (name !== undefined) {
+            if (match[1]) {
+                handler.onCloseTag(name);
+            } else {
+                handler.onOpenTag(name, parseXmlAttributes(match[3]), match[4] === '/');
+            }
+        } else if (match[5] !== undefined) {
+            handler.onText(match[5], true);
+        }
+    }
+
+    if (position < content.length) {
+        handler.onText(content.substring(position), false);
+    }
+}
@@ -4,6 +4,7 @@
  * - Undefined variables
  * - Unmatched block pairs (if/endif, function/endfunction, etc.)
  * - Non-existent file paths
+ * - Build-performance issues (slow configure/rebuild patterns)
  */
 
 import * as vscode from 'vscode';
@@ -12,7 +13,25 @@ import * as path from 'path';
 import { parseVariables, parsePaths } from '../parsers';
 import { getVariableResolver } from '../services/variableResolver';
 import { isBuiltInVariable } from '../utils/cmakeBuiltins';
-import { findUnmatchedBlocks, findDeprecatedCommands } from '../utils/diagnosticUtils';
+import { estimateBytes, MemoryUsage } from '../utils/memoryEstimate';
+import {
+    findUnmatchedBlocks,
+    findDeprecatedCommands,
+    findBuildPerformanceIssues,
+    resolveBuildPerformanceSeverities,
+    BuildPerformanceSeverity,
+    DEFAULT_LARGE_TARGET_SOURCES
+} from '../utils/diagnosticUtils';
+
+/**
+ * Map build-performance severity settings to VS Code severities
+ */
+const SEVERITY_MAP: Record<Exclude<BuildPerformanceSeverity, 'off'>, vscode.DiagnosticSeverity> = {
+    error: vscode.DiagnosticSeverity.Error,
+    warning: vscode.DiagnosticSeverity.Warning,
+    information: vscode.DiagnosticSeverity.Information,
+    hint: vscode.DiagnosticSeverity.Hint
+};
 
 export class CMakeDiagnosticProvider implements vscode.Disposable {
     private diagnosticCollection: vscode.DiagnosticCollection;
@@ -129,6 +148,9 @@ export class CMakeDiagnosticProvider implements vscode.Disposable {
             this.checkDeprecatedCommands(document, text, diagnostics);
         }
         
+        // Check for build-performance issues
+        this.checkBuildPerformance(document, text, diagnostics, config);
+        
         // Check for non-existent paths (optional - can be slow)
         if (config.get<boolean>('diagnostics.nonExistentPaths', false)) {
             this.checkNonExistentPaths(document, text, diagnostics);
@@ -274,6 +296,50 @@ export class CMakeDiagnosticProvider implements vscode.Disposable {
         }
     }
     
+    /**
+     * Check for constructs that slow down configure or build times
+     */
+    private checkBuildPerformance(
+        document: vscode.TextDocument,
+        text: string,
+        diagnostics: vscode.Diagnostic[],
+        config: vscode.WorkspaceConfiguration
+    ): void {
+        const severities = resolveBuildPerformanceSeverities(
+            config.get<Record<string, string>>('diagnostics.buildPerformance', {})
+        );
+        if (Object.values(severities).every(severity => severity === 'off')) {
+            return;
+        }
+        
+        const resolver = getVariableResolver();
+        const folder = vscode.workspace.getWorkspaceFolder(document.uri);
+        const isSourceRoot = path.basename(document.fileName) === 'CMakeLists.txt'
+            && folder !== undefined
+            && path.dirname(document.uri.fsPath) === folder.uri.fsPath;
+        
+        const issues = findBuildPerformanceIssues(text, {
+            isSourceRoot,
+            largeTargetSources: config.get<number>('diagnostics.largeTargetSources', DEFAULT_LARGE_TARGET_SOURCES),
+            getListLength: (name) => resolver.getList(name)?.length
+        });
+        
+        for (const issue of issues) {
+            const severity = severities[issue.check];
+            if (severity === 'off') {
+                continue;
+            }
+            const range = new vscode.Range(
+                document.positionAt(issue.startIndex),
+                document.positionAt(issue.endIndex)
+            );
+            const diagnostic = new vscode.Diagnostic(range, issue.message, SEVERITY_MAP[severity]);
+            diagnostic.source = 'cmake';
+            diagnostic.code = issue.check;
+            diagnostics.push(diagnostic);
+        }
+    }
+    
     /**
      * Check for non-existent file paths
      */
@@ -318,6 +384,20 @@ export class CMakeDiagnosticProvider implements vscode.Disposable {
         }
     }
     
+    /**
+     * Diagnostics held in the collection and their approximate size
+     */
+    getMemoryUsage(): MemoryUsage {
+        const seen = new WeakSet<object>();
+        let entries = 0;
+        let bytes = 0;
+        this.diagnosticCollection.forEach((uri, diagnostics) => {
+            entries += diagnostics.length;
+            bytes += estimateBytes(uri.toString(), seen) + estimateBytes(diagnostics, seen);
+        });
+        return { entries, bytes };
+    }
+    
     /**
      * Clear all diagnostics
      */
@@ -79,16 +79,17 @@ export class CMakeDocumentLinkProvider implements vscode.DocumentLinkProvider {
                 const endPos = document.positionAt(match.endIndex);
                 const range = new vscode.Range(startPos, endPos);
                 
-                // For CMake lists (semicolon-separated), use command URI to show quick pick
-                const isList = resolved.resolved.includes(';');
+                // For CMake lists, use command URI to show quick pick
+                // List variables come with their items; other values fall back to splitting
+                const items = resolved.items
+                    ?? (resolved.resolved.includes(';') ? resolved.resolved.split(';') : undefined);
                 
                 let linkTarget: vscode.Uri;
                 let tooltip: string;
                 
-                if (isList) {
-                    const params = encodeURIComponent(JSON.stringify([resolved.resolved]));
+                if (items) {
+                    const params = encodeURIComponent(JSON.stringify([items]));
                     linkTarget = vscode.Uri.parse(`command:cmake-companion.openPath?${params}`);
-                    const items = resolved.resolved.split(';');
                     const existCount = items.filter(i => { try { return fs.existsSync(i.trim()); } catch { return false; } }).length;
                     tooltip = `${existCount}/${items.length} files found (ctrl + click to select)`;
                 } else if (resolved.exists) {
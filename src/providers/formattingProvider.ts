@@ -9,17 +9,56 @@ import {
     CMakeFormattingOptions,
     DEFAULT_OPTIONS,
     STYLE_PRESETS,
-    INDENT_INCREASE_COMMANDS,
-    INDENT_DECREASE_COMMANDS,
-    formatLine,
-    wrapLineIfNeeded,
+    createIndent,
+    formatCMakeLines,
     getIndentation
 } from '../utils/formattingUtils';
+import { computeLineEdits, LineTextEdit } from '../utils/diffUtils';
+import { getIndentModelService } from '../services/indentModelService';
+import { IndentModel } from '../utils/indentModel';
 
 // Re-export types for consumers
 export type { CMakeFormattingOptions } from '../utils/formattingUtils';
 export type { CMakeFormattingStyle } from '../utils/formattingUtils';
 
+/**
+ * Get formatting options from VS Code settings
+ * Supports style presets (default, google) with individual option overrides
+ */
+function getFormattingOptions(options: vscode.FormattingOptions): CMakeFormattingOptions {
+    const config = vscode.workspace.getConfiguration('cmake-companion');
+    
+    // Get the style preset (default or google)
+    const style = config.get<CMakeFormattingStyle>('formatting.style', 'google');
+    const baseOptions = STYLE_PRESETS[style] || DEFAULT_OPTIONS;
+    
+    // Allow individual overrides on top of the style preset
+    return {
+        tabSize: options.tabSize || baseOptions.tabSize,
+        insertSpaces: options.insertSpaces !== undefined ? options.insertSpaces : baseOptions.insertSpaces,
+        maxLineLength: config.get<number>('formatting.maxLineLength') ?? baseOptions.maxLineLength,
+        spaceAfterOpenParen: config.get<boolean>('formatting.spaceAfterOpenParen') ?? baseOptions.spaceAfterOpenParen,
+        spaceBeforeCloseParen: config.get<boolean>('formatting.spaceBeforeCloseParen') ?? baseOptions.spaceBeforeCloseParen,
+        uppercaseCommands: config.get<boolean>('formatting.uppercaseCommands') ?? baseOptions.uppercaseCommands,
+        danglingParenthesis: config.get<boolean>('formatting.danglingParenthesis') ?? baseOptions.danglingParenthesis
+    };
+}
+
+/**
+ * Convert line edits to VS Code text edits, shifting them by a line offset
+ */
+function toTextEdits(edits: LineTextEdit[], lineOffset = 0): vscode.TextEdit[] {
+    return edits.map(edit =>
+        vscode.TextEdit.replace(
+            new vscode.Range(
+                edit.startLine + lineOffset, edit.startCharacter,
+                edit.endLine + lineOffset, edit.endCharacter
+            ),
+            edit.newText
+        )
+    );
+}
+
 /**
  * Document Formatting Provider for CMake files
  */
@@ -33,121 +72,69 @@ export class CMakeDocumentFormattingProvider implements vscode.DocumentFormattin
         options: vscode.FormattingOptions,
         token: vscode.CancellationToken
     ): vscode.ProviderResult<vscode.TextEdit[]> {
-        const edits: vscode.TextEdit[] = [];
         const text = document.getText();
-        const lines = text.split('\n');
         
         // Get formatting options from VS Code settings
-        const formattingOptions = this.getFormattingOptions(options);
-        
-        // Track indentation level
-        let indentLevel = 0;
-        const formattedLines: string[] = [];
+        const formattingOptions = getFormattingOptions(options);
         
-        for (let i = 0; i < lines.length; i++) {
-            if (token.isCancellationRequested) {
-                return edits;
-            }
-            
-            const line = lines[i];
-            const trimmedLine = line.trim();
-            
-            // Handle empty lines
-            if (!trimmedLine) {
-                formattedLines.push('');
-                continue;
-            }
-            
-            // Check for indent decrease commands first
-            const commandMatch = trimmedLine.match(/^([a-zA-Z_][a-zA-Z0-9_]*)\s*\(/i);
-            const commandName = commandMatch ? commandMatch[1].toLowerCase() : null;
-            
-            // Decrease indent before certain commands
-            if (commandName && INDENT_DECREASE_COMMANDS.has(commandName)) {
-                indentLevel = Math.max(0, indentLevel - 1);
-            }
-            
-            // Format the line
-            const formattedLine = formatLine(trimmedLine, indentLevel, formattingOptions);
-            const wrappedLines = wrapLineIfNeeded(formattedLine, indentLevel, formattingOptions);
-            formattedLines.push(...wrappedLines);
-            
-            // Increase indent after certain commands
-            if (commandName && INDENT_INCREASE_COMMANDS.has(commandName)) {
-                indentLevel++;
-            }
+        // Pretty-print from the command AST
+        const formattedLines = formatCMakeLines(text, formattingOptions);
+        if (token.isCancellationRequested) {
+            return [];
         }
         
-        // Create a single edit that replaces the entire document
-        const fullRange = new vscode.Range(
-            document.positionAt(0),
-            document.positionAt(text.length)
-        );
-        
-        const formattedText = formattedLines.join('\n');
-        
-        // Only create edit if there are actual changes
-        if (formattedText !== text) {
-            edits.push(vscode.TextEdit.replace(fullRange, formattedText));
-        }
-        
-        return edits;
-    }
-    
-    /**
-     * Get formatting options from VS Code settings
-     * Supports style presets (default, google) with individual option overrides
-     */
-    private getFormattingOptions(options: vscode.FormattingOptions): CMakeFormattingOptions {
-        const config = vscode.workspace.getConfiguration('cmake-companion');
-        
-        // Get the style preset (default or google)
-        const style = config.get<CMakeFormattingStyle>('formatting.style', 'google');
-        const baseOptions = STYLE_PRESETS[style] || DEFAULT_OPTIONS;
-        
-        // Allow individual overrides on top of the style preset
-        return {
-            tabSize: options.tabSize || baseOptions.tabSize,
-            insertSpaces: options.insertSpaces !== undefined ? options.insertSpaces : baseOptions.insertSpaces,
-            maxLineLength: config.get<number>('formatting.maxLineLength') ?? baseOptions.maxLineLength,
-            spaceAfterOpenParen: config.get<boolean>('formatting.spaceAfterOpenParen') ?? baseOptions.spaceAfterOpenParen,
-            spaceBeforeCloseParen: config.get<boolean>('formatting.spaceBeforeCloseParen') ?? baseOptions.spaceBeforeCloseParen,
-            uppercaseCommands: config.get<boolean>('formatting.uppercaseCommands') ?? baseOptions.uppercaseCommands,
-            danglingParenthesis: config.get<boolean>('formatting.danglingParenthesis') ?? baseOptions.danglingParenthesis
-        };
+        // Diff against the current lines so only changed lines are touched
+        const currentLines = text.split(/\r?\n/);
+        const eol = document.eol === vscode.EndOfLine.CRLF ? '\r\n' : '\n';
+        return toTextEdits(computeLineEdits(currentLines, formattedLines, eol));
     }
-    
 }
 
 /**
  * Document Range Formatting Provider for CMake files
  */
 export class CMakeDocumentRangeFormattingProvider implements vscode.DocumentRangeFormattingEditProvider {
-    private documentFormatter = new CMakeDocumentFormattingProvider();
     
     /**
      * Provide formatting edits for a range in the document
+     * The range is widened to whole commands using the cached indent model,
+     * which also supplies the block depth at its start, so only the range is read.
      */
     provideDocumentRangeFormattingEdits(
         document: vscode.TextDocument,
-        _range: vscode.Range,
+        range: vscode.Range,
         options: vscode.FormattingOptions,
         token: vscode.CancellationToken
     ): vscode.ProviderResult<vscode.TextEdit[]> {
-        // Note: Currently formats the entire document for consistency.
-        // Range-only formatting is complex in CMake because indentation depends on
-        // the global context (e.g., being inside an if/foreach block).
-        // A more sophisticated implementation could parse the context and format
-        // only the selected range while maintaining correct relative indentation.
-        const fullEdits = this.documentFormatter.provideDocumentFormattingEdits(document, options, token);
+        const model = getIndentModelService().getModel(document);
+        const startLine = model.findCommandStart(range.start.line);
+        // A selection ending at column 0 does not include that line
+        const lastLine = range.end.character === 0 && range.end.line > range.start.line
+            ? range.end.line - 1
+            : range.end.line;
+        const endLine = model.findCommandEnd(lastLine);
+        
+        const currentLines: string[] = [];
+        for (let line = startLine; line <= endLine; line++) {
+            currentLines.push(document.lineAt(line).text);
+        }
+        
+        const initialIndent = Math.max(0, model.getDepthBefore(startLine));
+        const formattedLines = formatCMakeLines(currentLines.join('\n'), getFormattingOptions(options), initialIndent);
+        if (token.isCancellationRequested) {
+            return [];
+        }
         
-        return fullEdits;
+        const eol = document.eol === vscode.EndOfLine.CRLF ? '\r\n' : '\n';
+        return toTextEdits(computeLineEdits(currentLines, formattedLines, eol), startLine);
     }
 }
 
 /**
  * On-Type Formatting Provider for CMake files
  * Provides formatting as you type (e.g., auto-indent on newline)
+ * Indent levels come from the cached indent model, so only the edited lines
+ * are read regardless of document size.
  */
 export class CMakeOnTypeFormattingProvider implements vscode.OnTypeFormattingEditProvider {
     
@@ -166,70 +153,53 @@ export class CMakeOnTypeFormattingProvider implements vscode.OnTypeFormattingEdi
         options: vscode.FormattingOptions,
         _token: vscode.CancellationToken
     ): vscode.ProviderResult<vscode.TextEdit[]> {
+        const model = getIndentModelService().getModel(document);
+        const formattingOptions = getFormattingOptions(options);
         const edits: vscode.TextEdit[] = [];
         
-        if (ch === '\n') {
-            // Auto-indent on newline
-            const edit = this.handleNewline(document, position, options);
+        const addEdit = (line: number) => {
+            const edit = this.reindentLine(document, model, line, formattingOptions);
             if (edit) {
                 edits.push(edit);
             }
+        };
+        
+        if (ch === '\n') {
+            // A block-closing command completed just before Enter outdents too
+            if (position.line > 0 && model.getLineInfo(position.line - 1).leadingDecrease) {
+                addEdit(position.line - 1);
+            }
+            addEdit(position.line);
+        } else if (ch === ')') {
+            // Re-indent the line the closed command starts on (e.g. a finished endif())
+            addEdit(model.findCommandStart(position.line));
         }
         
         return edits;
     }
     
     /**
-     * Handle newline - adjust indentation based on previous line
+     * Replace a line's indentation with the level given by the indent model
      */
-    private handleNewline(
+    private reindentLine(
         document: vscode.TextDocument,
-        position: vscode.Position,
-        options: vscode.FormattingOptions
+        model: IndentModel,
+        line: number,
+        options: CMakeFormattingOptions
     ): vscode.TextEdit | null {
-        // Get the previous line
-        if (position.line === 0) {
+        const text = document.lineAt(line).text;
+        const level = model.getExpectedIndentLevel(line, text);
+        if (level === undefined) {
             return null;
         }
         
-        const prevLine = document.lineAt(position.line - 1);
-        const prevLineText = prevLine.text.trim();
-        
-        // Determine base indentation from previous line
-        const prevIndent = getIndentation(prevLine.text);
-        let newIndent = prevIndent;
-        
-        // Check if previous line ends with command that increases indent
-        const commandMatch = prevLineText.match(/^([a-zA-Z_][a-zA-Z0-9_]*)\s*\(/i);
-        if (commandMatch) {
-            const commandName = commandMatch[1].toLowerCase();
-            if (INDENT_INCREASE_COMMANDS.has(commandName)) {
-                const indentChar = options.insertSpaces ? ' '.repeat(options.tabSize) : '\t';
-                newIndent = prevIndent + indentChar;
-            }
-        }
-        
-        // Check current line for indent decrease commands
-        const currentLine = document.lineAt(position.line);
-        const currentLineText = currentLine.text.trim();
-        const currentCommandMatch = currentLineText.match(/^([a-zA-Z_][a-zA-Z0-9_]*)\s*\(/i);
-        if (currentCommandMatch) {
-            const commandName = currentCommandMatch[1].toLowerCase();
-            if (INDENT_DECREASE_COMMANDS.has(commandName)) {
-                // Decrease indent
-                const indentChar = options.insertSpaces ? ' '.repeat(options.tabSize) : '\t';
-                if (newIndent.length >= indentChar.length) {
-                    newIndent = newIndent.substring(indentChar.length);
-                }
-            }
-        }
-        
         // Only create edit if indentation needs to change
-        const currentIndent = getIndentation(currentLine.text);
+        const currentIndent = getIndentation(text);
+        const newIndent = createIndent(level, options);
         if (currentIndent !== newIndent) {
             const range = new vscode.Range(
-                position.line, 0,
-                position.line, currentIndent.length
+                line, 0,
+                line, currentIndent.length
             );
             return vscode.TextEdit.replace(range, newIndent);
         }
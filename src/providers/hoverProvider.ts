@@ -6,11 +6,44 @@
 import * as vscode from 'vscode';
 import * as path from 'path';
 import * as fs from 'fs';
-import { parsePaths, parseVariables, CMakePathMatch } from '../parsers';
+import {
+    parsePaths,
+    parseVariables,
+    CMakePathMatch,
+    findGeneratorExpressions,
+    GeneratorExpressionEvaluator,
+    GeneratorExpressionMatch,
+    DEFAULT_CONFIGURATIONS
+} from '../parsers';
 import { getVariableResolver } from '../services/variableResolver';
+import { getTargetIndex } from '../services/targetIndex';
 import { isBuiltInVariable, getBuiltInVariableType, isNonPathVariable } from '../utils/cmakeBuiltins';
+import { MemoryUsage } from '../utils/memoryEstimate';
 
-export class CMakeHoverProvider implements vscode.HoverProvider {
+export class CMakeHoverProvider implements vscode.HoverProvider, vscode.Disposable {
+    
+    /** Memoized generator expression results per (expression, config) */
+    private genexEvaluator = new GeneratorExpressionEvaluator({
+        getTargetProperty: (target, property) => getTargetIndex().getTargetProperty(target, property)
+    });
+    
+    private unsubscribe: () => void;
+    
+    constructor() {
+        // Memoized TARGET_PROPERTY results go stale when targets change
+        this.unsubscribe = getTargetIndex().onDidChange(() => this.genexEvaluator.clear());
+    }
+    
+    dispose(): void {
+        this.unsubscribe();
+    }
+    
+    /**
+     * Memoized generator expressions and their approximate size
+     */
+    getMemoryUsage(): MemoryUsage {
+        return this.genexEvaluator.getMemoryUsage();
+    }
     
     /**
      * Provide hover information for CMake paths
@@ -53,9 +86,89 @@ export class CMakeHoverProvider implements vscode.HoverProvider {
             }
         }
         
+        // Check if we're hovering over a generator expression (they never span lines)
+        const line = document.lineAt(position.line);
+        const lineOffset = document.offsetAt(line.range.start);
+        for (const genex of findGeneratorExpressions(line.text)) {
+            if (position.character >= genex.startIndex && position.character <= genex.endIndex) {
+                return this.createGeneratorExpressionHover(document, genex, lineOffset);
+            }
+        }
+        
+        // Check if we're hovering over a known target name
+        const wordRange = document.getWordRangeAtPosition(position, /[A-Za-z0-9_.+:-]+/);
+        if (wordRange) {
+            const word = document.getText(wordRange);
+            if (getTargetIndex().hasTarget(word)) {
+                return this.createTargetHover(word, wordRange);
+            }
+        }
+        
         return null;
     }
     
+    /**
+     * Create hover content for a target, showing its direct and transitive dependencies
+     */
+    private createTargetHover(name: string, range: vscode.Range): vscode.Hover {
+        const index = getTargetIndex();
+        const target = index.getTarget(name)!;
+        const dependencies = index.getDependencies(name);
+        const dependents = index.getDependents(name);
+        const list = (names: ReadonlySet<string>) =>
+            names.size === 0 ? '*(none)*' : Array.from(names).sort().map(n => `\`${n}\``).join(', ');
+        
+        const markdown = new vscode.MarkdownString();
+        markdown.isTrusted = true;
+        
+        const kind = target.libraryType ? `${target.libraryType.toLowerCase()} ${target.kind}` : target.kind;
+        markdown.appendMarkdown('**CMake Target**\n\n');
+        markdown.appendMarkdown(`**Name:** \`${name}\` (${kind}${target.imported ? ', imported' : ''})\n\n`);
+        const fileUri = vscode.Uri.file(target.file);
+        markdown.appendMarkdown(`**Defined in:** [${target.file}:${target.line}](${fileUri.toString()}#L${target.line})\n\n`);
+        markdown.appendMarkdown(`**Depends on:** ${list(dependencies)}\n\n`);
+        markdown.appendMarkdown(`**Used by:** ${list(dependents)}\n\n`);
+        markdown.appendMarkdown(
+            `📦 *Pulls in ${index.getTransitiveDependencies(name).size} target(s); ` +
+            `changes affect ${index.getTransitiveDependents(name).size} target(s)*`
+        );
+        
+        const cycle = index.getCycle(name);
+        if (cycle) {
+            markdown.appendMarkdown(`\n\n⚠️ **Dependency cycle:** ${cycle.concat(cycle[0]).join(' → ')}`);
+        }
+        
+        return new vscode.Hover(markdown, range);
+    }
+    
+    /**
+     * Create hover content for a generator expression, showing its value per configuration
+     */
+    private createGeneratorExpressionHover(
+        document: vscode.TextDocument,
+        genex: GeneratorExpressionMatch,
+        lineOffset: number
+    ): vscode.Hover {
+        const resolver = getVariableResolver();
+        const expanded = resolver.expandVariables(genex.expression);
+        const configs = resolver.getList('CMAKE_CONFIGURATION_TYPES') ?? DEFAULT_CONFIGURATIONS;
+        
+        const markdown = new vscode.MarkdownString();
+        markdown.isTrusted = true;
+        
+        markdown.appendMarkdown('**Generator Expression**\n\n');
+        markdown.appendMarkdown(`**Expression:** \`${genex.expression}\`\n\n`);
+        markdown.appendMarkdown('| Configuration | Value |\n|---|---|\n');
+        for (const [config, value] of this.genexEvaluator.evaluateAll(expanded, configs)) {
+            const display = value ? `\`${value.replace(/\|/g, '\\|')}\`` : '*(empty)*';
+            markdown.appendMarkdown(`| ${config} | ${display} |\n`);
+        }
+        
+        const startPos = document.positionAt(lineOffset + genex.startIndex);
+        const endPos = document.positionAt(lineOffset + genex.endIndex);
+        return new vscode.Hover(markdown, new vscode.Range(startPos, endPos));
+    }
+    
     /**
      * Create hover content for a CMake path
      */
@@ -102,12 +215,13 @@ export class CMakeHoverProvider implements vscode.HoverProvider {
         markdown.appendMarkdown('**CMake Path**\n\n');
         markdown.appendMarkdown(`**Original:** \`${match.fullPath}\`\n\n`);
         
-        // Check if resolved value is a CMake list (semicolon-separated)
-        const isList = resolved.resolved.includes(';');
+        // Check if resolved value is a CMake list (list variable or semicolon-separated)
+        const items = resolved.items
+            ?? (resolved.resolved.includes(';') ? resolved.resolved.split(';') : undefined);
+        const isList = items !== undefined;
         
-        if (isList) {
+        if (items) {
             // Multi-value path (CMake list) — check each file individually
-            const items = resolved.resolved.split(';');
             markdown.appendMarkdown('**Resolved:**\n\n');
             for (const item of items) {
                 const trimmed = item.trim();
@@ -259,8 +373,8 @@ export class CMakeHoverProvider implements vscode.HoverProvider {
         markdown.appendMarkdown(`**Name:** \`${variable.variableName}\`\n\n`);
         
         if (value !== undefined) {
-            // Format value - if it contains semicolons (CMake list), display as list
-            const valueDisplay = this.formatValueForDisplay(value);
+            // Format value - if it is a CMake list, display as list
+            const valueDisplay = this.formatValueForDisplay(value, resolver.getList(variable.variableName));
             markdown.appendMarkdown(`**Value:** ${valueDisplay}\n\n`);
             
             if (definition) {
@@ -299,12 +413,12 @@ export class CMakeHoverProvider implements vscode.HoverProvider {
 
     /**
      * Format a value for display in hover
-     * If the value contains semicolons (CMake list), display as a formatted list
+     * If the value is a CMake list, display as a formatted list
      */
-    private formatValueForDisplay(value: string): string {
-        // Check if this is a CMake list (contains semicolons)
+    private formatValueForDisplay(value: string, items?: readonly string[]): string {
+        // Check if this is a CMake list (list items, or contains semicolons)
         if (value.includes(';')) {
-            const items = value.split(';');
+            items = items ?? value.split(';');
             // Display as a formatted list with line breaks
             return '\n' + items.map(item => `- \`${item}\``).join('\n');
         }
@@ -6,3 +6,4 @@ export * from './formattingProvider';
 export * from './completionProvider';
 export * from './diagnosticProvider';
 export * from './foldingProvider';
+export * from './targetTreeProvider';
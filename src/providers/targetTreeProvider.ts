@@ -0,0 +1,83 @@
+/**
+ * Target Tree Provider
+ * Shows indexed CMake targets and their dependencies in the explorer
+ */
+
+import * as vscode from 'vscode';
+import { getTargetIndex } from '../services/targetIndex';
+
+export class CMakeTargetTreeItem extends vscode.TreeItem {
+    /** Target (or external library) name */
+    readonly targetName: string;
+
+    /** Targets on the path from the root, used to stop expanding cycles */
+    readonly ancestors: readonly string[];
+
+    constructor(targetName: string, ancestors: readonly string[]) {
+        const index = getTargetIndex();
+        const target = index.getTarget(targetName);
+        const inCycle = ancestors.includes(targetName);
+        const expandable = !inCycle && index.getDependencies(targetName).size > 0;
+        super(
+            targetName,
+            expandable ? vscode.TreeItemCollapsibleState.Collapsed : vscode.TreeItemCollapsibleState.None
+        );
+        this.targetName = targetName;
+        this.ancestors = ancestors;
+
+        if (!target) {
+            this.description = 'external';
+            this.iconPath = new vscode.ThemeIcon('package');
+            return;
+        }
+
+        const dependents = index.getTransitiveDependents(targetName).size;
+        this.description = inCycle ? 'cycle' : `${target.kind}, used by ${dependents}`;
+        this.tooltip = `${target.file}:${target.line}`;
+        this.iconPath = new vscode.ThemeIcon(
+            inCycle ? 'warning' : target.kind === 'executable' ? 'run' : target.kind === 'custom' ? 'gear' : 'library'
+        );
+        this.command = {
+            command: 'vscode.open',
+            title: 'Go to Target Definition',
+            arguments: [
+                vscode.Uri.file(target.file),
+                { selection: new vscode.Range(target.line - 1, 0, target.line - 1, 0) }
+            ]
+        };
+    }
+}
+
+export class CMakeTargetTreeProvider implements vscode.TreeDataProvider<CMakeTargetTreeItem>, vscode.Disposable {
+    private changeEmitter = new vscode.EventEmitter<CMakeTargetTreeItem | undefined>();
+    private unsubscribe: () => void;
+
+    readonly onDidChangeTreeData = this.changeEmitter.event;
+
+    constructor() {
+        this.unsubscribe = getTargetIndex().onDidChange(() => this.changeEmitter.fire(undefined));
+    }
+
+    getTreeItem(element: CMakeTargetTreeItem): vscode.TreeItem {
+        return element;
+    }
+
+    /**
+     * Top level lists all targets; each target expands to its direct dependencies
+     */
+    getChildren(element?: CMakeTargetTreeItem): CMakeTargetTreeItem[] {
+        const index = getTargetIndex();
+        if (!element) {
+            return index.getTargetNames().map(name => new CMakeTargetTreeItem(name, []));
+        }
+        const ancestors = element.ancestors.concat(element.targetName);
+        return Array.from(index.getDependencies(element.targetName))
+            .sort()
+            .map(name => new CMakeTargetTreeItem(name, ancestors));
+    }
+
+    dispose(): void {
+        this.unsubscribe();
+        this.changeEmitter.dispose();
+    }
+}
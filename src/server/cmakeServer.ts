@@ -0,0 +1,446 @@
+/**
+ * CMake language server
+ * Serves diagnostics, document/range formatting and folding ranges from the
+ * pure core (parsers, CoreVariableResolver, diagnostic/formatting/folding
+ * utilities) over an LSP connection, so analysis runs outside the editor's
+ * extension host.
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import { fileURLToPath } from 'url';
+import { CoreVariableResolver } from '../services/coreVariableResolver';
+import {
+    CMakeFormattingOptions,
+    CMakeFormattingStyle,
+    DEFAULT_OPTIONS,
+    STYLE_PRESETS,
+    formatCMakeLines
+} from '../utils/formattingUtils';
+import { computeLineEdits } from '../utils/diffUtils';
+import { findMultiLineCommands, findCommentBlocks, findBlockPairs } from '../utils/foldingUtils';
+import { lintCMakeText, LintSeverity } from '../utils/lintUtils';
+import { CancellationToken, JsonRpcConnection } from './jsonRpc';
+import { Range, ServerTextDocument, TextDocumentContentChange } from './textDocuments';
+
+/**
+ * Settings sent by the client, mirroring the cmake-companion configuration section
+ */
+export interface ServerSettings {
+    formatting?: Partial<CMakeFormattingOptions> & { style?: string };
+    diagnostics?: {
+        enabled?: boolean;
+        undefinedVariables?: boolean;
+        unmatchedBlocks?: boolean;
+        deprecatedCommands?: boolean;
+        buildPerformance?: Record<string, string>;
+        largeTargetSources?: number;
+        nonExistentPaths?: boolean;
+    };
+    customVariables?: Record<string, string>;
+    environmentVariables?: Record<string, string>;
+}
+
+interface TextEdit {
+    range: Range;
+    newText: string;
+}
+
+interface FormattingParams {
+    textDocument: { uri: string };
+    options: { tabSize: number; insertSpaces: boolean };
+    range?: Range;
+}
+
+/**
+ * LSP DiagnosticSeverity values
+ */
+const LSP_SEVERITY: Record<LintSeverity, number> = {
+    error: 1,
+    warning: 2,
+    information: 3,
+    hint: 4
+};
+
+/**
+ * LSP TextDocumentSyncKind.Incremental
+ */
+const INCREMENTAL_SYNC = 2;
+
+/**
+ * Delay before re-validating an edited document
+ */
+export const VALIDATION_DELAY = 500;
+
+/**
+ * Merge formatting settings with the editor's indentation options
+ * Same precedence as the in-process formatter: style preset, then explicit settings.
+ */
+export function resolveFormattingOptions(
+    settings: ServerSettings['formatting'] = {},
+    editorOptions: { tabSize?: number; insertSpaces?: boolean } = {}
+): CMakeFormattingOptions {
+    const style = (settings.style ?? 'google') as CMakeFormattingStyle;
+    const base = STYLE_PRESETS[style] || DEFAULT_OPTIONS;
+    return {
+        tabSize: editorOptions.tabSize || base.tabSize,
+        insertSpaces: editorOptions.insertSpaces !== undefined ? editorOptions.insertSpaces : base.insertSpaces,
+        maxLineLength: settings.maxLineLength ?? base.maxLineLength,
+        spaceAfterOpenParen: settings.spaceAfterOpenParen ?? base.spaceAfterOpenParen,
+        spaceBeforeCloseParen: settings.spaceBeforeCloseParen ?? base.spaceBeforeCloseParen,
+        uppercaseCommands: settings.uppercaseCommands ?? base.uppercaseCommands,
+        danglingParenthesis: settings.danglingParenthesis ?? base.danglingParenthesis
+    };
+}
+
+/**
+ * File system path of a file: URI, or undefined for other schemes
+ */
+function uriToPath(uri: string): string | undefined {
+    try {
+        return uri.startsWith('file:') ? fileURLToPath(uri) : undefined;
+    } catch {
+        return undefined;
+    }
+}
+
+/**
+ * CMakeLists.txt and *.cmake files under the workspace folders, as the
+ * in-process resolver scans them: build directories are skipped and
+ * CMakeLists.txt files come parents first, followed by *.cmake files
+ */
+async function findWorkspaceCMakeFiles(folders: readonly string[]): Promise<string[]> {
+    const lists: string[] = [];
+    const modules: string[] = [];
+    const walk = async (dir: string): Promise<void> => {
+        let entries: fs.Dirent[];
+        try {
+            entries = await fs.promises.readdir(dir, { withFileTypes: true });
+        } catch {
+            return;
+        }
+        for (const entry of entries) {
+            const full = path.join(dir, entry.name);
+            if (entry.isDirectory()) {
+                if (entry.name !== 'build') {
+                    await walk(full);
+                }
+            } else if (entry.name === 'CMakeLists.txt') {
+                lists.push(full);
+            } else if (entry.name.endsWith('.cmake')) {
+                modules.push(full);
+            }
+        }
+    };
+    for (const folder of folders) {
+        await walk(folder);
+    }
+    const depth = (file: string) => file.split(path.sep).length;
+    return [...lists.sort((a, b) => depth(a) - depth(b)), ...modules];
+}
+
+export class CMakeLanguageServer {
+    private readonly connection: JsonRpcConnection;
+    private readonly onExit: (code: number) => void;
+    private documents = new Map<string, ServerTextDocument>();
+    private validationTimers = new Map<string, NodeJS.Timeout>();
+    private resolver = new CoreVariableResolver();
+    private settings: ServerSettings = {};
+    private workspaceFolders: string[] = [];
+    /** CMake files found under the workspace folders, in parse order */
+    private workspaceFiles: string[] = [];
+    /** Settles once the workspace files are parsed; validation waits for it */
+    private workspaceLoaded: Promise<void> = Promise.resolve();
+    private shutdownRequested = false;
+
+    /**
+     * @param connection Connection to the client
+     * @param onExit Called on the exit notification with the process exit code
+     */
+    constructor(connection: JsonRpcConnection, onExit: (code: number) => void) {
+        this.connection = connection;
+        this.onExit = onExit;
+
+        connection.onRequest('initialize', (params) => this.initialize(params as {
+            rootUri?: string | null;
+            workspaceFolders?: Array<{ uri: string }> | null;
+            initializationOptions?: ServerSettings;
+        }));
+        connection.onNotification('initialized', () => undefined);
+        connection.onRequest('shutdown', () => {
+            this.shutdownRequested = true;
+            return null;
+        });
+        connection.onNotification('exit', () => {
+            this.dispose();
+            this.onExit(this.shutdownRequested ? 0 : 1);
+        });
+        connection.onNotification('workspace/didChangeConfiguration', (params) => {
+            this.applySettings((params as { settings?: ServerSettings }).settings ?? {});
+            this.workspaceLoaded = this.workspaceLoaded.then(() => this.loadWorkspace());
+            for (const document of this.documents.values()) {
+                this.scheduleValidation(document, 0);
+            }
+        });
+
+        connection.onNotification('textDocument/didOpen', (params) => {
+            const { textDocument } = params as { textDocument: { uri: string; version: number; text: string } };
+            const document = new ServerTextDocument(textDocument.uri, textDocument.version, textDocument.text);
+            this.documents.set(textDocument.uri, document);
+            this.scheduleValidation(document, 0);
+        });
+        connection.onNotification('textDocument/didChange', (params) => {
+            const { textDocument, contentChanges } = params as {
+                textDocument: { uri: string; version: number };
+                contentChanges: TextDocumentContentChange[];
+            };
+            const document = this.documents.get(textDocument.uri);
+            if (document) {
+                document.applyChanges(contentChanges, textDocument.version);
+                this.scheduleValidation(document, VALIDATION_DELAY);
+            }
+        });
+        connection.onNotification('textDocument/didClose', (params) => {
+            const { uri } = (params as { textDocument: { uri: string } }).textDocument;
+            this.documents.delete(uri);
+            this.cancelValidation(uri);
+            this.connection.sendNotification('textDocument/publishDiagnostics', { uri, diagnostics: [] });
+        });
+
+        connection.onRequest('textDocument/formatting', (params, token) =>
+            this.format(params as FormattingParams, token));
+        connection.onRequest('textDocument/rangeFormatting', (params, token) =>
+            this.format(params as FormattingParams, token));
+        connection.onRequest('textDocument/foldingRange', (params) =>
+            this.foldingRanges((params as { textDocument: { uri: string } }).textDocument.uri));
+    }
+
+    /**
+     * Open document by URI (for tests and diagnostics)
+     */
+    getDocument(uri: string): ServerTextDocument | undefined {
+        return this.documents.get(uri);
+    }
+
+    dispose(): void {
+        for (const timer of this.validationTimers.values()) {
+            clearTimeout(timer);
+        }
+        this.validationTimers.clear();
+        this.documents.clear();
+    }
+
+    private initialize(params: {
+        rootUri?: string | null;
+        workspaceFolders?: Array<{ uri: string }> | null;
+        initializationOptions?: ServerSettings;
+    }): object {
+        const folders = params.workspaceFolders?.map(folder => folder.uri) ?? (params.rootUri ? [params.rootUri] : []);
+        this.workspaceFolders = folders.map(uriToPath).filter((folder): folder is string => folder !== undefined);
+        this.applySettings(params.initializationOptions ?? {});
+        this.workspaceLoaded = findWorkspaceCMakeFiles(this.workspaceFolders).then(files => {
+            this.workspaceFiles = files;
+            this.loadWorkspace();
+        });
+
+        return {
+            capabilities: {
+                textDocumentSync: { openClose: true, change: INCREMENTAL_SYNC },
+                documentFormattingProvider: true,
+                documentRangeFormattingProvider: true,
+                foldingRangeProvider: true
+            },
+            serverInfo: { name: 'cmake-companion' }
+        };
+    }
+
+    private applySettings(settings: ServerSettings): void {
+        this.settings = settings;
+        this.resolver.clear();
+        this.resolver.initialize(this.workspaceFolders);
+        this.resolver.loadEnvVariables(settings.environmentVariables ?? {});
+        this.resolver.loadCustomVariables(settings.customVariables ?? {});
+    }
+
+    /**
+     * Parse the workspace files into the freshly reset resolver, open documents
+     * taking the place of their file on disk
+     */
+    private loadWorkspace(): void {
+        const scanned = new Set(this.workspaceFiles);
+        for (const file of this.workspaceFiles) {
+            const content = this.readFile(file);
+            if (content !== undefined) {
+                this.resolver.parseFileContent(content, file);
+            }
+        }
+        for (const document of this.documents.values()) {
+            const filePath = uriToPath(document.uri);
+            if (filePath && !scanned.has(filePath)) {
+                this.parseVariables(document);
+            }
+        }
+    }
+
+    /**
+     * Re-parse a document's variables, dropping what its previous content assigned
+     * Other files that assigned the same variables are replayed from their open
+     * document, or from disk when they are not open.
+     */
+    private parseVariables(document: ServerTextDocument): void {
+        const filePath = uriToPath(document.uri);
+        if (filePath) {
+            this.resolver.reparseFileContent(document.getText(), filePath, file => this.readFile(file));
+        }
+    }
+
+    private readFile(filePath: string): string | undefined {
+        for (const document of this.documents.values()) {
+            if (uriToPath(document.uri) === filePath) {
+                return document.getText();
+            }
+        }
+        try {
+            return fs.readFileSync(filePath, 'utf8');
+        } catch {
+            return undefined;
+        }
+    }
+
+    private cancelValidation(uri: string): void {
+        const timer = this.validationTimers.get(uri);
+        if (timer) {
+            clearTimeout(timer);
+            this.validationTimers.delete(uri);
+        }
+    }
+
+    /**
+     * Validate after a delay, and not before the workspace is parsed; a newer
+     * edit restarts the delay
+     */
+    private scheduleValidation(document: ServerTextDocument, delay: number): void {
+        this.cancelValidation(document.uri);
+        this.validationTimers.set(document.uri, setTimeout(() => {
+            this.validationTimers.delete(document.uri);
+            void this.workspaceLoaded.then(() => {
+                if (this.documents.get(document.uri) === document && !this.validationTimers.has(document.uri)) {
+                    this.validate(document);
+                }
+            });
+        }, delay));
+    }
+
+    /**
+     * Lint a document and publish its diagnostics
+     */
+    validate(document: ServerTextDocument): void {
+        const diagnosticsSettings = this.settings.diagnostics ?? {};
+        if (diagnosticsSettings.enabled === false) {
+            this.connection.sendNotification('textDocument/publishDiagnostics', { uri: document.uri, diagnostics: [] });
+            return;
+        }
+
+        this.parseVariables(document);
+        const filePath = uriToPath(document.uri);
+        const isSourceRoot = filePath !== undefined
+            && path.basename(filePath) === 'CMakeLists.txt'
+            && this.workspaceFolders.includes(path.dirname(filePath));
+
+        const issues = lintCMakeText(document.getText(), {
+            undefinedVariables: diagnosticsSettings.undefinedVariables,
+            unmatchedBlocks: diagnosticsSettings.unmatchedBlocks,
+            deprecatedCommands: diagnosticsSettings.deprecatedCommands,
+            buildPerformance: diagnosticsSettings.buildPerformance,
+            largeTargetSources: diagnosticsSettings.largeTargetSources,
+            definedVariables: new Set(this.resolver.getVariableNames()),
+            getListLength: (name) => this.resolver.getList(name)?.length,
+            isSourceRoot,
+            pathExists: diagnosticsSettings.nonExistentPaths && filePath !== undefined
+                ? (expression) => this.pathExists(expression, path.dirname(filePath))
+                : undefined
+        });
+
+        this.connection.sendNotification('textDocument/publishDiagnostics', {
+            uri: document.uri,
+            version: document.version,
+            diagnostics: issues.map(issue => ({
+                range: {
+                    start: { line: issue.line, character: issue.column },
+                    end: { line: issue.endLine, character: issue.endColumn }
+                },
+                severity: LSP_SEVERITY[issue.severity],
+                code: issue.rule,
+                source: 'cmake',
+                message: issue.message,
+                // DiagnosticTag.Deprecated
+                tags: issue.rule === 'deprecated-command' ? [2] : undefined
+            }))
+        });
+    }
+
+    /**
+     * Whether a path expression exists, relative paths taken from the document's directory
+     * Same rules as the in-process path-not-found check: unresolved variables are skipped.
+     */
+    private pathExists(expression: string, documentDir: string): boolean | undefined {
+        const resolved = this.resolver.resolvePath(expression);
+        if (resolved.unresolvedVariables.length > 0) {
+            return undefined;
+        }
+        return fs.existsSync(path.resolve(documentDir, resolved.resolved));
+    }
+
+    /**
+     * Whole-document or range formatting, answered as minimal line edits
+     */
+    private format(params: FormattingParams, token: CancellationToken): TextEdit[] {
+        const document = this.documents.get(params.textDocument.uri);
+        if (!document) {
+            return [];
+        }
+        const options = resolveFormattingOptions(this.settings.formatting, params.options);
+        const eol = document.getText().includes('\r\n') ? '\r\n' : '\n';
+
+        let startLine = 0;
+        let endLine = document.lineCount - 1;
+        let initialIndent = 0;
+        if (params.range) {
+            const model = document.getIndentModel();
+            startLine = model.findCommandStart(params.range.start.line);
+            const lastLine = params.range.end.character === 0 && params.range.end.line > params.range.start.line
+                ? params.range.end.line - 1
+                : params.range.end.line;
+            endLine = model.findCommandEnd(Math.min(lastLine, document.lineCount - 1));
+            initialIndent = Math.max(0, model.getDepthBefore(startLine));
+        }
+
+        const currentLines: string[] = [];
+        for (let line = startLine; line <= endLine; line++) {
+            currentLines.push(document.lineAt(line));
+        }
+        const formattedLines = formatCMakeLines(currentLines.join('\n'), options, initialIndent);
+        if (token.isCancellationRequested) {
+            return [];
+        }
+
+        return computeLineEdits(currentLines, formattedLines, eol).map(edit => ({
+            range: {
+                start: { line: edit.startLine + startLine, character: edit.startCharacter },
+                end: { line: edit.endLine + startLine, character: edit.endCharacter }
+            },
+            newText: edit.newText
+        }));
+    }
+
+    private foldingRanges(uri: string): object[] {
+        const document = this.documents.get(uri);
+        if (!document) {
+            return [];
+        }
+        const lines = document.getText().split('\n');
+        const multiLine = findMultiLineCommands(lines);
+        const ranges = [...multiLine, ...findCommentBlocks(lines), ...findBlockPairs(lines, multiLine)];
+        return ranges.map(range => ({ startLine: range.start, endLine: range.end, kind: range.kind }));
+    }
+}
@@ -0,0 +1,19 @@
+/**
+ * Language server process entry point
+ * Started by the extension with `--stdio`; speaks LSP over stdin/stdout.
+ */
+
+import { JsonRpcConnection } from './jsonRpc';
+import { CMakeLanguageServer } from './cmakeServer';
+
+// stdout carries the protocol, so route stray logging to stderr
+console.log = (...args: unknown[]) => console.error(...args);
+console.info = console.log;
+
+const connection = new JsonRpcConnection(process.stdin, process.stdout);
+const server = new CMakeLanguageServer(connection, (code) => process.exit(code));
+connection.onClose(() => {
+    server.dispose();
+    process.exit(1);
+});
+connection.listen();
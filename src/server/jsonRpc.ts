@@ -0,0 +1,334 @@
+/**
+ * JSON-RPC 2.0 over a byte stream with LSP framing (Content-Length headers)
+ * Used by both the language server process and the extension-side client.
+ * Incoming requests can be cancelled with $/cancelRequest.
+ */
+
+import { Readable, Writable } from 'stream';
+
+export const ErrorCodes = {
+    ParseError: -32700,
+    InvalidRequest: -32600,
+    MethodNotFound: -32601,
+    InvalidParams: -32602,
+    InternalError: -32603,
+    ServerNotInitialized: -32002,
+    RequestCancelled: -32800
+} as const;
+
+export type RequestId = number | string;
+
+export interface ResponseErrorData {
+    code: number;
+    message: string;
+    data?: unknown;
+}
+
+export interface Message {
+    jsonrpc: '2.0';
+    id?: RequestId | null;
+    method?: string;
+    params?: unknown;
+    result?: unknown;
+    error?: ResponseErrorData;
+}
+
+/**
+ * Error returned to (or received from) the other side of a request
+ */
+export class ResponseError extends Error {
+    readonly code: number;
+    readonly data?: unknown;
+
+    constructor(code: number, message: string, data?: unknown) {
+        super(message);
+        this.code = code;
+        this.data = data;
+    }
+}
+
+/**
+ * Minimal cancellation token, compatible with vscode.CancellationToken
+ */
+export interface CancellationToken {
+    readonly isCancellationRequested: boolean;
+    onCancellationRequested(listener: () => void): unknown;
+}
+
+/**
+ * Cancellation state of one incoming request
+ */
+export class CancellationSource implements CancellationToken {
+    private cancelled = false;
+    private listeners: Array<() => void> = [];
+
+    get isCancellationRequested(): boolean {
+        return this.cancelled;
+    }
+
+    onCancellationRequested(listener: () => void): { dispose(): void } {
+        if (this.cancelled) {
+            listener();
+        } else {
+            this.listeners.push(listener);
+        }
+        return { dispose: () => { this.listeners = this.listeners.filter(l => l !== listener); } };
+    }
+
+    cancel(): void {
+        if (!this.cancelled) {
+            this.cancelled = true;
+            for (const listener of this.listeners) {
+                listener();
+            }
+            this.listeners = [];
+        }
+    }
+}
+
+/**
+ * Encode a message with its Content-Length header
+ */
+export function encodeMessage(message: Message): Buffer {
+    const body = Buffer.from(JSON.stringify(message), 'utf8');
+    return Buffer.concat([Buffer.from(`Content-Length: ${body.length}\r\n\r\n`, 'ascii'), body]);
+}
+
+/**
+ * Incremental decoder for Content-Length framed messages
+ */
+export class MessageDecoder {
+    private buffer = Buffer.alloc(0);
+    private readonly onMessage: (message: Message) => void;
+    private readonly onError: (error: Error) => void;
+
+    constructor(onMessage: (message: Message) => void, onError: (error: Error) => void = () => undefined) {
+        this.onMessage = onMessage;
+        this.onError = onError;
+    }
+
+    /**
+     * Feed a chunk; every complete message in the buffer is delivered
+     */
+    push(chunk: Buffer): void {
+        this.buffer = this.buffer.length === 0 ? chunk : Buffer.concat([this.buffer, chunk]);
+        for (;;) {
+            const headerEnd = this.buffer.indexOf('\r\n\r\n');
+            if (headerEnd < 0) {
+                return;
+            }
+            const header = this.buffer.toString('ascii', 0, headerEnd);
+            const match = /Content-Length:\s*(\d+)/i.exec(header);
+            if (!match) {
+                // Unrecoverable framing: drop the header and resynchronize
+                this.buffer = this.buffer.subarray(headerEnd + 4);
+                this.onError(new Error(`Missing Content-Length in header: ${header}`));
+                continue;
+            }
+            const length = parseInt(match[1], 10);
+            const start = headerEnd + 4;
+            if (this.buffer.length < start + length) {
+                return;
+            }
+            const body = this.buffer.toString('utf8', start, start + length);
+            this.buffer = this.buffer.subarray(start + length);
+            try {
+                this.onMessage(JSON.parse(body));
+            } catch (error) {
+                this.onError(error instanceof Error ? error : new Error(String(error)));
+            }
+        }
+    }
+}
+
+type RequestHandler = (params: unknown, token: CancellationToken) => unknown;
+type NotificationHandler = (params: unknown) => void;
+
+interface PendingRequest {
+    resolve: (result: unknown) => void;
+    reject: (error: Error) => void;
+}
+
+/**
+ * Bidirectional JSON-RPC connection
+ */
+export class JsonRpcConnection {
+    private readonly input: Readable;
+    private readonly output: Writable;
+    private readonly decoder: MessageDecoder;
+    private requestHandlers = new Map<string, RequestHandler>();
+    private notificationHandlers = new Map<string, NotificationHandler>();
+    private pending = new Map<RequestId, PendingRequest>();
+    private running = new Map<RequestId, CancellationSource>();
+    private closeListeners: Array<() => void> = [];
+    private nextId = 1;
+    private closed = false;
+
+    constructor(input: Readable, output: Writable) {
+        this.input = input;
+        this.output = output;
+        this.decoder = new MessageDecoder(
+            (message) => this.handleMessage(message),
+            (error) => this.sendError(null, ErrorCodes.ParseError, error.message)
+        );
+    }
+
+    /**
+     * Start reading messages from the input stream
+     */
+    listen(): void {
+        this.input.on('data', (chunk: Buffer) => this.decoder.push(chunk));
+        this.input.on('close', () => this.close());
+        this.input.on('end', () => this.close());
+    }
+
+    onRequest(method: string, handler: RequestHandler): void {
+        this.requestHandlers.set(method, handler);
+    }
+
+    onNotification(method: string, handler: NotificationHandler): void {
+        this.notificationHandlers.set(method, handler);
+    }
+
+    /**
+     * Register a listener for the input stream closing
+     */
+    onClose(listener: () => void): void {
+        this.closeListeners.push(listener);
+    }
+
+    /**
+     * Send a request; cancelling the token sends $/cancelRequest
+     */
+    sendRequest<T>(method: string, params?: unknown, token?: CancellationToken): Promise<T> {
+        if (this.closed) {
+            return Promise.reject(new Error('Connection is closed'));
+        }
+        const id = this.nextId++;
+        const result = new Promise<T>((resolve, reject) => {
+            this.pending.set(id, { resolve: resolve as (result: unknown) => void, reject });
+        });
+        this.write({ jsonrpc: '2.0', id, method, params });
+        token?.onCancellationRequested(() => {
+            if (this.pending.has(id)) {
+                this.sendNotification('$/cancelRequest', { id });
+            }
+        });
+        return result;
+    }
+
+    sendNotification(method: string, params?: unknown): void {
+        if (!this.closed) {
+            this.write({ jsonrpc: '2.0', method, params });
+        }
+    }
+
+    /**
+     * Stop handling messages and fail pending requests
+     */
+    close(): void {
+        if (this.closed) {
+            return;
+        }
+        this.closed = true;
+        for (const request of this.pending.values()) {
+            request.reject(new Error('Connection closed'));
+        }
+        this.pending.clear();
+        for (const source of this.running.values()) {
+            source.cancel();
+        }
+        this.running.clear();
+        for (const listener of this.closeListeners) {
+            listener();
+        }
+    }
+
+    private write(message: Message): void {
+        this.output.write(encodeMessage(message));
+    }
+
+    private sendError(id: RequestId | null, code: number, message: string): void {
+        if (!this.closed) {
+            this.write({ jsonrpc: '2.0', id, error: { code, message } });
+        }
+    }
+
+    private handleMessage(message: Message): void {
+        if (message.method !== undefined && message.id !== undefined && message.id !== null) {
+            this.handleRequest(message.id, message.method, message.params);
+        } else if (message.method !== undefined) {
+            this.handleNotification(message.method, message.params);
+        } else if (message.id !== undefined && message.id !== null) {
+            const request = this.pending.get(message.id);
+            if (request) {
+                this.pending.delete(message.id);
+                if (message.error) {
+                    request.reject(new ResponseError(message.error.code, message.error.message, message.error.data));
+                } else {
+                    request.resolve(message.result ?? null);
+                }
+            }
+        }
+    }
+
+    private handleNotification(method: string, params: unknown): void {
+        if (method === '$/cancelRequest') {
+            const id = (params as { id?: RequestId } | undefined)?.id;
+            if (id !== undefined) {
+                this.running.get(id)?.cancel();
+            }
+            return;
+        }
+        const handler = this.notificationHandlers.get(method);
+        if (handler) {
+            try {
+                handler(params);
+            } catch (error) {
+                process.stderr.write(`Error handling ${method}: ${error instanceof Error ? error.stack : String(error)}\n`);
+            }
+        }
+    }
+
+    private handleRequest(id: RequestId, method: string, params: unknown): void {
+        const handler = this.requestHandlers.get(method);
+        if (!handler) {
+            this.sendError(id, ErrorCodes.MethodNotFound, `Unhandled method ${method}`);
+            return;
+        }
+
+        const source = new CancellationSource();
+        this.running.set(id, source);
+        const finish = (message: Message) => {
+            this.running.delete(id);
+            if (!this.closed) {
+                this.write(message);
+            }
+        };
+        const cancelled = () => finish({
+            jsonrpc: '2.0', id, error: { code: ErrorCodes.RequestCancelled, message: 'Request cancelled' }
+        });
+
+        // Yield first so a $/cancelRequest already queued behind this request is seen
+        setImmediate(() => {
+            if (source.isCancellationRequested) {
+                cancelled();
+                return;
+            }
+            Promise.resolve()
+                .then(() => handler(params, source))
+                .then(
+                    (result) => source.isCancellationRequested
+                        ? cancelled()
+                        : finish({ jsonrpc: '2.0', id, result: result === undefined ? null : result }),
+                    (error) => finish({
+                        jsonrpc: '2.0',
+                        id,
+                        error: error instanceof ResponseError
+                            ? { code: error.code, message: error.message, data: error.data }
+                            : { code: ErrorCodes.InternalError, message: error instanceof Error ? error.message : String(error) }
+                    })
+                );
+        });
+    }
+}
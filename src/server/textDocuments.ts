@@ -0,0 +1,128 @@
+/**
+ * Server-side text documents kept in sync with incremental LSP changes
+ */
+
+import { LineIndex } from '../utils/lintUtils';
+import { IndentModel } from '../utils/indentModel';
+
+export interface Position {
+    /** 0-based line */
+    line: number;
+    /** 0-based UTF-16 offset in the line */
+    character: number;
+}
+
+export interface Range {
+    start: Position;
+    end: Position;
+}
+
+export interface TextDocumentContentChange {
+    /** Replaced range; absent for a full-text replacement */
+    range?: Range;
+    text: string;
+}
+
+/**
+ * An open document
+ * Line offsets are rebuilt lazily after edits; the indent model used for
+ * range formatting is kept up to date incrementally once created.
+ */
+export class ServerTextDocument {
+    readonly uri: string;
+    private _version: number;
+    private text: string;
+    private index: LineIndex | undefined;
+    private indentModel: IndentModel | undefined;
+
+    constructor(uri: string, version: number, text: string) {
+        this.uri = uri;
+        this._version = version;
+        this.text = text;
+    }
+
+    get version(): number {
+        return this._version;
+    }
+
+    get lineCount(): number {
+        return this.getIndex().lineCount;
+    }
+
+    getText(): string {
+        return this.text;
+    }
+
+    /**
+     * Text of a line without its terminator
+     */
+    lineAt(line: number): string {
+        return this.getIndex().lineText(line);
+    }
+
+    /**
+     * Offset of a position; characters past the end of a line clamp to it
+     */
+    offsetAt(position: Position): number {
+        const index = this.getIndex();
+        if (position.line < 0) {
+            return 0;
+        }
+        if (position.line >= index.lineCount) {
+            return this.text.length;
+        }
+        const character = Math.max(0, Math.min(position.character, index.lineText(position.line).length));
+        return index.offsetAt(position.line, character);
+    }
+
+    positionAt(offset: number): Position {
+        const { line, column } = this.getIndex().positionAt(Math.max(0, Math.min(offset, this.text.length)));
+        return { line, character: column };
+    }
+
+    /**
+     * Indent model of the document, built on first use
+     */
+    getIndentModel(): IndentModel {
+        if (!this.indentModel) {
+            this.indentModel = IndentModel.fromText(this.text);
+        }
+        return this.indentModel;
+    }
+
+    /**
+     * Apply changes in order; each range refers to the text after the previous change
+     */
+    applyChanges(changes: readonly TextDocumentContentChange[], version: number): void {
+        for (const change of changes) {
+            if (!change.range) {
+                this.text = change.text;
+                this.index = undefined;
+                this.indentModel = undefined;
+                continue;
+            }
+            const start = this.offsetAt(change.range.start);
+            const end = this.offsetAt(change.range.end);
+            this.text = this.text.substring(0, start) + change.text + this.text.substring(end);
+            this.index = undefined;
+
+            if (this.indentModel) {
+                const newLineCount = change.text.split('\n').length;
+                this.indentModel.applyEdit(
+                    change.range.start.line,
+                    change.range.end.line,
+                    newLineCount,
+                    (line) => this.lineAt(line)
+                );
+            }
+        }
+        this._version = version;
+    }
+
+    private getIndex(): LineIndex {
+        if (!this.index) {
+            this.index = new LineIndex(this.text);
+        }
+        return this.index;
+    }
+}
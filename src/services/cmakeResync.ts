@@ -0,0 +1,86 @@
+/**
+ * CMake Re-sync
+ * Decides how to write regenerated CMakeLists.txt files over existing ones.
+ * Files from an earlier conversion have fenced sections and are merged
+ * section by section, so hand edits survive and unchanged files are not
+ * touched; anything else needs the user's permission to overwrite.
+ */
+
+import * as fs from 'fs';
+import { hasFencedSections, mergeFencedSections } from '../utils/fencedSections';
+
+/**
+ * - create: the file does not exist
+ * - update: fenced sections changed
+ * - unchanged: nothing to write
+ * - overwrite: the file exists without fences and differs
+ */
+export type ResyncAction = 'create' | 'update' | 'unchanged' | 'overwrite';
+
+export interface ResyncPlan {
+    path: string;
+    action: ResyncAction;
+    /** Content to write */
+    content: string;
+    /** Sections replaced, added or removed */
+    updated: string[];
+    /** Edited sections kept although the generated content changed */
+    kept: string[];
+}
+
+export interface ResyncFile {
+    path: string;
+    content: string;
+}
+
+/**
+ * Plan writing generated content over a file
+ * @param existing Current content, or undefined if the file does not exist
+ * @param generated New content, fenced when it should merge into fenced files
+ */
+export function planResync(filePath: string, existing: string | undefined, generated: string): ResyncPlan {
+    if (existing === undefined) {
+        return { path: filePath, action: 'create', content: generated, updated: [], kept: [] };
+    }
+    if (existing === generated) {
+        return { path: filePath, action: 'unchanged', content: existing, updated: [], kept: [] };
+    }
+    if (hasFencedSections(existing) && hasFencedSections(generated)) {
+        const merge = mergeFencedSections(existing, generated);
+        return {
+            path: filePath,
+            action: merge.content === existing ? 'unchanged' : 'update',
+            content: merge.content,
+            updated: merge.updated,
+            kept: merge.kept
+        };
+    }
+    return { path: filePath, action: 'overwrite', content: generated, updated: [], kept: [] };
+}
+
+/**
+ * Read the existing files and plan writing each generated file
+ */
+export async function planResyncFiles(files: readonly ResyncFile[]): Promise<ResyncPlan[]> {
+    return Promise.all(files.map(async file => {
+        let existing: string | undefined;
+        try {
+            existing = await fs.promises.readFile(file.path, 'utf8');
+        } catch {
+            existing = undefined;
+        }
+        return planResync(file.path, existing, file.content);
+    }));
+}
+
+/**
+ * Write the planned files
+ * @param overwrite Whether files planned as 'overwrite' are written
+ * @returns The plans that were written
+ */
+export async function writeResyncPlans(plans: readonly ResyncPlan[], overwrite: boolean): Promise<ResyncPlan[]> {
+    const written = plans.filter(plan =>
+        plan.action === 'create' || plan.action === 'update' || (plan.action === 'overwrite' && overwrite));
+    await Promise.all(written.map(plan => fs.promises.writeFile(plan.path, plan.content, 'utf8')));
+    return written;
+}
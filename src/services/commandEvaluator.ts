@@ -0,0 +1,391 @@
+/**
+ * Command Evaluator
+ * Evaluates the common list() and string() subcommands
+ * Pure TypeScript implementation without VS Code dependencies
+ */
+
+import { PersistentList } from '../utils/persistentList';
+
+/**
+ * Read access to the variables a command operates on
+ */
+export interface VariableStore {
+    /** Get a variable as a list (undefined if not defined) */
+    getList(name: string): PersistentList | undefined;
+    /** Get a variable as a string (undefined if not defined) */
+    getString(name: string): string | undefined;
+}
+
+/**
+ * A variable assignment produced by evaluating a command
+ * List values keep their structure; strings are plain values
+ */
+export interface VariableAssignment {
+    name: string;
+    value: string | PersistentList;
+}
+
+/**
+ * Compile a CMake regular expression for use in JavaScript
+ * @returns The compiled regex, or null if it is not valid
+ */
+function compileRegex(pattern: string, flags = ''): RegExp | null {
+    try {
+        return new RegExp(pattern, flags);
+    } catch {
+        return null;
+    }
+}
+
+/**
+ * Convert a CMake regex replacement (\1, \\) to a JavaScript replacement ($1, \)
+ */
+function convertReplacement(replacement: string): string {
+    let result = '';
+    for (let i = 0; i < replacement.length; i++) {
+        const ch = replacement[i];
+        if (ch === '$') {
+            result += '$$';
+        } else if (ch === '\\' && i + 1 < replacement.length) {
+            const next = replacement[++i];
+            result += /[0-9]/.test(next) ? (next === '0' ? '$&' : `$${next}`) : next;
+        } else {
+            result += ch;
+        }
+    }
+    return result;
+}
+
+/**
+ * Resolve a CMake list index (negative counts from the end)
+ * @returns Normalized index, or -1 if out of range
+ */
+function normalizeIndex(index: string, length: number, allowEnd = false): number {
+    const value = parseInt(index, 10);
+    if (isNaN(value)) {
+        return -1;
+    }
+    const normalized = value < 0 ? length + value : value;
+    const max = allowEnd ? length : length - 1;
+    return normalized >= 0 && normalized <= max ? normalized : -1;
+}
+
+/**
+ * Evaluate a list() command
+ * @param args Expanded arguments (the subcommand first)
+ * @param store Current variable values
+ * @returns Assignments made by the command
+ */
+export function evaluateListCommand(args: readonly string[], store: VariableStore): VariableAssignment[] {
+    if (args.length < 2) {
+        return [];
+    }
+
+    const subcommand = args[0].toUpperCase();
+    const name = args[1];
+    const current = store.getList(name) ?? PersistentList.EMPTY;
+    const rest = args.slice(2);
+
+    switch (subcommand) {
+        case 'APPEND':
+            return [{ name, value: current.append(rest) }];
+
+        case 'PREPEND':
+            return [{ name, value: PersistentList.from([...rest, ...current.toArray()]) }];
+
+        case 'INSERT': {
+            const index = normalizeIndex(rest[0] ?? '', current.length, true);
+            if (index < 0) {
+                return [];
+            }
+            const items = current.toArray().slice();
+            items.splice(index, 0, ...rest.slice(1));
+            return [{ name, value: PersistentList.from(items) }];
+        }
+
+        case 'REMOVE_ITEM': {
+            const removed = new Set(rest);
+            return [{ name, value: PersistentList.from(current.toArray().filter(item => !removed.has(item))) }];
+        }
+
+        case 'REMOVE_AT': {
+            const indices = new Set(rest.map(i => normalizeIndex(i, current.length)));
+            return [{ name, value: PersistentList.from(current.toArray().filter((_, i) => !indices.has(i))) }];
+        }
+
+        case 'REMOVE_DUPLICATES':
+            return [{ name, value: PersistentList.from([...new Set(current.toArray())]) }];
+
+        case 'REVERSE':
+            return [{ name, value: PersistentList.from(current.toArray().slice().reverse()) }];
+
+        case 'SORT': {
+            const upper = rest.map(a => a.toUpperCase());
+            const caseIndex = upper.indexOf('CASE');
+            const orderIndex = upper.indexOf('ORDER');
+            const insensitive = caseIndex >= 0 && upper[caseIndex + 1] === 'INSENSITIVE';
+            const descending = orderIndex >= 0 && upper[orderIndex + 1] === 'DESCENDING';
+            const key = (s: string) => insensitive ? s.toLowerCase() : s;
+            const sorted = current.toArray().slice().sort((a, b) => {
+                const ka = key(a);
+                const kb = key(b);
+                return ka < kb ? -1 : ka > kb ? 1 : 0;
+            });
+            if (descending) {
+                sorted.reverse();
+            }
+            return [{ name, value: PersistentList.from(sorted) }];
+        }
+
+        case 'FILTER': {
+            // list(FILTER <list> <INCLUDE|EXCLUDE> REGEX <regex>)
+            const mode = (rest[0] ?? '').toUpperCase();
+            const regex = rest[1]?.toUpperCase() === 'REGEX' ? compileRegex(rest[2] ?? '') : null;
+            if (!regex || (mode !== 'INCLUDE' && mode !== 'EXCLUDE')) {
+                return [];
+            }
+            const include = mode === 'INCLUDE';
+            return [{ name, value: PersistentList.from(current.toArray().filter(item => regex.test(item) === include)) }];
+        }
+
+        case 'POP_BACK':
+        case 'POP_FRONT': {
+            const items = current.toArray().slice();
+            const assignments: VariableAssignment[] = [];
+            const count = Math.max(rest.length, 1);
+            const popped: string[] = [];
+            for (let i = 0; i < count && items.length > 0; i++) {
+                popped.push((subcommand === 'POP_BACK' ? items.pop() : items.shift()) as string);
+            }
+            rest.forEach((out, i) => {
+                assignments.push({ name: out, value: popped[i] ?? '' });
+            });
+            assignments.unshift({ name, value: PersistentList.from(items) });
+            return assignments;
+        }
+
+        case 'LENGTH':
+            return rest[0] ? [{ name: rest[0], value: String(current.length) }] : [];
+
+        case 'GET': {
+            // list(GET <list> <index> [<index> ...] <out>)
+            if (rest.length < 2) {
+                return [];
+            }
+            const out = rest[rest.length - 1];
+            const values = rest.slice(0, -1)
+                .map(i => current.get(parseInt(i, 10)))
+                .filter((v): v is string => v !== undefined);
+            return [{ name: out, value: values.join(';') }];
+        }
+
+        case 'JOIN':
+            return rest.length >= 2 ? [{ name: rest[1], value: current.join(rest[0]) }] : [];
+
+        case 'FIND':
+            return rest.length >= 2 ? [{ name: rest[1], value: String(current.toArray().indexOf(rest[0])) }] : [];
+
+        case 'SUBLIST': {
+            // list(SUBLIST <list> <begin> <length> <out>)
+            if (rest.length < 3) {
+                return [];
+            }
+            const begin = parseInt(rest[0], 10);
+            const count = parseInt(rest[1], 10);
+            if (isNaN(begin) || isNaN(count) || begin < 0) {
+                return [];
+            }
+            const items = current.toArray();
+            const end = count < 0 ? items.length : Math.min(items.length, begin + count);
+            return [{ name: rest[2], value: PersistentList.from(items.slice(begin, end)) }];
+        }
+
+        case 'TRANSFORM':
+            return evaluateListTransform(name, current, rest);
+
+        default:
+            return [];
+    }
+}
+
+/**
+ * Evaluate list(TRANSFORM <list> <ACTION> [args] [selector] [OUTPUT_VARIABLE <out>])
+ */
+function evaluateListTransform(name: string, current: PersistentList, args: readonly string[]): VariableAssignment[] {
+    const action = (args[0] ?? '').toUpperCase();
+    let rest = args.slice(1);
+
+    let output = name;
+    const outputIndex = rest.findIndex(a => a.toUpperCase() === 'OUTPUT_VARIABLE');
+    if (outputIndex >= 0) {
+        output = rest[outputIndex + 1] ?? name;
+        rest = rest.slice(0, outputIndex);
+    }
+
+    let transform: ((item: string) => string) | null = null;
+    let consumed = 0;
+    switch (action) {
+        case 'APPEND':
+            transform = item => item + (rest[0] ?? '');
+            consumed = 1;
+            break;
+        case 'PREPEND':
+            transform = item => (rest[0] ?? '') + item;
+            consumed = 1;
+            break;
+        case 'TOLOWER':
+            transform = item => item.toLowerCase();
+            break;
+        case 'TOUPPER':
+            transform = item => item.toUpperCase();
+            break;
+        case 'STRIP':
+            transform = item => item.trim();
+            break;
+        case 'REPLACE': {
+            const regex = compileRegex(rest[0] ?? '', 'g');
+            const replacement = convertReplacement(rest[1] ?? '');
+            if (regex) {
+                transform = item => item.replace(regex, replacement);
+            }
+            consumed = 2;
+            break;
+        }
+    }
+    if (!transform) {
+        return [];
+    }
+
+    // Optional selector: AT <index>... | REGEX <regex>
+    const selector = rest.slice(consumed);
+    const items = current.toArray();
+    let selected: (item: string, index: number) => boolean = () => true;
+    const selectorKind = (selector[0] ?? '').toUpperCase();
+    if (selectorKind === 'AT') {
+        const indices = new Set(selector.slice(1).map(i => normalizeIndex(i, items.length)));
+        selected = (_, index) => indices.has(index);
+    } else if (selectorKind === 'REGEX') {
+        const regex = compileRegex(selector[1] ?? '');
+        if (!regex) {
+            return [];
+        }
+        selected = item => regex.test(item);
+    }
+
+    const fn = transform;
+    return [{ name: output, value: PersistentList.from(items.map((item, i) => selected(item, i) ? fn(item) : item)) }];
+}
+
+/**
+ * Evaluate a string() command
+ * @param args Expanded arguments (the subcommand first)
+ * @param store Current variable values
+ * @returns Assignments made by the command
+ */
+export function evaluateStringCommand(args: readonly string[], store: VariableStore): VariableAssignment[] {
+    if (args.length < 2) {
+        return [];
+    }
+
+    const subcommand = args[0].toUpperCase();
+
+    switch (subcommand) {
+        case 'REPLACE': {
+            // string(REPLACE <match> <replace> <out> <input>...)
+            if (args.length < 4) {
+                return [];
+            }
+            const [, match, replace, out] = args;
+            const input = args.slice(4).join('');
+            return [{ name: out, value: match ? input.split(match).join(replace) : input }];
+        }
+
+        case 'REGEX': {
+            const mode = args[1].toUpperCase();
+            if (mode === 'REPLACE') {
+                // string(REGEX REPLACE <regex> <replace> <out> <input>...)
+                if (args.length < 5) {
+                    return [];
+                }
+                const regex = compileRegex(args[2], 'g');
+                if (!regex) {
+                    return [];
+                }
+                const input = args.slice(5).join('');
+                return [{ name: args[4], value: input.replace(regex, convertReplacement(args[3])) }];
+            }
+            if (mode === 'MATCH' || mode === 'MATCHALL') {
+                // string(REGEX MATCH[ALL] <regex> <out> <input>...)
+                if (args.length < 4) {
+                    return [];
+                }
+                const regex = compileRegex(args[2], mode === 'MATCHALL' ? 'g' : '');
+                if (!regex) {
+                    return [];
+                }
+                const input = args.slice(4).join('');
+                const value = mode === 'MATCHALL'
+                    ? (input.match(regex) ?? []).join(';')
+                    : (regex.exec(input)?.[0] ?? '');
+                return [{ name: args[3], value }];
+            }
+            return [];
+        }
+
+        case 'APPEND':
+        case 'PREPEND': {
+            const name = args[1];
+            const current = store.getString(name) ?? '';
+            const extra = args.slice(2).join('');
+            return [{ name, value: subcommand === 'APPEND' ? current + extra : extra + current }];
+        }
+
+        case 'CONCAT':
+            return [{ name: args[1], value: args.slice(2).join('') }];
+
+        case 'JOIN':
+            // string(JOIN <glue> <out> <input>...)
+            return args.length >= 3 ? [{ name: args[2], value: args.slice(3).join(args[1]) }] : [];
+
+        case 'TOLOWER':
+        case 'TOUPPER':
+            // string(TOLOWER <string> <out>)
+            if (args.length < 3) {
+                return [];
+            }
+            return [{ name: args[2], value: subcommand === 'TOLOWER' ? args[1].toLowerCase() : args[1].toUpperCase() }];
+
+        case 'LENGTH':
+            return args.length >= 3 ? [{ name: args[2], value: String(args[1].length) }] : [];
+
+        case 'STRIP':
+            return args.length >= 3 ? [{ name: args[2], value: args[1].trim() }] : [];
+
+        case 'SUBSTRING': {
+            // string(SUBSTRING <string> <begin> <length> <out>)
+            if (args.length < 5) {
+                return [];
+            }
+            const begin = parseInt(args[2], 10);
+            const count = parseInt(args[3], 10);
+            if (isNaN(begin) || isNaN(count) || begin < 0 || begin > args[1].length) {
+                return [];
+            }
+            const value = count < 0 ? args[1].substring(begin) : args[1].substr(begin, count);
+            return [{ name: args[4], value }];
+        }
+
+        case 'FIND': {
+            // string(FIND <string> <substring> <out> [REVERSE])
+            if (args.length < 4) {
+                return [];
+            }
+            const reverse = args[4]?.toUpperCase() === 'REVERSE';
+            const index = reverse ? args[1].lastIndexOf(args[2]) : args[1].indexOf(args[2]);
+            return [{ name: args[3], value: String(index) }];
+        }
+
+        default:
+            return [];
+    }
+}
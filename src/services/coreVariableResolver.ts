@@ -6,7 +6,10 @@
 
 import * as path from 'path';
 import * as fs from 'fs';
-import { CMakeVariableDefinition, parseSetCommands, parseProjectName, parseOptions } from '../parsers';
+import { CMakeVariableDefinition, CMakeCommand, parseProjectName, parseCommands, setCommandDefinition, optionCommandDefinition } from '../parsers';
+import { PersistentList } from '../utils/persistentList';
+import { estimateCollection, MemoryUsage } from '../utils/memoryEstimate';
+import { evaluateListCommand, evaluateStringCommand, VariableStore } from './commandEvaluator';
 
 /**
  * Maximum recursion depth for nested variable resolution
@@ -23,6 +26,45 @@ export interface ResolvedPath {
     exists: boolean;
     /** Any unresolved variables remaining */
     unresolvedVariables: string[];
+    /** List items when the expression is a single reference to a list variable */
+    items?: readonly string[];
+}
+
+/**
+ * Entries and approximate size of each store of a resolver
+ */
+export interface ResolverMemoryUsage {
+    variables: MemoryUsage;
+    lists: MemoryUsage;
+    definitions: MemoryUsage;
+    contributors: MemoryUsage;
+    environment: MemoryUsage;
+}
+
+/**
+ * Variables removed along with a file, and the other files that also assigned them
+ */
+export interface FileRemoval {
+    /** Variables the file assigned; all of them were removed */
+    names: ReadonlySet<string>;
+    /** Other files that assigned any of them, in parse order */
+    files: string[];
+}
+
+/**
+ * Matches an expression consisting of exactly one variable reference
+ */
+const SINGLE_VARIABLE_REGEX = /^\$\{([A-Za-z_][A-Za-z0-9_]*)\}$/;
+
+/**
+ * Read a file for replay, or undefined when it no longer exists
+ */
+function readFileIfExists(filePath: string): string | undefined {
+    try {
+        return fs.readFileSync(filePath, 'utf8');
+    } catch {
+        return undefined;
+    }
 }
 
 /**
@@ -33,9 +75,21 @@ export class CoreVariableResolver {
     /** Map of variable name to value */
     protected variables: Map<string, string> = new Map();
     
+    /** Map of variable name to list value (list variables are not stored in variables) */
+    protected lists: Map<string, PersistentList> = new Map();
+    
     /** Map of variable name to definition info */
     protected definitions: Map<string, CMakeVariableDefinition> = new Map();
 
+    /** Map of variable name to the files whose set()/list()/string()/option() commands assigned it */
+    protected contributors: Map<string, Set<string>> = new Map();
+    
+    /** Map of file to the variables its commands assigned (the inverse of contributors) */
+    protected fileVariables: Map<string, Set<string>> = new Map();
+    
+    /** Parse order of each file, used to replay dependent files in order */
+    protected fileOrder: Map<string, number> = new Map();
+
     /** Map of environment variable name to value */
     protected envVariables: Map<string, string> = new Map();
     
@@ -108,6 +162,21 @@ export class CoreVariableResolver {
      */
     setVariable(name: string, value: string, definition?: CMakeVariableDefinition): void {
         this.variables.set(name, value);
+        this.lists.delete(name);
+        if (definition) {
+            this.definitions.set(name, definition);
+        }
+    }
+    
+    /**
+     * Set a list variable value, sharing the list structure
+     * @param name Variable name
+     * @param list List value
+     * @param definition Optional definition info
+     */
+    setList(name: string, list: PersistentList, definition?: CMakeVariableDefinition): void {
+        this.lists.set(name, list);
+        this.variables.delete(name);
         if (definition) {
             this.definitions.set(name, definition);
         }
@@ -119,7 +188,33 @@ export class CoreVariableResolver {
      * @returns Variable value or undefined
      */
     getVariable(name: string): string | undefined {
-        return this.variables.get(name);
+        const value = this.variables.get(name);
+        if (value !== undefined) {
+            return value;
+        }
+        return this.lists.get(name)?.join();
+    }
+    
+    /**
+     * Get a variable value as list items
+     * The returned array is shared and must not be mutated.
+     * @param name Variable name
+     * @returns List items or undefined
+     */
+    getList(name: string): readonly string[] | undefined {
+        return this.getListValue(name)?.toArray();
+    }
+    
+    /**
+     * Get a variable as a persistent list, converting a string value on first use
+     */
+    protected getListValue(name: string): PersistentList | undefined {
+        const list = this.lists.get(name);
+        if (list) {
+            return list;
+        }
+        const value = this.variables.get(name);
+        return value === undefined ? undefined : PersistentList.fromString(value);
     }
     
     /**
@@ -137,7 +232,7 @@ export class CoreVariableResolver {
      * @returns True if defined
      */
     hasVariable(name: string): boolean {
-        return this.variables.has(name);
+        return this.variables.has(name) || this.lists.has(name);
     }
     
     /**
@@ -145,7 +240,7 @@ export class CoreVariableResolver {
      * @returns Array of variable names
      */
     getVariableNames(): string[] {
-        return Array.from(this.variables.keys());
+        return [...this.variables.keys(), ...this.lists.keys()];
     }
     
     /**
@@ -153,7 +248,11 @@ export class CoreVariableResolver {
      */
     clear(): void {
         this.variables.clear();
+        this.lists.clear();
         this.definitions.clear();
+        this.contributors.clear();
+        this.fileVariables.clear();
+        this.fileOrder.clear();
         this.envVariables.clear();
         this.loadEnvVariables();
         this.setupBuiltInVariables();
@@ -167,8 +266,60 @@ export class CoreVariableResolver {
      * @returns Resolved path information
      */
     resolvePath(pathExpression: string, maxDepth = MAX_VARIABLE_RESOLUTION_DEPTH): ResolvedPath {
-        let resolved = pathExpression;
         const unresolvedVariables: string[] = [];
+        let resolved = this.expandVariables(pathExpression, unresolvedVariables, maxDepth);
+        
+        // Normalize path separators
+        resolved = resolved.replace(/\\/g, '/');
+        
+        // Normalize .. and . segments in resolved paths
+        if (unresolvedVariables.length === 0 && (resolved.includes('/..') || resolved.includes('/.'))) {
+            // Preserve leading slash for absolute paths
+            const isAbsolute = resolved.startsWith('/');
+            const normalized = path.posix.normalize(resolved);
+            // path.posix.normalize handles forward-slash paths correctly
+            resolved = isAbsolute && !normalized.startsWith('/') ? '/' + normalized : normalized;
+        }
+        
+        // Check if the resolved path exists
+        let exists = false;
+        try {
+            exists = fs.existsSync(resolved);
+        } catch {
+            // Ignore errors
+        }
+        
+        const result: ResolvedPath = {
+            original: pathExpression,
+            resolved,
+            exists,
+            unresolvedVariables
+        };
+        
+        // Expose list items directly so callers don't have to re-split the joined value
+        const single = SINGLE_VARIABLE_REGEX.exec(pathExpression);
+        const list = single ? this.lists.get(single[1]) : undefined;
+        if (list && list.length > 1) {
+            result.items = list.toArray();
+        }
+        
+        return result;
+    }
+    
+    /**
+     * Substitute $ENV{VAR} and ${VAR} references without any path normalization
+     * Supports nested variables with recursive resolution
+     * @param expression The expression to expand
+     * @param unresolvedVariables Receives the names of variables that could not be resolved
+     * @param maxDepth Maximum recursion depth for nested variables
+     * @returns The expanded text
+     */
+    expandVariables(
+        expression: string,
+        unresolvedVariables: string[] = [],
+        maxDepth = MAX_VARIABLE_RESOLUTION_DEPTH
+    ): string {
+        let resolved = expression;
         
         // First, resolve $ENV{VAR}
         const envRegex = /\$ENV\{([^}]+)\}/g;
@@ -190,7 +341,7 @@ export class CoreVariableResolver {
             let hasReplacement = false;
             
             resolved = resolved.replace(variableRegex, (match, varName) => {
-                const value = this.variables.get(varName);
+                const value = this.getVariable(varName);
                 if (value !== undefined) {
                     hasReplacement = true;
                     return value;
@@ -209,42 +360,27 @@ export class CoreVariableResolver {
             depth++;
         }
         
-        // Normalize path separators
-        resolved = resolved.replace(/\\/g, '/');
-        
-        // Normalize .. and . segments in resolved paths
-        if (unresolvedVariables.length === 0 && (resolved.includes('/..') || resolved.includes('/.'))) {
-            // Preserve leading slash for absolute paths
-            const isAbsolute = resolved.startsWith('/');
-            const normalized = path.posix.normalize(resolved);
-            // path.posix.normalize handles forward-slash paths correctly
-            resolved = isAbsolute && !normalized.startsWith('/') ? '/' + normalized : normalized;
-        }
-        
-        // Check if the resolved path exists
-        let exists = false;
-        try {
-            exists = fs.existsSync(resolved);
-        } catch {
-            // Ignore errors
-        }
-        
-        return {
-            original: pathExpression,
-            resolved,
-            exists,
-            unresolvedVariables
-        };
+        return resolved;
+    }
+    
+    /**
+     * Expand an unquoted argument into CMake list items
+     * @param expression The argument text
+     * @returns Non-empty list items after variable expansion
+     */
+    expandList(expression: string): string[] {
+        return this.expandVariables(expression).split(';').filter(item => item.length > 0);
     }
     
     /**
      * Parse a CMakeLists.txt file and add its variables
      * @param filePath Path to the CMakeLists.txt file
+     * @param only Apply only assignments to these variables (replaying a file)
      */
-    async parseFile(filePath: string): Promise<void> {
+    async parseFile(filePath: string, only?: ReadonlySet<string>): Promise<void> {
         try {
             const content = await fs.promises.readFile(filePath, 'utf8');
-            this.parseFileContent(content, filePath);
+            this.parseFileContent(content, filePath, only);
         } catch (error) {
             console.error(`Error parsing CMake file: ${filePath}`, error);
         }
@@ -254,12 +390,17 @@ export class CoreVariableResolver {
      * Parse CMake file content and add its variables
      * @param content The file content
      * @param filePath The file path
+     * @param only Apply only assignments to these variables; used to replay a
+     * file's contributions after another file that assigned them changed
      */
-    parseFileContent(content: string, filePath: string): void {
+    parseFileContent(content: string, filePath: string, only?: ReadonlySet<string>): void {
         const dirPath = path.dirname(filePath);
+        if (!this.fileOrder.has(filePath)) {
+            this.fileOrder.set(filePath, this.fileOrder.size);
+        }
         
         // Parse project name
-        const projectName = parseProjectName(content);
+        const projectName = only ? null : parseProjectName(content);
         if (projectName) {
             this.projectName = projectName;
             this.setVariable('PROJECT_NAME', projectName);
@@ -275,21 +416,206 @@ export class CoreVariableResolver {
         this.setVariable('CMAKE_CURRENT_LIST_DIR', dirPath);
         this.setVariable('CMAKE_CURRENT_LIST_FILE', filePath);
         
-        // Parse set() commands
-        const definitions = parseSetCommands(content, filePath);
-        for (const def of definitions) {
-            // Resolve the value in case it contains variables
-            const resolvedValue = this.resolvePath(def.value);
-            this.setVariable(def.name, resolvedValue.resolved, def);
+        // Evaluate set(), list(), string() and option() commands in source order
+        // so that list(APPEND ...) and string(REPLACE ...) see the values set before them
+        for (const command of parseCommands(content)) {
+            switch (command.name.toLowerCase()) {
+                case 'set': {
+                    const def = setCommandDefinition(command, filePath);
+                    if (def && (!only || only.has(def.name))) {
+                        this.evaluateSet(def);
+                        this.addContributor(def.name, filePath);
+                    }
+                    break;
+                }
+                case 'list':
+                case 'string':
+                    this.evaluateListOrString(command, filePath, only);
+                    break;
+                case 'option': {
+                    const opt = optionCommandDefinition(command, filePath);
+                    if (opt && (!only || only.has(opt.name))) {
+                        this.setVariable(opt.name, opt.value, opt);
+                        this.addContributor(opt.name, filePath);
+                    }
+                    break;
+                }
+            }
         }
+    }
+    
+    /**
+     * Re-parse a file after its content changed
+     * Other files that assigned the same variables (e.g. a list(APPEND) in b.cmake
+     * on a variable set() in a.cmake) replay their assignments to those variables
+     * in the original parse order, so no contribution is lost or applied twice.
+     * @param content The new file content
+     * @param filePath The file path
+     * @param readFile Returns the content of another file to replay, or undefined to skip it
+     */
+    reparseFileContent(
+        content: string,
+        filePath: string,
+        readFile: (filePath: string) => string | undefined = readFileIfExists
+    ): void {
+        const removal = this.removeDefinitionsForFile(filePath);
+        for (const file of this.sortByParseOrder([filePath, ...removal.files])) {
+            if (file === filePath) {
+                this.parseFileContent(content, file);
+                continue;
+            }
+            const fileContent = readFile(file);
+            if (fileContent !== undefined) {
+                this.parseFileContent(fileContent, file, removal.names);
+            }
+        }
+    }
+    
+    /**
+     * Remove every variable a file assigned
+     * Variables other files also assigned are removed entirely; replay those
+     * files restricted to the removed names to restore their contributions.
+     * @param filePath The file path
+     * @returns The removed variables and the other files that assigned them
+     */
+    removeDefinitionsForFile(filePath: string): FileRemoval {
+        const names = new Set(this.fileVariables.get(filePath));
+        const files = new Set<string>();
+        for (const name of names) {
+            for (const file of this.contributors.get(name) ?? []) {
+                if (file !== filePath) {
+                    files.add(file);
+                }
+            }
+            this.removeVariable(name);
+        }
+        this.fileVariables.delete(filePath);
+        return { names, files: this.sortByParseOrder([...files]) };
+    }
+    
+    /**
+     * Order files by when they were first parsed; unknown files go last
+     */
+    protected sortByParseOrder(files: string[]): string[] {
+        const order = (file: string) => this.fileOrder.get(file) ?? Number.MAX_SAFE_INTEGER;
+        return files.sort((a, b) => order(a) - order(b));
+    }
+    
+    /**
+     * Drop a variable and everything recorded about it
+     */
+    protected removeVariable(name: string): void {
+        for (const file of this.contributors.get(name) ?? []) {
+            this.fileVariables.get(file)?.delete(name);
+        }
+        this.variables.delete(name);
+        this.lists.delete(name);
+        this.definitions.delete(name);
+        this.contributors.delete(name);
+    }
+    
+    /**
+     * Record that a file's commands assigned a variable
+     */
+    protected addContributor(name: string, filePath: string): void {
+        const files = this.contributors.get(name);
+        if (files) {
+            files.add(filePath);
+        } else {
+            this.contributors.set(name, new Set([filePath]));
+        }
+        const names = this.fileVariables.get(filePath);
+        if (names) {
+            names.add(name);
+        } else {
+            this.fileVariables.set(filePath, new Set([name]));
+        }
+    }
+    
+    /**
+     * Apply a parsed set() definition
+     */
+    protected evaluateSet(def: CMakeVariableDefinition): void {
+        // set(B ${A}) shares the list structure of A instead of copying it
+        const single = SINGLE_VARIABLE_REGEX.exec(def.value);
+        const list = single ? this.lists.get(single[1]) : undefined;
+        if (list) {
+            this.setList(def.name, list, def);
+            return;
+        }
+        // Resolve the value in case it contains variables
+        const resolvedValue = this.resolvePath(def.value);
+        this.setVariable(def.name, resolvedValue.resolved, def);
+    }
+    
+    /**
+     * Evaluate a list() or string() command and apply its assignments
+     * @param only Apply only assignments to these variables
+     */
+    protected evaluateListOrString(command: CMakeCommand, filePath: string, only?: ReadonlySet<string>): void {
+        const args = this.expandArguments(command);
+        const store: VariableStore = {
+            getList: name => this.getListValue(name),
+            getString: name => this.getVariable(name)
+        };
+        const assignments = command.name.toLowerCase() === 'list'
+            ? evaluateListCommand(args, store)
+            : evaluateStringCommand(args, store);
         
-        // Parse options
-        const options = parseOptions(content, filePath);
-        for (const opt of options) {
-            this.setVariable(opt.name, opt.value, opt);
+        for (const assignment of assignments) {
+            if (only && !only.has(assignment.name)) {
+                continue;
+            }
+            // Keep the original definition site (e.g. the first set()) for hover/navigation
+            const definition = this.definitions.get(assignment.name) ?? {
+                name: assignment.name,
+                value: assignment.value.toString(),
+                file: filePath,
+                line: command.line + 1,
+                isCache: false
+            };
+            if (typeof assignment.value === 'string') {
+                this.setVariable(assignment.name, assignment.value, definition);
+            } else {
+                this.setList(assignment.name, assignment.value, definition);
+            }
+            this.addContributor(assignment.name, filePath);
         }
     }
     
+    /**
+     * Expand command arguments the way CMake does: variables are substituted,
+     * and unquoted arguments are split into list elements
+     */
+    protected expandArguments(command: CMakeCommand): string[] {
+        const result: string[] = [];
+        for (const arg of command.arguments) {
+            if (arg.kind === 'bracket') {
+                result.push(arg.value);
+                continue;
+            }
+            if (arg.kind === 'quoted') {
+                result.push(this.expandVariables(arg.value));
+                continue;
+            }
+            // ${LIST} splices the shared items directly, without join/split
+            const single = SINGLE_VARIABLE_REGEX.exec(arg.value);
+            const list = single ? this.lists.get(single[1]) : undefined;
+            if (list) {
+                for (const item of list.toArray()) {
+                    result.push(item);
+                }
+                continue;
+            }
+            for (const item of this.expandVariables(arg.value).split(';')) {
+                if (item.length > 0) {
+                    result.push(item);
+                }
+            }
+        }
+        return result;
+    }
+    
     /**
      * Get project name
      * @returns Project name
@@ -303,6 +629,23 @@ export class CoreVariableResolver {
      * @returns Map of variable names to values
      */
     getAllVariables(): Map<string, string> {
-        return new Map(this.variables);
+        const all = new Map(this.variables);
+        for (const [name, list] of this.lists) {
+            all.set(name, list.join());
+        }
+        return all;
+    }
+    
+    /**
+     * Entries and approximate size of each variable store, for the memory report
+     */
+    getMemoryUsage(): ResolverMemoryUsage {
+        return {
+            variables: estimateCollection(this.variables),
+            lists: estimateCollection(this.lists),
+            definitions: estimateCollection(this.definitions),
+            contributors: estimateCollection(this.contributors),
+            environment: estimateCollection(this.envVariables)
+        };
     }
 }
@@ -5,7 +5,16 @@
  */
 
 import * as vscode from 'vscode';
+import { estimateStringBytes, MemoryUsage } from '../utils/memoryEstimate';
 import { getVariableResolver } from './variableResolver';
+import { getTargetIndex } from './targetIndex';
+import { getTracer } from './tracer';
+
+/**
+ * Rough extension-host cost of one FileSystemWatcher; most of its state
+ * lives in VS Code's file service
+ */
+const WATCHER_BYTES = 512;
 
 export class FileWatcher implements vscode.Disposable {
     private watchers: Map<string, vscode.FileSystemWatcher> = new Map();
@@ -74,7 +83,10 @@ export class FileWatcher implements vscode.Disposable {
         }
         
         this.refreshDebounceTimer = setTimeout(async () => {
-            await this.refreshVariables(uri, isDelete);
+            await getTracer().span('watcher.refresh', 'watcher', () => this.refreshVariables(uri, isDelete), {
+                file: uri?.fsPath,
+                deleted: isDelete
+            });
         }, this.debounceDelay);
     }
     
@@ -83,13 +95,16 @@ export class FileWatcher implements vscode.Disposable {
      */
     async refreshVariables(uri?: vscode.Uri, isDelete = false): Promise<void> {
         const resolver = getVariableResolver();
+        const targetIndex = getTargetIndex();
         if (uri) {
             const filePath = uri.fsPath;
             if (isDelete) {
-                resolver.removeFile(filePath);
+                await resolver.removeFile(filePath);
+                targetIndex.removeFile(filePath);
                 this.removeFile(filePath);
             } else {
                 await resolver.reparseFile(filePath);
+                await targetIndex.parseFile(filePath, value => resolver.expandList(value));
             }
         }
         
@@ -102,6 +117,17 @@ export class FileWatcher implements vscode.Disposable {
         });
     }
     
+    /**
+     * Watched files and an approximate size of their watchers
+     */
+    getMemoryUsage(): MemoryUsage {
+        let bytes = 0;
+        for (const filePath of this.watchers.keys()) {
+            bytes += WATCHER_BYTES + estimateStringBytes(filePath);
+        }
+        return { entries: this.watchers.size, bytes };
+    }
+    
     /**
      * Dispose of all watchers
      */
@@ -0,0 +1,111 @@
+/**
+ * Indent Model Service
+ * Keeps an IndentModel per open CMake document, updated from edit events
+ */
+
+import * as vscode from 'vscode';
+import { IndentModel } from '../utils/indentModel';
+import { estimateCollection, MemoryUsage } from '../utils/memoryEstimate';
+
+interface CachedModel {
+    version: number;
+    model: IndentModel;
+}
+
+export class IndentModelService implements vscode.Disposable {
+    private models: Map<string, CachedModel> = new Map();
+    private disposables: vscode.Disposable[] = [];
+
+    constructor() {
+        this.disposables.push(
+            vscode.workspace.onDidChangeTextDocument(this.onDidChange.bind(this)),
+            vscode.workspace.onDidCloseTextDocument((document) => {
+                this.models.delete(document.uri.toString());
+            })
+        );
+    }
+
+    /**
+     * Get the model for a document, building it if missing or out of date
+     * @param document The document
+     */
+    getModel(document: vscode.TextDocument): IndentModel {
+        const key = document.uri.toString();
+        const cached = this.models.get(key);
+        if (cached && cached.version === document.version) {
+            return cached.model;
+        }
+
+        const lines: string[] = [];
+        for (let i = 0; i < document.lineCount; i++) {
+            lines.push(document.lineAt(i).text);
+        }
+        const model = new IndentModel(lines);
+        this.models.set(key, { version: document.version, model });
+        return model;
+    }
+
+    /**
+     * Apply a single-range edit incrementally; anything else drops the model
+     * so it is rebuilt on next use
+     */
+    private onDidChange(event: vscode.TextDocumentChangeEvent): void {
+        const key = event.document.uri.toString();
+        const cached = this.models.get(key);
+        if (!cached) {
+            return;
+        }
+        if (event.contentChanges.length !== 1 || cached.version !== event.document.version - 1) {
+            this.models.delete(key);
+            return;
+        }
+
+        const change = event.contentChanges[0];
+        const newLineCount = change.text.split('\n').length;
+        cached.model.applyEdit(
+            change.range.start.line,
+            change.range.end.line,
+            newLineCount,
+            (line) => event.document.lineAt(line).text
+        );
+        cached.version = event.document.version;
+    }
+
+    /**
+     * Documents with a model and the approximate size of the models
+     */
+    getMemoryUsage(): MemoryUsage {
+        return estimateCollection(this.models);
+    }
+
+    dispose(): void {
+        for (const disposable of this.disposables) {
+            disposable.dispose();
+        }
+        this.models.clear();
+    }
+}
+
+// Singleton instance
+let instance: IndentModelService | null = null;
+
+/**
+ * Get the singleton instance of IndentModelService
+ * @returns IndentModelService instance
+ */
+export function getIndentModelService(): IndentModelService {
+    if (!instance) {
+        instance = new IndentModelService();
+    }
+    return instance;
+}
+
+/**
+ * Dispose the indent model service singleton
+ */
+export function disposeIndentModelService(): void {
+    if (instance) {
+        instance.dispose();
+        instance = null;
+    }
+}
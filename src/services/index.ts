@@ -1,3 +1,14 @@
 export * from './coreVariableResolver';
 export * from './variableResolver';
 export * from './fileWatcher';
+export * from './targetIndex';
+export * from './indentModelService';
+export * from './languageClient';
+export * from './solutionConverter';
+export * from './propertySheetCache';
+export * from './xcodeprojConverter';
+export * from './xcconfigCache';
+export * from './cmakeResync';
+export * from './performanceMonitor';
+export * from './tracer';
+export * from './memoryRegistry';
@@ -0,0 +1,331 @@
+/**
+ * Language Client
+ * Starts the CMake language server in a child process and bridges it to
+ * VS Code: document sync, diagnostics, formatting and folding.
+ */
+
+import * as vscode from 'vscode';
+import * as path from 'path';
+import { ChildProcess, fork } from 'child_process';
+import { JsonRpcConnection, ResponseError, ErrorCodes } from '../server/jsonRpc';
+import { ServerSettings } from '../server/cmakeServer';
+
+/**
+ * Crashes tolerated within RESTART_WINDOW before the server is left stopped
+ */
+const MAX_RESTARTS = 4;
+const RESTART_WINDOW = 3 * 60 * 1000;
+
+interface LspRange {
+    start: { line: number; character: number };
+    end: { line: number; character: number };
+}
+
+interface LspDiagnostic {
+    range: LspRange;
+    severity: number;
+    code?: string;
+    source?: string;
+    message: string;
+    tags?: number[];
+}
+
+interface LspTextEdit {
+    range: LspRange;
+    newText: string;
+}
+
+interface LspFoldingRange {
+    startLine: number;
+    endLine: number;
+    kind?: string;
+}
+
+function toRange(range: LspRange): vscode.Range {
+    return new vscode.Range(range.start.line, range.start.character, range.end.line, range.end.character);
+}
+
+function fromRange(range: vscode.Range): LspRange {
+    return {
+        start: { line: range.start.line, character: range.start.character },
+        end: { line: range.end.line, character: range.end.character }
+    };
+}
+
+function isCMakeDocument(document: vscode.TextDocument): boolean {
+    if (document.languageId === 'cmake') {
+        return true;
+    }
+    const fileName = path.basename(document.fileName);
+    return fileName === 'CMakeLists.txt' || fileName.endsWith('.cmake');
+}
+
+/**
+ * Read the settings forwarded to the server
+ */
+function readSettings(): ServerSettings {
+    const config = vscode.workspace.getConfiguration('cmake-companion');
+    return {
+        formatting: {
+            style: config.get<string>('formatting.style', 'google'),
+            maxLineLength: config.get<number>('formatting.maxLineLength'),
+            spaceAfterOpenParen: config.get<boolean>('formatting.spaceAfterOpenParen'),
+            spaceBeforeCloseParen: config.get<boolean>('formatting.spaceBeforeCloseParen'),
+            uppercaseCommands: config.get<boolean>('formatting.uppercaseCommands'),
+            danglingParenthesis: config.get<boolean>('formatting.danglingParenthesis')
+        },
+        diagnostics: {
+            enabled: config.get<boolean>('diagnostics.enabled', true),
+            undefinedVariables: config.get<boolean>('diagnostics.undefinedVariables', true),
+            unmatchedBlocks: config.get<boolean>('diagnostics.unmatchedBlocks', true),
+            deprecatedCommands: config.get<boolean>('diagnostics.deprecatedCommands', true),
+            buildPerformance: config.get<Record<string, string>>('diagnostics.buildPerformance', {}),
+            largeTargetSources: config.get<number>('diagnostics.largeTargetSources'),
+            nonExistentPaths: config.get<boolean>('diagnostics.nonExistentPaths', false)
+        },
+        customVariables: config.get<Record<string, string>>('customVariables', {}),
+        environmentVariables: config.get<Record<string, string>>('environmentVariables', {})
+    };
+}
+
+export class CMakeLanguageClient implements
+    vscode.Disposable,
+    vscode.DocumentFormattingEditProvider,
+    vscode.DocumentRangeFormattingEditProvider,
+    vscode.FoldingRangeProvider {
+
+    private readonly serverModule: string;
+    private child: ChildProcess | undefined;
+    private connection: JsonRpcConnection | undefined;
+    private ready: Promise<void> | undefined;
+    /** Set once 'initialized' is sent; document notifications wait for it */
+    private initialized = false;
+    private diagnosticCollection: vscode.DiagnosticCollection;
+    private outputChannel: vscode.OutputChannel;
+    private disposables: vscode.Disposable[] = [];
+    private crashTimes: number[] = [];
+    private stopping = false;
+
+    /**
+     * @param serverModule Path of the compiled server entry point (dist/server/index.js)
+     */
+    constructor(serverModule: string) {
+        this.serverModule = serverModule;
+        this.diagnosticCollection = vscode.languages.createDiagnosticCollection('cmake');
+        this.outputChannel = vscode.window.createOutputChannel('CMake Language Server');
+        this.disposables.push(this.diagnosticCollection, this.outputChannel);
+
+        this.disposables.push(
+            vscode.workspace.onDidOpenTextDocument((document) => this.didOpen(document)),
+            vscode.workspace.onDidChangeTextDocument((event) => {
+                if (this.connection && this.initialized && isCMakeDocument(event.document) && event.contentChanges.length > 0) {
+                    this.connection.sendNotification('textDocument/didChange', {
+                        textDocument: { uri: event.document.uri.toString(), version: event.document.version },
+                        contentChanges: event.contentChanges.map(change => ({
+                            range: fromRange(change.range),
+                            text: change.text
+                        }))
+                    });
+                }
+            }),
+            vscode.workspace.onDidCloseTextDocument((document) => {
+                if (this.connection && this.initialized && isCMakeDocument(document)) {
+                    this.connection.sendNotification('textDocument/didClose', {
+                        textDocument: { uri: document.uri.toString() }
+                    });
+                }
+                this.diagnosticCollection.delete(document.uri);
+            }),
+            vscode.workspace.onDidChangeConfiguration((event) => {
+                if (event.affectsConfiguration('cmake-companion')) {
+                    this.connection?.sendNotification('workspace/didChangeConfiguration', { settings: readSettings() });
+                }
+            })
+        );
+    }
+
+    /**
+     * Start the server process and send the open CMake documents
+     */
+    start(): Promise<void> {
+        const child = fork(this.serverModule, ['--stdio'], { silent: true });
+        const connection = new JsonRpcConnection(child.stdout!, child.stdin!);
+        this.child = child;
+        this.connection = connection;
+
+        child.stderr?.on('data', (chunk: Buffer) => this.outputChannel.append(chunk.toString()));
+        child.on('exit', (code) => this.onExit(child, code));
+
+        connection.onNotification('textDocument/publishDiagnostics', (params) => {
+            const { uri, diagnostics } = params as { uri: string; diagnostics: LspDiagnostic[] };
+            this.diagnosticCollection.set(vscode.Uri.parse(uri), diagnostics.map(item => {
+                const diagnostic = new vscode.Diagnostic(
+                    toRange(item.range),
+                    item.message,
+                    (item.severity - 1) as vscode.DiagnosticSeverity
+                );
+                diagnostic.source = item.source;
+                diagnostic.code = item.code;
+                if (item.tags?.includes(2)) {
+                    diagnostic.tags = [vscode.DiagnosticTag.Deprecated];
+                }
+                return diagnostic;
+            }));
+        });
+        connection.listen();
+
+        this.ready = connection.sendRequest('initialize', {
+            processId: process.pid,
+            rootUri: vscode.workspace.workspaceFolders?.[0]?.uri.toString() ?? null,
+            workspaceFolders: vscode.workspace.workspaceFolders?.map(folder => ({
+                uri: folder.uri.toString(),
+                name: folder.name
+            })) ?? null,
+            initializationOptions: readSettings(),
+            capabilities: {}
+        }).then(() => {
+            connection.sendNotification('initialized', {});
+            this.initialized = true;
+            // Documents opened during startup are sent here, once
+            for (const document of vscode.workspace.textDocuments) {
+                this.didOpen(document);
+            }
+        });
+        return this.ready;
+    }
+
+    provideDocumentFormattingEdits(
+        document: vscode.TextDocument,
+        options: vscode.FormattingOptions,
+        token: vscode.CancellationToken
+    ): Promise<vscode.TextEdit[]> {
+        return this.requestEdits('textDocument/formatting', {
+            textDocument: { uri: document.uri.toString() },
+            options: { tabSize: options.tabSize, insertSpaces: options.insertSpaces }
+        }, token);
+    }
+
+    provideDocumentRangeFormattingEdits(
+        document: vscode.TextDocument,
+        range: vscode.Range,
+        options: vscode.FormattingOptions,
+        token: vscode.CancellationToken
+    ): Promise<vscode.TextEdit[]> {
+        return this.requestEdits('textDocument/rangeFormatting', {
+            textDocument: { uri: document.uri.toString() },
+            range: fromRange(range),
+            options: { tabSize: options.tabSize, insertSpaces: options.insertSpaces }
+        }, token);
+    }
+
+    async provideFoldingRanges(
+        document: vscode.TextDocument,
+        _context: vscode.FoldingContext,
+        token: vscode.CancellationToken
+    ): Promise<vscode.FoldingRange[]> {
+        const ranges = await this.request<LspFoldingRange[]>('textDocument/foldingRange', {
+            textDocument: { uri: document.uri.toString() }
+        }, token);
+        return (ranges ?? []).map(range => new vscode.FoldingRange(
+            range.startLine,
+            range.endLine,
+            range.kind === 'comment' ? vscode.FoldingRangeKind.Comment : vscode.FoldingRangeKind.Region
+        ));
+    }
+
+    /**
+     * Ask the server to shut down, then stop the process
+     */
+    async stop(): Promise<void> {
+        this.stopping = true;
+        const connection = this.connection;
+        const child = this.child;
+        if (!connection || !child) {
+            return;
+        }
+        try {
+            await Promise.race([
+                connection.sendRequest('shutdown'),
+                new Promise(resolve => setTimeout(resolve, 2000))
+            ]);
+            connection.sendNotification('exit');
+        } catch {
+            // Server already gone
+        }
+        connection.close();
+        setTimeout(() => child.kill(), 2000).unref();
+    }
+
+    dispose(): void {
+        void this.stop();
+        for (const disposable of this.disposables) {
+            disposable.dispose();
+        }
+        this.disposables = [];
+    }
+
+    private didOpen(document: vscode.TextDocument): void {
+        if (this.connection && this.initialized && isCMakeDocument(document)) {
+            this.connection.sendNotification('textDocument/didOpen', {
+                textDocument: {
+                    uri: document.uri.toString(),
+                    languageId: 'cmake',
+                    version: document.version,
+                    text: document.getText()
+                }
+            });
+        }
+    }
+
+    /**
+     * Send a request once the server is initialized; cancellation resolves to undefined
+     */
+    private async request<T>(method: string, params: unknown, token: vscode.CancellationToken): Promise<T | undefined> {
+        if (!this.connection || !this.ready) {
+            return undefined;
+        }
+        try {
+            await this.ready;
+            return await this.connection.sendRequest<T>(method, params, token);
+        } catch (error) {
+            if (!(error instanceof ResponseError && error.code === ErrorCodes.RequestCancelled)) {
+                this.outputChannel.appendLine(`${method} failed: ${error instanceof Error ? error.message : String(error)}`);
+            }
+            return undefined;
+        }
+    }
+
+    private async requestEdits(method: string, params: unknown, token: vscode.CancellationToken): Promise<vscode.TextEdit[]> {
+        const edits = await this.request<LspTextEdit[]>(method, params, token);
+        return (edits ?? []).map(edit => vscode.TextEdit.replace(toRange(edit.range), edit.newText));
+    }
+
+    /**
+     * Restart after a crash unless the server keeps failing
+     */
+    private onExit(child: ChildProcess, code: number | null): void {
+        if (child !== this.child) {
+            return;
+        }
+        this.connection?.close();
+        this.connection = undefined;
+        this.ready = undefined;
+        this.initialized = false;
+        this.diagnosticCollection.clear();
+        if (this.stopping) {
+            return;
+        }
+
+        const now = Date.now();
+        this.crashTimes = this.crashTimes.filter(time => now - time < RESTART_WINDOW);
+        this.crashTimes.push(now);
+        this.outputChannel.appendLine(`Language server exited with code ${code}`);
+        if (this.crashTimes.length > MAX_RESTARTS) {
+            void vscode.window.showErrorMessage(
+                'The CMake language server crashed repeatedly and will not be restarted. See the "CMake Language Server" output for details.'
+            );
+            return;
+        }
+        void this.start().catch(error => this.outputChannel.appendLine(`Restart failed: ${error}`));
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * Memory Registry
+ * Caches and indexes register a function reporting their entry count and
+ * approximate size; the memory report lists them all next to the process
+ * figures. Sizes are computed when asked for, so registration costs nothing.
+ */
+
+import { formatBytes, MemoryUsage } from '../utils/memoryEstimate';
+
+export type MemorySource = () => MemoryUsage;
+
+export interface MemoryReportRow extends MemoryUsage {
+    name: string;
+    /** Set when the source threw instead of reporting */
+    error?: string;
+}
+
+export class MemoryRegistry {
+    private sources = new Map<string, MemorySource>();
+
+    /**
+     * Register a source; a source registered under the same name is replaced
+     * @returns Disposable that unregisters the source
+     */
+    register(name: string, source: MemorySource): { dispose(): void } {
+        this.sources.set(name, source);
+        return {
+            dispose: () => {
+                if (this.sources.get(name) === source) {
+                    this.sources.delete(name);
+                }
+            }
+        };
+    }
+
+    /**
+     * Current usage of every source, by name
+     */
+    getReport(): MemoryReportRow[] {
+        return [...this.sources.keys()].sort().map(name => {
+            try {
+                return { name, ...this.sources.get(name)!() };
+            } catch (error) {
+                return { name, entries: 0, bytes: 0, error: error instanceof Error ? error.message : String(error) };
+            }
+        });
+    }
+
+    /**
+     * Report as text: process memory, then each source and their total
+     * @param usage Process memory, process.memoryUsage() by default
+     */
+    formatReport(usage: NodeJS.MemoryUsage = process.memoryUsage()): string {
+        const lines = [
+            'Process',
+            `  rss            ${formatBytes(usage.rss)}`,
+            `  heap used      ${formatBytes(usage.heapUsed)} of ${formatBytes(usage.heapTotal)}`,
+            `  external       ${formatBytes(usage.external)}`,
+            `  array buffers  ${formatBytes(usage.arrayBuffers)}`,
+            ''
+        ];
+        const rows = this.getReport();
+        const width = Math.max(6, ...rows.map(row => row.name.length));
+        lines.push(`${'source'.padEnd(width)}  ${'entries'.padStart(9)}  ${'approx.'.padStart(10)}`);
+        let entries = 0;
+        let bytes = 0;
+        for (const row of rows) {
+            entries += row.entries;
+            bytes += row.bytes;
+            lines.push(row.error
+                ? `${row.name.padEnd(width)}  failed: ${row.error}`
+                : `${row.name.padEnd(width)}  ${String(row.entries).padStart(9)}  ${formatBytes(row.bytes).padStart(10)}`);
+        }
+        lines.push(`${'total'.padEnd(width)}  ${String(entries).padStart(9)}  ${formatBytes(bytes).padStart(10)}`);
+        return lines.join('\n');
+    }
+}
+
+// Singleton instance
+let instance: MemoryRegistry | null = null;
+
+/**
+ * Get the singleton instance of MemoryRegistry
+ * @returns MemoryRegistry instance
+ */
+export function getMemoryRegistry(): MemoryRegistry {
+    if (!instance) {
+        instance = new MemoryRegistry();
+    }
+    return instance;
+}
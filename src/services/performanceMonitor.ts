@@ -0,0 +1,234 @@
+/**
+ * Performance Monitor
+ * Latency histograms for provider calls and resolver work, per operation
+ * and document size, for the "Show Performance Report" command. While
+ * disabled, measure() only checks a flag and calls through.
+ */
+
+import { LatencyHistogram } from '../utils/latencyHistogram';
+import { estimateBytes, MemoryUsage } from '../utils/memoryEstimate';
+import { getTracer } from './tracer';
+
+/**
+ * Document size buckets by line count, smallest first
+ */
+export const SIZE_BUCKETS: readonly { label: string; maxLines: number }[] = [
+    { label: '<100 lines', maxLines: 99 },
+    { label: '100-999 lines', maxLines: 999 },
+    { label: '1k-9k lines', maxLines: 9999 },
+    { label: '10k+ lines', maxLines: Infinity }
+];
+
+/**
+ * Bucket label for operations without a document
+ */
+const NO_DOCUMENT = '-';
+
+export function getSizeBucket(lineCount: number | undefined): string {
+    if (lineCount === undefined) {
+        return NO_DOCUMENT;
+    }
+    return SIZE_BUCKETS.find(bucket => lineCount <= bucket.maxLines)!.label;
+}
+
+export interface PerformanceReportRow {
+    operation: string;
+    /** Size bucket label, or 'all' for the operation's total */
+    size: string;
+    count: number;
+    p50: number;
+    p95: number;
+    p99: number;
+    max: number;
+}
+
+export class PerformanceMonitor {
+    private enabled = false;
+    /** Operation -> size bucket -> histogram */
+    private histograms = new Map<string, Map<string, LatencyHistogram>>();
+
+    isEnabled(): boolean {
+        return this.enabled;
+    }
+
+    /**
+     * Turn recording on or off; recorded data is kept until clear()
+     */
+    setEnabled(enabled: boolean): void {
+        this.enabled = enabled;
+    }
+
+    /**
+     * Record a duration
+     * @param lineCount Size of the document involved, if any
+     */
+    record(operation: string, lineCount: number | undefined, ms: number): void {
+        let bySize = this.histograms.get(operation);
+        if (!bySize) {
+            bySize = new Map();
+            this.histograms.set(operation, bySize);
+        }
+        const size = getSizeBucket(lineCount);
+        let histogram = bySize.get(size);
+        if (!histogram) {
+            histogram = new LatencyHistogram();
+            bySize.set(size, histogram);
+        }
+        histogram.record(ms);
+    }
+
+    /**
+     * Time a call, including the promise it returns; rejected and thrown
+     * calls are recorded too
+     * @param lineCount Size of the document involved, if any
+     */
+    measure<T>(operation: string, lineCount: number | undefined, fn: () => T): T {
+        if (!this.enabled) {
+            return fn();
+        }
+        const start = process.hrtime.bigint();
+        const done = () => this.record(operation, lineCount, Number(process.hrtime.bigint() - start) / 1e6);
+        let result: T;
+        try {
+            result = fn();
+        } catch (error) {
+            done();
+            throw error;
+        }
+        if (result instanceof Promise) {
+            return result.finally(done) as T;
+        }
+        if (isThenable(result)) {
+            // Thenables without finally(), as VS Code APIs may return
+            result.then(done, done);
+            return result;
+        }
+        done();
+        return result;
+    }
+
+    /**
+     * Wrap methods of a provider so each call is measured, and traced as a
+     * span when tracing is on
+     * A TextDocument first argument selects the size bucket by its lineCount.
+     * @param operations Method name -> operation name, e.g. { provideHover: 'hover' }
+     * @param category Trace event category
+     */
+    instrument<T extends object>(provider: T, operations: Partial<Record<keyof T & string, string>>, category = 'provider'): T {
+        const target = provider as Record<string, unknown>;
+        const tracer = getTracer();
+        for (const [method, operation] of Object.entries(operations) as [string, string][]) {
+            const original = target[method];
+            if (typeof original !== 'function') {
+                continue;
+            }
+            target[method] = (...args: unknown[]) => tracer.span(operation, category, () => this.measure(
+                operation,
+                this.enabled ? getLineCount(args[0]) : undefined,
+                () => original.apply(provider, args)
+            ));
+        }
+        return provider;
+    }
+
+    /**
+     * Percentiles per operation: one 'all' row, then a row per size bucket
+     * when the operation saw more than one
+     */
+    getReport(): PerformanceReportRow[] {
+        const rows: PerformanceReportRow[] = [];
+        const row = (operation: string, size: string, histogram: LatencyHistogram): PerformanceReportRow => ({
+            operation,
+            size,
+            count: histogram.count,
+            p50: histogram.percentile(50),
+            p95: histogram.percentile(95),
+            p99: histogram.percentile(99),
+            max: histogram.max()
+        });
+        const sizeOrder = [NO_DOCUMENT, ...SIZE_BUCKETS.map(bucket => bucket.label)];
+        for (const operation of [...this.histograms.keys()].sort()) {
+            const bySize = this.histograms.get(operation)!;
+            const total = new LatencyHistogram();
+            for (const histogram of bySize.values()) {
+                total.merge(histogram);
+            }
+            rows.push(row(operation, 'all', total));
+            if (bySize.size > 1) {
+                for (const size of sizeOrder) {
+                    const histogram = bySize.get(size);
+                    if (histogram) {
+                        rows.push(row(operation, size, histogram));
+                    }
+                }
+            }
+        }
+        return rows;
+    }
+
+    /**
+     * Report as an aligned text table, times in milliseconds
+     */
+    formatReport(): string {
+        const rows = this.getReport();
+        if (rows.length === 0) {
+            return this.enabled
+                ? 'No calls recorded yet.'
+                : 'Performance monitoring is off. Enable "cmake-companion.performance.monitoring" and use the editor to collect data.';
+        }
+        const header = ['operation', 'size', 'count', 'p50 ms', 'p95 ms', 'p99 ms', 'max ms'];
+        const table = rows.map(item => [
+            item.size === 'all' ? item.operation : '',
+            item.size,
+            String(item.count),
+            item.p50.toFixed(2),
+            item.p95.toFixed(2),
+            item.p99.toFixed(2),
+            item.max.toFixed(2)
+        ]);
+        const widths = header.map((title, column) => Math.max(title.length, ...table.map(cells => cells[column].length)));
+        const format = (cells: string[]) => cells
+            .map((cell, column) => (column < 2 ? cell.padEnd(widths[column]) : cell.padStart(widths[column])))
+            .join('  ')
+            .trimEnd();
+        return [format(header), ...table.map(format)].join('\n');
+    }
+
+    /**
+     * Histograms held and their approximate size
+     */
+    getMemoryUsage(): MemoryUsage {
+        let entries = 0;
+        for (const bySize of this.histograms.values()) {
+            entries += bySize.size;
+        }
+        return { entries, bytes: estimateBytes(this.histograms) };
+    }
+
+    clear(): void {
+        this.histograms.clear();
+    }
+}
+
+function isThenable(value: unknown): value is PromiseLike<unknown> {
+    return typeof (value as PromiseLike<unknown> | undefined)?.then === 'function';
+}
+
+function getLineCount(document: unknown): number | undefined {
+    const lineCount = (document as { lineCount?: unknown } | undefined)?.lineCount;
+    return typeof lineCount === 'number' ? lineCount : undefined;
+}
+
+// Singleton instance
+let instance: PerformanceMonitor | null = null;
+
+/**
+ * Get the singleton instance of PerformanceMonitor
+ * @returns PerformanceMonitor instance
+ */
+export function getPerformanceMonitor(): PerformanceMonitor {
+    if (!instance) {
+        instance = new PerformanceMonitor();
+    }
+    return instance;
+}
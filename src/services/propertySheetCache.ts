@@ -0,0 +1,189 @@
+/**
+ * Property Sheet Cache
+ * Parsed MSBuild property sheets (.props/.targets), keyed by path and
+ * invalidated when the file or any sheet it imports changes on disk. Shared
+ * sheets are parsed once however many projects import them.
+ */
+
+import * as fs from 'fs';
+import { MsBuildSettingsIndex, MsBuildConfigurationEntry } from '../parsers/msbuildSettingsIndex';
+import { MsBuildPropertySheet, VcxprojParseOptions, parsePropertySheet, resolveImportPath } from '../parsers/vcxprojParser';
+import { FileStamp, isStampUnchanged, stampFile, stampFileOrMissing } from '../utils/fileStamp';
+import { estimateCollection, MemoryUsage } from '../utils/memoryEstimate';
+
+interface CachedSheet {
+    /** The sheet and every sheet it imports, as they were when parsed */
+    stamps: FileStamp[];
+    /** undefined when the file could not be parsed */
+    sheet: MsBuildPropertySheet | undefined;
+}
+
+/**
+ * Cache entry in a form that can be posted to a worker thread
+ */
+export interface SerializedPropertySheet {
+    key: string;
+    stamps: FileStamp[];
+    path: string;
+    directories: string[];
+    imports: string[];
+    missingImports: string[];
+    entries: Array<[string, MsBuildConfigurationEntry]>;
+}
+
+/**
+ * Import elements of a project, found without a full parse
+ */
+const IMPORT_REGEX = /<Import\s[^>]*?Project\s*=\s*(?:"([^"]*)"|'([^']*)')/g;
+
+function cacheKey(sheetPath: string, solutionDir: string | undefined): string {
+    // $(SolutionDir) in nested imports makes a sheet depend on the solution
+    return `${solutionDir ?? ''}\0${sheetPath}`;
+}
+
+export class PropertySheetCache {
+    private sheets = new Map<string, CachedSheet>();
+    /** Sheets being parsed, to break import cycles */
+    private loading = new Set<string>();
+    private parseCount = 0;
+
+    /**
+     * Load a sheet, parsing it only if it is not cached or changed on disk
+     * @param sheetPath Absolute path with '/' separators
+     * @returns undefined if the sheet does not exist, cannot be read, or imports itself
+     */
+    load(sheetPath: string, solutionDir?: string): MsBuildPropertySheet | undefined {
+        const key = cacheKey(sheetPath, solutionDir);
+        const cached = this.sheets.get(key);
+        if (cached && cached.stamps.every(isStampUnchanged)) {
+            return cached.sheet;
+        }
+        const stamp = stampFile(sheetPath);
+        if (!stamp) {
+            return undefined;
+        }
+        if (this.loading.has(key)) {
+            return undefined;
+        }
+
+        this.loading.add(key);
+        let sheet: MsBuildPropertySheet | undefined;
+        try {
+            const content = fs.readFileSync(sheetPath, 'utf8');
+            sheet = parsePropertySheet(content, sheetPath, this.getParseOptions(solutionDir));
+            this.parseCount++;
+        } catch {
+            sheet = undefined;
+        } finally {
+            this.loading.delete(key);
+        }
+        const stamps = [stamp];
+        for (const path of [...sheet?.imports ?? [], ...sheet?.missingImports ?? []]) {
+            stamps.push(stampFileOrMissing(path));
+        }
+        this.sheets.set(key, { stamps, sheet });
+        return sheet;
+    }
+
+    /**
+     * Options for parseVcxproj that resolve imports through this cache
+     */
+    getParseOptions(solutionDir?: string): VcxprojParseOptions {
+        return {
+            solutionDir,
+            loadImport: (sheetPath) => this.load(sheetPath, solutionDir)
+        };
+    }
+
+    /**
+     * Load every sheet a project imports directly, along with their own imports
+     * Lets the sheets of a batch be parsed up front, before the projects are
+     * handed to worker threads.
+     */
+    preload(projectContent: string, projectPath: string, solutionDir?: string): void {
+        if (!projectContent.includes('<Import')) {
+            return;
+        }
+        const projectDir = projectPath.replace(/\\/g, '/').replace(/\/[^/]*$/, '');
+        const regex = new RegExp(IMPORT_REGEX.source, 'g');
+        let match: RegExpExecArray | null;
+        while ((match = regex.exec(projectContent)) !== null) {
+            const sheetPath = resolveImportPath(match[1] ?? match[2], projectDir, { projectDir, solutionDir });
+            if (sheetPath !== undefined) {
+                this.load(sheetPath, solutionDir);
+            }
+        }
+    }
+
+    /**
+     * Parsed sheets, for seeding the cache of a worker thread
+     */
+    serialize(): SerializedPropertySheet[] {
+        const result: SerializedPropertySheet[] = [];
+        for (const [key, cached] of this.sheets) {
+            if (cached.sheet) {
+                result.push({
+                    key,
+                    stamps: cached.stamps,
+                    path: cached.sheet.path,
+                    directories: cached.sheet.directories,
+                    imports: cached.sheet.imports,
+                    missingImports: cached.sheet.missingImports,
+                    entries: cached.sheet.settings.toEntries()
+                });
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Add sheets serialized by another thread's cache
+     */
+    restore(sheets: readonly SerializedPropertySheet[]): void {
+        for (const item of sheets) {
+            this.sheets.set(item.key, {
+                stamps: item.stamps,
+                sheet: {
+                    path: item.path,
+                    settings: MsBuildSettingsIndex.fromEntries(item.entries),
+                    directories: item.directories,
+                    imports: item.imports,
+                    missingImports: item.missingImports
+                }
+            });
+        }
+    }
+
+    /**
+     * Number of times a sheet was read and parsed
+     */
+    getParseCount(): number {
+        return this.parseCount;
+    }
+
+    /**
+     * Cached sheets and their approximate size
+     */
+    getMemoryUsage(): MemoryUsage {
+        return estimateCollection(this.sheets);
+    }
+
+    clear(): void {
+        this.sheets.clear();
+        this.parseCount = 0;
+    }
+}
+
+// Singleton instance
+let instance: PropertySheetCache | null = null;
+
+/**
+ * Get the singleton instance of PropertySheetCache
+ * @returns PropertySheetCache instance
+ */
+export function getPropertySheetCache(): PropertySheetCache {
+    if (!instance) {
+        instance = new PropertySheetCache();
+    }
+    return instance;
+}
@@ -0,0 +1,281 @@
+/**
+ * Solution Converter
+ * Converts every C++ project of a Visual Studio solution to CMake. Projects
+ * are parsed on worker threads; references are then resolved across the
+ * solution and the files generated in solution order, so the output is the
+ * same however many threads were used.
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import { parseVcxproj, VcxprojParseOptions, VcxprojProject } from '../parsers/vcxprojParser';
+import { parseSln, normalizeGuid, SlnProject, SlnSolution } from '../parsers/slnParser';
+import {
+    generateCMakeLists,
+    generateFencedCMakeLists,
+    generateSolutionCMakeLists,
+    getGeneratedCMakeVersion,
+    getMaxCMakeVersion,
+    getPchCompatibilityKey,
+    FastBuildProfile,
+    SolutionTarget
+} from '../parsers/cmakeGenerator';
+import { PoolCancellationToken, WorkerPoolCancelledError, runWorkerPool } from '../utils/workerPool';
+import { getPropertySheetCache, SerializedPropertySheet } from './propertySheetCache';
+
+/**
+ * Projects sent to a worker per message; project sizes vary a lot, so batches stay small
+ */
+const PROJECT_BATCH_SIZE = 4;
+
+export interface ProjectParseTask {
+    path: string;
+    /** File content; undefined when it could not be read */
+    content?: string;
+    error?: string;
+}
+
+/**
+ * Data passed to each worker thread
+ */
+export interface SolutionWorkerData {
+    solutionDir: string;
+    /** Property sheets parsed up front by the main thread */
+    sheets: SerializedPropertySheet[];
+}
+
+export interface ProjectParseResult {
+    project?: VcxprojProject;
+    error?: string;
+}
+
+export interface SolutionOutputFile {
+    path: string;
+    content: string;
+}
+
+export interface SkippedProject {
+    name: string;
+    path: string;
+    reason: string;
+}
+
+export interface SolutionConversion {
+    solution: SlnSolution;
+    /** Project CMakeLists.txt files in solution order, then the top-level one */
+    files: SolutionOutputFile[];
+    skipped: SkippedProject[];
+}
+
+export interface SolutionConversionOptions {
+    /** Worker threads (1 = parse in the calling thread) */
+    jobs: number;
+    /** Called as projects are parsed */
+    onProgress?: (finished: number, total: number) => void;
+    token?: PoolCancellationToken;
+    /** Fence project sections so re-conversion can merge them (see generateFencedCMakeLists) */
+    fenced?: boolean;
+    /** Generate unity builds, shared precompiled headers and other build-speed settings */
+    fastBuild?: FastBuildProfile;
+}
+
+/**
+ * How planSolutionConversion generates project files
+ */
+export type SolutionGenerationOptions = Pick<SolutionConversionOptions, 'fenced' | 'fastBuild'>;
+
+/**
+ * Read a project file
+ */
+async function readProjectFile(projectPath: string): Promise<ProjectParseTask> {
+    try {
+        return { path: projectPath, content: await fs.promises.readFile(projectPath, 'utf8') };
+    } catch (error) {
+        return { path: projectPath, error: error instanceof Error ? error.message : String(error) };
+    }
+}
+
+/**
+ * Parse one project read by readProjectFile
+ */
+export function parseProjectTask(task: ProjectParseTask, options: VcxprojParseOptions): ProjectParseResult {
+    if (task.content === undefined) {
+        return { error: task.error };
+    }
+    try {
+        return { project: parseVcxproj(task.content, task.path, options) };
+    } catch (error) {
+        return { error: error instanceof Error ? error.message : String(error) };
+    }
+}
+
+/**
+ * Key for matching project paths; Windows paths are case-insensitive
+ */
+function pathKey(filePath: string): string {
+    return path.resolve(filePath).toLowerCase();
+}
+
+/**
+ * Find projects that can reuse another project's precompiled header
+ * Projects share a PCH when they use the same header file with the same
+ * target type, include directories and compile settings; the first of each
+ * group in solution order builds it.
+ * @returns Donor target name of each reusing project
+ */
+function planPchReuse(slnDir: string, converted: Array<{ project: VcxprojProject; directory: string }>): Map<VcxprojProject, string> {
+    const donors = new Map<string, string>();
+    const reuse = new Map<VcxprojProject, string>();
+    for (const { project, directory } of converted) {
+        const projectDir = path.join(slnDir, directory);
+        const settings = getPchCompatibilityKey(project, dir =>
+            dir.includes('$(') ? dir : pathKey(path.resolve(projectDir, dir)));
+        if (settings === undefined) {
+            continue;
+        }
+        const header = pathKey(path.join(projectDir, project.pchConfig!.headerFile!.replace(/\\/g, '/')));
+        const key = `${header}\0${settings}`;
+        const donor = donors.get(key);
+        if (donor === undefined) {
+            donors.set(key, project.name);
+        } else {
+            reuse.set(project, donor);
+        }
+    }
+    return reuse;
+}
+
+/**
+ * Generate the CMake files of a solution from its parsed projects
+ * @param slnPath Path of the .sln file
+ * @param solution Parsed solution
+ * @param projects C++ projects of the solution, in solution order
+ * @param results Parse result of each project
+ * @param skipped Projects already left out
+ * @param generation Fenced output and fast build profile
+ */
+export function planSolutionConversion(
+    slnPath: string,
+    solution: SlnSolution,
+    projects: SlnProject[],
+    results: ProjectParseResult[],
+    skipped: SkippedProject[] = [],
+    generation: SolutionGenerationOptions = {}
+): SolutionConversion {
+    const slnDir = path.dirname(slnPath);
+    const converted: Array<{ entry: SlnProject; project: VcxprojProject; directory: string }> = [];
+    const directories = new Set<string>();
+
+    projects.forEach((entry, index) => {
+        const result = results[index];
+        const directory = path.posix.dirname(entry.path);
+        let reason: string | undefined;
+        if (!result.project) {
+            reason = result.error ?? 'Failed to parse';
+        } else if (directory === '.') {
+            reason = 'Project is in the solution directory, which gets the top-level CMakeLists.txt';
+        } else if (directories.has(directory.toLowerCase())) {
+            reason = `Another project already converts ${directory}`;
+        }
+        if (reason) {
+            skipped.push({ name: entry.name, path: entry.path, reason });
+            return;
+        }
+        directories.add(directory.toLowerCase());
+        converted.push({ entry, project: result.project!, directory });
+    });
+
+    const byGuid = new Map<string, SolutionTarget>();
+    const byPath = new Map<string, SolutionTarget>();
+    for (const { entry, project } of converted) {
+        const target: SolutionTarget = { name: project.name, type: project.type };
+        byGuid.set(entry.guid, target);
+        byPath.set(pathKey(path.join(slnDir, entry.path)), target);
+    }
+
+    const pchReuse = generation.fastBuild ? planPchReuse(slnDir, converted) : new Map<VcxprojProject, string>();
+
+    const files: SolutionOutputFile[] = [];
+    const versions: string[] = [];
+    for (const { entry, project, directory } of converted) {
+        const projectDir = path.join(slnDir, directory);
+        const referenceTargets = project.projectReferences.map(ref =>
+            (ref.projectGuid !== undefined ? byGuid.get(normalizeGuid(ref.projectGuid)) : undefined) ??
+            byPath.get(pathKey(path.join(projectDir, ref.path.replace(/\\/g, '/'))))
+        );
+        const dependencyTargets = entry.dependencies
+            .map(guid => byGuid.get(guid)?.name)
+            .filter((name): name is string => name !== undefined);
+
+        const context = { referenceTargets, dependencyTargets, pchReuseFrom: pchReuse.get(project) };
+        const content = generation.fenced
+            ? generateFencedCMakeLists(project, context, generation.fastBuild)
+            : generateCMakeLists(project, context, generation.fastBuild);
+        versions.push(getGeneratedCMakeVersion(content) ?? '3.10');
+        files.push({ path: path.join(projectDir, 'CMakeLists.txt'), content });
+    }
+
+    files.push({
+        path: path.join(slnDir, 'CMakeLists.txt'),
+        content: generateSolutionCMakeLists(
+            solution.name,
+            converted.map(item => item.directory),
+            getMaxCMakeVersion(versions.length > 0 ? versions : ['3.10'])
+        )
+    });
+
+    return { solution, files, skipped };
+}
+
+/**
+ * Parse a solution and convert all of its C++ projects
+ * Nothing is written; the caller writes SolutionConversion.files.
+ * @throws WorkerPoolCancelledError when cancelled through options.token
+ */
+export async function convertSolution(slnPath: string, options: SolutionConversionOptions): Promise<SolutionConversion> {
+    const solution = parseSln(await fs.promises.readFile(slnPath, 'utf8'), slnPath);
+    const slnDir = path.dirname(slnPath);
+
+    const skipped: SkippedProject[] = [];
+    const projects = solution.projects.filter(entry => {
+        if (entry.path.toLowerCase().endsWith('.vcxproj')) {
+            return true;
+        }
+        skipped.push({ name: entry.name, path: entry.path, reason: 'Not a C++ project' });
+        return false;
+    });
+    const tasks = await Promise.all(projects.map(entry => readProjectFile(path.join(slnDir, entry.path))));
+
+    // Imported property sheets are parsed once here and shared by every project
+    const sheetCache = getPropertySheetCache();
+    let results: ProjectParseResult[];
+    if (options.jobs <= 1 || projects.length <= PROJECT_BATCH_SIZE) {
+        const parseOptions = sheetCache.getParseOptions(slnDir);
+        results = [];
+        for (const task of tasks) {
+            if (options.token?.isCancellationRequested) {
+                throw new WorkerPoolCancelledError();
+            }
+            results.push(parseProjectTask(task, parseOptions));
+            options.onProgress?.(results.length, projects.length);
+        }
+    } else {
+        for (const task of tasks) {
+            if (task.content !== undefined) {
+                sheetCache.preload(task.content, task.path, slnDir);
+            }
+        }
+        const data: SolutionWorkerData = { solutionDir: slnDir, sheets: sheetCache.serialize() };
+        // The worker sits next to this file (.js when compiled, .ts under ts-node)
+        const workerFile = path.join(__dirname, `solutionWorker${path.extname(__filename)}`);
+        results = await runWorkerPool<ProjectParseTask, ProjectParseResult>(workerFile, tasks, {
+            jobs: options.jobs,
+            data,
+            batchSize: PROJECT_BATCH_SIZE,
+            onProgress: options.onProgress,
+            token: options.token
+        });
+    }
+
+    return planSolutionConversion(slnPath, solution, projects, results, skipped, options);
+}
@@ -0,0 +1,15 @@
+/**
+ * Solution conversion worker thread: parses batches of project files
+ */
+
+import { workerData } from 'worker_threads';
+import { parseProjectTask, ProjectParseTask, SolutionWorkerData } from './solutionConverter';
+import { getPropertySheetCache } from './propertySheetCache';
+import { serveWorkerTasks } from '../utils/workerPool';
+
+const data = workerData as SolutionWorkerData;
+const sheetCache = getPropertySheetCache();
+sheetCache.restore(data.sheets);
+const parseOptions = sheetCache.getParseOptions(data.solutionDir);
+
+serveWorkerTasks((task: ProjectParseTask) => parseProjectTask(task, parseOptions));
@@ -0,0 +1,675 @@
+/**
+ * Target Index
+ * Indexes add_library/add_executable/add_custom_target and the
+ * target_link_libraries/add_dependencies edges between them.
+ * Pure TypeScript implementation without VS Code dependencies
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import { parseCommands, CMakeCommand } from '../parsers';
+import { estimateBytes, MemoryUsage } from '../utils/memoryEstimate';
+
+export type CMakeTargetKind = 'library' | 'executable' | 'custom' | 'alias';
+
+export interface CMakeTargetInfo {
+    /** Target name */
+    name: string;
+    /** Kind of target */
+    kind: CMakeTargetKind;
+    /** Library type (STATIC, SHARED, INTERFACE, ...) if given */
+    libraryType?: string;
+    /** Whether the target is IMPORTED */
+    imported: boolean;
+    /** File where the target is defined */
+    file: string;
+    /** Line number in the file (1-based) */
+    line: number;
+}
+
+export type TargetEdgeKind = 'link' | 'dependency' | 'alias';
+
+export interface TargetEdge {
+    /** Dependent target */
+    from: string;
+    /** Target (or external library) that is depended on */
+    to: string;
+    /** link: target_link_libraries, dependency: add_dependencies, alias: ALIAS target */
+    kind: TargetEdgeKind;
+    /** File where the edge is declared */
+    file: string;
+    /** Line number in the file (1-based) */
+    line: number;
+}
+
+/**
+ * Expands a raw command argument (e.g. ${LIBS}) into list items
+ */
+export type ArgumentExpander = (value: string) => readonly string[];
+
+const LIBRARY_TYPES = new Set(['STATIC', 'SHARED', 'MODULE', 'OBJECT', 'INTERFACE', 'UNKNOWN']);
+
+/**
+ * Keywords in target_link_libraries() that are not library names
+ */
+const LINK_KEYWORDS = new Set([
+    'PUBLIC', 'PRIVATE', 'INTERFACE',
+    'LINK_PUBLIC', 'LINK_PRIVATE', 'LINK_INTERFACE_LIBRARIES',
+    'debug', 'optimized', 'general'
+]);
+
+const EMPTY_SET: ReadonlySet<string> = new Set();
+
+/**
+ * Extract targets and edges from parsed commands
+ * @param commands Parsed commands of one file
+ * @param filePath The file path
+ * @param expand Optional expansion of variable references in arguments
+ */
+export function extractTargets(
+    commands: CMakeCommand[],
+    filePath: string,
+    expand?: ArgumentExpander
+): { targets: CMakeTargetInfo[]; edges: TargetEdge[] } {
+    const targets: CMakeTargetInfo[] = [];
+    const edges: TargetEdge[] = [];
+
+    const values = (command: CMakeCommand): string[] => {
+        const result: string[] = [];
+        for (const arg of command.arguments) {
+            if (expand && arg.kind !== 'bracket' && arg.value.includes('$')) {
+                result.push(...expand(arg.value));
+            } else {
+                result.push(arg.value);
+            }
+        }
+        return result;
+    };
+
+    for (const command of commands) {
+        const name = command.name.toLowerCase();
+        if (name !== 'add_library' && name !== 'add_executable' && name !== 'add_custom_target' &&
+            name !== 'target_link_libraries' && name !== 'add_dependencies') {
+            continue;
+        }
+
+        const args = values(command);
+        if (args.length === 0) {
+            continue;
+        }
+        const line = command.line + 1;
+        const target = args[0];
+
+        if (name === 'target_link_libraries' || name === 'add_dependencies') {
+            const kind: TargetEdgeKind = name === 'add_dependencies' ? 'dependency' : 'link';
+            for (const item of args.slice(1)) {
+                // Skip keywords, linker flags, generator expressions and unresolved variables
+                if (!item || LINK_KEYWORDS.has(item) || item.startsWith('-') || item.includes('$')) {
+                    continue;
+                }
+                edges.push({ from: target, to: item, kind, file: filePath, line });
+            }
+            continue;
+        }
+
+        const upper = args.map(a => a.toUpperCase());
+        const aliasIndex = upper.indexOf('ALIAS');
+        if (name !== 'add_custom_target' && aliasIndex === 1 && args[2]) {
+            targets.push({ name: target, kind: 'alias', imported: false, file: filePath, line });
+            edges.push({ from: target, to: args[2], kind: 'alias', file: filePath, line });
+            continue;
+        }
+
+        targets.push({
+            name: target,
+            kind: name === 'add_library' ? 'library' : name === 'add_executable' ? 'executable' : 'custom',
+            libraryType: name === 'add_library' && LIBRARY_TYPES.has(upper[1]) ? upper[1] : undefined,
+            imported: name !== 'add_custom_target' && upper.slice(1, 3).includes('IMPORTED'),
+            file: filePath,
+            line
+        });
+
+        // add_custom_target(name ... DEPENDS ...) lists files and targets; only targets matter here
+        if (name === 'add_custom_target') {
+            const dependsIndex = upper.indexOf('DEPENDS');
+            if (dependsIndex > 0) {
+                for (let i = dependsIndex + 1; i < args.length && !/^[A-Z_]+$/.test(args[i]); i++) {
+                    edges.push({ from: target, to: args[i], kind: 'dependency', file: filePath, line });
+                }
+            }
+        }
+    }
+
+    return { targets, edges };
+}
+
+/**
+ * Index of CMake targets and their dependency graph
+ * Per-file contributions are kept separately so a changed file only
+ * applies the difference to its own targets and edges. Direct adjacency
+ * queries are O(1); transitive closures are computed lazily and cached,
+ * and a change only drops the closures that can reach the edges it touched.
+ */
+export class TargetIndex {
+    /** Targets defined per file */
+    private fileTargets: Map<string, CMakeTargetInfo[]> = new Map();
+
+    /** Edges declared per file */
+    private fileEdges: Map<string, TargetEdge[]> = new Map();
+
+    /** Target name to definition */
+    private targets: Map<string, CMakeTargetInfo> = new Map();
+
+    /** Target name to the files defining it, in indexing order (the last one wins) */
+    private targetFiles: Map<string, Set<string>> = new Map();
+
+    /** Direct dependencies (adjacency list) */
+    private dependencies: Map<string, Set<string>> = new Map();
+
+    /** Direct dependents (reverse adjacency list) */
+    private dependents: Map<string, Set<string>> = new Map();
+
+    /** Number of declarations of each edge, keyed by from and to, so duplicates survive one removal */
+    private edgeCounts: Map<string, number> = new Map();
+
+    /** Cached transitive dependencies */
+    private dependencyClosure: Map<string, ReadonlySet<string>> = new Map();
+
+    /** Cached transitive dependents */
+    private dependentClosure: Map<string, ReadonlySet<string>> = new Map();
+
+    /** Cached cycles (null when stale) */
+    private cycles: string[][] | null = null;
+
+    /** Change listeners */
+    private listeners: Array<() => void> = [];
+
+    /** Nesting depth of batched updates; listeners are notified when it returns to 0 */
+    private batchDepth = 0;
+
+    /** Whether the index changed during the current batch */
+    private pendingChange = false;
+
+    /**
+     * Parse a CMake file and replace its contribution to the index
+     * @param filePath Path to the file
+     * @param expand Optional expansion of variable references in arguments
+     */
+    async parseFile(filePath: string, expand?: ArgumentExpander): Promise<void> {
+        try {
+            const content = await fs.promises.readFile(filePath, 'utf8');
+            this.updateFile(filePath, content, expand);
+        } catch (error) {
+            console.error(`Error indexing CMake targets: ${filePath}`, error);
+        }
+    }
+
+    /**
+     * Parse several files, notifying listeners once at the end
+     * @param filePaths Paths of the files
+     * @param expand Optional expansion of variable references in arguments
+     */
+    async indexFiles(filePaths: readonly string[], expand?: ArgumentExpander): Promise<void> {
+        this.batchDepth++;
+        try {
+            for (const filePath of filePaths) {
+                await this.parseFile(filePath, expand);
+            }
+        } finally {
+            this.endBatch();
+        }
+    }
+
+    /**
+     * Replace the targets and edges contributed by a file
+     * @param filePath Path to the file
+     * @param content File content
+     * @param expand Optional expansion of variable references in arguments
+     */
+    updateFile(filePath: string, content: string, expand?: ArgumentExpander): void {
+        const { targets, edges } = extractTargets(parseCommands(content), filePath, expand);
+        this.applyFile(filePath, targets, edges);
+    }
+
+    /**
+     * Remove everything contributed by a file
+     */
+    removeFile(filePath: string): void {
+        if (this.fileTargets.has(filePath) || this.fileEdges.has(filePath)) {
+            this.applyFile(filePath, undefined, undefined);
+        }
+    }
+
+    /**
+     * Clear the whole index
+     */
+    clear(): void {
+        this.fileTargets.clear();
+        this.fileEdges.clear();
+        this.targets.clear();
+        this.targetFiles.clear();
+        this.dependencies.clear();
+        this.dependents.clear();
+        this.edgeCounts.clear();
+        this.dependencyClosure.clear();
+        this.dependentClosure.clear();
+        this.cycles = null;
+        this.notify();
+    }
+
+    /**
+     * Targets held and the approximate size of the index with its
+     * dependency graph and cached closures
+     */
+    getMemoryUsage(): MemoryUsage {
+        const seen = new WeakSet<object>();
+        const bytes = [this.fileTargets, this.fileEdges, this.targets, this.targetFiles, this.dependencies,
+            this.dependents, this.edgeCounts, this.dependencyClosure, this.dependentClosure]
+            .reduce((sum, map) => sum + estimateBytes(map, seen), 0);
+        return { entries: this.targets.size, bytes };
+    }
+
+    /**
+     * Register a listener called whenever the index changes
+     * @returns Function that unregisters the listener
+     */
+    onDidChange(listener: () => void): () => void {
+        this.listeners.push(listener);
+        return () => {
+            this.listeners = this.listeners.filter(l => l !== listener);
+        };
+    }
+
+    /**
+     * Replace a file's contribution with new targets and edges (undefined removes the file)
+     * Applies only the difference: linear in the size of the file's old and new
+     * contributions, plus the closures that can reach the touched edges.
+     */
+    private applyFile(filePath: string, targets: CMakeTargetInfo[] | undefined, edges: TargetEdge[] | undefined): void {
+        const oldTargets = this.fileTargets.get(filePath) ?? [];
+        const oldEdges = this.fileEdges.get(filePath) ?? [];
+        if (targets && edges) {
+            this.fileTargets.set(filePath, targets);
+            this.fileEdges.set(filePath, edges);
+        } else {
+            this.fileTargets.delete(filePath);
+            this.fileEdges.delete(filePath);
+        }
+
+        for (const target of oldTargets) {
+            this.targetFiles.get(target.name)?.delete(filePath);
+        }
+        for (const target of targets ?? []) {
+            // Re-inserting moves the file to the end, matching "last indexed wins"
+            this.targetFiles.get(target.name)?.delete(filePath);
+            this.addToSet(this.targetFiles, target.name, filePath);
+        }
+        for (const target of [...oldTargets, ...(targets ?? [])]) {
+            this.refreshTarget(target.name);
+        }
+
+        // Count each edge's declarations in the old and new contribution; only net changes touch the graph
+        const delta = new Map<string, { from: string; to: string; count: number }>();
+        const count = (edge: TargetEdge, change: number) => {
+            const key = `${edge.from}\0${edge.to}`;
+            const entry = delta.get(key) ?? { from: edge.from, to: edge.to, count: 0 };
+            entry.count += change;
+            delta.set(key, entry);
+        };
+        oldEdges.forEach(edge => count(edge, -1));
+        (edges ?? []).forEach(edge => count(edge, 1));
+
+        // Removals are invalidated against the graph before the edge goes, additions after it exists
+        let graphChanged = false;
+        for (const [key, { from, to, count: change }] of delta) {
+            const total = (this.edgeCounts.get(key) ?? 0) + change;
+            if (change < 0 && total <= 0) {
+                this.invalidateClosures(from, to);
+                this.edgeCounts.delete(key);
+                this.removeFromSet(this.dependencies, from, to);
+                this.removeFromSet(this.dependents, to, from);
+                graphChanged = true;
+            } else if (change !== 0) {
+                this.edgeCounts.set(key, total);
+            }
+        }
+        for (const [key, { from, to, count: change }] of delta) {
+            if (change > 0 && this.edgeCounts.get(key) === change) {
+                this.addToSet(this.dependencies, from, to);
+                this.addToSet(this.dependents, to, from);
+                this.invalidateClosures(from, to);
+                graphChanged = true;
+            }
+        }
+        if (graphChanged) {
+            this.cycles = null;
+        }
+
+        this.notify();
+    }
+
+    /**
+     * Point a target name at the definition of the last file that still defines it
+     */
+    private refreshTarget(name: string): void {
+        const files = this.targetFiles.get(name);
+        let definition: CMakeTargetInfo | undefined;
+        if (files && files.size > 0) {
+            const file = Array.from(files)[files.size - 1];
+            // Within a file, the last definition wins as well
+            for (const target of this.fileTargets.get(file) ?? []) {
+                if (target.name === name) {
+                    definition = target;
+                }
+            }
+        } else {
+            this.targetFiles.delete(name);
+        }
+        if (definition) {
+            this.targets.set(name, definition);
+        } else {
+            this.targets.delete(name);
+        }
+    }
+
+    /**
+     * Drop the cached closures an edge from -> to can be part of: the dependency
+     * closures of from and everything that reaches it, and the dependent closures
+     * of to and everything it reaches
+     */
+    private invalidateClosures(from: string, to: string): void {
+        this.dropReachable(from, this.dependents, this.dependencyClosure);
+        this.dropReachable(to, this.dependencies, this.dependentClosure);
+    }
+
+    private dropReachable(start: string, adjacency: Map<string, Set<string>>, cache: Map<string, ReadonlySet<string>>): void {
+        if (cache.size === 0) {
+            return;
+        }
+        const visited = new Set<string>([start]);
+        const stack = [start];
+        while (stack.length > 0) {
+            const node = stack.pop() as string;
+            cache.delete(node);
+            for (const next of adjacency.get(node) ?? []) {
+                if (!visited.has(next)) {
+                    visited.add(next);
+                    stack.push(next);
+                }
+            }
+        }
+    }
+
+    /**
+     * Notify listeners, or record the change until the current batch ends
+     */
+    private notify(): void {
+        if (this.batchDepth > 0) {
+            this.pendingChange = true;
+            return;
+        }
+        for (const listener of this.listeners) {
+            listener();
+        }
+    }
+
+    private endBatch(): void {
+        this.batchDepth--;
+        if (this.batchDepth === 0 && this.pendingChange) {
+            this.pendingChange = false;
+            this.notify();
+        }
+    }
+
+    private removeFromSet(map: Map<string, Set<string>>, key: string, value: string): void {
+        const set = map.get(key);
+        if (set) {
+            set.delete(value);
+            if (set.size === 0) {
+                map.delete(key);
+            }
+        }
+    }
+
+    private addToSet(map: Map<string, Set<string>>, key: string, value: string): void {
+        let set = map.get(key);
+        if (!set) {
+            set = new Set();
+            map.set(key, set);
+        }
+        set.add(value);
+    }
+
+    /**
+     * Get a target definition
+     */
+    getTarget(name: string): CMakeTargetInfo | undefined {
+        return this.targets.get(name);
+    }
+
+    /**
+     * Check if a name is a known target
+     */
+    hasTarget(name: string): boolean {
+        return this.targets.has(name);
+    }
+
+    /**
+     * Value of a target property the index can tell statically
+     * Answers NAME, TYPE, IMPORTED, ALIASED_TARGET and SOURCE_DIR; anything
+     * else (or a library whose type depends on BUILD_SHARED_LIBS) is undefined.
+     */
+    getTargetProperty(name: string, property: string): string | undefined {
+        const target = this.targets.get(name);
+        if (!target) {
+            return undefined;
+        }
+        const aliased = target.kind === 'alias' ? this.dependencies.get(name)?.values().next().value : undefined;
+        switch (property) {
+            case 'NAME':
+                return aliased ?? target.name;
+            case 'IMPORTED':
+                return target.imported ? 'TRUE' : 'FALSE';
+            case 'ALIASED_TARGET':
+                return aliased ?? '';
+            case 'SOURCE_DIR':
+                return path.dirname(target.file);
+            case 'TYPE':
+                if (aliased) {
+                    return aliased === name ? undefined : this.getTargetProperty(aliased, property);
+                }
+                if (target.kind === 'executable') {
+                    return 'EXECUTABLE';
+                }
+                if (target.kind === 'custom') {
+                    return 'UTILITY';
+                }
+                return target.kind === 'library' && target.libraryType && target.libraryType !== 'UNKNOWN'
+                    ? `${target.libraryType}_LIBRARY`
+                    : undefined;
+            default:
+                return undefined;
+        }
+    }
+
+    /**
+     * Get all target names, sorted
+     */
+    getTargetNames(): string[] {
+        return Array.from(this.targets.keys()).sort();
+    }
+
+    /**
+     * Get edges declared in a file
+     */
+    getEdges(filePath: string): readonly TargetEdge[] {
+        return this.fileEdges.get(filePath) ?? [];
+    }
+
+    /**
+     * Direct dependencies of a target ("what does X link/depend on")
+     */
+    getDependencies(name: string): ReadonlySet<string> {
+        return this.dependencies.get(name) ?? EMPTY_SET;
+    }
+
+    /**
+     * Direct dependents of a target ("who links/depends on X")
+     */
+    getDependents(name: string): ReadonlySet<string> {
+        return this.dependents.get(name) ?? EMPTY_SET;
+    }
+
+    /**
+     * Everything a target pulls in, directly or transitively (cached)
+     */
+    getTransitiveDependencies(name: string): ReadonlySet<string> {
+        return this.closure(name, this.dependencies, this.dependencyClosure);
+    }
+
+    /**
+     * Every target affected by a change to this one, directly or transitively (cached)
+     * This is the rebuild blast radius of the target.
+     */
+    getTransitiveDependents(name: string): ReadonlySet<string> {
+        return this.closure(name, this.dependents, this.dependentClosure);
+    }
+
+    /**
+     * Compute (or fetch) the reachable set from a node
+     */
+    private closure(
+        name: string,
+        adjacency: Map<string, Set<string>>,
+        cache: Map<string, ReadonlySet<string>>
+    ): ReadonlySet<string> {
+        const cached = cache.get(name);
+        if (cached) {
+            return cached;
+        }
+
+        // Iterative DFS; reuse cached closures of visited nodes
+        const reached = new Set<string>();
+        const stack = Array.from(adjacency.get(name) ?? []);
+        while (stack.length > 0) {
+            const node = stack.pop() as string;
+            if (reached.has(node)) {
+                continue;
+            }
+            reached.add(node);
+            const known = cache.get(node);
+            if (known) {
+                for (const n of known) {
+                    reached.add(n);
+                }
+                continue;
+            }
+            for (const next of adjacency.get(node) ?? []) {
+                if (!reached.has(next)) {
+                    stack.push(next);
+                }
+            }
+        }
+        reached.delete(name);
+
+        cache.set(name, reached);
+        return reached;
+    }
+
+    /**
+     * Find dependency cycles (strongly connected components with more than
+     * one target, or a target depending on itself)
+     */
+    findCycles(): string[][] {
+        if (this.cycles) {
+            return this.cycles;
+        }
+
+        // Tarjan's algorithm, iterative to avoid stack overflows on deep graphs
+        const indices = new Map<string, number>();
+        const lowLinks = new Map<string, number>();
+        const onStack = new Set<string>();
+        const stack: string[] = [];
+        const cycles: string[][] = [];
+        let nextIndex = 0;
+
+        for (const root of this.dependencies.keys()) {
+            if (indices.has(root)) {
+                continue;
+            }
+            const work: Array<{ node: string; neighbors: string[]; next: number }> = [];
+            const visit = (node: string) => {
+                indices.set(node, nextIndex);
+                lowLinks.set(node, nextIndex);
+                nextIndex++;
+                stack.push(node);
+                onStack.add(node);
+                work.push({ node, neighbors: Array.from(this.dependencies.get(node) ?? []), next: 0 });
+            };
+            visit(root);
+
+            while (work.length > 0) {
+                const frame = work[work.length - 1];
+                if (frame.next < frame.neighbors.length) {
+                    const neighbor = frame.neighbors[frame.next++];
+                    if (!indices.has(neighbor)) {
+                        visit(neighbor);
+                    } else if (onStack.has(neighbor)) {
+                        lowLinks.set(frame.node, Math.min(lowLinks.get(frame.node)!, indices.get(neighbor)!));
+                    }
+                    continue;
+                }
+
+                work.pop();
+                if (work.length > 0) {
+                    const parent = work[work.length - 1].node;
+                    lowLinks.set(parent, Math.min(lowLinks.get(parent)!, lowLinks.get(frame.node)!));
+                }
+                if (lowLinks.get(frame.node) === indices.get(frame.node)) {
+                    const component: string[] = [];
+                    let member: string;
+                    do {
+                        member = stack.pop() as string;
+                        onStack.delete(member);
+                        component.push(member);
+                    } while (member !== frame.node);
+                    const selfLoop = component.length === 1 && (this.dependencies.get(member)?.has(member) ?? false);
+                    if (component.length > 1 || selfLoop) {
+                        cycles.push(component.reverse());
+                    }
+                }
+            }
+        }
+
+        this.cycles = cycles;
+        return cycles;
+    }
+
+    /**
+     * Get the cycle containing a target, if any
+     */
+    getCycle(name: string): string[] | undefined {
+        return this.findCycles().find(cycle => cycle.includes(name));
+    }
+}
+
+// Singleton instance
+let instance: TargetIndex | null = null;
+
+/**
+ * Get the singleton instance of TargetIndex
+ * @returns TargetIndex instance
+ */
+export function getTargetIndex(): TargetIndex {
+    if (!instance) {
+        instance = new TargetIndex();
+    }
+    return instance;
+}
+
+/**
+ * Reset the singleton instance (for testing)
+ */
+export function resetTargetIndex(): void {
+    instance = null;
+}
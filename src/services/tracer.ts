@@ -0,0 +1,193 @@
+/**
+ * Tracer
+ * Opt-in spans for activation, file parsing, provider calls, watcher
+ * batches and diagnostics, exported in the Chrome Trace Event format for
+ * chrome://tracing or Perfetto. Nesting follows the async call chain
+ * (AsyncLocalStorage), so a parseFile started from activate() records
+ * activate() as its parent even across awaits.
+ *
+ * Spans that finish synchronously become complete ('X') events on the
+ * thread track, where they show what blocked the extension host. Spans that
+ * await become nestable async ('b'/'e') events grouped under their root
+ * span, since interleaved async work does not nest on one thread track.
+ * Viewers group async events by category and id, so they carry the root
+ * span's category and keep their own in args.category.
+ */
+
+import { AsyncLocalStorage } from 'async_hooks';
+import * as fs from 'fs';
+import * as path from 'path';
+import { performance } from 'perf_hooks';
+import { estimateBytes, MemoryUsage } from '../utils/memoryEstimate';
+
+/**
+ * Events kept in memory; the oldest are dropped beyond this
+ */
+const MAX_EVENTS = 200000;
+
+export interface TraceEvent {
+    name: string;
+    cat: string;
+    ph: 'X' | 'b' | 'e' | 'M';
+    /** Microseconds */
+    ts: number;
+    dur?: number;
+    pid: number;
+    tid: number;
+    id?: string;
+    args?: Record<string, unknown>;
+}
+
+interface Span {
+    id: number;
+    rootId: number;
+    /** Category of the root span, shared by the async events of its tree */
+    rootCategory: string;
+    ended: boolean;
+}
+
+export class Tracer {
+    private enabled = false;
+    private readonly context = new AsyncLocalStorage<Span>();
+    private nextId = 1;
+    /** Ring buffer of recorded events */
+    private events: TraceEvent[] = [];
+    private next = 0;
+    private dropped = 0;
+
+    isEnabled(): boolean {
+        return this.enabled;
+    }
+
+    setEnabled(enabled: boolean): void {
+        this.enabled = enabled;
+    }
+
+    /**
+     * Run fn inside a span; promises are traced until they settle
+     * @param args Extra values shown with the span, such as a file path
+     */
+    span<T>(name: string, category: string, fn: () => T, args?: Record<string, unknown>): T {
+        if (!this.enabled) {
+            return fn();
+        }
+        const parent = this.context.getStore();
+        const open = parent && !parent.ended ? parent : undefined;
+        const id = this.nextId++;
+        const span: Span = { id, rootId: open ? open.rootId : id, rootCategory: open ? open.rootCategory : category, ended: false };
+        const spanArgs = { ...args, spanId: id, parentId: open?.id };
+        const start = now();
+
+        let result: T;
+        try {
+            result = this.context.run(span, fn);
+        } catch (error) {
+            span.ended = true;
+            this.push({ name, cat: category, ph: 'X', ts: start, dur: now() - start, pid: process.pid, tid: 1, args: { ...spanArgs, error: String(error) } });
+            throw error;
+        }
+        if (!isThenable(result)) {
+            span.ended = true;
+            this.push({ name, cat: category, ph: 'X', ts: start, dur: now() - start, pid: process.pid, tid: 1, args: spanArgs });
+            return result;
+        }
+
+        const asyncId = `0x${span.rootId.toString(16)}`;
+        const asyncCategory = span.rootCategory;
+        this.push({ name, cat: asyncCategory, ph: 'b', ts: start, pid: process.pid, tid: 1, id: asyncId, args: { ...spanArgs, category } });
+        const end = (error?: unknown) => {
+            span.ended = true;
+            this.push({
+                name, cat: asyncCategory, ph: 'e', ts: now(), pid: process.pid, tid: 1, id: asyncId,
+                args: error === undefined ? undefined : { error: String(error) }
+            });
+        };
+        result.then(() => end(), end);
+        return result;
+    }
+
+    /**
+     * Recorded events as a Chrome Trace Event JSON object
+     */
+    toChromeTrace(): { traceEvents: TraceEvent[]; displayTimeUnit: string; otherData: Record<string, unknown> } {
+        const ordered = this.events.length < MAX_EVENTS
+            ? this.events
+            : [...this.events.slice(this.next), ...this.events.slice(0, this.next)];
+        const metadata: TraceEvent[] = [
+            { name: 'process_name', cat: '__metadata', ph: 'M', ts: 0, pid: process.pid, tid: 1, args: { name: 'CMake Companion (extension host)' } },
+            { name: 'thread_name', cat: '__metadata', ph: 'M', ts: 0, pid: process.pid, tid: 1, args: { name: 'main' } }
+        ];
+        return {
+            traceEvents: [...metadata, ...ordered],
+            displayTimeUnit: 'ms',
+            otherData: { droppedEvents: this.dropped }
+        };
+    }
+
+    /**
+     * Write the trace to a new file in a directory
+     * @returns Path of the written file
+     */
+    async writeTrace(directory: string): Promise<string> {
+        await fs.promises.mkdir(directory, { recursive: true });
+        const stamp = new Date().toISOString().replace(/[:.]/g, '-');
+        const filePath = path.join(directory, `cmake-companion-trace-${stamp}.json`);
+        await fs.promises.writeFile(filePath, JSON.stringify(this.toChromeTrace()), 'utf8');
+        return filePath;
+    }
+
+    /**
+     * Number of events recorded (up to the buffer size)
+     */
+    getEventCount(): number {
+        return this.events.length;
+    }
+
+    /**
+     * Buffered events and their approximate size
+     */
+    getMemoryUsage(): MemoryUsage {
+        return { entries: this.events.length, bytes: estimateBytes(this.events) };
+    }
+
+    clear(): void {
+        this.events = [];
+        this.next = 0;
+        this.dropped = 0;
+    }
+
+    private push(event: TraceEvent): void {
+        if (this.events.length < MAX_EVENTS) {
+            this.events.push(event);
+            return;
+        }
+        this.events[this.next] = event;
+        this.next = (this.next + 1) % MAX_EVENTS;
+        this.dropped++;
+    }
+}
+
+/**
+ * Microseconds since the Unix epoch
+ */
+function now(): number {
+    return Math.round((performance.timeOrigin + performance.now()) * 1000);
+}
+
+function isThenable(value: unknown): value is PromiseLike<unknown> {
+    return typeof (value as PromiseLike<unknown> | undefined)?.then === 'function';
+}
+
+// Singleton instance
+let instance: Tracer | null = null;
+
+/**
+ * Get the singleton instance of Tracer
+ * @returns Tracer instance
+ */
+export function getTracer(): Tracer {
+    if (!instance) {
+        instance = new Tracer();
+    }
+    return instance;
+}
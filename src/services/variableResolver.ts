@@ -6,6 +6,8 @@
 import * as vscode from 'vscode';
 import * as path from 'path';
 import { CoreVariableResolver } from './coreVariableResolver';
+import { getPerformanceMonitor } from './performanceMonitor';
+import { getTracer } from './tracer';
 
 // Re-export ResolvedPath for convenience
 export { ResolvedPath } from './coreVariableResolver';
@@ -97,32 +99,54 @@ export class VariableResolver extends CoreVariableResolver {
     }
 
     /**
-     * Re-parse a single file incrementally
+     * Read and parse a file, traced as a parseFile span when tracing is on
      */
-    async reparseFile(filePath: string): Promise<void> {
-        this.removeDefinitionsForFile(filePath);
-        await this.parseFile(filePath);
-        logDebug(this.debugEnabled, `Reparsed file: ${filePath}`);
+    override parseFile(filePath: string, only?: ReadonlySet<string>): Promise<void> {
+        return getTracer().span('parseFile', 'resolver', () => super.parseFile(filePath, only), { file: filePath });
     }
 
     /**
-     * Remove definitions originating from a file (e.g., on delete)
+     * Parse file content, measured as resolver.parse when monitoring is on
      */
-    removeFile(filePath: string): void {
-        this.removeDefinitionsForFile(filePath);
-        logDebug(this.debugEnabled, `Removed definitions for file: ${filePath}`);
+    override parseFileContent(content: string, filePath: string, only?: ReadonlySet<string>): void {
+        const monitor = getPerformanceMonitor();
+        monitor.measure(
+            'resolver.parse',
+            monitor.isEnabled() ? content.split('\n').length : undefined,
+            () => super.parseFileContent(content, filePath, only)
+        );
     }
 
     /**
-     * Remove variables/definitions tied to a specific file
+     * Resolve a path expression, measured as resolver.resolve when monitoring is on
+     */
+    override resolvePath(pathExpression: string, maxDepth?: number) {
+        return getPerformanceMonitor().measure('resolver.resolve', undefined, () => super.resolvePath(pathExpression, maxDepth));
+    }
+
+    /**
+     * Re-parse a single file incrementally
+     * Files that assigned the same variables replay those assignments in parse order.
      */
-    private removeDefinitionsForFile(filePath: string): void {
-        for (const [name, def] of Array.from(this.definitions.entries())) {
-            if (def.file === filePath) {
-                this.definitions.delete(name);
-                this.variables.delete(name);
-            }
+    async reparseFile(filePath: string): Promise<void> {
+        const removal = this.removeDefinitionsForFile(filePath);
+        for (const file of this.sortByParseOrder([filePath, ...removal.files])) {
+            await this.parseFile(file, file === filePath ? undefined : removal.names);
+        }
+        logDebug(this.debugEnabled, `Reparsed file: ${filePath} (replayed ${removal.files.length} dependent files)`);
+    }
+
+    /**
+     * Remove definitions originating from a file (e.g., on delete)
+     * Files that also assigned those variables are replayed without it.
+     */
+    async removeFile(filePath: string): Promise<void> {
+        const removal = this.removeDefinitionsForFile(filePath);
+        this.fileOrder.delete(filePath);
+        for (const file of removal.files) {
+            await this.parseFile(file, removal.names);
         }
+        logDebug(this.debugEnabled, `Removed definitions for file: ${filePath}`);
     }
 }
 
@@ -0,0 +1,114 @@
+/**
+ * Xcconfig Cache
+ * Parsed .xcconfig files with their `#include`s inlined, keyed by path and
+ * invalidated when the file or anything it includes changes on disk. Shared
+ * base configurations are read once however many targets use them.
+ */
+
+import * as fs from 'fs';
+import { posix } from 'path';
+import { parseXcconfig, XcconfigAssignment } from '../parsers/xcconfigParser';
+import { XcodeprojParseOptions } from '../parsers/xcodeprojParser';
+import { FileStamp, isStampUnchanged, stampFile, stampFileOrMissing } from '../utils/fileStamp';
+import { estimateCollection, MemoryUsage } from '../utils/memoryEstimate';
+
+interface CachedXcconfig {
+    /** The file and every file it includes, as they were when parsed */
+    stamps: FileStamp[];
+    /** Assignments with includes inlined; undefined when the file could not be read */
+    assignments: XcconfigAssignment[] | undefined;
+}
+
+export class XcconfigCache {
+    private files = new Map<string, CachedXcconfig>();
+    /** Files being loaded, to break include cycles */
+    private loading = new Set<string>();
+    private parseCount = 0;
+
+    /**
+     * Load an xcconfig file, parsing it only if it is not cached or changed on disk
+     * @param filePath Absolute path with '/' separators
+     * @returns Assignments in evaluation order, or undefined if the file cannot be read
+     */
+    load(filePath: string): XcconfigAssignment[] | undefined {
+        const cached = this.files.get(filePath);
+        if (cached && cached.stamps.every(isStampUnchanged)) {
+            return cached.assignments;
+        }
+        const stamp = stampFile(filePath);
+        if (!stamp || this.loading.has(filePath)) {
+            return undefined;
+        }
+
+        this.loading.add(filePath);
+        const stamps = [stamp];
+        let assignments: XcconfigAssignment[] | undefined;
+        try {
+            const file = parseXcconfig(fs.readFileSync(filePath, 'utf8'), filePath);
+            this.parseCount++;
+            assignments = [];
+            for (const entry of file.entries) {
+                if (entry.kind === 'assignment') {
+                    assignments.push(entry);
+                    continue;
+                }
+                // Includes are relative to the including file; missing ones are skipped
+                const path = entry.path.replace(/\\/g, '/');
+                const includePath = posix.normalize(path.startsWith('/') ? path : posix.join(posix.dirname(filePath), path));
+                const included = this.load(includePath);
+                if (included) {
+                    assignments.push(...included);
+                }
+                stamps.push(...(this.files.get(includePath)?.stamps ?? [stampFileOrMissing(includePath)]));
+            }
+        } catch {
+            assignments = undefined;
+        } finally {
+            this.loading.delete(filePath);
+        }
+        this.files.set(filePath, { stamps, assignments });
+        return assignments;
+    }
+
+    /**
+     * Options for parseXcodeproj that read base configurations through this cache
+     */
+    getParseOptions(): XcodeprojParseOptions {
+        return {
+            loadXcconfig: (filePath) => this.load(filePath)
+        };
+    }
+
+    /**
+     * Number of times a file was read and parsed
+     */
+    getParseCount(): number {
+        return this.parseCount;
+    }
+
+    /**
+     * Cached files and their approximate size
+     */
+    getMemoryUsage(): MemoryUsage {
+        return estimateCollection(this.files);
+    }
+
+    clear(): void {
+        this.files.clear();
+        this.parseCount = 0;
+    }
+}
+
+// Singleton instance
+let instance: XcconfigCache | null = null;
+
+/**
+ * Get the singleton instance of XcconfigCache
+ * @returns XcconfigCache instance
+ */
+export function getXcconfigCache(): XcconfigCache {
+    if (!instance) {
+        instance = new XcconfigCache();
+    }
+    return instance;
+}
@@ -0,0 +1,214 @@
+/**
+ * Xcode Project Converter
+ * Converts every native target of an .xcodeproj to CMake. Dependencies
+ * between targets are resolved first; each target's section is then
+ * generated independently and the sections joined in project order.
+ * Sections are cheap string building, so they are generated in the calling
+ * thread; handing each parsed project to a worker would cost more.
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import { parseXcodeprojTargets, XcodeprojProject } from '../parsers/xcodeprojParser';
+import { parseXcworkspace } from '../parsers/xcworkspaceParser';
+import {
+    generateCMakeListsFromXcode,
+    generateSolutionCMakeLists,
+    generateXcodeProjectCMakeLists,
+    getGeneratedCMakeVersion,
+    getMaxCMakeVersion,
+    XcodeTarget,
+    XcodeTargetLinkContext
+} from '../parsers/cmakeGenerator';
+import { PoolCancellationToken, WorkerPoolCancelledError } from '../utils/workerPool';
+import { getXcconfigCache } from './xcconfigCache';
+import { SkippedProject, SolutionOutputFile } from './solutionConverter';
+
+/**
+ * One target's section to generate
+ */
+export interface XcodeTargetTask {
+    project: XcodeprojProject;
+    targets: XcodeTargetLinkContext;
+}
+
+export interface XcodeprojConversion {
+    /** Every native target, in project order */
+    projects: XcodeprojProject[];
+    /** Path of the generated CMakeLists.txt, next to the .xcodeproj */
+    path: string;
+    content: string;
+}
+
+export interface XcodeprojConversionOptions {
+    /** Called as target sections are generated */
+    onProgress?: (finished: number, total: number) => void;
+    token?: PoolCancellationToken;
+}
+
+/**
+ * Generate one target's section
+ */
+export function generateXcodeTargetSection(task: XcodeTargetTask): string {
+    return generateCMakeListsFromXcode(task.project, task.targets);
+}
+
+export interface XcworkspaceConversion {
+    /** Project CMakeLists.txt files in workspace order, then the top-level one */
+    files: SolutionOutputFile[];
+    skipped: SkippedProject[];
+    /** Number of converted targets across all projects */
+    targetCount: number;
+}
+
+/**
+ * Resolve each target's dependencies against the other targets of the project
+ * @param workspaceTargets Targets of other projects in the workspace, used
+ *        for dependencies not found in this project
+ * @returns Tasks in project order
+ */
+export function planXcodeTargets(
+    projects: readonly XcodeprojProject[],
+    workspaceTargets?: ReadonlyMap<string, XcodeTarget>
+): XcodeTargetTask[] {
+    const byName = new Map<string, XcodeTarget>();
+    for (const project of projects) {
+        byName.set(project.name, { name: project.name, type: project.type });
+    }
+    return projects.map(project => ({
+        project,
+        targets: {
+            dependencyTargets: (project.targetDependencies ?? []).map(name => byName.get(name) ?? workspaceTargets?.get(name))
+        }
+    }));
+}
+
+/**
+ * Generate the sections of every task, checking for cancellation between targets
+ */
+function generateXcodeTargetSections(tasks: XcodeTargetTask[], options: XcodeprojConversionOptions): string[] {
+    const sections: string[] = [];
+    for (const task of tasks) {
+        if (options.token?.isCancellationRequested) {
+            throw new WorkerPoolCancelledError();
+        }
+        sections.push(generateXcodeTargetSection(task));
+        options.onProgress?.(sections.length, tasks.length);
+    }
+    return sections;
+}
+
+/**
+ * Parse an Xcode project and convert all of its native targets
+ * A project with a single target converts exactly as before. Nothing is
+ * written; the caller writes XcodeprojConversion.content.
+ * @throws WorkerPoolCancelledError when cancelled through options.token
+ */
+export async function convertXcodeproj(xcodeprojPath: string, options: XcodeprojConversionOptions = {}): Promise<XcodeprojConversion> {
+    const content = await fs.promises.readFile(path.join(xcodeprojPath, 'project.pbxproj'), 'utf8');
+    const projects = parseXcodeprojTargets(content, xcodeprojPath, getXcconfigCache().getParseOptions());
+    if (projects.length === 0) {
+        throw new Error('No native target found in Xcode project');
+    }
+    const outputPath = path.join(path.dirname(xcodeprojPath), 'CMakeLists.txt');
+    if (projects.length === 1) {
+        options.onProgress?.(1, 1);
+        return { projects, path: outputPath, content: generateCMakeListsFromXcode(projects[0]) };
+    }
+
+    const sections = generateXcodeTargetSections(planXcodeTargets(projects), options);
+    const name = path.basename(xcodeprojPath, '.xcodeproj');
+    return { projects, path: outputPath, content: generateXcodeProjectCMakeLists(name, projects, sections) };
+}
+
+/**
+ * Parse an Xcode workspace and convert every native target of its projects
+ * Each project gets a CMakeLists.txt next to its .xcodeproj, with dependencies
+ * on targets of other projects linked by name; the workspace directory gets a
+ * top-level file adding each project directory. Base configurations shared
+ * between projects are read once through the xcconfig cache. Nothing is
+ * written; the caller writes XcworkspaceConversion.files.
+ * @throws WorkerPoolCancelledError when cancelled through options.token
+ */
+export async function convertXcworkspace(workspacePath: string, options: XcodeprojConversionOptions = {}): Promise<XcworkspaceConversion> {
+    const workspaceData = await fs.promises.readFile(path.join(workspacePath, 'contents.xcworkspacedata'), 'utf8');
+    const workspaceDir = path.dirname(workspacePath);
+    const parseOptions = getXcconfigCache().getParseOptions();
+
+    const skipped: SkippedProject[] = [];
+    const directories = new Set<string>();
+    /** Target name to the project that defines it */
+    const targetOwners = new Map<string, string>();
+    const converted: Array<{ xcodeprojPath: string; directory: string; projects: XcodeprojProject[] }> = [];
+    for (const projectPath of parseXcworkspace(workspaceData, workspacePath)) {
+        const xcodeprojPath = path.resolve(projectPath);
+        const name = path.basename(xcodeprojPath, '.xcodeproj');
+        const directory = path.relative(workspaceDir, path.dirname(xcodeprojPath)).replace(/\\/g, '/') || '.';
+        let projects: XcodeprojProject[] = [];
+        let reason: string | undefined;
+        try {
+            const content = await fs.promises.readFile(path.join(xcodeprojPath, 'project.pbxproj'), 'utf8');
+            projects = parseXcodeprojTargets(content, xcodeprojPath, parseOptions);
+        } catch (error) {
+            reason = error instanceof Error ? error.message : String(error);
+        }
+        if (reason === undefined) {
+            if (projects.length === 0) {
+                reason = 'No native target found in Xcode project';
+            } else if (directory === '.') {
+                reason = 'Project is in the workspace directory, which gets the top-level CMakeLists.txt';
+            } else if (directories.has(directory)) {
+                reason = `Another project already converts ${directory}`;
+            } else {
+                // CMake target names are global, so a second project defining one would fail at configure time
+                const clashes = projects.filter(project => targetOwners.has(project.name))
+                    .map(project => `${project.name} (${targetOwners.get(project.name)})`);
+                if (clashes.length > 0) {
+                    reason = `Target names already used by another project: ${clashes.join(', ')}`;
+                }
+            }
+        }
+        if (reason) {
+            skipped.push({ name, path: path.relative(workspaceDir, xcodeprojPath).replace(/\\/g, '/'), reason });
+            continue;
+        }
+        directories.add(directory);
+        for (const project of projects) {
+            targetOwners.set(project.name, name);
+        }
+        converted.push({ xcodeprojPath, directory, projects });
+    }
+
+    // Targets of other projects resolve dependencies a project cannot resolve itself
+    const workspaceTargets = new Map<string, XcodeTarget>();
+    for (const { projects } of converted) {
+        for (const project of projects) {
+            workspaceTargets.set(project.name, { name: project.name, type: project.type });
+        }
+    }
+    const plans = converted.map(item => planXcodeTargets(item.projects, workspaceTargets));
+    const sections = generateXcodeTargetSections(plans.flat(), options);
+
+    const files: SolutionOutputFile[] = [];
+    const versions: string[] = [];
+    let offset = 0;
+    converted.forEach((item, index) => {
+        const projectSections = sections.slice(offset, offset + plans[index].length);
+        offset += plans[index].length;
+        const name = path.basename(item.xcodeprojPath, '.xcodeproj');
+        const content = generateXcodeProjectCMakeLists(name, item.projects, projectSections);
+        versions.push(getGeneratedCMakeVersion(content) ?? '3.10');
+        files.push({ path: path.join(path.dirname(item.xcodeprojPath), 'CMakeLists.txt'), content });
+    });
+
+    files.push({
+        path: path.join(workspaceDir, 'CMakeLists.txt'),
+        content: generateSolutionCMakeLists(
+            path.basename(workspacePath, '.xcworkspace'),
+            converted.map(item => item.directory),
+            getMaxCMakeVersion(versions.length > 0 ? versions : ['3.10'])
+        )
+    });
+
+    return { files, skipped, targetCount: offset };
+}
@@ -0,0 +1,74 @@
+/**
+ * Tests for the benchmark regression gate
+ */
+
+import * as assert from 'assert';
+import { BenchFile, compareBenchFiles, mannWhitneyU } from '../bench/benchCompare';
+import { BenchResult } from '../bench/benchUtils';
+
+function result(name: string, samples: number[]): BenchResult {
+    const sorted = [...samples].sort((a, b) => a - b);
+    const median = sorted[Math.floor(sorted.length / 2)];
+    return { name, samples, min: sorted[0], median, mean: median, p50: median, p99: sorted[sorted.length - 1], opsPerSec: 1000 / median, allocatedBytes: 0 };
+}
+
+function benchFile(calibration: number, results: BenchResult[]): BenchFile {
+    return { version: 1, calibration, results };
+}
+
+/**
+ * Samples spread evenly around a center
+ */
+function samples(center: number, count = 20): number[] {
+    return Array.from({ length: count }, (_, i) => center * (0.9 + (0.2 * i) / (count - 1)));
+}
+
+describe('Benchmark comparison', () => {
+    describe('mannWhitneyU', () => {
+        it('should compute U and a small p-value for separated samples', () => {
+            const test = mannWhitneyU([6, 7, 8, 9, 10, 11, 12, 13], [1, 2, 3, 4, 5, 6, 7, 8]);
+            assert.strictEqual(test.u, 59.5);
+            assert.ok(test.z > 2);
+            assert.ok(test.pValue < 0.01);
+        });
+
+        it('should not find a difference between identical samples', () => {
+            const test = mannWhitneyU([1, 2, 3, 3, 4], [1, 2, 3, 3, 4]);
+            assert.ok(test.pValue > 0.4);
+        });
+    });
+
+    describe('compareBenchFiles', () => {
+        it('should flag significant slowdowns beyond tolerance only', () => {
+            const baseline = benchFile(10, [result('slow', samples(10)), result('noisy', samples(10)), result('fast', samples(10))]);
+            const current = benchFile(10, [
+                result('slow', samples(15)),
+                result('noisy', samples(10.5)),
+                result('fast', samples(5)),
+                result('added', samples(1))
+            ]);
+
+            assert.deepStrictEqual(
+                compareBenchFiles(baseline, current).map(comparison => comparison.status),
+                ['regressed', 'unchanged', 'improved', 'new']
+            );
+        });
+
+        it('should report baseline benchmarks missing from the run', () => {
+            const baseline = benchFile(10, [result('kept', samples(10)), result('dropped', samples(10))]);
+            const current = benchFile(10, [result('kept', samples(10))]);
+
+            assert.deepStrictEqual(
+                compareBenchFiles(baseline, current).map(comparison => [comparison.name, comparison.status]),
+                [['kept', 'unchanged'], ['dropped', 'missing']]
+            );
+        });
+
+        it('should scale the baseline by the calibration time', () => {
+            // The current machine is twice as slow, so 2x the time is no change
+            const comparisons = compareBenchFiles(benchFile(10, [result('a', samples(10))]), benchFile(20, [result('a', samples(20))]));
+            assert.strictEqual(comparisons[0].status, 'unchanged');
+            assert.ok(Math.abs(comparisons[0].ratio - 1) < 1e-9);
+        });
+    });
+});
@@ -0,0 +1,230 @@
+/**
+ * Tests for the command-line formatter and linter
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import {
+    parseCliArgs,
+    collectFiles,
+    processFile,
+    hashTask,
+    ResultCache,
+    createUnifiedDiff,
+    formatTextReport,
+    formatSarifReport,
+    stripJsonComments
+} from '../cli/cliUtils';
+import { lintCMakeText } from '../utils/lintUtils';
+import { runWorkerPool } from '../utils/workerPool';
+import { GOOGLE_STYLE_OPTIONS } from '../utils/formattingUtils';
+
+describe('CLI', () => {
+
+    describe('parseCliArgs', () => {
+        it('should parse commands, flags and paths', () => {
+            const options = parseCliArgs(['fmt', '--check', '-j4', '--format=sarif', 'src', 'cmake']);
+            assert.strictEqual(options.command, 'fmt');
+            assert.strictEqual(options.check, true);
+            assert.strictEqual(options.jobs, 4);
+            assert.strictEqual(options.format, 'sarif');
+            assert.deepStrictEqual(options.paths, ['src', 'cmake']);
+        });
+
+        it('should default to the current directory and the Google style', () => {
+            const options = parseCliArgs(['lint'], 3);
+            assert.deepStrictEqual(options.paths, ['.']);
+            assert.strictEqual(options.jobs, 3);
+            assert.deepStrictEqual(options.formatting, GOOGLE_STYLE_OPTIONS);
+        });
+
+        it('should apply style and line length overrides', () => {
+            const options = parseCliArgs(['fmt', '--style', 'microsoft', '--max-line-length', '60']);
+            assert.strictEqual(options.formatting.maxLineLength, 60);
+            assert.strictEqual(options.formatting.tabSize, 4);
+        });
+
+        it('should reject unknown commands and options', () => {
+            assert.throws(() => parseCliArgs(['build']), /Unknown command/);
+            assert.throws(() => parseCliArgs(['fmt', '--bogus']), /Unknown option/);
+            assert.throws(() => parseCliArgs(['lint', '--format', 'xml']), /Unknown format/);
+            assert.throws(() => parseCliArgs(['lint', '--jobs']), /Missing value/);
+        });
+
+        it('should read settings from a settings.json file', () => {
+            const file = path.join(os.tmpdir(), `cmake-companion-settings-${Date.now()}.json`);
+            fs.writeFileSync(file, `{
+    // editor settings
+    "cmake-companion.formatting.style": "kde",
+    "cmake-companion.formatting.maxLineLength": 100,
+    "cmake-companion.diagnostics.undefinedVariables": false,
+}`);
+            try {
+                const options = parseCliArgs(['lint', '--settings', file]);
+                assert.strictEqual(options.formatting.maxLineLength, 100);
+                assert.strictEqual(options.formatting.tabSize, 4);
+                assert.strictEqual(options.lint.undefinedVariables, false);
+            } finally {
+                fs.unlinkSync(file);
+            }
+        });
+
+        it('should strip comments but keep strings intact', () => {
+            assert.deepStrictEqual(JSON.parse(stripJsonComments('{"a": "x//y", /* c */ "b": 1,}')), { a: 'x//y', b: 1 });
+        });
+    });
+
+    describe('collectFiles', () => {
+        it('should find CMake files and skip build trees', () => {
+            const root = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-cli-'));
+            try {
+                fs.mkdirSync(path.join(root, 'lib'));
+                fs.mkdirSync(path.join(root, 'build'));
+                fs.mkdirSync(path.join(root, 'node_modules'));
+                fs.writeFileSync(path.join(root, 'CMakeLists.txt'), '');
+                fs.writeFileSync(path.join(root, 'lib', 'CMakeLists.txt'), '');
+                fs.writeFileSync(path.join(root, 'lib', 'util.cmake'), '');
+                fs.writeFileSync(path.join(root, 'lib', 'notes.txt'), '');
+                fs.writeFileSync(path.join(root, 'build', 'CMakeCache.txt'), '');
+                fs.writeFileSync(path.join(root, 'build', 'CMakeLists.txt'), '');
+                fs.writeFileSync(path.join(root, 'node_modules', 'x.cmake'), '');
+
+                const files = collectFiles([root]);
+                assert.deepStrictEqual(files.map(file => path.relative(root, file.path)), [
+                    'CMakeLists.txt',
+                    path.join('lib', 'CMakeLists.txt'),
+                    path.join('lib', 'util.cmake')
+                ]);
+                assert.deepStrictEqual(files.map(file => file.isSourceRoot), [true, false, false]);
+                assert.strictEqual(collectFiles([root], ['lib']).length, 1);
+            } finally {
+                fs.rmSync(root, { recursive: true, force: true });
+            }
+        });
+    });
+
+    describe('processFile', () => {
+        const options = parseCliArgs(['fmt']);
+
+        it('should report formatting changes', () => {
+            const result = processFile('fmt', { path: 'a.cmake', text: 'IF(A)\nset(B 1)\nENDIF()\n', isSourceRoot: false }, options.formatting, options.lint);
+            assert.strictEqual(result.changed, true);
+            assert.strictEqual(result.formatted, 'if(A)\n  set(B 1)\nendif()\n');
+            assert.strictEqual(result.issues[0].rule, 'format');
+            assert.strictEqual(result.issues[0].line, 0);
+        });
+
+        it('should keep CRLF line endings', () => {
+            const result = processFile('fmt', { path: 'a.cmake', text: 'if(A)\r\nset(B 1)\r\nendif()\r\n', isSourceRoot: false }, options.formatting, options.lint);
+            assert.strictEqual(result.formatted, 'if(A)\r\n  set(B 1)\r\nendif()\r\n');
+        });
+
+        it('should leave formatted files unchanged', () => {
+            const result = processFile('fmt', { path: 'a.cmake', text: 'set(A 1)\n', isSourceRoot: false }, options.formatting, options.lint);
+            assert.strictEqual(result.changed, false);
+            assert.deepStrictEqual(result.issues, []);
+        });
+
+        it('should lint with editor rule ids and severities', () => {
+            const result = processFile('lint', { path: 'a.cmake', text: 'if(A)\ninclude_directories(x)\n', isSourceRoot: false }, options.formatting, options.lint);
+            const rules = result.issues.map(issue => `${issue.rule}:${issue.severity}`);
+            assert.ok(rules.includes('unmatched-block:error'));
+            assert.ok(rules.includes('deprecated-command:hint'));
+        });
+    });
+
+    describe('lintCMakeText', () => {
+        it('should report positions and honour disabled checks', () => {
+            const issues = lintCMakeText('set(A ${B})\n', { deprecatedCommands: false });
+            assert.deepStrictEqual(issues.map(issue => [issue.rule, issue.line, issue.column, issue.endColumn]), [
+                ['undefined-variable', 0, 6, 10]
+            ]);
+            assert.deepStrictEqual(lintCMakeText('set(A ${B})\n', { undefinedVariables: false }), []);
+            assert.deepStrictEqual(lintCMakeText('set(A ${B})\n', { definedVariables: new Set(['B']) }), []);
+        });
+    });
+
+    describe('ResultCache', () => {
+        it('should return results only for matching hashes', () => {
+            const file = path.join(os.tmpdir(), `cmake-companion-cache-${Date.now()}.json`);
+            const options = parseCliArgs(['lint']);
+            const task = { path: 'x/CMakeLists.txt', text: 'if(A)\n', isSourceRoot: false };
+            const hash = hashTask('lint', options, task);
+            try {
+                const cache = new ResultCache(file, '1.0.0');
+                cache.load();
+                cache.set(task.path, hash, processFile('lint', task, options.formatting, options.lint));
+                cache.save();
+
+                const reloaded = new ResultCache(file, '1.0.0');
+                reloaded.load();
+                assert.strictEqual(reloaded.get(task.path, hash)!.issues[0].rule, 'unmatched-block');
+                const edited = hashTask('lint', options, { ...task, text: 'if(A)\nendif()\n' });
+                assert.strictEqual(reloaded.get(task.path, edited), undefined);
+                assert.notStrictEqual(hashTask('fmt', options, task), hash);
+
+                // Results written by another version of the tool are not reused
+                const upgraded = new ResultCache(file, '1.1.0');
+                upgraded.load();
+                assert.strictEqual(upgraded.get(task.path, hash), undefined);
+            } finally {
+                fs.rmSync(file, { force: true });
+            }
+        });
+    });
+
+    describe('runWorkerPool', () => {
+        it('should reject when a worker exits without finishing its batch', async () => {
+            const file = path.join(os.tmpdir(), `cmake-companion-worker-${Date.now()}.js`);
+            fs.writeFileSync(file, `require('worker_threads').parentPort.on('message', () => process.exit(3));`);
+            try {
+                await assert.rejects(
+                    runWorkerPool(file, [1, 2, 3], { jobs: 2, batchSize: 1 }),
+                    /exited with code 3/
+                );
+            } finally {
+                fs.rmSync(file, { force: true });
+            }
+        });
+    });
+
+    describe('reports', () => {
+        it('should render unified diffs with context', () => {
+            const oldText = ['a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j'].join('\n');
+            const newText = ['a', 'B', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'J'].join('\n');
+            assert.strictEqual(createUnifiedDiff('CMakeLists.txt', oldText, newText, 1), [
+                '--- a/CMakeLists.txt',
+                '+++ b/CMakeLists.txt',
+                '@@ -1,3 +1,3 @@',
+                ' a',
+                '-b',
+                '+B',
+                ' c',
+                '@@ -9,2 +9,2 @@',
+                ' i',
+                '-j',
+                '+J',
+                ''
+            ].join('\n'));
+            assert.strictEqual(createUnifiedDiff('x', 'same', 'same'), '');
+        });
+
+        it('should render text and SARIF reports with 1-based positions', () => {
+            const results = [{
+                path: 'CMakeLists.txt',
+                changed: false,
+                issues: [{ rule: 'unmatched-block', severity: 'error' as const, message: 'm', line: 2, column: 0, endLine: 2, endColumn: 5 }]
+            }];
+            assert.strictEqual(formatTextReport(results, 'lint', false), 'CMakeLists.txt:3:1: error: m [unmatched-block]');
+
+            const sarif = JSON.parse(formatSarifReport(results, '1.0.0'));
+            assert.strictEqual(sarif.version, '2.1.0');
+            const result = sarif.runs[0].results[0];
+            assert.strictEqual(result.level, 'error');
+            assert.deepStrictEqual(result.locations[0].physicalLocation.region, { startLine: 3, startColumn: 1, endLine: 3, endColumn: 6 });
+            assert.deepStrictEqual(sarif.runs[0].tool.driver.rules, [{ id: 'unmatched-block' }]);
+        });
+    });
+});
@@ -0,0 +1,110 @@
+/**
+ * Tests for CMake Command Parser
+ */
+
+import * as assert from 'assert';
+import { parseCommands } from '../parsers/cmakeCommandParser';
+
+describe('CMake Command Parser', () => {
+
+    describe('parseCommands', () => {
+        it('should parse a simple command', () => {
+            const result = parseCommands('set(MY_VAR value)');
+            assert.strictEqual(result.length, 1);
+            assert.strictEqual(result[0].name, 'set');
+            assert.deepStrictEqual(result[0].arguments.map(a => a.value), ['MY_VAR', 'value']);
+            assert.strictEqual(result[0].closed, true);
+        });
+
+        it('should track start and end lines (0-based)', () => {
+            const content = `project(A)
+
+add_library(foo
+    a.cpp
+    b.cpp
+)`;
+            const result = parseCommands(content);
+            assert.strictEqual(result.length, 2);
+            assert.strictEqual(result[1].line, 2);
+            assert.strictEqual(result[1].endLine, 5);
+            assert.strictEqual(result[1].arguments[2].line, 4);
+        });
+
+        it('should record start and end indices', () => {
+            const content = '  set(A 1)';
+            const [cmd] = parseCommands(content);
+            assert.strictEqual(cmd.startIndex, 2);
+            assert.strictEqual(cmd.endIndex, content.length);
+            assert.strictEqual(content.substring(cmd.arguments[1].startIndex, cmd.arguments[1].endIndex), '1');
+        });
+
+        it('should parse quoted arguments', () => {
+            const [cmd] = parseCommands('message(STATUS "hello (world) # not a comment")');
+            assert.strictEqual(cmd.arguments.length, 2);
+            assert.strictEqual(cmd.arguments[1].kind, 'quoted');
+            assert.strictEqual(cmd.arguments[1].value, 'hello (world) # not a comment');
+        });
+
+        it('should handle escaped quotes', () => {
+            const [cmd] = parseCommands('set(A "say \\"hi\\"")');
+            assert.strictEqual(cmd.arguments[1].value, 'say \\"hi\\"');
+        });
+
+        it('should parse bracket arguments', () => {
+            const [cmd] = parseCommands('set(A [==[\nraw ) "text" ]==])');
+            assert.strictEqual(cmd.arguments[1].kind, 'bracket');
+            assert.strictEqual(cmd.arguments[1].value, 'raw ) "text" ');
+        });
+
+        it('should skip line comments and record comments inside commands', () => {
+            const content = `# set(IGNORED 1)
+set(SOURCES
+    a.cpp # first
+    # b.cpp
+    c.cpp
+)`;
+            const result = parseCommands(content);
+            assert.strictEqual(result.length, 1);
+            assert.deepStrictEqual(result[0].arguments.map(a => a.value), ['SOURCES', 'a.cpp', 'c.cpp']);
+            assert.strictEqual(result[0].comments.length, 2);
+            assert.strictEqual(result[0].comments[0].text, '# first');
+        });
+
+        it('should skip bracket comments', () => {
+            const result = parseCommands('#[[\nset(IGNORED 1)\n]]\nset(A 1)');
+            assert.strictEqual(result.length, 1);
+            assert.strictEqual(result[0].line, 3);
+        });
+
+        it('should keep nested parentheses as arguments', () => {
+            const [cmd] = parseCommands('if((A OR B) AND C)');
+            assert.deepStrictEqual(cmd.arguments.map(a => a.value), ['(', 'A', 'OR', 'B', ')', 'AND', 'C']);
+        });
+
+        it('should allow whitespace between name and parenthesis', () => {
+            const result = parseCommands('endif ()');
+            assert.strictEqual(result.length, 1);
+            assert.strictEqual(result[0].name, 'endif');
+        });
+
+        it('should keep variable references and generator expressions intact', () => {
+            const [cmd] = parseCommands('target_include_directories(foo PUBLIC $<BUILD_INTERFACE:${DIR}/include>)');
+            assert.strictEqual(cmd.arguments[2].value, '$<BUILD_INTERFACE:${DIR}/include>');
+        });
+
+        it('should keep legacy quoted sections in unquoted arguments', () => {
+            const [cmd] = parseCommands('add_definitions(-DNAME="a b")');
+            assert.deepStrictEqual(cmd.arguments.map(a => a.value), ['-DNAME="a b"']);
+        });
+
+        it('should mark unterminated commands', () => {
+            const [cmd] = parseCommands('set(A 1');
+            assert.strictEqual(cmd.closed, false);
+        });
+
+        it('should ignore identifiers without parentheses', () => {
+            const result = parseCommands('just some text\nset(A 1)');
+            assert.strictEqual(result.length, 1);
+        });
+    });
+});
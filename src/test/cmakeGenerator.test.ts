@@ -751,6 +751,45 @@ describe('CMake Generator', () => {
             const cmake = generateCMakeLists(project);
             assert.ok(cmake.includes('cmake_minimum_required(VERSION 3.13)'));
         });
+
+        describe('fast build profile', () => {
+            const profile = { compilerLauncher: 'ccache' };
+
+            it('should generate a unity build sized by the number of sources', () => {
+                const sourceFiles = Array.from({ length: 40 }, (_, i) => `src/file${i}.cpp`);
+                const project = makeVcxProject({
+                    sourceFiles,
+                    pchConfig: { enabled: true, headerFile: 'pch.h', excludedFiles: ['src/file0.cpp'] }
+                });
+
+                const cmake = generateCMakeLists(project, undefined, profile);
+
+                assert.ok(cmake.includes('cmake_minimum_required(VERSION 3.16)'));
+                assert.ok(cmake.includes('    UNITY_BUILD ON\n    UNITY_BUILD_BATCH_SIZE 5\n'));
+                assert.ok(cmake.includes('    src/file0.cpp\n    PROPERTIES SKIP_UNITY_BUILD_INCLUSION ON'));
+                assert.ok(!generateCMakeLists(makeVcxProject(), undefined, profile).includes('UNITY_BUILD'));
+                assert.ok(!generateCMakeLists(project).includes('UNITY_BUILD'));
+            });
+
+            it('should find the compiler launcher and keep /MP for Visual Studio generators only', () => {
+                const project = makeVcxProject({ multiProcessorCompilation: true, warningLevel: 4 });
+
+                const cmake = generateCMakeLists(project, undefined, profile);
+
+                assert.ok(cmake.includes('find_program(CCACHE_PROGRAM ccache)\nif(CCACHE_PROGRAM)\n    set(CMAKE_C_COMPILER_LAUNCHER ${CCACHE_PROGRAM})'));
+                assert.ok(cmake.includes('target_compile_options(${PROJECT_NAME} PRIVATE\n    $<$<CXX_COMPILER_ID:MSVC>:/W4>\n)'));
+                assert.ok(cmake.includes('if(CMAKE_GENERATOR MATCHES "Visual Studio")\n    target_compile_options(${PROJECT_NAME} PRIVATE /MP)\nendif()'));
+                assert.ok(!cmake.includes('JOB_POOL'));
+                assert.ok(!generateCMakeLists(project, undefined, {}).includes('COMPILER_LAUNCHER'));
+            });
+
+            it('should reuse a precompiled header named by the solution', () => {
+                const project = makeVcxProject({ pchConfig: { enabled: true, headerFile: '../common/pch.h', excludedFiles: [] } });
+                const cmake = generateCMakeLists(project, { referenceTargets: [], dependencyTargets: [], pchReuseFrom: 'Core' }, profile);
+                assert.ok(cmake.includes('target_precompile_headers(${PROJECT_NAME} REUSE_FROM Core)'));
+                assert.ok(!cmake.includes('PRIVATE ../common/pch.h'));
+            });
+        });
     });
 
     describe('generateCMakeListsFromXcode', () => {
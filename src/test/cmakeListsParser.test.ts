@@ -71,6 +71,14 @@ set(ACTUAL "value")`;
             assert.strictEqual(result[0].name, 'ACTUAL');
         });
         
+        it('should only match set() itself and stop values at PARENT_SCOPE', () => {
+            const content = `my_set(NOT_A_SET x)
+set(LIBS a b PARENT_SCOPE)`;
+            const result = parseSetCommands(content, '/path/CMakeLists.txt');
+            
+            assert.deepStrictEqual(result.map(def => [def.name, def.value, def.isCache]), [['LIBS', 'a;b', false]]);
+        });
+        
         it('should parse path values', () => {
             const content = 'set(MY_PATH "${CMAKE_SOURCE_DIR}/include")';
             const result = parseSetCommands(content, '/path/CMakeLists.txt');
@@ -319,6 +319,188 @@ set(OTHER_VAR "world")
         });
     });
 
+    describe('list() and string() evaluation', () => {
+        it('should append to a list defined with set()', () => {
+            const content = `set(SOURCES a.cpp)
+list(APPEND SOURCES b.cpp c.cpp)
+list(APPEND SOURCES d.cpp)`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getVariable('SOURCES'), 'a.cpp;b.cpp;c.cpp;d.cpp');
+            assert.deepStrictEqual(resolver.getList('SOURCES'), ['a.cpp', 'b.cpp', 'c.cpp', 'd.cpp']);
+        });
+
+        it('should keep the set() definition site after list(APPEND)', () => {
+            const content = `set(SOURCES a.cpp)\nlist(APPEND SOURCES b.cpp)`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getDefinition('SOURCES')!.line, 1);
+        });
+
+        it('should create a list on APPEND to an undefined variable', () => {
+            resolver.parseFileContent('list(APPEND NEW_LIST x y)', '/project/CMakeLists.txt');
+            assert.deepStrictEqual(resolver.getList('NEW_LIST'), ['x', 'y']);
+            assert.strictEqual(resolver.getDefinition('NEW_LIST')!.line, 1);
+        });
+
+        it('should remove items and duplicates', () => {
+            const content = `set(L a b c b a)
+list(REMOVE_ITEM L c)
+list(REMOVE_DUPLICATES L)`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.deepStrictEqual(resolver.getList('L'), ['a', 'b']);
+        });
+
+        it('should expand list variables in arguments', () => {
+            const content = `set(A x y)
+set(B z)
+list(APPEND B \${A})
+list(LENGTH B B_LEN)`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.deepStrictEqual(resolver.getList('B'), ['z', 'x', 'y']);
+            assert.strictEqual(resolver.getVariable('B_LEN'), '3');
+        });
+
+        it('should see list values in later set() commands', () => {
+            const content = `set(A x)
+list(APPEND A y)
+set(B "\${A}")`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getVariable('B'), 'x;y');
+        });
+
+        it('should support PREPEND, INSERT, REVERSE, SORT, GET, JOIN and FIND', () => {
+            const content = `set(L b c)
+list(PREPEND L a)
+list(INSERT L 1 x)
+list(GET L 0 -1 ENDS)
+list(JOIN L "," JOINED)
+list(FIND L c C_INDEX)
+list(REVERSE L)
+list(SORT L)`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getVariable('ENDS'), 'a;c');
+            assert.strictEqual(resolver.getVariable('JOINED'), 'a,x,b,c');
+            assert.strictEqual(resolver.getVariable('C_INDEX'), '3');
+            assert.deepStrictEqual(resolver.getList('L'), ['a', 'b', 'c', 'x']);
+        });
+
+        it('should filter and transform lists', () => {
+            const content = `set(FILES a.cpp b.h c.cpp)
+list(FILTER FILES INCLUDE REGEX "\\.cpp$")
+list(TRANSFORM FILES PREPEND "src/")`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.deepStrictEqual(resolver.getList('FILES'), ['src/a.cpp', 'src/c.cpp']);
+        });
+
+        it('should evaluate string(REPLACE) and string(REGEX REPLACE)', () => {
+            const content = `set(NAME "my-lib")
+string(REPLACE "-" "_" SAFE_NAME \${NAME})
+string(REGEX REPLACE "^my_(.*)$" "lib\\1" SHORT \${SAFE_NAME})
+string(TOUPPER \${SAFE_NAME} UPPER_NAME)`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getVariable('SAFE_NAME'), 'my_lib');
+            assert.strictEqual(resolver.getVariable('SHORT'), 'liblib');
+            assert.strictEqual(resolver.getVariable('UPPER_NAME'), 'MY_LIB');
+        });
+
+        it('should evaluate string(APPEND) and string(CONCAT)', () => {
+            const content = `set(FLAGS "-O2")
+string(APPEND FLAGS " -g")
+string(CONCAT BOTH "a" "b")`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getVariable('FLAGS'), '-O2 -g');
+            assert.strictEqual(resolver.getVariable('BOTH'), 'ab');
+        });
+
+        it('should ignore list() commands in comments', () => {
+            const content = `set(L a)\n# list(APPEND L b)`;
+            resolver.parseFileContent(content, '/project/CMakeLists.txt');
+            assert.deepStrictEqual(resolver.getList('L'), ['a']);
+        });
+
+        it('should not grow a list appended from another file on reparse', () => {
+            const files: Record<string, string> = {
+                '/project/a.cmake': 'set(SOURCES a.cpp)',
+                '/project/b.cmake': 'list(APPEND SOURCES b.cpp)\nstring(APPEND FLAGS " -g")'
+            };
+            const readFile = (file: string) => files[file];
+            resolver.parseFileContent(files['/project/a.cmake'], '/project/a.cmake');
+            resolver.parseFileContent(files['/project/b.cmake'], '/project/b.cmake');
+
+            resolver.reparseFileContent(files['/project/b.cmake'], '/project/b.cmake', readFile);
+            resolver.reparseFileContent(files['/project/b.cmake'], '/project/b.cmake', readFile);
+            assert.deepStrictEqual(resolver.getList('SOURCES'), ['a.cpp', 'b.cpp']);
+            assert.strictEqual(resolver.getVariable('FLAGS'), ' -g');
+
+            files['/project/a.cmake'] = 'set(SOURCES main.cpp)';
+            resolver.reparseFileContent(files['/project/a.cmake'], '/project/a.cmake', readFile);
+            assert.deepStrictEqual(resolver.getList('SOURCES'), ['main.cpp', 'b.cpp']);
+            assert.strictEqual(resolver.getDefinition('SOURCES')!.file, '/project/a.cmake');
+
+            files['/project/b.cmake'] = '';
+            resolver.reparseFileContent('', '/project/b.cmake', readFile);
+            assert.deepStrictEqual(resolver.getList('SOURCES'), ['main.cpp']);
+            assert.strictEqual(resolver.hasVariable('FLAGS'), false);
+        });
+
+        it('should only replay the files that assigned the changed variables', () => {
+            const files: Record<string, string> = {
+                '/project/a.cmake': 'set(SOURCES a.cpp)',
+                '/project/c.cmake': 'set(FLAGS -O2)',
+                '/project/b.cmake': 'list(APPEND SOURCES b.cpp)\nlist(APPEND FLAGS -g)'
+            };
+            const read: string[] = [];
+            const readFile = (file: string) => {
+                read.push(file);
+                return files[file];
+            };
+            for (const file of ['/project/a.cmake', '/project/c.cmake', '/project/b.cmake']) {
+                resolver.parseFileContent(files[file], file);
+            }
+
+            files['/project/a.cmake'] = 'set(SOURCES main.cpp)';
+            resolver.reparseFileContent(files['/project/a.cmake'], '/project/a.cmake', readFile);
+            assert.deepStrictEqual(read, ['/project/b.cmake']);
+            assert.deepStrictEqual(resolver.getList('SOURCES'), ['main.cpp', 'b.cpp']);
+            assert.deepStrictEqual(resolver.getList('FLAGS'), ['-O2', '-g']);
+        });
+
+        it('should expose list items from resolvePath for a list variable', () => {
+            resolver.parseFileContent('set(L /a/x.cpp)\nlist(APPEND L /a/y.cpp)', '/project/CMakeLists.txt');
+            const resolved = resolver.resolvePath('${L}');
+            assert.strictEqual(resolved.resolved, '/a/x.cpp;/a/y.cpp');
+            assert.deepStrictEqual(resolved.items, ['/a/x.cpp', '/a/y.cpp']);
+        });
+
+        it('should share list structure between set(B ${A}) and A', () => {
+            resolver.parseFileContent('set(A x y)\nlist(APPEND A z)\nset(B ${A})', '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getList('A'), resolver.getList('B'));
+        });
+
+        it('should handle many appends', () => {
+            const lines = ['set(BIG first)'];
+            for (let i = 0; i < 500; i++) {
+                lines.push(`list(APPEND BIG file${i}.cpp)`);
+            }
+            resolver.parseFileContent(lines.join('\n'), '/project/CMakeLists.txt');
+            const items = resolver.getList('BIG')!;
+            assert.strictEqual(items.length, 501);
+            assert.strictEqual(items[500], 'file499.cpp');
+        });
+
+        it('should report list variables in names and getAllVariables', () => {
+            resolver.parseFileContent('list(APPEND L a b)', '/project/CMakeLists.txt');
+            assert.ok(resolver.hasVariable('L'));
+            assert.ok(resolver.getVariableNames().includes('L'));
+            assert.strictEqual(resolver.getAllVariables().get('L'), 'a;b');
+        });
+
+        it('should replace a list with a plain set()', () => {
+            resolver.parseFileContent('list(APPEND L a b)\nset(L c)', '/project/CMakeLists.txt');
+            assert.strictEqual(resolver.getVariable('L'), 'c');
+            assert.deepStrictEqual(resolver.getList('L'), ['c']);
+        });
+    });
+
     describe('parseFile', () => {
         it('should handle non-existent file gracefully', async () => {
             // Should not throw
@@ -9,6 +9,8 @@ import {
     findUndefinedVariables,
     findUnmatchedBlocks,
     findDeprecatedCommands,
+    findBuildPerformanceIssues,
+    resolveBuildPerformanceSeverities,
     BLOCK_PAIRS,
     DEPRECATED_COMMANDS
 } from '../utils/diagnosticUtils';
@@ -290,4 +292,110 @@ link_libraries(lib)`;
             assert.strictEqual(deprecated[1].line, 3);
         });
     });
+    
+    describe('findBuildPerformanceIssues', () => {
+        const checks = (text: string, options = {}) =>
+            findBuildPerformanceIssues(text, options).map(issue => issue.check);
+        
+        it('should flag GLOB_RECURSE over the source root', () => {
+            assert.deepStrictEqual(checks('file(GLOB_RECURSE SRCS ${CMAKE_SOURCE_DIR}/*.cpp)'), ['glob-recurse-source-root']);
+            assert.deepStrictEqual(checks('file(GLOB_RECURSE SRCS ${PROJECT_SOURCE_DIR}/src/*.cpp)'), []);
+        });
+        
+        it('should treat relative globs as the source root only in the top-level file', () => {
+            const text = 'file(GLOB_RECURSE SRCS RELATIVE ${CMAKE_SOURCE_DIR} *.cpp)';
+            assert.deepStrictEqual(checks(text), []);
+            assert.deepStrictEqual(checks(text, { isSourceRoot: true }), ['glob-recurse-source-root']);
+            assert.deepStrictEqual(checks('file(GLOB_RECURSE S ${CMAKE_CURRENT_SOURCE_DIR}/*.h)', { isSourceRoot: true }), ['glob-recurse-source-root']);
+        });
+        
+        it('should flag CONFIGURE_DEPENDS on recursive globs only', () => {
+            assert.deepStrictEqual(checks('file(GLOB_RECURSE S CONFIGURE_DEPENDS src/*.cpp)'), ['configure-depends']);
+            assert.deepStrictEqual(checks('file(GLOB S CONFIGURE_DEPENDS src/*.cpp)'), []);
+        });
+        
+        it('should flag execute_process and include_directories', () => {
+            const text = `execute_process(COMMAND git rev-parse HEAD)
+include_directories(include)`;
+            const issues = findBuildPerformanceIssues(text);
+            assert.deepStrictEqual(issues.map(i => [i.check, i.line]), [
+                ['configure-time-process', 0],
+                ['global-include-directories', 1]
+            ]);
+            assert.strictEqual(text.substring(issues[1].startIndex, issues[1].endIndex), 'include_directories');
+        });
+        
+        it('should flag repeated find_package calls', () => {
+            const text = `find_package(Boost REQUIRED)
+find_package(Threads)
+find_package(Boost COMPONENTS system)`;
+            const issues = findBuildPerformanceIssues(text);
+            assert.strictEqual(issues.length, 1);
+            assert.strictEqual(issues[0].check, 'duplicate-find-package');
+            assert.strictEqual(issues[0].line, 2);
+            assert.ok(issues[0].message.includes('line 1'));
+        });
+        
+        it('should not flag find_package in separate branches', () => {
+            const text = `if(WIN32)
+  find_package(Foo)
+else()
+  find_package(Foo)
+endif()
+function(f)
+  find_package(Bar)
+endfunction()
+find_package(Bar)`;
+            assert.deepStrictEqual(checks(text), []);
+        });
+        
+        it('should flag large targets without PCH or unity builds', () => {
+            const sources = Array.from({ length: 5 }, (_, i) => `s${i}.cpp`).join(' ');
+            assert.deepStrictEqual(checks(`add_library(big STATIC ${sources})`, { largeTargetSources: 5 }), ['large-target-without-pch']);
+            assert.deepStrictEqual(checks(`add_library(big ${sources})\ntarget_precompile_headers(big PRIVATE pch.h)`, { largeTargetSources: 5 }), []);
+            assert.deepStrictEqual(checks(`add_library(big ${sources})\nset_target_properties(big PROPERTIES UNITY_BUILD ON)`, { largeTargetSources: 5 }), []);
+            assert.deepStrictEqual(checks(`set(CMAKE_UNITY_BUILD ON)\nadd_library(big ${sources})`, { largeTargetSources: 5 }), []);
+            assert.deepStrictEqual(checks(`add_library(big ${sources})\nset_target_properties(big PROPERTIES UNITY_BUILD OFF)`, { largeTargetSources: 5 }), ['large-target-without-pch']);
+            assert.deepStrictEqual(checks(`add_library(big ${sources})\nset_property(TARGET big PROPERTY UNITY_BUILD_BATCH_SIZE 8)`, { largeTargetSources: 5 }), ['large-target-without-pch']);
+            assert.deepStrictEqual(checks(`add_library(big ${sources})\nset_property(TARGET big PROPERTY UNITY_BUILD TRUE)`, { largeTargetSources: 5 }), []);
+        });
+        
+        it('should count sources of list variables through the callback', () => {
+            const options = { largeTargetSources: 100, getListLength: (name: string) => name === 'SRCS' ? 120 : undefined };
+            assert.deepStrictEqual(checks('add_executable(app ${SRCS})', options), ['large-target-without-pch']);
+            assert.deepStrictEqual(checks('add_executable(app ${OTHER})', options), []);
+        });
+        
+        it('should skip imported, alias and interface targets', () => {
+            assert.deepStrictEqual(checks('add_library(x INTERFACE a b c)', { largeTargetSources: 1 }), []);
+            assert.deepStrictEqual(checks('add_library(x ALIAS y)', { largeTargetSources: 1 }), []);
+        });
+        
+        it('should ignore commands in comments', () => {
+            assert.deepStrictEqual(checks('# execute_process(COMMAND x)\n#[[ include_directories(a) ]]'), []);
+        });
+        
+        it('should scale linearly on large files', () => {
+            const text = Array.from({ length: 20000 }, (_, i) => `find_package(P${i})\nif(A)\nendif()`).join('\n');
+            const start = Date.now();
+            assert.strictEqual(findBuildPerformanceIssues(text).length, 0);
+            assert.ok(Date.now() - start < 2000);
+        });
+    });
+    
+    describe('resolveBuildPerformanceSeverities', () => {
+        it('should apply valid overrides and keep defaults', () => {
+            const severities = resolveBuildPerformanceSeverities({
+                'configure-time-process': 'off',
+                'duplicate-find-package': 'error',
+                'unknown-check': 'error',
+                'global-include-directories': 'loud'
+            });
+            assert.strictEqual(severities['configure-time-process'], 'off');
+            assert.strictEqual(severities['duplicate-find-package'], 'error');
+            assert.strictEqual(severities['global-include-directories'], 'information');
+            assert.strictEqual(severities['glob-recurse-source-root'], 'warning');
+            assert.ok(!('unknown-check' in severities));
+        });
+    });
 });
@@ -0,0 +1,138 @@
+/**
+ * Tests for line diff utilities
+ */
+
+import * as assert from 'assert';
+import { diffLines, computeLineEdits, LineTextEdit } from '../utils/diffUtils';
+
+/**
+ * Apply edits (in document order) to lines joined with '\n'
+ */
+function applyEdits(lines: string[], edits: LineTextEdit[]): string {
+    const starts: number[] = [];
+    let offset = 0;
+    for (const line of lines) {
+        starts.push(offset);
+        offset += line.length + 1;
+    }
+    let text = lines.join('\n');
+    for (const edit of edits.slice().reverse()) {
+        const start = starts[edit.startLine] + edit.startCharacter;
+        const end = starts[edit.endLine] + edit.endCharacter;
+        text = text.substring(0, start) + edit.newText + text.substring(end);
+    }
+    return text;
+}
+
+/**
+ * Deterministic pseudo-random generator for mutation tests
+ */
+function random(seed: number): () => number {
+    let state = seed;
+    return () => {
+        state = (state * 1103515245 + 12345) & 0x7fffffff;
+        return state / 0x7fffffff;
+    };
+}
+
+describe('Diff Utils', () => {
+
+    describe('diffLines', () => {
+        it('should return no hunks for equal input', () => {
+            assert.deepStrictEqual(diffLines(['a', 'b'], ['a', 'b']), []);
+        });
+
+        it('should find a single changed line', () => {
+            assert.deepStrictEqual(diffLines(['a', 'b', 'c'], ['a', 'x', 'c']), [
+                { oldStart: 1, oldEnd: 2, newStart: 1, newEnd: 2 }
+            ]);
+        });
+
+        it('should find insertions and deletions', () => {
+            assert.deepStrictEqual(diffLines(['a', 'c'], ['a', 'b', 'c']), [
+                { oldStart: 1, oldEnd: 1, newStart: 1, newEnd: 2 }
+            ]);
+            assert.deepStrictEqual(diffLines(['a', 'b', 'c'], ['a', 'c']), [
+                { oldStart: 1, oldEnd: 2, newStart: 1, newEnd: 1 }
+            ]);
+        });
+
+        it('should keep separate hunks for separate changes', () => {
+            const hunks = diffLines(['a', 'b', 'c', 'd', 'e'], ['A', 'b', 'c', 'd', 'E']);
+            assert.strictEqual(hunks.length, 2);
+            assert.deepStrictEqual(hunks[0], { oldStart: 0, oldEnd: 1, newStart: 0, newEnd: 1 });
+            assert.deepStrictEqual(hunks[1], { oldStart: 4, oldEnd: 5, newStart: 4, newEnd: 5 });
+        });
+
+        it('should produce a minimal script around moved lines', () => {
+            const hunks = diffLines(['x', 'a', 'b', 'c', 'y'], ['x', 'b', 'c', 'a', 'y']);
+            const changed = hunks.reduce((sum, h) => sum + (h.oldEnd - h.oldStart) + (h.newEnd - h.newStart), 0);
+            assert.strictEqual(changed, 2);
+        });
+
+        it('should fall back to one hunk beyond the edit distance bound', () => {
+            const hunks = diffLines(['a', 'b', 'c', 'd'], ['w', 'x', 'y', 'z'], 2);
+            assert.deepStrictEqual(hunks, [{ oldStart: 0, oldEnd: 4, newStart: 0, newEnd: 4 }]);
+        });
+    });
+
+    describe('computeLineEdits', () => {
+        const check = (oldLines: string[], newLines: string[]) => {
+            const edits = computeLineEdits(oldLines, newLines);
+            assert.strictEqual(applyEdits(oldLines, edits), newLines.join('\n'));
+            return edits;
+        };
+
+        it('should produce no edits for equal input', () => {
+            assert.deepStrictEqual(check(['a', 'b'], ['a', 'b']), []);
+        });
+
+        it('should replace only changed lines', () => {
+            const edits = check(['a', '  b', 'c'], ['a', 'b', 'c']);
+            assert.deepStrictEqual(edits, [{ startLine: 1, startCharacter: 0, endLine: 1, endCharacter: 3, newText: 'b' }]);
+        });
+
+        it('should handle insertion and deletion at the edges', () => {
+            check(['a', 'b'], ['x', 'a', 'b']);
+            check(['a', 'b'], ['a', 'b', 'x']);
+            check(['x', 'a', 'b'], ['a', 'b']);
+            check(['a', 'b', 'x'], ['a', 'b']);
+            check(['a'], ['']);
+        });
+
+        it('should use the given line terminator for inserted lines', () => {
+            const edits = computeLineEdits(['a', 'c'], ['a', 'b', 'c'], '\r\n');
+            assert.strictEqual(edits[0].newText, 'b\r\n');
+        });
+
+        it('should round-trip random mutations', () => {
+            const next = random(42);
+            for (let round = 0; round < 200; round++) {
+                const oldLines = Array.from({ length: 1 + Math.floor(next() * 30) }, () => String(Math.floor(next() * 6)));
+                const newLines = oldLines.slice();
+                const mutations = Math.floor(next() * 6);
+                for (let i = 0; i < mutations; i++) {
+                    const at = Math.floor(next() * (newLines.length + 1));
+                    const op = next();
+                    if (op < 0.33 && newLines.length > 1) {
+                        newLines.splice(Math.min(at, newLines.length - 1), 1);
+                    } else if (op < 0.66) {
+                        newLines.splice(at, 0, 'n' + i);
+                    } else if (newLines.length > 0) {
+                        newLines[Math.min(at, newLines.length - 1)] = 'm' + i;
+                    }
+                }
+                check(oldLines, newLines);
+            }
+        });
+
+        it('should touch only changed lines of a large document', () => {
+            const oldLines = Array.from({ length: 10000 }, (_, i) => `set(V${i} ${i})`);
+            const newLines = oldLines.slice();
+            newLines[10] = '  ' + newLines[10];
+            newLines[9000] = 'changed()';
+            const edits = check(oldLines, newLines);
+            assert.deepStrictEqual(edits.map(e => e.startLine), [10, 9000]);
+        });
+    });
+});
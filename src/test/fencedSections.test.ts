@@ -0,0 +1,80 @@
+/**
+ * Tests for fenced generated sections and incremental re-conversion
+ */
+
+import * as assert from 'assert';
+import { parseVcxproj } from '../parsers/vcxprojParser';
+import { generateCMakeLists, generateFencedCMakeLists } from '../parsers/cmakeGenerator';
+import { mergeFencedSections } from '../utils/fencedSections';
+import { planResync } from '../services/cmakeResync';
+
+function makeProject(sources: string[], definitions: string, includes?: string) {
+    return parseVcxproj(`<?xml version="1.0" encoding="utf-8"?>
+<Project>
+  <PropertyGroup Label="Globals"><ProjectName>App</ProjectName></PropertyGroup>
+  <PropertyGroup><ConfigurationType>Application</ConfigurationType></PropertyGroup>
+  <ItemDefinitionGroup>
+    <ClCompile>
+      <PreprocessorDefinitions>${definitions};%(PreprocessorDefinitions)</PreprocessorDefinitions>
+      ${includes ? `<AdditionalIncludeDirectories>${includes}</AdditionalIncludeDirectories>` : ''}
+    </ClCompile>
+  </ItemDefinitionGroup>
+  <ItemGroup>${sources.map(file => `<ClCompile Include="${file}" />`).join('')}</ItemGroup>
+</Project>`, '/p/App.vcxproj');
+}
+
+describe('Fenced Sections', () => {
+    it('should fence sections without changing the generated lines', () => {
+        const project = makeProject(['main.cpp'], 'APP', 'include');
+        const fenced = generateFencedCMakeLists(project);
+
+        assert.ok(fenced.includes('# cmake-companion begin sources\n# Source files\n'));
+        assert.match(fenced, /\)\n# cmake-companion end sources [0-9a-f]{12}\n\n# cmake-companion begin target\n/);
+        const stripped = fenced.split('\n').filter(line => !line.startsWith('# cmake-companion ')).join('\n');
+        assert.strictEqual(stripped, generateCMakeLists(project));
+    });
+
+    it('should update changed sections and keep edited ones and text outside fences', () => {
+        const original = generateFencedCMakeLists(makeProject(['main.cpp'], 'APP'));
+        const edited = original
+            .replace('    APP\n', '    APP\n    HAND_EDITED\n')
+            .replace('# cmake-companion begin sources', '# Added by hand\nset(EXTRA ON)\n\n# cmake-companion begin sources');
+        const regenerated = generateFencedCMakeLists(makeProject(['main.cpp', 'util.cpp'], 'APP;NEW', 'include'));
+
+        const merge = mergeFencedSections(edited, regenerated);
+
+        assert.deepStrictEqual(merge.updated, ['sources', 'include-directories']);
+        assert.deepStrictEqual(merge.kept, ['definitions']);
+        assert.ok(merge.content.includes('# Added by hand\nset(EXTRA ON)\n'));
+        assert.ok(merge.content.includes('    main.cpp\n    util.cpp\n'));
+        assert.ok(merge.content.includes('    APP\n    HAND_EDITED\n'));
+        assert.ok(!merge.content.includes('NEW'));
+        assert.ok(/# cmake-companion end target \w+\n\n# cmake-companion begin include-directories\n/.test(merge.content));
+        assert.ok(/# cmake-companion end include-directories \w+\n\n# cmake-companion begin definitions\n/.test(merge.content));
+
+        // Merging the same output again changes nothing
+        assert.strictEqual(mergeFencedSections(merge.content, regenerated).content, merge.content);
+    });
+
+    it('should remove sections that are no longer generated', () => {
+        const original = generateFencedCMakeLists(makeProject(['main.cpp'], 'APP', 'include'));
+        const regenerated = generateFencedCMakeLists(makeProject(['main.cpp'], 'APP'));
+
+        const merge = mergeFencedSections(original, regenerated);
+
+        assert.deepStrictEqual(merge.updated, ['include-directories']);
+        assert.strictEqual(merge.content, regenerated);
+    });
+
+    it('should plan writes by existing content', () => {
+        const generated = generateFencedCMakeLists(makeProject(['main.cpp'], 'APP'));
+        assert.strictEqual(planResync('CMakeLists.txt', undefined, generated).action, 'create');
+        assert.strictEqual(planResync('CMakeLists.txt', generated, generated).action, 'unchanged');
+        assert.strictEqual(planResync('CMakeLists.txt', generated.replace(/\n/g, '\r\n'), generated).action, 'unchanged');
+        assert.strictEqual(planResync('CMakeLists.txt', 'project(Manual)\n', generated).action, 'overwrite');
+        const changed = generateFencedCMakeLists(makeProject(['main.cpp', 'b.cpp'], 'APP'));
+        const plan = planResync('CMakeLists.txt', generated, changed);
+        assert.strictEqual(plan.action, 'update');
+        assert.strictEqual(plan.content, changed);
+    });
+});
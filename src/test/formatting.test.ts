@@ -23,9 +23,9 @@ import {
     splitArguments,
     containsCommentOutsideString,
     formatLine,
-    wrapLineIfNeeded,
     getIndentation,
-    formatCMakeDocument
+    formatCMakeDocument,
+    formatCMakeLines
 } from '../utils/formattingUtils';
 
 describe('CMake Formatting Logic', () => {
@@ -284,56 +284,6 @@ describe('CMake Formatting Logic', () => {
         });
     });
 
-    describe('wrapLineIfNeeded', () => {
-        const opts: CMakeFormattingOptions = { ...DEFAULT_OPTIONS, maxLineLength: 30 };
-
-        it('should not wrap short lines', () => {
-            const result = wrapLineIfNeeded('set(VAR value)', 0, opts);
-            assert.deepStrictEqual(result, ['set(VAR value)']);
-        });
-
-        it('should wrap long command lines', () => {
-            const result = wrapLineIfNeeded('target_link_libraries(myapp lib1 lib2 lib3)', 0, opts);
-            assert.ok(result.length > 1);
-            assert.ok(result[0].includes('target_link_libraries('));
-            assert.ok(result[result.length - 1].trim() === ')');
-        });
-
-        it('should use compact style when danglingParenthesis is false', () => {
-            const compactOpts: CMakeFormattingOptions = { ...DEFAULT_OPTIONS, maxLineLength: 30, danglingParenthesis: false };
-            const result = wrapLineIfNeeded('target_link_libraries(myapp lib1 lib2 lib3)', 0, compactOpts);
-            assert.ok(result.length > 1);
-            assert.ok(result[0].includes('target_link_libraries('));
-            // Last line should end with ')' right after the last arg
-            const lastLine = result[result.length - 1].trim();
-            assert.ok(lastLine.endsWith(')'), `Expected last line to end with ')': ${lastLine}`);
-            assert.ok(lastLine !== ')', `Expected last line to contain an arg before ')': ${lastLine}`);
-        });
-
-        it('should use dangling style when danglingParenthesis is true', () => {
-            const danglingOpts: CMakeFormattingOptions = { ...DEFAULT_OPTIONS, maxLineLength: 30, danglingParenthesis: true };
-            const result = wrapLineIfNeeded('target_link_libraries(myapp lib1 lib2 lib3)', 0, danglingOpts);
-            assert.ok(result.length > 1);
-            // Last line should be just ')'
-            assert.strictEqual(result[result.length - 1].trim(), ')');
-        });
-
-        it('should not wrap when maxLineLength is 0', () => {
-            const result = wrapLineIfNeeded('very_long_command(arg1 arg2 arg3 arg4 arg5)', 0, DEFAULT_OPTIONS);
-            assert.strictEqual(result.length, 1);
-        });
-
-        it('should not wrap comments', () => {
-            const result = wrapLineIfNeeded('# this is a very long comment that exceeds the limit', 0, opts);
-            assert.strictEqual(result.length, 1);
-        });
-
-        it('should not wrap single-argument commands', () => {
-            const result = wrapLineIfNeeded('set(VARIABLE_WITH_VERY_LONG_NAME)', 0, opts);
-            assert.strictEqual(result.length, 1);
-        });
-    });
-
     describe('getIndentation', () => {
         it('should return spaces', () => {
             assert.strictEqual(getIndentation('  set(VAR)'), '  ');
@@ -418,4 +368,136 @@ endif()`;
             assert.strictEqual(lines[2], 'endif()');
         });
     });
+
+    describe('formatCMakeLines (AST)', () => {
+        it('should re-flow multi-line commands that fit the line limit', () => {
+            const input = `add_executable(app
+main.cpp
+  util.cpp)`;
+            assert.deepStrictEqual(formatCMakeLines(input, GOOGLE_STYLE_OPTIONS), ['add_executable(app main.cpp util.cpp)']);
+        });
+
+        it('should keep multi-line layout without a line limit', () => {
+            const input = `add_executable(app
+main.cpp
+)`;
+            assert.deepStrictEqual(formatCMakeLines(input, DEFAULT_OPTIONS), ['add_executable(app', '  main.cpp', ')']);
+        });
+
+        it('should re-flow commands containing comments, keeping them after their argument', () => {
+            const input = `if(A)
+add_library(foo
+a.cpp # first
+b.cpp
+)
+endif()`;
+            assert.deepStrictEqual(formatCMakeLines(input, GOOGLE_STYLE_OPTIONS), [
+                'if(A)',
+                '  add_library(foo a.cpp # first',
+                '    b.cpp',
+                '  )',
+                'endif()'
+            ]);
+        });
+
+        it('should keep comments that have their own line', () => {
+            const input = `set(SRCS
+# generated
+a.cpp b.cpp)`;
+            const opts: CMakeFormattingOptions = { ...GOOGLE_STYLE_OPTIONS, danglingParenthesis: false };
+            assert.deepStrictEqual(formatCMakeLines(input, opts), ['set(SRCS', '  # generated', '  a.cpp b.cpp)']);
+        });
+
+        it('should re-indent comments inside parenthesized groups', () => {
+            const input = `if(A AND (B # why
+OR C))
+endif()`;
+            assert.deepStrictEqual(formatCMakeLines(input, GOOGLE_STYLE_OPTIONS), ['if(A AND (B # why', '  OR C))', 'endif()']);
+        });
+
+        it('should pack keyword groups into as few lines as fit', () => {
+            const opts: CMakeFormattingOptions = { ...GOOGLE_STYLE_OPTIONS, maxLineLength: 40 };
+            const input = 'target_link_libraries(app PUBLIC alpha beta gamma delta epsilon PRIVATE zeta eta)';
+            assert.deepStrictEqual(formatCMakeLines(input, opts), [
+                'target_link_libraries(app',
+                '  PUBLIC alpha beta gamma delta epsilon',
+                '  PRIVATE zeta eta',
+                ')'
+            ]);
+        });
+
+        it('should indent keyword group continuations and keep lines within the limit', () => {
+            const opts: CMakeFormattingOptions = { ...GOOGLE_STYLE_OPTIONS, maxLineLength: 40, danglingParenthesis: false };
+            const files = Array.from({ length: 30 }, (_, i) => `src/file${i}.cpp`);
+            const result = formatCMakeLines(`target_sources(app PRIVATE ${files.join(' ')})`, opts);
+            assert.strictEqual(result[0], 'target_sources(app');
+            assert.ok(result[1].startsWith('  PRIVATE src/file0.cpp'));
+            assert.ok(result.slice(2).every(line => line.startsWith('    src/')));
+            assert.ok(result.every(line => line.length <= 40));
+            assert.ok(result[result.length - 1].endsWith('.cpp)'));
+            assert.strictEqual(result.join(' ').split(/\s+/).filter(t => t.startsWith('src/')).length, 30);
+        });
+
+        it('should not treat variable names like SOURCES as keyword groups', () => {
+            const opts: CMakeFormattingOptions = { ...GOOGLE_STYLE_OPTIONS, maxLineLength: 40 };
+            const files = Array.from({ length: 10 }, (_, i) => `src/file${i}.cpp`).join(' ');
+
+            const set = formatCMakeLines(`set(SOURCES ${files})`, opts);
+            assert.ok(set[0].startsWith('set(SOURCES src/'), set[0]);
+            assert.ok(set.slice(1, -1).every(line => line.startsWith('  src/')));
+            assert.ok(set.every(line => line.length <= 40));
+
+            const list = formatCMakeLines(`list(APPEND FILES ${files})`, opts);
+            assert.ok(list[0].startsWith('list(APPEND FILES src/'), list[0]);
+            assert.ok(list.slice(1, -1).every(line => line.startsWith('  src/')));
+        });
+
+        it('should copy multi-line strings and bracket comments verbatim', () => {
+            const input = `if(A)
+set(MSG "line one
+   line two")
+#[[ note
+   keep ]]
+endif()`;
+            assert.deepStrictEqual(formatCMakeLines(input, GOOGLE_STYLE_OPTIONS), [
+                'if(A)',
+                '  set(MSG "line one',
+                '   line two")',
+                '  #[[ note',
+                '   keep ]]',
+                'endif()'
+            ]);
+        });
+
+        it('should keep trailing comments and nested parentheses', () => {
+            const input = 'IF(A   AND ( B OR C ))   # why';
+            assert.deepStrictEqual(formatCMakeLines(input, DEFAULT_OPTIONS), ['if(A AND (B OR C)) # why']);
+        });
+
+        it('should track blocks for several commands on one line', () => {
+            const input = `if(X) set(Y 1) endif()
+set(Z 2)`;
+            assert.deepStrictEqual(formatCMakeLines(input, DEFAULT_OPTIONS), ['if(X) set(Y 1) endif()', 'set(Z 2)']);
+        });
+
+        it('should wrap from arguments without splitting bracket arguments', () => {
+            const opts: CMakeFormattingOptions = { ...DEFAULT_OPTIONS, maxLineLength: 30 };
+            const result = formatCMakeLines('message(STATUS [[a long bracket argument]] tail)', opts);
+            assert.deepStrictEqual(result, ['message(STATUS', '  [[a long bracket argument]]', '  tail', ')']);
+        });
+
+        it('should be idempotent', () => {
+            const input = `project(X)
+if(WIN32)
+add_library(core STATIC a.cpp b.cpp c.cpp d.cpp e.cpp f.cpp g.cpp h.cpp i.cpp j.cpp k.cpp)
+endif()
+`;
+            const once = formatCMakeDocument(input, GOOGLE_STYLE_OPTIONS);
+            assert.strictEqual(formatCMakeDocument(once, GOOGLE_STYLE_OPTIONS), once);
+        });
+
+        it('should ignore CRLF line endings', () => {
+            assert.deepStrictEqual(formatCMakeLines('IF(A)\r\nSET(B 1)\r\nENDIF()', DEFAULT_OPTIONS), ['if(A)', '  set(B 1)', 'endif()']);
+        });
+    });
 });
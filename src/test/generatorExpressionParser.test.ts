@@ -0,0 +1,165 @@
+/**
+ * Tests for Generator Expression Parser
+ */
+
+import * as assert from 'assert';
+import {
+    findGeneratorExpressions,
+    parseGeneratorExpression,
+    evaluateGeneratorExpression,
+    GeneratorExpressionEvaluator,
+    GenexExpression
+} from '../parsers/generatorExpressionParser';
+
+describe('Generator Expression Parser', () => {
+
+    describe('findGeneratorExpressions', () => {
+        it('should find top-level expressions', () => {
+            const text = 'target_compile_definitions(app PRIVATE $<$<CONFIG:Debug>:DEBUG> $<BUILD_INTERFACE:X>)';
+            const result = findGeneratorExpressions(text);
+            assert.strictEqual(result.length, 2);
+            assert.strictEqual(result[0].expression, '$<$<CONFIG:Debug>:DEBUG>');
+            assert.strictEqual(text.substring(result[1].startIndex, result[1].endIndex), '$<BUILD_INTERFACE:X>');
+        });
+
+        it('should skip unterminated expressions', () => {
+            assert.strictEqual(findGeneratorExpressions('$<CONFIG:Debug').length, 0);
+        });
+
+        it('should return nothing for plain text', () => {
+            assert.strictEqual(findGeneratorExpressions('set(A ${B})').length, 0);
+        });
+    });
+
+    describe('parseGeneratorExpression', () => {
+        it('should parse a simple expression', () => {
+            const nodes = parseGeneratorExpression('$<CONFIG:Debug>');
+            assert.strictEqual(nodes.length, 1);
+            const expr = nodes[0] as GenexExpression;
+            assert.strictEqual(expr.kind, 'genex');
+            assert.strictEqual(expr.name, 'CONFIG');
+            assert.strictEqual(expr.arguments.length, 1);
+        });
+
+        it('should parse nested conditional expressions', () => {
+            const nodes = parseGeneratorExpression('$<$<CONFIG:Debug>:_DEBUG>');
+            const expr = nodes[0] as GenexExpression;
+            assert.strictEqual(expr.name, '');
+            assert.strictEqual(expr.head.length, 1);
+            assert.strictEqual((expr.head[0] as GenexExpression).name, 'CONFIG');
+        });
+
+        it('should split comma-separated arguments', () => {
+            const expr = parseGeneratorExpression('$<IF:$<CONFIG:Debug>,d,r>')[0] as GenexExpression;
+            assert.strictEqual(expr.name, 'IF');
+            assert.strictEqual(expr.arguments.length, 3);
+        });
+
+        it('should keep surrounding text', () => {
+            const nodes = parseGeneratorExpression('lib$<$<CONFIG:Debug>:d>.a');
+            assert.strictEqual(nodes.length, 3);
+            assert.strictEqual(nodes[0].kind, 'text');
+            assert.strictEqual(nodes[2].kind, 'text');
+        });
+
+        it('should keep unterminated expressions as text', () => {
+            const nodes = parseGeneratorExpression('a$<CONFIG:Debug');
+            assert.strictEqual(nodes.length, 1);
+            assert.strictEqual(nodes[0].kind, 'text');
+        });
+    });
+
+    describe('evaluateGeneratorExpression', () => {
+        const debug = { config: 'Debug' };
+        const release = { config: 'Release' };
+
+        it('should evaluate CONFIG conditions', () => {
+            assert.strictEqual(evaluateGeneratorExpression('$<$<CONFIG:Debug>:_DEBUG>', debug), '_DEBUG');
+            assert.strictEqual(evaluateGeneratorExpression('$<$<CONFIG:Debug>:_DEBUG>', release), '');
+        });
+
+        it('should match CONFIG case-insensitively and against several configs', () => {
+            assert.strictEqual(evaluateGeneratorExpression('$<CONFIG:release,RelWithDebInfo>', release), '1');
+        });
+
+        it('should return the config name for $<CONFIG>', () => {
+            assert.strictEqual(evaluateGeneratorExpression('out/$<CONFIG>/bin', release), 'out/Release/bin');
+        });
+
+        it('should evaluate IF', () => {
+            const expr = '$<IF:$<CONFIG:Debug>,libd,lib>';
+            assert.strictEqual(evaluateGeneratorExpression(expr, debug), 'libd');
+            assert.strictEqual(evaluateGeneratorExpression(expr, release), 'lib');
+        });
+
+        it('should evaluate BUILD_INTERFACE and INSTALL_INTERFACE', () => {
+            assert.strictEqual(evaluateGeneratorExpression('$<BUILD_INTERFACE:/src/include>', debug), '/src/include');
+            assert.strictEqual(evaluateGeneratorExpression('$<INSTALL_INTERFACE:include>', debug), '');
+        });
+
+        it('should evaluate logical operators', () => {
+            assert.strictEqual(evaluateGeneratorExpression('$<AND:1,$<CONFIG:Debug>>', debug), '1');
+            assert.strictEqual(evaluateGeneratorExpression('$<OR:0,$<CONFIG:Debug>>', release), '0');
+            assert.strictEqual(evaluateGeneratorExpression('$<NOT:$<CONFIG:Debug>>', release), '1');
+            assert.strictEqual(evaluateGeneratorExpression('$<BOOL:OFF>', release), '0');
+        });
+
+        it('should evaluate string comparisons', () => {
+            assert.strictEqual(evaluateGeneratorExpression('$<STREQUAL:a,a>', debug), '1');
+            assert.strictEqual(evaluateGeneratorExpression('$<IN_LIST:b,a;b;c>', debug), '1');
+        });
+
+        it('should keep commas inside conditional values', () => {
+            assert.strictEqual(evaluateGeneratorExpression('$<$<CONFIG:Debug>:a,b>', debug), 'a,b');
+        });
+
+        it('should resolve TARGET_PROPERTY through the context', () => {
+            const context = {
+                config: 'Debug',
+                getTargetProperty: (target: string, prop: string) => target === 'app' && prop === 'OUTPUT_NAME' ? 'myapp' : undefined
+            };
+            assert.strictEqual(evaluateGeneratorExpression('$<TARGET_PROPERTY:app,OUTPUT_NAME>', context), 'myapp');
+        });
+
+        it('should keep undeterminable expressions as written', () => {
+            const expr = '$<TARGET_PROPERTY:app,OUTPUT_NAME>';
+            assert.strictEqual(evaluateGeneratorExpression(expr, debug), expr);
+            assert.strictEqual(
+                evaluateGeneratorExpression('$<$<CXX_COMPILER_ID:MSVC>:/W4> $<$<CONFIG:Debug>:-g>', debug),
+                '$<$<CXX_COMPILER_ID:MSVC>:/W4> -g'
+            );
+        });
+
+        it('should evaluate compiler id when known', () => {
+            const context = { config: 'Debug', compilerId: 'MSVC' };
+            assert.strictEqual(evaluateGeneratorExpression('$<$<CXX_COMPILER_ID:MSVC>:/W4>', context), '/W4');
+        });
+    });
+
+    describe('GeneratorExpressionEvaluator', () => {
+        it('should memoize results per expression and config', () => {
+            const evaluator = new GeneratorExpressionEvaluator();
+            assert.strictEqual(evaluator.evaluate('$<$<CONFIG:Debug>:D>', 'Debug'), 'D');
+            assert.strictEqual(evaluator.evaluate('$<$<CONFIG:Debug>:D>', 'Debug'), 'D');
+            assert.strictEqual(evaluator.evaluate('$<$<CONFIG:Debug>:D>', 'Release'), '');
+            assert.strictEqual(evaluator.size, 2);
+        });
+
+        it('should evaluate for all configurations', () => {
+            const evaluator = new GeneratorExpressionEvaluator();
+            const values = evaluator.evaluateAll('$<IF:$<CONFIG:Debug>,d,r>', ['Debug', 'Release']);
+            assert.strictEqual(values.get('Debug'), 'd');
+            assert.strictEqual(values.get('Release'), 'r');
+        });
+
+        it('should use context callbacks and clear the cache', () => {
+            let name = 'first';
+            const evaluator = new GeneratorExpressionEvaluator({ getTargetProperty: () => name });
+            assert.strictEqual(evaluator.evaluate('$<TARGET_PROPERTY:t,p>', 'Debug'), 'first');
+            name = 'second';
+            assert.strictEqual(evaluator.evaluate('$<TARGET_PROPERTY:t,p>', 'Debug'), 'first');
+            evaluator.clear();
+            assert.strictEqual(evaluator.evaluate('$<TARGET_PROPERTY:t,p>', 'Debug'), 'second');
+        });
+    });
+});
@@ -0,0 +1,182 @@
+/**
+ * Tests for the incremental indentation model
+ */
+
+import * as assert from 'assert';
+import { IndentModel, scanLine, TOP_LEVEL_STATE } from '../utils/indentModel';
+import { formatCMakeLines, DEFAULT_OPTIONS } from '../utils/formattingUtils';
+
+/**
+ * Apply a line-range replacement to an array of lines and the model
+ */
+function edit(model: IndentModel, lines: string[], startLine: number, oldEndLine: number, newLines: string[]): string[] {
+    const result = [...lines.slice(0, startLine), ...newLines, ...lines.slice(oldEndLine + 1)];
+    model.applyEdit(startLine, oldEndLine, newLines.length, (line) => result[line]);
+    return result;
+}
+
+/**
+ * Assert that a model matches a freshly built one
+ */
+function assertSameAsFresh(model: IndentModel, lines: string[]): void {
+    const fresh = new IndentModel(lines);
+    assert.strictEqual(model.lineCount, lines.length);
+    for (let i = 0; i < lines.length; i++) {
+        assert.deepStrictEqual(model.getLineInfo(i), fresh.getLineInfo(i), `line ${i}`);
+        assert.strictEqual(model.getDepthBefore(i), fresh.getDepthBefore(i), `depth at line ${i}`);
+    }
+}
+
+describe('Indent Model', () => {
+
+    describe('scanLine', () => {
+        it('should count block commands', () => {
+            assert.strictEqual(scanLine('if(A)', TOP_LEVEL_STATE).info.delta, 1);
+            assert.strictEqual(scanLine('endif()', TOP_LEVEL_STATE).info.delta, -1);
+            assert.strictEqual(scanLine('else()', TOP_LEVEL_STATE).info.delta, 0);
+            assert.strictEqual(scanLine('if(A) set(B 1) endif()', TOP_LEVEL_STATE).info.delta, 0);
+        });
+
+        it('should mark leading decrease commands', () => {
+            assert.strictEqual(scanLine('  endforeach()', TOP_LEVEL_STATE).info.leadingDecrease, true);
+            assert.strictEqual(scanLine('set(A) endif()', TOP_LEVEL_STATE).info.leadingDecrease, false);
+            assert.strictEqual(scanLine('elseif(B)', TOP_LEVEL_STATE).info.firstCommand, 'elseif');
+        });
+
+        it('should carry state across unterminated commands and strings', () => {
+            const open = scanLine('add_library(foo "a', TOP_LEVEL_STATE);
+            assert.notStrictEqual(open.exitState, TOP_LEVEL_STATE);
+            const inside = scanLine('if(X) b" c', open.exitState);
+            assert.strictEqual(inside.info.delta, 0);
+            assert.strictEqual(scanLine(')', inside.exitState).exitState, TOP_LEVEL_STATE);
+        });
+
+        it('should ignore commands in comments and bracket arguments', () => {
+            assert.strictEqual(scanLine('# if(A)', TOP_LEVEL_STATE).info.delta, 0);
+            const bracket = scanLine('set(X [[', TOP_LEVEL_STATE);
+            assert.strictEqual(scanLine('if(A) ]])', bracket.exitState).info.delta, 0);
+            const comment = scanLine('#[==[ start', TOP_LEVEL_STATE);
+            const end = scanLine('if(A) ]==] if(B)', comment.exitState);
+            assert.strictEqual(end.info.delta, 1);
+            assert.strictEqual(end.info.firstCommand, 'if');
+        });
+    });
+
+    describe('IndentModel', () => {
+        const lines = [
+            'project(X)',
+            'if(A)',
+            'foreach(f ${FILES})',
+            'add_library(foo',
+            '  a.cpp',
+            ')',
+            'endforeach()',
+            'else()',
+            'set(B 1)',
+            'endif()'
+        ];
+
+        it('should match the formatter indentation', () => {
+            const model = new IndentModel(lines);
+            const formatted = formatCMakeLines(lines.join('\n'), DEFAULT_OPTIONS);
+            for (const line of [0, 1, 2, 3, 6, 7, 8, 9]) {
+                const indent = formatted[line].length - formatted[line].trimStart().length;
+                assert.strictEqual(model.getIndentLevel(line) * 2, indent, `line ${line}`);
+            }
+        });
+
+        it('should find command boundaries', () => {
+            const model = new IndentModel(lines);
+            assert.strictEqual(model.findCommandStart(4), 3);
+            assert.strictEqual(model.findCommandStart(5), 3);
+            assert.strictEqual(model.findCommandEnd(3), 5);
+            assert.strictEqual(model.findCommandEnd(1), 1);
+            assert.strictEqual(model.isTopLevel(4), false);
+        });
+
+        it('should give the expected indent level for typed lines', () => {
+            const model = new IndentModel([
+                'if(A)',
+                'set(S "x',
+                'y")',
+                'add_library(foo',
+                'a.cpp',
+                ')',
+                'endif()',
+                ''
+            ]);
+            assert.strictEqual(model.getExpectedIndentLevel(1, 'set(S "x'), 1);
+            assert.strictEqual(model.getExpectedIndentLevel(2, 'y")'), undefined);
+            assert.strictEqual(model.getExpectedIndentLevel(4, 'a.cpp'), 2);
+            assert.strictEqual(model.getExpectedIndentLevel(5, ')'), 1);
+            assert.strictEqual(model.getExpectedIndentLevel(6, 'endif()'), 0);
+            assert.strictEqual(model.getExpectedIndentLevel(7, ''), 0);
+        });
+
+        it('should outdent a typed end command after an incremental edit', () => {
+            const big: string[] = ['if(A)'];
+            for (let i = 0; i < 20000; i++) {
+                big.push(`  set(V${i} ${i})`);
+            }
+            big.push('  ');
+            const model = new IndentModel(big);
+            assert.strictEqual(model.getExpectedIndentLevel(big.length - 1, '  '), 1);
+            const updated = edit(model, big, big.length - 1, big.length - 1, ['  endif()']);
+            assert.strictEqual(model.getExpectedIndentLevel(updated.length - 1, '  endif()'), 0);
+        });
+
+        it('should update depths after inserting a block', () => {
+            const model = new IndentModel(lines);
+            const updated = edit(model, lines, 8, 8, ['if(C)', 'set(B 1)', 'endif()']);
+            assertSameAsFresh(model, updated);
+            assert.strictEqual(model.getIndentLevel(9), 2);
+        });
+
+        it('should re-scan following lines when a string is opened', () => {
+            const model = new IndentModel(lines);
+            const updated = edit(model, lines, 0, 0, ['set(S "open']);
+            assertSameAsFresh(model, updated);
+            assert.strictEqual(model.isTopLevel(1), false);
+        });
+
+        it('should handle deleting lines', () => {
+            const model = new IndentModel(lines);
+            const updated = edit(model, lines, 2, 6, ['set(C 1)']);
+            assertSameAsFresh(model, updated);
+        });
+
+        it('should stay consistent under random edits', () => {
+            const pool = ['if(A)', 'endif()', 'else()', 'foreach(x y)', 'endforeach()', 'set(A "q', 'b")', 'add_x(', ')', '#[[', ']]', 'set(B 1)', ''];
+            let seed = 7;
+            const next = () => {
+                seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+                return seed;
+            };
+            let current = lines.slice();
+            const model = new IndentModel(current);
+            for (let round = 0; round < 300; round++) {
+                const start = next() % current.length;
+                const end = Math.min(current.length - 1, start + next() % 3);
+                const inserted = Array.from({ length: 1 + next() % 3 }, () => pool[next() % pool.length]);
+                current = edit(model, current, start, end, inserted);
+            }
+            assertSameAsFresh(model, current);
+        });
+
+        it('should answer depth queries on large documents without rescanning', () => {
+            const big: string[] = [];
+            for (let i = 0; i < 50000; i++) {
+                big.push(i % 2 === 0 ? 'if(A)' : 'endif()');
+            }
+            const model = new IndentModel(big);
+            assert.strictEqual(model.getDepthBefore(49999), 1);
+            const start = Date.now();
+            for (let i = 0; i < 1000; i++) {
+                big[25000] = i % 2 === 0 ? 'set(X 1)' : 'if(A)';
+                model.applyEdit(25000, 25000, 1, (line) => big[line]);
+                model.getDepthBefore(49999);
+            }
+            assert.ok(Date.now() - start < 1000);
+        });
+    });
+});
@@ -0,0 +1,273 @@
+/**
+ * Tests for the language server: JSON-RPC framing, cancellation, document sync and handlers
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { pathToFileURL } from 'url';
+import { PassThrough } from 'stream';
+import {
+    CancellationSource,
+    ErrorCodes,
+    JsonRpcConnection,
+    Message,
+    MessageDecoder,
+    ResponseError,
+    encodeMessage
+} from '../server/jsonRpc';
+import { ServerTextDocument } from '../server/textDocuments';
+import { CMakeLanguageServer, resolveFormattingOptions } from '../server/cmakeServer';
+import { GOOGLE_STYLE_OPTIONS } from '../utils/formattingUtils';
+
+/**
+ * Two connections wired to each other through in-memory streams
+ */
+function createPair(): { client: JsonRpcConnection; server: JsonRpcConnection } {
+    const toServer = new PassThrough();
+    const toClient = new PassThrough();
+    const client = new JsonRpcConnection(toClient, toServer);
+    const server = new JsonRpcConnection(toServer, toClient);
+    client.listen();
+    server.listen();
+    return { client, server };
+}
+
+describe('Language Server', () => {
+
+    describe('MessageDecoder', () => {
+        it('should decode messages split across and packed into chunks', () => {
+            const messages: Message[] = [];
+            const decoder = new MessageDecoder(message => messages.push(message));
+            const first = encodeMessage({ jsonrpc: '2.0', method: 'a', params: { text: 'ü' } });
+            const second = encodeMessage({ jsonrpc: '2.0', id: 1, result: 2 });
+            const bytes = Buffer.concat([first, second]);
+
+            decoder.push(bytes.subarray(0, 10));
+            decoder.push(bytes.subarray(10, first.length + 3));
+            assert.strictEqual(messages.length, 1);
+            assert.deepStrictEqual(messages[0].params, { text: 'ü' });
+            decoder.push(bytes.subarray(first.length + 3));
+            assert.strictEqual(messages.length, 2);
+            assert.strictEqual(messages[1].result, 2);
+        });
+    });
+
+    describe('JsonRpcConnection', () => {
+        it('should answer requests and report unknown methods', async () => {
+            const { client, server } = createPair();
+            server.onRequest('add', (params) => (params as number[])[0] + (params as number[])[1]);
+            assert.strictEqual(await client.sendRequest<number>('add', [2, 3]), 5);
+            await assert.rejects(client.sendRequest('missing'), (error: ResponseError) =>
+                error.code === ErrorCodes.MethodNotFound);
+            client.close();
+            server.close();
+        });
+
+        it('should cancel a running request', async () => {
+            const { client, server } = createPair();
+            let observed = false;
+            server.onRequest('slow', (_params, token) => new Promise(resolve => {
+                token.onCancellationRequested(() => {
+                    observed = true;
+                    resolve('late');
+                });
+            }));
+
+            const source = new CancellationSource();
+            const result = client.sendRequest('slow', undefined, source);
+            setTimeout(() => source.cancel(), 5);
+            await assert.rejects(result, (error: ResponseError) => error.code === ErrorCodes.RequestCancelled);
+            assert.ok(observed);
+            client.close();
+            server.close();
+        });
+    });
+
+    describe('ServerTextDocument', () => {
+        it('should apply incremental changes like a full replacement', () => {
+            const document = new ServerTextDocument('file:///a.cmake', 1, 'if(A)\nset(B 1)\nendif()\n');
+            assert.strictEqual(document.getIndentModel().getDepthBefore(1), 1);
+
+            document.applyChanges([
+                { range: { start: { line: 1, character: 4 }, end: { line: 1, character: 5 } }, text: 'C' },
+                { range: { start: { line: 0, character: 5 }, end: { line: 0, character: 5 } }, text: '\nwhile(X)' },
+                { range: { start: { line: 3, character: 0 }, end: { line: 3, character: 0 } }, text: 'endwhile()\n' }
+            ], 2);
+
+            const expected = 'if(A)\nwhile(X)\nset(C 1)\nendwhile()\nendif()\n';
+            assert.strictEqual(document.getText(), expected);
+            assert.strictEqual(document.version, 2);
+            assert.strictEqual(document.lineAt(2), 'set(C 1)');
+            assert.deepStrictEqual(document.positionAt(expected.indexOf('set')), { line: 2, character: 0 });
+
+            const fresh = new ServerTextDocument('file:///b.cmake', 1, expected);
+            for (let line = 0; line < fresh.lineCount; line++) {
+                assert.strictEqual(document.getIndentModel().getDepthBefore(line), fresh.getIndentModel().getDepthBefore(line));
+            }
+        });
+
+        it('should clamp positions past the end of a line', () => {
+            const document = new ServerTextDocument('file:///a.cmake', 1, 'ab\ncd');
+            assert.strictEqual(document.offsetAt({ line: 0, character: 99 }), 2);
+            assert.strictEqual(document.offsetAt({ line: 9, character: 0 }), 5);
+        });
+    });
+
+    describe('CMakeLanguageServer', () => {
+        const uri = 'untitled:CMakeLists.txt';
+
+        async function startServer(rootUri: string | null = null): Promise<{ client: JsonRpcConnection; server: CMakeLanguageServer; diagnostics: unknown[] }> {
+            const pair = createPair();
+            const diagnostics: unknown[] = [];
+            pair.client.onNotification('textDocument/publishDiagnostics', (params) => diagnostics.push(params));
+            const server = new CMakeLanguageServer(pair.server, () => undefined);
+            const result = await pair.client.sendRequest<{ capabilities: Record<string, unknown> }>('initialize', {
+                rootUri,
+                initializationOptions: { formatting: { style: 'google' } }
+            });
+            assert.strictEqual(result.capabilities.documentFormattingProvider, true);
+            return { client: pair.client, server, diagnostics };
+        }
+
+        it('should format whole documents and ranges as minimal edits', async () => {
+            const { client, server } = await startServer();
+            client.sendNotification('textDocument/didOpen', {
+                textDocument: { uri, languageId: 'cmake', version: 1, text: 'IF(A)\nset(B 1)\n  set(C 2)\nENDIF()\n' }
+            });
+            const options = { tabSize: 2, insertSpaces: true };
+
+            const edits = await client.sendRequest<Array<{ range: { start: { line: number } }; newText: string }>>(
+                'textDocument/formatting', { textDocument: { uri }, options });
+            assert.deepStrictEqual(edits.map(edit => [edit.range.start.line, edit.newText]), [
+                [0, 'if(A)\n  set(B 1)'],
+                [3, 'endif()']
+            ]);
+
+            const rangeEdits = await client.sendRequest<Array<{ range: { start: { line: number } }; newText: string }>>(
+                'textDocument/rangeFormatting', {
+                    textDocument: { uri },
+                    range: { start: { line: 1, character: 0 }, end: { line: 1, character: 3 } },
+                    options
+                });
+            assert.deepStrictEqual(rangeEdits.map(edit => [edit.range.start.line, edit.newText]), [[1, '  set(B 1)']]);
+            server.dispose();
+            client.close();
+        });
+
+        it('should publish debounced diagnostics and folding ranges', async () => {
+            const { client, server, diagnostics } = await startServer();
+            client.sendNotification('textDocument/didOpen', {
+                textDocument: { uri, languageId: 'cmake', version: 1, text: 'if(A)\ninclude_directories(x)\n' }
+            });
+            await new Promise(resolve => setTimeout(resolve, 20));
+
+            const published = diagnostics[0] as { uri: string; diagnostics: Array<{ code: string; severity: number; tags?: number[] }> };
+            assert.strictEqual(published.uri, uri);
+            const unmatched = published.diagnostics.find(item => item.code === 'unmatched-block')!;
+            assert.strictEqual(unmatched.severity, 1);
+            const deprecated = published.diagnostics.find(item => item.code === 'deprecated-command')!;
+            assert.deepStrictEqual(deprecated.tags, [2]);
+
+            client.sendNotification('textDocument/didChange', {
+                textDocument: { uri, version: 2 },
+                contentChanges: [{ range: { start: { line: 2, character: 0 }, end: { line: 2, character: 0 } }, text: 'endif()\n' }]
+            });
+            const folds = await client.sendRequest<Array<{ startLine: number; endLine: number }>>(
+                'textDocument/foldingRange', { textDocument: { uri } });
+            assert.deepStrictEqual(folds.map(fold => [fold.startLine, fold.endLine]), [[0, 2]]);
+            assert.strictEqual(server.getDocument(uri)!.version, 2);
+            server.dispose();
+            client.close();
+        });
+
+        it('should not grow appended lists when a document is validated again', async () => {
+            const { client, server, diagnostics } = await startServer();
+            const fileUri = 'file:///project/CMakeLists.txt';
+            client.sendNotification('workspace/didChangeConfiguration', {
+                settings: { diagnostics: { largeTargetSources: 2 } }
+            });
+            client.sendNotification('textDocument/didOpen', {
+                textDocument: {
+                    uri: fileUri,
+                    languageId: 'cmake',
+                    version: 1,
+                    text: 'list(APPEND SRCS a.cpp b.cpp)\nadd_library(big ${SRCS})\n'
+                }
+            });
+            await new Promise(resolve => setTimeout(resolve, 20));
+
+            const document = server.getDocument(fileUri)!;
+            server.validate(document);
+            server.validate(document);
+            const messages = (diagnostics as Array<{ diagnostics: Array<{ code: string; message: string }> }>)
+                .map(published => published.diagnostics.find(item => item.code === 'large-target-without-pch')?.message);
+            assert.ok(messages.length >= 3);
+            for (const message of messages) {
+                assert.ok(message?.includes('has 2 sources'), message);
+            }
+            server.dispose();
+            client.close();
+        });
+
+        it('should report non-existent paths when diagnostics.nonExistentPaths is on', async () => {
+            const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-server-'));
+            fs.writeFileSync(path.join(dir, 'main.cpp'), '');
+            const { client, server, diagnostics } = await startServer();
+            client.sendNotification('workspace/didChangeConfiguration', {
+                settings: { diagnostics: { nonExistentPaths: true } }
+            });
+            client.sendNotification('textDocument/didOpen', {
+                textDocument: {
+                    uri: pathToFileURL(path.join(dir, 'CMakeLists.txt')).toString(),
+                    languageId: 'cmake',
+                    version: 1,
+                    text: 'add_executable(app main.cpp missing.cpp)\n'
+                }
+            });
+            await new Promise(resolve => setTimeout(resolve, 20));
+
+            const published = diagnostics[0] as { diagnostics: Array<{ code: string; message: string }> };
+            const missing = published.diagnostics.filter(item => item.code === 'path-not-found');
+            assert.deepStrictEqual(missing.map(item => item.message), ['Path does not exist: missing.cpp']);
+            server.dispose();
+            client.close();
+            fs.rmSync(dir, { recursive: true, force: true });
+        });
+
+        it('should resolve variables set in unopened workspace files', async () => {
+            const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-server-'));
+            fs.mkdirSync(path.join(dir, 'app'));
+            fs.mkdirSync(path.join(dir, 'build'));
+            fs.writeFileSync(path.join(dir, 'CMakeLists.txt'), 'set(APP_SOURCES main.cpp)\nadd_subdirectory(app)\n');
+            fs.writeFileSync(path.join(dir, 'build', 'generated.cmake'), 'set(GENERATED_ONLY 1)\n');
+            const appFile = path.join(dir, 'app', 'CMakeLists.txt');
+            const appText = 'add_executable(app ${APP_SOURCES} ${GENERATED_ONLY})\n';
+            fs.writeFileSync(appFile, appText);
+
+            const { client, server, diagnostics } = await startServer(pathToFileURL(dir).toString());
+            client.sendNotification('textDocument/didOpen', {
+                textDocument: { uri: pathToFileURL(appFile).toString(), languageId: 'cmake', version: 1, text: appText }
+            });
+            await new Promise(resolve => setTimeout(resolve, 50));
+
+            const published = diagnostics[0] as { diagnostics: Array<{ code: string; message: string }> };
+            const undefinedVariables = published.diagnostics.filter(item => item.code === 'undefined-variable');
+            assert.deepStrictEqual(undefinedVariables.map(item => item.message), ['Undefined variable: GENERATED_ONLY']);
+            server.dispose();
+            client.close();
+            fs.rmSync(dir, { recursive: true, force: true });
+        });
+    });
+
+    describe('resolveFormattingOptions', () => {
+        it('should layer explicit settings and editor options over the preset', () => {
+            assert.deepStrictEqual(resolveFormattingOptions({}, {}), GOOGLE_STYLE_OPTIONS);
+            const options = resolveFormattingOptions({ style: 'kde', maxLineLength: 60 }, { tabSize: 3, insertSpaces: false });
+            assert.strictEqual(options.maxLineLength, 60);
+            assert.strictEqual(options.tabSize, 3);
+            assert.strictEqual(options.insertSpaces, false);
+        });
+    });
+});
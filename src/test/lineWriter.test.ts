@@ -0,0 +1,50 @@
+/**
+ * Tests for line writers
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { StreamLineWriter, StringLineWriter } from '../utils/lineWriter';
+import { parseVcxproj } from '../parsers/vcxprojParser';
+import { generateCMakeLists, writeCMakeLists } from '../parsers/cmakeGenerator';
+
+describe('Line Writers', () => {
+    it('should produce the same text as joining the lines', () => {
+        const lines = ['cmake_minimum_required(VERSION 3.10)', '', 'x'.repeat(70000), 'add_executable(app main.cpp)', ''];
+        const writer = new StringLineWriter();
+        writer.push(lines[0]);
+        writer.push(...lines.slice(1));
+        assert.strictEqual(writer.toString(), lines.join('\n'));
+        assert.strictEqual(writer.toString(), lines.join('\n'));
+        assert.strictEqual(new StringLineWriter().toString(), '');
+    });
+
+    it('should stream generated CMake to a file unchanged', async () => {
+        const sources = Array.from({ length: 5000 }, (_, i) => `<ClCompile Include="src\\file${i}.cpp" />`).join('\n');
+        const project = parseVcxproj(`<?xml version="1.0" encoding="utf-8"?>
+<Project>
+  <PropertyGroup Label="Globals"><ProjectName>Big</ProjectName></PropertyGroup>
+  <PropertyGroup><ConfigurationType>Application</ConfigurationType></PropertyGroup>
+  <ItemGroup>${sources}</ItemGroup>
+</Project>`, '/p/Big.vcxproj');
+
+        const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-writer-'));
+        try {
+            const filePath = path.join(dir, 'CMakeLists.txt');
+            const writer = new StreamLineWriter(fs.createWriteStream(filePath, 'utf8'));
+            writeCMakeLists(writer, project);
+            await writer.end();
+            assert.strictEqual(fs.readFileSync(filePath, 'utf8'), generateCMakeLists(project));
+        } finally {
+            fs.rmSync(dir, { recursive: true, force: true });
+        }
+    });
+
+    it('should reject when the stream fails', async () => {
+        const writer = new StreamLineWriter(fs.createWriteStream(path.join(os.tmpdir(), 'missing-dir-cmake-companion', 'x.txt')));
+        writer.push('line');
+        await assert.rejects(writer.end());
+    });
+});
@@ -0,0 +1,70 @@
+/**
+ * Tests for memory estimates, the memory registry and cache accounting
+ */
+
+import * as assert from 'assert';
+import { GeneratorExpressionEvaluator } from '../parsers/generatorExpressionParser';
+import { CoreVariableResolver } from '../services/coreVariableResolver';
+import { MemoryRegistry } from '../services/memoryRegistry';
+import { estimateBytes, estimateStringBytes } from '../utils/memoryEstimate';
+
+describe('Memory accounting', () => {
+    describe('estimateBytes', () => {
+        it('should size strings by encoding and count shared objects once', () => {
+            assert.strictEqual(estimateStringBytes('abcd'), 20);
+            assert.strictEqual(estimateStringBytes('ab中'), 22);
+
+            const shared = { path: 'x'.repeat(1000) };
+            const once = estimateBytes([shared]);
+            assert.strictEqual(estimateBytes([shared, shared]), once + 8);
+            assert.ok(estimateBytes(new Map([['key', shared]])) > 1000);
+        });
+    });
+
+    describe('MemoryRegistry', () => {
+        it('should report sources by name and survive failing sources', () => {
+            const registry = new MemoryRegistry();
+            registry.register('b', () => ({ entries: 2, bytes: 2048 }));
+            const a = registry.register('a', () => {
+                throw new Error('gone');
+            });
+
+            assert.deepStrictEqual(registry.getReport().map(row => [row.name, row.entries, row.error]), [
+                ['a', 0, 'gone'],
+                ['b', 2, undefined]
+            ]);
+            a.dispose();
+            const report = registry.formatReport({ rss: 1, heapTotal: 2, heapUsed: 1, external: 0, arrayBuffers: 0 });
+            assert.ok(report.includes('b') && report.includes('2.0 KB') && !report.includes('gone'));
+        });
+    });
+
+    describe('Caches', () => {
+        it('should account resolver variables and definitions separately', () => {
+            const resolver = new CoreVariableResolver();
+            resolver.initialize(['/workspace']);
+            const before = resolver.getMemoryUsage();
+            resolver.parseFileContent('set(SOURCES a.cpp b.cpp)\nset(ROOT "/workspace/src")\n', '/workspace/CMakeLists.txt');
+            const after = resolver.getMemoryUsage();
+
+            assert.strictEqual(after.definitions.entries, before.definitions.entries + 2);
+            assert.ok(after.variables.bytes > before.variables.bytes);
+        });
+
+        it('should reset the generator expression cache by its byte estimate', () => {
+            const evaluator = new GeneratorExpressionEvaluator();
+            const long = 'x'.repeat(100000);
+            evaluator.evaluate(`$<$<CONFIG:Debug>:${long}>`, 'Debug');
+            const usage = evaluator.getMemoryUsage();
+            assert.strictEqual(usage.entries, 2);
+            assert.ok(usage.bytes > 200000);
+
+            // About 400 KB per distinct expression, so the 4 MB budget resets it
+            for (let i = 0; i < 12; i++) {
+                evaluator.evaluate(`$<$<CONFIG:Debug>:${long}${i}>`, 'Debug');
+            }
+            assert.ok(evaluator.getMemoryUsage().bytes <= 4 * 1024 * 1024);
+            assert.ok(evaluator.getMemoryUsage().entries < 26);
+        });
+    });
+});
@@ -0,0 +1,75 @@
+/**
+ * Tests for the per-configuration MSBuild settings index
+ */
+
+import * as assert from 'assert';
+import {
+    MsBuildSettingsIndex,
+    MsBuildSettingsView,
+    parseConfigurationCondition
+} from '../parsers/msbuildSettingsIndex';
+import { parseVcxproj } from '../parsers/vcxprojParser';
+
+describe('MSBuild Settings Index', () => {
+    it('should parse configuration conditions', () => {
+        assert.deepStrictEqual(parseConfigurationCondition("'$(Configuration)|$(Platform)'=='Debug|x64'"), { configuration: 'Debug', platform: 'x64' });
+        assert.deepStrictEqual(parseConfigurationCondition("'$(Configuration)' == 'Release'"), { configuration: 'Release' });
+        assert.strictEqual(parseConfigurationCondition("Exists('local.props')"), undefined);
+    });
+
+    it('should file values by configuration and platform', () => {
+        const index = new MsBuildSettingsIndex();
+        assert.ok(index.add(undefined, 'ClCompile', 'WarningLevel', 'Level3'));
+        assert.ok(index.add("'$(Configuration)|$(Platform)'=='Debug|Win32'", 'ClCompile', 'Optimization', 'Disabled'));
+        assert.ok(index.add("'$(Configuration)|$(Platform)'=='Debug|x64'", 'ClCompile', 'Optimization', 'MinSpace'));
+        assert.ok(index.add("'$(Configuration)|$(Platform)'=='Release|x64'", 'Link', 'OptimizeReferences', 'true'));
+        assert.strictEqual(index.add("'$(Platform)'=='ARM64'", 'ClCompile', 'Optimization', 'Full'), false);
+
+        assert.deepStrictEqual(index.getConfigurations(), ['Debug', 'Release']);
+        assert.deepStrictEqual(index.getPlatforms(), ['Win32', 'x64']);
+        assert.strictEqual(index.getEntry('Debug', 'Win32')!.sections.get('ClCompile')!.get('Optimization')![0], 'Disabled');
+
+        const debug = new MsBuildSettingsView(index.getEntries('Debug'));
+        assert.strictEqual(debug.get('ClCompile', 'Optimization'), 'MinSpace');
+        assert.deepStrictEqual(debug.getAll('ClCompile', 'Optimization'), ['Disabled', 'MinSpace']);
+        assert.strictEqual(debug.get('Link', 'OptimizeReferences'), undefined);
+        assert.strictEqual(new MsBuildSettingsView([index.getUnconditional()!]).get('ClCompile', 'WarningLevel'), 'Level3');
+    });
+
+    it('should merge platforms and read configuration properties in parseVcxproj', () => {
+        const configurations = ['Debug', 'Release', 'Profile', 'Asan', 'Tsan', 'Ubsan', 'Fuzz', 'Ship'];
+        const platforms = ['Win32', 'x64', 'ARM64'];
+        const groups: string[] = [];
+        for (const configuration of configurations) {
+            for (const platform of platforms) {
+                const condition = `'$(Configuration)|$(Platform)'=='${configuration}|${platform}'`;
+                groups.push(
+                    `  <PropertyGroup Condition="${condition}" Label="Configuration">`,
+                    `    <WholeProgramOptimization>${configuration === 'Ship'}</WholeProgramOptimization>`,
+                    '  </PropertyGroup>',
+                    `  <ItemDefinitionGroup Condition="${condition}">`,
+                    '    <ClCompile>',
+                    `      <PreprocessorDefinitions>${configuration.toUpperCase()};${platform.toUpperCase()};%(PreprocessorDefinitions)</PreprocessorDefinitions>`,
+                    `      <Optimization>${platform === 'ARM64' ? 'MinSpace' : 'MaxSpeed'}</Optimization>`,
+                    '    </ClCompile>',
+                    '    <Lib>',
+                    '      <AdditionalDependencies>zlib.lib;%(AdditionalDependencies)</AdditionalDependencies>',
+                    '    </Lib>',
+                    '  </ItemDefinitionGroup>'
+                );
+            }
+        }
+        const content = `<Project>\n${groups.join('\n')}\n  <ItemDefinitionGroup>\n    <ClCompile>\n      <AdditionalIncludeDirectories Condition="'$(Configuration)'=='Asan'">asan/include</AdditionalIncludeDirectories>\n    </ClCompile>\n  </ItemDefinitionGroup>\n</Project>`;
+
+        const project = parseVcxproj(content, '/path/to/Many.vcxproj');
+        assert.deepStrictEqual(Object.keys(project.configurations!), configurations);
+        const ship = project.configurations!.Ship;
+        assert.deepStrictEqual(ship.preprocessorDefinitions, ['SHIP', 'WIN32', 'X64', 'ARM64']);
+        assert.strictEqual(ship.optimization, 'MinSpace');
+        assert.strictEqual(ship.wholeProgramOptimization, true);
+        assert.deepStrictEqual(ship.libraries, ['zlib']);
+        assert.strictEqual(project.configurations!.Debug.wholeProgramOptimization, false);
+        assert.deepStrictEqual(project.configurations!.Asan.includeDirectories, ['asan/include']);
+        assert.deepStrictEqual(project.includeDirectories, []);
+    });
+});
@@ -0,0 +1,76 @@
+/**
+ * Tests for latency histograms and the performance monitor
+ */
+
+import * as assert from 'assert';
+import { PerformanceMonitor } from '../services/performanceMonitor';
+import { LatencyHistogram } from '../utils/latencyHistogram';
+
+describe('Performance monitoring', () => {
+    describe('LatencyHistogram', () => {
+        it('should report percentiles within 2% of the recorded values', () => {
+            const histogram = new LatencyHistogram();
+            for (let i = 1; i <= 10000; i++) {
+                histogram.record(i / 10);
+            }
+
+            assert.strictEqual(histogram.count, 10000);
+            for (const [p, expected] of [[50, 500], [95, 950], [99, 990]]) {
+                const value = histogram.percentile(p);
+                assert.ok(Math.abs(value - expected) / expected < 0.02, `p${p} = ${value}`);
+            }
+            assert.strictEqual(histogram.max(), 1000);
+            assert.ok(Math.abs(histogram.mean() - 500.05) < 1e-6);
+        });
+
+        it('should merge histograms', () => {
+            const a = new LatencyHistogram();
+            const b = new LatencyHistogram();
+            a.record(0.05);
+            b.record(5000);
+            a.merge(b);
+
+            assert.strictEqual(a.count, 2);
+            assert.strictEqual(a.percentile(50), 0.05);
+            assert.strictEqual(a.percentile(100), 5000);
+        });
+    });
+
+    describe('PerformanceMonitor', () => {
+        it('should only record while enabled', () => {
+            const monitor = new PerformanceMonitor();
+            assert.strictEqual(monitor.measure('hover', 10, () => 42), 42);
+            assert.deepStrictEqual(monitor.getReport(), []);
+
+            monitor.setEnabled(true);
+            monitor.measure('hover', 10, () => 42);
+            assert.strictEqual(monitor.getReport()[0].count, 1);
+        });
+
+        it('should time promises and instrumented providers per size bucket', async () => {
+            const monitor = new PerformanceMonitor();
+            monitor.setEnabled(true);
+            const provider = monitor.instrument({
+                offset: 1,
+                provideHover(document: { lineCount: number }) {
+                    return Promise.resolve(document.lineCount + this.offset);
+                }
+            }, { provideHover: 'hover' });
+
+            assert.strictEqual(await provider.provideHover({ lineCount: 20 }), 21);
+            await provider.provideHover({ lineCount: 50000 });
+            await assert.rejects(monitor.measure('resolver.parse', undefined, () => Promise.reject(new Error('failed'))));
+
+            assert.deepStrictEqual(
+                monitor.getReport().map(row => [row.operation, row.size, row.count]),
+                [
+                    ['hover', 'all', 2],
+                    ['hover', '<100 lines', 1],
+                    ['hover', '10k+ lines', 1],
+                    ['resolver.parse', 'all', 1]
+                ]
+            );
+            assert.ok(monitor.formatReport().startsWith('operation'));
+        });
+    });
+});
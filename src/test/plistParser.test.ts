@@ -0,0 +1,80 @@
+/**
+ * Tests for the OpenStep plist parser and pbxproj object graph
+ */
+
+import * as assert from 'assert';
+import { parsePlist, PbxObjectGraph, PlistParseError } from '../parsers/plistParser';
+import { makePbxproj } from '../bench/xcodeproj.bench';
+
+describe('Plist Parser', () => {
+    it('should parse dictionaries, arrays, strings and data', () => {
+        const value = parsePlist(`// !$*UTF8*$!
+{
+    name = App;
+    list = ( a, "b c", /* comment */ 'd', );
+    empty = ();
+    nested = { key = "value"; };
+    data = <0fbd 7771>;
+    path = ../src/main.cpp;
+}`);
+        assert.deepStrictEqual(value, {
+            name: 'App',
+            list: ['a', 'b c', 'd'],
+            empty: [],
+            nested: { key: 'value' },
+            data: '0fbd7771',
+            path: '../src/main.cpp'
+        });
+    });
+
+    it('should not treat braces and comment markers inside strings as structure', () => {
+        const value = parsePlist('{ script = "if [ -d x ]; then { echo \\"}\\"; } fi // not a comment /* nor this */"; next = 1; }');
+        assert.deepStrictEqual(value, {
+            script: 'if [ -d x ]; then { echo "}"; } fi // not a comment /* nor this */',
+            next: '1'
+        });
+    });
+
+    it('should decode escape sequences', () => {
+        assert.strictEqual(parsePlist('"a\\nb\\t\\\\\\"\\101\\U00e9"'), 'a\nb\t\\"Aé');
+    });
+
+    it('should report the offset of malformed input', () => {
+        assert.throws(() => parsePlist('{ a = b }'), (error: unknown) =>
+            error instanceof PlistParseError && error.offset === 8);
+        assert.throws(() => parsePlist('{ a = "b; }'), /Unterminated string/);
+        assert.throws(() => parsePlist('( a b )'), /Expected ','/);
+    });
+});
+
+describe('PbxObjectGraph', () => {
+    it('should index objects by ID and by isa in document order', () => {
+        const graph = PbxObjectGraph.parse(`{
+    objects = {
+        B2 = { isa = PBXFileReference; path = b.h; };
+        A1 = { isa = PBXFileReference; path = a.cpp; };
+        T1 = { isa = PBXNativeTarget; name = App; files = ( A1, MISSING, B2 ); main = A1; };
+        X = "not an object";
+    };
+    rootObject = T1;
+}`);
+        assert.strictEqual(graph.size, 3);
+        assert.strictEqual(graph.rootObjectId, 'T1');
+        assert.deepStrictEqual(graph.getIdsByIsa('PBXFileReference'), ['B2', 'A1']);
+        assert.deepStrictEqual(graph.getIdsByIsa('PBXGroup'), []);
+
+        const target = graph.get('T1')!;
+        assert.deepStrictEqual(graph.getRefs(target, 'files').map(file => file.path), ['a.cpp', 'b.h']);
+        assert.strictEqual(graph.getRef(target, 'main', 'PBXFileReference')?.path, 'a.cpp');
+        assert.strictEqual(graph.getRef(target, 'main', 'PBXGroup'), undefined);
+    });
+
+    it('should parse a large generated project', () => {
+        const graph = PbxObjectGraph.parse(makePbxproj(5000));
+        assert.strictEqual(graph.getIdsByIsa('PBXFileReference').length, 10000);
+        assert.strictEqual(graph.getIdsByIsa('PBXBuildFile').length, 5000);
+        const [target] = graph.getByIsa('PBXNativeTarget');
+        const [sources] = graph.getRefs(target, 'buildPhases');
+        assert.strictEqual(graph.getRefs(sources, 'files').length, 5000);
+    });
+});
@@ -0,0 +1,157 @@
+/**
+ * Tests for MSBuild property sheet imports and the sheet cache
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { parseVcxproj, resolveImportPath } from '../parsers/vcxprojParser';
+import { generateCMakeLists } from '../parsers/cmakeGenerator';
+import { PropertySheetCache } from '../services/propertySheetCache';
+import { isStampUnchanged, stampFile, stampFileOrMissing } from '../utils/fileStamp';
+
+const COMMON_PROPS = `<Project>
+  <ImportGroup Label="PropertySheets">
+    <Import Project="shared\\base.props" />
+  </ImportGroup>
+  <ItemDefinitionGroup>
+    <ClCompile>
+      <AdditionalIncludeDirectories>$(MSBuildThisFileDirectory)include;%(AdditionalIncludeDirectories)</AdditionalIncludeDirectories>
+      <PreprocessorDefinitions>COMMON;%(PreprocessorDefinitions)</PreprocessorDefinitions>
+    </ClCompile>
+  </ItemDefinitionGroup>
+</Project>`;
+
+const BASE_PROPS = `<Project>
+  <ItemDefinitionGroup>
+    <ClCompile><PreprocessorDefinitions>BASE;%(PreprocessorDefinitions)</PreprocessorDefinitions></ClCompile>
+    <Link><AdditionalDependencies>base.lib;%(AdditionalDependencies)</AdditionalDependencies></Link>
+  </ItemDefinitionGroup>
+</Project>`;
+
+const DEBUG_PROPS = `<Project>
+  <ItemDefinitionGroup>
+    <ClCompile><PreprocessorDefinitions>TRACE;%(PreprocessorDefinitions)</PreprocessorDefinitions></ClCompile>
+  </ItemDefinitionGroup>
+</Project>`;
+
+const PROJECT = `<Project>
+  <ImportGroup Label="PropertySheets" Condition="'$(Configuration)|$(Platform)'=='Debug|x64'">
+    <Import Project="$(UserRootDir)\\Microsoft.Cpp.$(Platform).user.props" Condition="exists('$(UserRootDir)\\Microsoft.Cpp.$(Platform).user.props')" />
+    <Import Project="$(SolutionDir)config\\debug.props" />
+  </ImportGroup>
+  <ImportGroup Label="PropertySheets">
+    <Import Project="..\\common.props" />
+  </ImportGroup>
+  <ItemDefinitionGroup>
+    <ClCompile>
+      <AdditionalIncludeDirectories>src;%(AdditionalIncludeDirectories)</AdditionalIncludeDirectories>
+      <PreprocessorDefinitions>APP;%(PreprocessorDefinitions)</PreprocessorDefinitions>
+    </ClCompile>
+  </ItemDefinitionGroup>
+  <ItemGroup><ClCompile Include="main.cpp" /></ItemGroup>
+</Project>`;
+
+describe('Property Sheets', () => {
+    let root: string;
+
+    function write(relativePath: string, content: string): string {
+        const filePath = path.join(root, relativePath);
+        fs.mkdirSync(path.dirname(filePath), { recursive: true });
+        fs.writeFileSync(filePath, content);
+        return filePath;
+    }
+
+    beforeEach(() => {
+        root = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-props-'));
+        write('common.props', COMMON_PROPS);
+        write('shared/base.props', BASE_PROPS);
+        write('config/debug.props', DEBUG_PROPS);
+        write('app/App.vcxproj', PROJECT);
+        write('tool/Tool.vcxproj', PROJECT);
+    });
+
+    afterEach(() => {
+        fs.rmSync(root, { recursive: true, force: true });
+    });
+
+    it('should resolve import paths', () => {
+        assert.strictEqual(resolveImportPath('..\\common.props', '/src/app'), '/src/common.props');
+        assert.strictEqual(resolveImportPath('$(SolutionDir)x.props', '/src/app', { solutionDir: 'C:\\src\\' }), 'C:/src/x.props');
+        assert.strictEqual(resolveImportPath('$(MSBuildThisFileDirectory)\\a\\..\\b.props', '/src'), '/src/b.props');
+        assert.strictEqual(resolveImportPath('$(VCTargetsPath)\\Microsoft.Cpp.props', '/src'), undefined);
+        assert.strictEqual(resolveImportPath('$(SolutionDir)x.props', '/src'), undefined);
+    });
+
+    it('should merge imported sheets into the project settings', () => {
+        const cache = new PropertySheetCache();
+        const projectPath = path.join(root, 'app', 'App.vcxproj');
+        const project = parseVcxproj(fs.readFileSync(projectPath, 'utf8'), projectPath, cache.getParseOptions(root));
+
+        assert.deepStrictEqual(project.includeDirectories, ['../include', 'src']);
+        assert.deepStrictEqual(project.preprocessorDefinitions, ['BASE', 'COMMON', 'APP']);
+        assert.deepStrictEqual(project.libraries, ['base']);
+        assert.deepStrictEqual(project.configurations!.Debug.preprocessorDefinitions, ['TRACE']);
+
+        // Without a loader, imports are ignored as before
+        assert.deepStrictEqual(parseVcxproj(PROJECT, projectPath).preprocessorDefinitions, ['APP']);
+    });
+
+    it('should parse each sheet once and reparse it when it changes', () => {
+        const cache = new PropertySheetCache();
+        const options = cache.getParseOptions(root);
+        for (const name of ['app/App.vcxproj', 'tool/Tool.vcxproj']) {
+            parseVcxproj(PROJECT, path.join(root, name), options);
+        }
+        assert.strictEqual(cache.getParseCount(), 3);
+
+        // A changed nested sheet invalidates the sheet that imports it
+        const basePath = write('shared/base.props', BASE_PROPS.replace('BASE;', 'BASE2;'));
+        const later = new Date(Date.now() + 10000);
+        fs.utimesSync(basePath, later, later);
+        const project = parseVcxproj(PROJECT, path.join(root, 'app', 'App.vcxproj'), options);
+        assert.deepStrictEqual(project.preprocessorDefinitions, ['BASE2', 'COMMON', 'APP']);
+        assert.strictEqual(cache.getParseCount(), 5);
+
+        // Sheets handed to another cache are not parsed again
+        const copy = new PropertySheetCache();
+        copy.restore(cache.serialize());
+        parseVcxproj(PROJECT, path.join(root, 'tool', 'Tool.vcxproj'), copy.getParseOptions(root));
+        assert.strictEqual(copy.getParseCount(), 0);
+    });
+
+    it('should treat a stamped file as changed when it appears, changes or disappears', () => {
+        const missing = stampFileOrMissing(path.join(root, 'later.props'));
+        assert.strictEqual(isStampUnchanged(missing), true);
+        write('later.props', DEBUG_PROPS);
+        assert.strictEqual(isStampUnchanged(missing), false);
+
+        const basePath = path.join(root, 'shared', 'base.props');
+        const stamp = stampFile(basePath)!;
+        assert.strictEqual(isStampUnchanged(stamp), true);
+        write('shared/base.props', BASE_PROPS + '\n');
+        assert.strictEqual(isStampUnchanged(stamp), false);
+        fs.rmSync(basePath);
+        assert.strictEqual(stampFile(basePath), undefined);
+        assert.strictEqual(isStampUnchanged(stamp), false);
+    });
+
+    it('should reparse a sheet once a missing nested import appears', () => {
+        fs.rmSync(path.join(root, 'shared', 'base.props'));
+        const cache = new PropertySheetCache();
+        const projectPath = path.join(root, 'app', 'App.vcxproj');
+        assert.deepStrictEqual(parseVcxproj(PROJECT, projectPath, cache.getParseOptions(root)).preprocessorDefinitions, ['COMMON', 'APP']);
+
+        write('shared/base.props', BASE_PROPS);
+        assert.deepStrictEqual(parseVcxproj(PROJECT, projectPath, cache.getParseOptions(root)).preprocessorDefinitions, ['BASE', 'COMMON', 'APP']);
+    });
+
+    it('should convert MSBuild directory properties in include directories', () => {
+        const project = parseVcxproj(`<Project><ItemDefinitionGroup><ClCompile>
+            <AdditionalIncludeDirectories>$(SolutionDir)include;$(ProjectDir)\\gen;$(SolutionDir)</AdditionalIncludeDirectories>
+        </ClCompile></ItemDefinitionGroup></Project>`, 'App.vcxproj');
+        const cmake = generateCMakeLists(project);
+        assert.ok(cmake.includes('    ${CMAKE_SOURCE_DIR}/include\n    ${CMAKE_CURRENT_SOURCE_DIR}/gen\n    ${CMAKE_SOURCE_DIR}\n'));
+    });
+});
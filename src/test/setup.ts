@@ -0,0 +1,8 @@
+/**
+ * Mocha setup, loaded with --require before the tests
+ * Worker threads inherit process.execArgv but not the ts-node hook that
+ * mocha's --require registered, so workers started by the tests (solution
+ * conversion, the CLI pool) are given it explicitly to load .ts scripts.
+ */
+
+process.execArgv.push('--require', 'ts-node/register/transpile-only');
@@ -0,0 +1,224 @@
+/**
+ * Tests for .sln parsing and whole-solution conversion
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { parseSln } from '../parsers/slnParser';
+import { generateCMakeLists } from '../parsers/cmakeGenerator';
+import { parseVcxproj } from '../parsers/vcxprojParser';
+import { convertSolution } from '../services/solutionConverter';
+import { WorkerPoolCancelledError } from '../utils/workerPool';
+
+const SOLUTION = `
+Microsoft Visual Studio Solution File, Format Version 12.00
+# Visual Studio Version 17
+Project("{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}") = "App", "app\\App.vcxproj", "{11111111-1111-1111-1111-111111111111}"
+	ProjectSection(ProjectDependencies) = postProject
+		{33333333-3333-3333-3333-333333333333} = {33333333-3333-3333-3333-333333333333}
+	EndProjectSection
+EndProject
+Project("{2150E333-8FDC-42A3-9474-1A3956D46DE8}") = "Libraries", "Libraries", "{99999999-9999-9999-9999-999999999999}"
+EndProject
+Project("{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}") = "Core", "libs\\core\\Core.vcxproj", "{22222222-2222-2222-2222-222222222222}"
+EndProject
+Project("{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}") = "Tool", "tool\\Tool.vcxproj", "{33333333-3333-3333-3333-333333333333}"
+EndProject
+Project("{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}") = "Scripts", "scripts\\Scripts.csproj", "{44444444-4444-4444-4444-444444444444}"
+EndProject
+Global
+	GlobalSection(SolutionConfigurationPlatforms) = preSolution
+		Debug|x64 = Debug|x64
+		Release|x64 = Release|x64
+	EndGlobalSection
+EndGlobal
+`;
+
+function vcxproj(type: string, sources: string[], references: string[] = []): string {
+    return `<Project>
+  <PropertyGroup Label="Configuration"><ConfigurationType>${type}</ConfigurationType></PropertyGroup>
+  <ItemGroup>${sources.map(source => `<ClCompile Include="${source}" />`).join('')}</ItemGroup>
+  <ItemGroup>${references.join('')}</ItemGroup>
+</Project>`;
+}
+
+describe('Solution Conversion', () => {
+    describe('parseSln', () => {
+        it('should read projects, dependencies and configurations', () => {
+            const solution = parseSln(SOLUTION, 'C:\\src\\Game.sln');
+            assert.strictEqual(solution.name, 'Game');
+            assert.deepStrictEqual(solution.projects.map(project => project.name), ['App', 'Core', 'Tool', 'Scripts']);
+            assert.strictEqual(solution.projects[1].path, 'libs/core/Core.vcxproj');
+            assert.strictEqual(solution.projects[1].guid, '22222222-2222-2222-2222-222222222222');
+            assert.deepStrictEqual(solution.projects[0].dependencies, ['33333333-3333-3333-3333-333333333333']);
+            assert.deepStrictEqual(solution.configurations, ['Debug|x64', 'Release|x64']);
+        });
+    });
+
+    describe('generateCMakeLists with a solution context', () => {
+        it('should link library references and order application references', () => {
+            const project = parseVcxproj(vcxproj('Application', ['main.cpp'], [
+                '<ProjectReference Include="..\\core\\Core.vcxproj" />',
+                '<ProjectReference Include="..\\gen\\Gen.vcxproj" />',
+                '<ProjectReference Include="..\\external\\Ext.vcxproj" />'
+            ]), 'App.vcxproj');
+            const cmake = generateCMakeLists(project, {
+                referenceTargets: [{ name: 'Core', type: 'StaticLibrary' }, { name: 'Gen', type: 'Application' }, undefined],
+                dependencyTargets: ['Gen', 'Core']
+            });
+            assert.ok(cmake.includes('target_link_libraries(${PROJECT_NAME} PRIVATE\n    Core\n)'));
+            assert.ok(cmake.includes('add_dependencies(${PROJECT_NAME} Gen)'));
+            assert.ok(cmake.includes('# Dependency not in solution: Ext'));
+            assert.ok(!cmake.includes('# add_dependencies'));
+        });
+    });
+
+    describe('convertSolution', () => {
+        let root: string;
+
+        beforeEach(() => {
+            root = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-sln-'));
+            for (const dir of ['app', 'libs/core', 'tool']) {
+                fs.mkdirSync(path.join(root, dir), { recursive: true });
+            }
+            fs.writeFileSync(path.join(root, 'Game.sln'), SOLUTION);
+            fs.writeFileSync(path.join(root, 'app', 'App.vcxproj'), vcxproj('Application', ['main.cpp'], [
+                '<ProjectReference Include="..\\libs\\core\\Core.vcxproj"><Project>{22222222-2222-2222-2222-222222222222}</Project></ProjectReference>'
+            ]));
+            fs.writeFileSync(path.join(root, 'libs', 'core', 'Core.vcxproj'), vcxproj('StaticLibrary', ['core.cpp']));
+            fs.writeFileSync(path.join(root, 'tool', 'Tool.vcxproj'), vcxproj('Application', ['tool.cpp'], [
+                // Matched by path, case-insensitively
+                '<ProjectReference Include="..\\LIBS\\core\\core.vcxproj" />'
+            ]));
+        });
+
+        afterEach(() => {
+            fs.rmSync(root, { recursive: true, force: true });
+        });
+
+        it('should convert every project and add them from the top level', async () => {
+            const progress: number[] = [];
+            const conversion = await convertSolution(path.join(root, 'Game.sln'), {
+                jobs: 1,
+                onProgress: (finished) => progress.push(finished)
+            });
+
+            assert.deepStrictEqual(progress, [1, 2, 3]);
+            assert.deepStrictEqual(conversion.files.map(file => path.relative(root, file.path)), [
+                path.join('app', 'CMakeLists.txt'),
+                path.join('libs', 'core', 'CMakeLists.txt'),
+                path.join('tool', 'CMakeLists.txt'),
+                'CMakeLists.txt'
+            ]);
+            assert.deepStrictEqual(conversion.skipped.map(item => item.name), ['Scripts']);
+
+            const app = conversion.files[0].content;
+            assert.ok(app.includes('target_link_libraries(${PROJECT_NAME} PRIVATE\n    Core\n)'));
+            assert.ok(app.includes('add_dependencies(${PROJECT_NAME} Tool)'));
+            assert.ok(conversion.files[2].content.includes('    Core\n)'));
+
+            const top = conversion.files[3].content;
+            assert.ok(top.startsWith('cmake_minimum_required(VERSION 3.10)\n\nproject(Game)'));
+            assert.ok(top.includes('add_subdirectory(app)\nadd_subdirectory(libs/core)\nadd_subdirectory(tool)\n'));
+        });
+
+        const pch = (header: string, type = 'StaticLibrary', includes = '') => `<Project>
+  <PropertyGroup Label="Configuration"><ConfigurationType>${type}</ConfigurationType></PropertyGroup>
+  <ItemDefinitionGroup><ClCompile><PrecompiledHeader>Use</PrecompiledHeader><PrecompiledHeaderFile>${header}</PrecompiledHeaderFile>${
+    includes ? `<AdditionalIncludeDirectories>${includes}</AdditionalIncludeDirectories>` : ''}</ClCompile></ItemDefinitionGroup>
+  <ItemGroup><ClCompile Include="a.cpp" /></ItemGroup>
+</Project>`;
+
+        it('should share a precompiled header between projects with the fast build profile', async () => {
+            fs.writeFileSync(path.join(root, 'app', 'App.vcxproj'), pch('..\\common\\pch.h'));
+            fs.writeFileSync(path.join(root, 'libs', 'core', 'Core.vcxproj'), pch('pch.h'));
+            fs.writeFileSync(path.join(root, 'tool', 'Tool.vcxproj'), pch('..\\COMMON\\pch.h'));
+
+            const conversion = await convertSolution(path.join(root, 'Game.sln'), {
+                jobs: 1,
+                fastBuild: {}
+            });
+
+            assert.ok(conversion.files[0].content.includes('target_precompile_headers(${PROJECT_NAME} PRIVATE ../common/pch.h)'));
+            assert.ok(conversion.files[1].content.includes('target_precompile_headers(${PROJECT_NAME} PRIVATE pch.h)'));
+            assert.ok(conversion.files[2].content.includes('target_precompile_headers(${PROJECT_NAME} REUSE_FROM App)'));
+        });
+
+        it('should not share a precompiled header across target types or include directories', async () => {
+            // A DLL is compiled with <name>_EXPORTS and PIC, so it cannot reuse an executable's PCH
+            fs.writeFileSync(path.join(root, 'app', 'App.vcxproj'), pch('..\\common\\pch.h', 'Application'));
+            fs.writeFileSync(path.join(root, 'libs', 'core', 'Core.vcxproj'), pch('..\\..\\common\\pch.h', 'DynamicLibrary'));
+            // Same relative include directory, but it names a different directory per project
+            fs.writeFileSync(path.join(root, 'tool', 'Tool.vcxproj'), pch('..\\common\\pch.h', 'Application', 'include'));
+
+            const conversion = await convertSolution(path.join(root, 'Game.sln'), {
+                jobs: 1,
+                fastBuild: {}
+            });
+
+            assert.ok(conversion.files[0].content.includes('target_precompile_headers(${PROJECT_NAME} PRIVATE ../common/pch.h)'));
+            assert.ok(conversion.files[1].content.includes('target_precompile_headers(${PROJECT_NAME} PRIVATE ../../common/pch.h)'));
+            assert.ok(conversion.files[2].content.includes('target_precompile_headers(${PROJECT_NAME} PRIVATE ../common/pch.h)'));
+            assert.ok(conversion.files.every(file => !file.content.includes('REUSE_FROM')));
+        });
+
+        it('should produce the same files on worker threads as in process', async function () {
+            // Workers load the TypeScript sources through ts-node (see setup.ts)
+            this.timeout(30000);
+            const names = ['Base', 'Core', 'Net', 'Ui', 'Game', 'Editor', 'Tests'];
+            const guid = (index: number) => `${index}0000000-0000-0000-0000-000000000000`;
+            const solution = names.map((name, index) =>
+                `Project("{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}") = "${name}", "${name.toLowerCase()}\\${name}.vcxproj", "{${guid(index + 1)}}"\nEndProject`
+            ).join('\n');
+            fs.writeFileSync(path.join(root, 'Big.sln'), `Microsoft Visual Studio Solution File, Format Version 12.00\n${solution}\n`);
+            fs.writeFileSync(path.join(root, 'common.props'), `<Project>
+  <ItemDefinitionGroup><ClCompile><PreprocessorDefinitions>COMMON;%(PreprocessorDefinitions)</PreprocessorDefinitions></ClCompile></ItemDefinitionGroup>
+</Project>`);
+            names.forEach((name, index) => {
+                const type = index < 4 ? 'StaticLibrary' : 'Application';
+                const reference = index > 0
+                    ? `<ProjectReference Include="..\\${names[index - 1].toLowerCase()}\\${names[index - 1]}.vcxproj" />`
+                    : '';
+                fs.mkdirSync(path.join(root, name.toLowerCase()), { recursive: true });
+                fs.writeFileSync(path.join(root, name.toLowerCase(), `${name}.vcxproj`), `<Project>
+  <PropertyGroup Label="Configuration"><ConfigurationType>${type}</ConfigurationType></PropertyGroup>
+  <ImportGroup Label="PropertySheets"><Import Project="..\\common.props" /></ImportGroup>
+  <ItemDefinitionGroup><ClCompile><PrecompiledHeader>Use</PrecompiledHeader><PrecompiledHeaderFile>..\\pch.h</PrecompiledHeaderFile></ClCompile></ItemDefinitionGroup>
+  <ItemGroup><ClCompile Include="${name.toLowerCase()}.cpp" /></ItemGroup>
+  <ItemGroup>${reference}</ItemGroup>
+</Project>`);
+            });
+
+            const serial = await convertSolution(path.join(root, 'Big.sln'), { jobs: 1, fastBuild: {} });
+            const progress: number[] = [];
+            const parallel = await convertSolution(path.join(root, 'Big.sln'), {
+                jobs: 2,
+                fastBuild: {},
+                onProgress: (finished) => progress.push(finished)
+            });
+
+            assert.deepStrictEqual(parallel.files, serial.files);
+            assert.deepStrictEqual(parallel.skipped, serial.skipped);
+            assert.strictEqual(progress[progress.length - 1], names.length);
+            // The imported sheet reached the workers, and references resolved across batches
+            assert.ok(parallel.files[0].content.includes('COMMON'));
+            assert.ok(parallel.files[4].content.includes('target_link_libraries(${PROJECT_NAME} PRIVATE\n    Ui\n)'));
+            assert.ok(parallel.files[6].content.includes('add_dependencies(${PROJECT_NAME} Editor)'));
+            assert.ok(parallel.files[5].content.includes('REUSE_FROM Game'));
+        });
+
+        it('should skip unreadable projects and stop when cancelled', async () => {
+            fs.rmSync(path.join(root, 'tool', 'Tool.vcxproj'));
+            const conversion = await convertSolution(path.join(root, 'Game.sln'), { jobs: 1 });
+            assert.deepStrictEqual(conversion.skipped.map(item => item.name), ['Scripts', 'Tool']);
+            assert.ok(!conversion.files[0].content.includes('add_dependencies'));
+
+            await assert.rejects(
+                convertSolution(path.join(root, 'Game.sln'), { jobs: 1, token: { isCancellationRequested: true } }),
+                WorkerPoolCancelledError
+            );
+        });
+    });
+});
@@ -0,0 +1,208 @@
+/**
+ * Tests for Target Index
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { TargetIndex, extractTargets } from '../services/targetIndex';
+import { parseCommands } from '../parsers/cmakeCommandParser';
+
+describe('Target Index', () => {
+
+    describe('extractTargets', () => {
+        it('should extract libraries, executables and custom targets', () => {
+            const content = `add_library(core STATIC core.cpp)
+add_executable(app main.cpp)
+add_custom_target(docs COMMAND doxygen)
+add_library(ext::zlib SHARED IMPORTED)`;
+            const { targets } = extractTargets(parseCommands(content), '/p/CMakeLists.txt');
+            assert.deepStrictEqual(targets.map(t => [t.name, t.kind]), [
+                ['core', 'library'], ['app', 'executable'], ['docs', 'custom'], ['ext::zlib', 'library']
+            ]);
+            assert.strictEqual(targets[0].libraryType, 'STATIC');
+            assert.strictEqual(targets[0].line, 1);
+            assert.strictEqual(targets[1].line, 2);
+            assert.strictEqual(targets[3].imported, true);
+        });
+
+        it('should skip link keywords, flags and generator expressions', () => {
+            const content = 'target_link_libraries(app PUBLIC core PRIVATE -pthread $<$<CONFIG:Debug>:dbg> debug util)';
+            const { edges } = extractTargets(parseCommands(content), 'f');
+            assert.deepStrictEqual(edges.map(e => e.to), ['core', 'util']);
+            assert.ok(edges.every(e => e.from === 'app' && e.kind === 'link'));
+        });
+
+        it('should record ALIAS targets as edges to the real target', () => {
+            const { targets, edges } = extractTargets(parseCommands('add_library(ns::core ALIAS core)'), 'f');
+            assert.strictEqual(targets[0].kind, 'alias');
+            assert.deepStrictEqual(edges.map(e => [e.from, e.to, e.kind]), [['ns::core', 'core', 'alias']]);
+        });
+
+        it('should expand list variables through the expander', () => {
+            const content = 'target_link_libraries(app ${LIBS})';
+            const { edges } = extractTargets(parseCommands(content), 'f', () => ['a', 'b']);
+            assert.deepStrictEqual(edges.map(e => e.to), ['a', 'b']);
+        });
+
+        it('should read add_dependencies and custom target DEPENDS', () => {
+            const content = `add_dependencies(app gen)
+add_custom_target(all_docs DEPENDS docs_a docs_b COMMENT "x")`;
+            const { edges } = extractTargets(parseCommands(content), 'f');
+            assert.deepStrictEqual(edges.map(e => [e.from, e.to, e.kind]), [
+                ['app', 'gen', 'dependency'],
+                ['all_docs', 'docs_a', 'dependency'],
+                ['all_docs', 'docs_b', 'dependency']
+            ]);
+        });
+    });
+
+    describe('TargetIndex', () => {
+        let index: TargetIndex;
+
+        beforeEach(() => {
+            index = new TargetIndex();
+            index.updateFile('/p/base/CMakeLists.txt', `add_library(base base.cpp)`);
+            index.updateFile('/p/core/CMakeLists.txt', `add_library(core core.cpp)
+target_link_libraries(core PUBLIC base)`);
+            index.updateFile('/p/app/CMakeLists.txt', `add_executable(app main.cpp)
+target_link_libraries(app PRIVATE core)
+add_executable(tool tool.cpp)
+target_link_libraries(tool base)`);
+        });
+
+        it('should answer direct dependency queries', () => {
+            assert.deepStrictEqual(Array.from(index.getDependencies('app')), ['core']);
+            assert.deepStrictEqual(Array.from(index.getDependents('base')).sort(), ['core', 'tool']);
+            assert.strictEqual(index.getDependencies('unknown').size, 0);
+        });
+
+        it('should compute transitive closures', () => {
+            assert.deepStrictEqual(Array.from(index.getTransitiveDependencies('app')).sort(), ['base', 'core']);
+            assert.deepStrictEqual(Array.from(index.getTransitiveDependents('base')).sort(), ['app', 'core', 'tool']);
+        });
+
+        it('should cache closures until a file changes', () => {
+            const first = index.getTransitiveDependents('base');
+            assert.strictEqual(index.getTransitiveDependents('base'), first);
+
+            index.updateFile('/p/app/CMakeLists.txt', 'add_executable(app main.cpp)');
+            assert.deepStrictEqual(Array.from(index.getTransitiveDependents('base')), ['core']);
+            assert.strictEqual(index.hasTarget('tool'), false);
+        });
+
+        it('should drop a removed file\'s targets and edges', () => {
+            index.removeFile('/p/core/CMakeLists.txt');
+            assert.strictEqual(index.hasTarget('core'), false);
+            assert.deepStrictEqual(Array.from(index.getDependents('base')), ['tool']);
+            assert.deepStrictEqual(index.getTargetNames(), ['app', 'base', 'tool']);
+        });
+
+        it('should report no cycles for an acyclic graph', () => {
+            assert.deepStrictEqual(index.findCycles(), []);
+            assert.strictEqual(index.getCycle('app'), undefined);
+        });
+
+        it('should find link cycles', () => {
+            index.updateFile('/p/base/CMakeLists.txt', `add_library(base base.cpp)
+target_link_libraries(base app)`);
+            const cycles = index.findCycles();
+            assert.strictEqual(cycles.length, 1);
+            assert.deepStrictEqual(cycles[0].slice().sort(), ['app', 'base', 'core']);
+            assert.ok(index.getCycle('core'));
+            assert.strictEqual(index.getCycle('tool'), undefined);
+            // Closures terminate and exclude the target itself
+            assert.deepStrictEqual(Array.from(index.getTransitiveDependencies('app')).sort(), ['base', 'core']);
+        });
+
+        it('should detect self dependencies', () => {
+            index.updateFile('/p/x/CMakeLists.txt', 'add_library(x x.cpp)\ntarget_link_libraries(x x)');
+            assert.deepStrictEqual(index.getCycle('x'), ['x']);
+        });
+
+        it('should answer target properties it can tell statically', () => {
+            index.updateFile('/p/x/CMakeLists.txt', `add_library(shared SHARED s.cpp)
+add_library(lib::shared ALIAS shared)
+add_library(ext STATIC IMPORTED)`);
+            assert.strictEqual(index.getTargetProperty('app', 'TYPE'), 'EXECUTABLE');
+            assert.strictEqual(index.getTargetProperty('lib::shared', 'TYPE'), 'SHARED_LIBRARY');
+            assert.strictEqual(index.getTargetProperty('lib::shared', 'ALIASED_TARGET'), 'shared');
+            assert.strictEqual(index.getTargetProperty('ext', 'IMPORTED'), 'TRUE');
+            assert.strictEqual(index.getTargetProperty('core', 'SOURCE_DIR'), path.dirname('/p/core/CMakeLists.txt'));
+            // Depends on BUILD_SHARED_LIBS, and properties the index does not hold
+            assert.strictEqual(index.getTargetProperty('core', 'TYPE'), undefined);
+            assert.strictEqual(index.getTargetProperty('app', 'OUTPUT_NAME'), undefined);
+            assert.strictEqual(index.getTargetProperty('missing', 'TYPE'), undefined);
+        });
+
+        it('should notify listeners on change', () => {
+            let calls = 0;
+            const unsubscribe = index.onDidChange(() => calls++);
+            index.updateFile('/p/y/CMakeLists.txt', 'add_library(y y.cpp)');
+            unsubscribe();
+            index.clear();
+            assert.strictEqual(calls, 1);
+        });
+
+        it('should keep closures that cannot reach a changed edge', () => {
+            index.updateFile('/p/other/CMakeLists.txt', 'add_library(other o.cpp)\ntarget_link_libraries(other ext)');
+            const app = index.getTransitiveDependencies('app');
+            const other = index.getTransitiveDependencies('other');
+            const base = index.getTransitiveDependents('base');
+
+            index.updateFile('/p/other/CMakeLists.txt', 'add_library(other o.cpp)\ntarget_link_libraries(other ext2)');
+            assert.strictEqual(index.getTransitiveDependencies('app'), app);
+            assert.strictEqual(index.getTransitiveDependents('base'), base);
+            assert.notStrictEqual(index.getTransitiveDependencies('other'), other);
+            assert.deepStrictEqual(Array.from(index.getTransitiveDependencies('other')), ['ext2']);
+        });
+
+        it('should keep an edge declared in two files until both drop it', () => {
+            index.updateFile('/p/extra/CMakeLists.txt', 'target_link_libraries(app core)');
+            index.removeFile('/p/extra/CMakeLists.txt');
+            assert.deepStrictEqual(Array.from(index.getDependencies('app')), ['core']);
+            index.updateFile('/p/app/CMakeLists.txt', 'add_executable(app main.cpp)');
+            assert.strictEqual(index.getDependencies('app').size, 0);
+            assert.deepStrictEqual(Array.from(index.getTransitiveDependents('base')), ['core']);
+        });
+
+        it('should fall back to another definition when a redefining file is removed', () => {
+            index.updateFile('/p/dup/CMakeLists.txt', 'add_executable(core dup.cpp)');
+            assert.strictEqual(index.getTarget('core')!.kind, 'executable');
+            index.removeFile('/p/dup/CMakeLists.txt');
+            assert.strictEqual(index.getTarget('core')!.file, '/p/core/CMakeLists.txt');
+        });
+
+        it('should notify listeners once for a batch of files', async () => {
+            const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-targets-'));
+            const files = ['a', 'b', 'c'].map(name => {
+                const file = path.join(dir, `${name}.cmake`);
+                fs.writeFileSync(file, `add_library(${name} ${name}.cpp)`);
+                return file;
+            });
+            let calls = 0;
+            const unsubscribe = index.onDidChange(() => calls++);
+            await index.indexFiles(files);
+            unsubscribe();
+            fs.rmSync(dir, { recursive: true, force: true });
+
+            assert.strictEqual(calls, 1);
+            assert.ok(['a', 'b', 'c'].every(name => index.hasTarget(name)));
+        });
+
+        it('should handle deep dependency chains', () => {
+            const lines: string[] = [];
+            for (let i = 0; i < 5000; i++) {
+                lines.push(`add_library(t${i} t.cpp)`);
+                if (i > 0) {
+                    lines.push(`target_link_libraries(t${i} t${i - 1})`);
+                }
+            }
+            index.updateFile('/p/deep/CMakeLists.txt', lines.join('\n'));
+            assert.strictEqual(index.getTransitiveDependencies('t4999').size, 4999);
+            assert.strictEqual(index.getTransitiveDependents('t0').size, 4999);
+            assert.deepStrictEqual(index.findCycles(), []);
+        });
+    });
+});
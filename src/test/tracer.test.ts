@@ -0,0 +1,99 @@
+/**
+ * Tests for the Chrome trace-event tracer
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { TraceEvent, Tracer } from '../services/tracer';
+
+function spans(tracer: Tracer): TraceEvent[] {
+    return tracer.toChromeTrace().traceEvents.filter(event => event.ph !== 'M');
+}
+
+describe('Tracer', () => {
+    it('should record nothing while disabled', () => {
+        const tracer = new Tracer();
+        assert.strictEqual(tracer.span('work', 'test', () => 1), 1);
+        assert.strictEqual(tracer.getEventCount(), 0);
+    });
+
+    it('should nest spans across awaits and emit async events for promises', async () => {
+        const tracer = new Tracer();
+        tracer.setEnabled(true);
+
+        await tracer.span('activate', 'activation', async () => {
+            await new Promise(resolve => setTimeout(resolve, 1));
+            tracer.span('parse', 'resolver', () => undefined, { file: 'CMakeLists.txt' });
+        });
+
+        const events = spans(tracer);
+        assert.deepStrictEqual(events.map(event => [event.name, event.ph]), [
+            ['activate', 'b'],
+            ['parse', 'X'],
+            ['activate', 'e']
+        ]);
+        assert.strictEqual(events[1].args?.parentId, events[0].args?.spanId);
+        assert.strictEqual(events[1].args?.file, 'CMakeLists.txt');
+        assert.strictEqual(events[0].id, events[2].id);
+        assert.ok(events[2].ts >= events[0].ts);
+    });
+
+    it('should group async spans of other categories under the root span', async () => {
+        const tracer = new Tracer();
+        tracer.setEnabled(true);
+
+        await tracer.span('activate', 'activation', async () => {
+            await tracer.span('parseFile', 'resolver', async () => {
+                await new Promise(resolve => setTimeout(resolve, 1));
+            });
+        });
+
+        // A child that starts before the first await is recorded before its
+        // parent's 'b' event; viewers order events by timestamp
+        const events = spans(tracer);
+        assert.deepStrictEqual(events.map(event => [event.name, event.ph, event.cat, event.args?.category]).sort(), [
+            ['activate', 'b', 'activation', 'activation'],
+            ['activate', 'e', 'activation', undefined],
+            ['parseFile', 'b', 'activation', 'resolver'],
+            ['parseFile', 'e', 'activation', undefined]
+        ]);
+        assert.ok(events.every(event => event.id === events[0].id));
+    });
+
+    it('should not parent spans to a span that has ended', async () => {
+        const tracer = new Tracer();
+        tracer.setEnabled(true);
+        let later: Promise<void> | undefined;
+        tracer.span('setup', 'test', () => {
+            later = new Promise(resolve => setTimeout(() => {
+                tracer.span('timer', 'test', () => undefined);
+                resolve();
+            }, 1));
+        });
+        await later;
+
+        const timer = spans(tracer).find(event => event.name === 'timer');
+        assert.strictEqual(timer?.args?.parentId, undefined);
+    });
+
+    it('should write a trace file that records errors', async () => {
+        const tracer = new Tracer();
+        tracer.setEnabled(true);
+        assert.throws(() => tracer.span('fail', 'test', () => {
+            throw new Error('boom');
+        }));
+
+        const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-trace-'));
+        try {
+            const file = await tracer.writeTrace(dir);
+            const trace = JSON.parse(fs.readFileSync(file, 'utf8'));
+            assert.strictEqual(trace.displayTimeUnit, 'ms');
+            const failed = trace.traceEvents.find((event: TraceEvent) => event.name === 'fail');
+            assert.strictEqual(failed.args.error, 'Error: boom');
+        } finally {
+            fs.rmSync(dir, { recursive: true, force: true });
+        }
+    });
+});
@@ -1097,5 +1097,75 @@ describe('Vcxproj Parser', () => {
             const project = parseVcxproj(content, '/path/to/MyApp.vcxproj');
             assert.strictEqual(project.cxxStandard, 20);
         });
+
+        it('should keep per-file metadata out of project-wide settings', () => {
+            const content = `<?xml version="1.0" encoding="utf-8"?>
+<Project DefaultTargets="Build" xmlns="http://schemas.microsoft.com/developer/msbuild/2003">
+  <ItemDefinitionGroup>
+    <ClCompile>
+      <PreprocessorDefinitions>APP;%(PreprocessorDefinitions)</PreprocessorDefinitions>
+    </ClCompile>
+  </ItemDefinitionGroup>
+  <ItemGroup>
+    <ClCompile Include="legacy.c">
+      <PreprocessorDefinitions>LEGACY;%(PreprocessorDefinitions)</PreprocessorDefinitions>
+      <Optimization>Disabled</Optimization>
+    </ClCompile>
+  </ItemGroup>
+</Project>`;
+
+            const project = parseVcxproj(content, '/path/to/MyApp.vcxproj');
+            assert.deepStrictEqual(project.preprocessorDefinitions, ['APP']);
+            assert.strictEqual(project.optimization, undefined);
+            assert.deepStrictEqual(project.sourceFiles, ['legacy.c']);
+        });
+
+        it('should read conditioned items and per-configuration PCH settings', () => {
+            const content = `<?xml version="1.0" encoding="utf-8"?>
+<Project DefaultTargets="Build" xmlns="http://schemas.microsoft.com/developer/msbuild/2003">
+  <ItemGroup>
+    <ClCompile Include="win.cpp" Condition="'$(Platform)'=='x64'" />
+    <ClCompile Include="pch.cpp">
+      <PrecompiledHeader Condition="'$(Configuration)|$(Platform)'=='Debug|x64'">Create</PrecompiledHeader>
+      <PrecompiledHeader Condition="'$(Configuration)|$(Platform)'=='Release|x64'">Create</PrecompiledHeader>
+    </ClCompile>
+    <ClCompile Include="win.cpp" />
+  </ItemGroup>
+</Project>`;
+
+            const project = parseVcxproj(content, '/path/to/MyApp.vcxproj');
+            assert.deepStrictEqual(project.sourceFiles, ['win.cpp', 'pch.cpp']);
+            assert.strictEqual(project.pchConfig?.sourceFile, 'pch.cpp');
+            assert.strictEqual(project.pchConfig?.enabled, true);
+        });
+
+        it('should read build event commands from CDATA and skip comments', () => {
+            const content = `<?xml version="1.0" encoding="utf-8"?>
+<Project DefaultTargets="Build" xmlns="http://schemas.microsoft.com/developer/msbuild/2003">
+  <!-- <ClCompile Include="commented.cpp" /> -->
+  <ItemDefinitionGroup>
+    <PostBuildEvent>
+      <Command><![CDATA[copy a b]]></Command>
+    </PostBuildEvent>
+  </ItemDefinitionGroup>
+</Project>`;
+
+            const project = parseVcxproj(content, '/path/to/MyApp.vcxproj');
+            assert.deepStrictEqual(project.sourceFiles, []);
+            assert.strictEqual(project.buildEvents?.[0].command, 'copy a b');
+        });
+
+        it('should deduplicate large item lists in document order', () => {
+            const items: string[] = [];
+            for (let i = 0; i < 20000; i++) {
+                items.push(`    <ClCompile Include="src\\file${i % 10000}.cpp" />`);
+            }
+            const content = `<Project>\n  <ItemGroup>\n${items.join('\n')}\n  </ItemGroup>\n</Project>`;
+
+            const project = parseVcxproj(content, '/path/to/Big.vcxproj');
+            assert.strictEqual(project.sourceFiles.length, 10000);
+            assert.strictEqual(project.sourceFiles[0], 'src/file0.cpp');
+            assert.strictEqual(project.sourceFiles[9999], 'src/file9999.cpp');
+        });
     });
 });
@@ -0,0 +1,74 @@
+/**
+ * Tests for optimal-fit line wrapping
+ */
+
+import * as assert from 'assert';
+import { breakLines, packLines } from '../utils/wrapUtils';
+
+/**
+ * Minimum number of lines, computed greedily
+ */
+function greedyLineCount(texts: string[], width: number): number {
+    let lines = 0;
+    let used = Infinity;
+    for (const text of texts) {
+        if (used + 1 + text.length > width) {
+            lines++;
+            used = text.length;
+        } else {
+            used += 1 + text.length;
+        }
+    }
+    return lines;
+}
+
+describe('Wrap Utils', () => {
+
+    describe('breakLines', () => {
+        it('should return no lines for no items', () => {
+            assert.deepStrictEqual(breakLines([], 10), []);
+        });
+
+        it('should keep everything on one line when it fits', () => {
+            assert.deepStrictEqual(breakLines([{ width: 3 }, { width: 3 }], 7), [0]);
+        });
+
+        it('should give an oversized item its own line', () => {
+            assert.deepStrictEqual(breakLines([{ width: 2 }, { width: 20 }, { width: 2 }], 10), [0, 1, 2]);
+        });
+
+        it('should honour forced breaks', () => {
+            assert.deepStrictEqual(breakLines([{ width: 1, breakAfter: true }, { width: 1 }, { width: 1 }], 80), [0, 1]);
+        });
+
+        it('should use the first line width', () => {
+            assert.deepStrictEqual(breakLines([{ width: 4 }, { width: 4 }, { width: 4 }], 9, 4), [0, 1]);
+        });
+    });
+
+    describe('packLines', () => {
+        it('should use the minimum number of lines', () => {
+            const texts = 'aaa bb c dddd ee f ggggg hh i jjj kk'.split(' ');
+            for (let width = 5; width <= 20; width++) {
+                const lines = packLines(texts, width);
+                assert.strictEqual(lines.length, greedyLineCount(texts, width), `width ${width}`);
+                assert.ok(lines.every(line => line.length <= width));
+                assert.strictEqual(lines.join(' '), texts.join(' '));
+            }
+        });
+
+        it('should balance lines instead of filling greedily', () => {
+            // Greedy fills "aaa bb" and leaves "cc" alone on the second line
+            assert.deepStrictEqual(packLines(['aaa', 'bb', 'cc', 'ddddd'], 6), ['aaa', 'bb cc', 'ddddd']);
+        });
+
+        it('should pack thousands of items in linear time', () => {
+            const texts = Array.from({ length: 5000 }, (_, i) => `src/module${i % 97}/file${i}.cpp`);
+            const start = Date.now();
+            const lines = packLines(texts, 76, 60);
+            assert.ok(Date.now() - start < 500);
+            assert.strictEqual(lines.join(' '), texts.join(' '));
+            assert.ok(lines.every(line => line.length <= 76));
+        });
+    });
+});
@@ -0,0 +1,232 @@
+/**
+ * Tests for xcconfig evaluation, the xcconfig cache and Xcode workspaces
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { parseXcconfig, splitSettingValue, XcconfigAssignment, XcodeBuildSettings } from '../parsers/xcconfigParser';
+import { parseXcodeproj } from '../parsers/xcodeprojParser';
+import { parseXcworkspace } from '../parsers/xcworkspaceParser';
+import { XcconfigCache } from '../services/xcconfigCache';
+import { convertXcworkspace } from '../services/xcodeprojConverter';
+
+function assignments(content: string): XcconfigAssignment[] {
+    return parseXcconfig(content, 'test.xcconfig').entries.filter(
+        (entry): entry is XcconfigAssignment => entry.kind === 'assignment'
+    );
+}
+
+/**
+ * Project and target each with a base configuration (Shared.xcconfig and
+ * App.xcconfig) and buildSettings on top
+ */
+function makePbxproj(name: string, dependencies: string[] = []): string {
+    const dependencyObjects = dependencies.map((dep, index) =>
+        `DEP${index} = { isa = PBXTargetDependency; name = ${dep}; };`).join('\n\t\t');
+    return `// !$*UTF8*$!
+{
+	objects = {
+		PROJ = { isa = PBXProject; buildConfigurationList = PROJCL; mainGroup = MAIN; targets = ( APP ); };
+		MAIN = { isa = PBXGroup; children = ( SHARED, APPCONF, FR1 ); sourceTree = "<group>"; };
+		SHARED = { isa = PBXFileReference; path = Shared.xcconfig; sourceTree = "<group>"; };
+		APPCONF = { isa = PBXFileReference; path = config/App.xcconfig; sourceTree = SOURCE_ROOT; };
+		FR1 = { isa = PBXFileReference; path = main.cpp; sourceTree = "<group>"; };
+		PROJCL = { isa = XCConfigurationList; buildConfigurations = ( PROJDEBUG ); };
+		PROJDEBUG = {
+			isa = XCBuildConfiguration;
+			baseConfigurationReference = SHARED;
+			buildSettings = { GCC_PREPROCESSOR_DEFINITIONS = ( "$(inherited)", PROJECT ); };
+			name = Debug;
+		};
+		APP = {
+			isa = PBXNativeTarget;
+			buildConfigurationList = APPCL;
+			buildPhases = ( APPSRC );
+			dependencies = ( ${dependencies.map((_, index) => `DEP${index}`).join(', ')} );
+			name = ${name};
+			productType = "com.apple.product-type.library.static";
+		};
+		${dependencyObjects}
+		APPCL = { isa = XCConfigurationList; buildConfigurations = ( APPDEBUG ); };
+		APPDEBUG = {
+			isa = XCBuildConfiguration;
+			baseConfigurationReference = APPCONF;
+			buildSettings = { GCC_PREPROCESSOR_DEFINITIONS = "$(inherited) TARGET"; };
+			name = Debug;
+		};
+		APPSRC = { isa = PBXSourcesBuildPhase; files = ( BF1 ); };
+		BF1 = { isa = PBXBuildFile; fileRef = FR1; };
+	};
+	rootObject = PROJ;
+}`;
+}
+
+describe('Xcconfig', () => {
+    describe('parseXcconfig', () => {
+        it('should parse includes, conditions and comments', () => {
+            const file = parseXcconfig([
+                '// Shared settings',
+                '#include "Base.xcconfig"',
+                '#include? "Local.xcconfig"',
+                'OTHER_CFLAGS = -Wall // comment',
+                'GCC_OPTIMIZATION_LEVEL[config=Debug] = 0;',
+                'ARCHS[sdk=iphoneos*][arch=*] = arm64'
+            ].join('\n'), 'Shared.xcconfig');
+
+            assert.deepStrictEqual(file.entries, [
+                { kind: 'include', path: 'Base.xcconfig', optional: false },
+                { kind: 'include', path: 'Local.xcconfig', optional: true },
+                { kind: 'assignment', key: 'OTHER_CFLAGS', conditions: [], value: '-Wall' },
+                { kind: 'assignment', key: 'GCC_OPTIMIZATION_LEVEL', conditions: [['config', 'Debug']], value: '0' },
+                { kind: 'assignment', key: 'ARCHS', conditions: [['sdk', 'iphoneos*'], ['arch', '*']], value: 'arm64' }
+            ]);
+        });
+
+        it('should split values honoring quotes and escapes', () => {
+            assert.deepStrictEqual(
+                splitSettingValue('A "B C" \'D\' E\\ F'),
+                ['A', 'B C', 'D', 'E F']
+            );
+        });
+    });
+
+    describe('XcodeBuildSettings', () => {
+        it('should expand $(inherited) through layers and apply config conditions', () => {
+            const settings = new XcodeBuildSettings()
+                .withAssignments(assignments([
+                    'GCC_PREPROCESSOR_DEFINITIONS = BASE',
+                    'GCC_PREPROCESSOR_DEFINITIONS[config=Debug] = $(inherited) DEBUG=1',
+                    'GCC_PREPROCESSOR_DEFINITIONS[config=Release] = $(inherited) NDEBUG',
+                    'ARCHS[sdk=iphoneos*] = arm64'
+                ].join('\n')), 'Debug')
+                .withDictionary({ GCC_PREPROCESSOR_DEFINITIONS: ['$(inherited)', 'NAME="a b"'] });
+
+            assert.deepStrictEqual(settings.getList('GCC_PREPROCESSOR_DEFINITIONS'), ['BASE', 'DEBUG=1', 'NAME="a b"']);
+            assert.strictEqual(settings.has('ARCHS'), false);
+        });
+    });
+
+    describe('XcconfigCache', () => {
+        let root: string;
+
+        beforeEach(() => {
+            root = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-xcconfig-'));
+        });
+
+        afterEach(() => {
+            fs.rmSync(root, { recursive: true, force: true });
+        });
+
+        it('should inline includes and reparse only when an included file changes', () => {
+            const shared = path.join(root, 'Shared.xcconfig');
+            const base = path.join(root, 'base', 'Base.xcconfig');
+            fs.mkdirSync(path.dirname(base));
+            fs.writeFileSync(shared, '#include "base/Base.xcconfig"\n#include? "Missing.xcconfig"\nOTHER_CFLAGS = $(inherited) -Wall\n');
+            fs.writeFileSync(base, 'OTHER_CFLAGS = -O2\n');
+
+            const cache = new XcconfigCache();
+            const sharedPath = shared.replace(/\\/g, '/');
+            assert.deepStrictEqual(cache.load(sharedPath)?.map(item => item.value), ['-O2', '$(inherited) -Wall']);
+            cache.load(sharedPath);
+            assert.strictEqual(cache.getParseCount(), 2);
+
+            fs.writeFileSync(base, 'OTHER_CFLAGS = -O3 -g\n');
+            assert.deepStrictEqual(cache.load(sharedPath)?.map(item => item.value), ['-O3 -g', '$(inherited) -Wall']);
+            assert.strictEqual(cache.getParseCount(), 4);
+        });
+
+        it('should layer project and target base configurations when parsing a project', () => {
+            fs.writeFileSync(path.join(root, 'Shared.xcconfig'), 'GCC_PREPROCESSOR_DEFINITIONS = SHARED\n');
+            fs.mkdirSync(path.join(root, 'config'));
+            fs.writeFileSync(path.join(root, 'config', 'App.xcconfig'),
+                'GCC_PREPROCESSOR_DEFINITIONS = $(inherited) APP\nCLANG_CXX_LANGUAGE_STANDARD = c++20\n');
+
+            const projectPath = path.join(root, 'App.xcodeproj').replace(/\\/g, '/');
+            const project = parseXcodeproj(makePbxproj('App'), projectPath, new XcconfigCache().getParseOptions());
+
+            assert.deepStrictEqual(project.configurations?.Debug.preprocessorDefinitions, ['SHARED', 'PROJECT', 'APP', 'TARGET']);
+            assert.strictEqual(project.cxxStandard, 20);
+        });
+    });
+
+    describe('Workspaces', () => {
+        it('should resolve group, container and absolute locations', () => {
+            const workspace = `<?xml version="1.0" encoding="UTF-8"?>
+<Workspace version = "1.0">
+   <FileRef location = "group:App/App.xcodeproj"></FileRef>
+   <Group location = "container:Libraries" name = "Libraries">
+      <FileRef location = "group:Core/Core.xcodeproj"></FileRef>
+      <FileRef location = "group:README.md"></FileRef>
+   </Group>
+   <FileRef location = "absolute:/opt/Vendor/Vendor.xcodeproj"></FileRef>
+   <FileRef location = "container:App/App.xcodeproj"></FileRef>
+</Workspace>`;
+            assert.deepStrictEqual(parseXcworkspace(workspace, '/src/All.xcworkspace'), [
+                '/src/App/App.xcodeproj',
+                '/src/Libraries/Core/Core.xcodeproj',
+                '/opt/Vendor/Vendor.xcodeproj'
+            ]);
+        });
+
+        it('should convert every project and link targets across projects', async () => {
+            const root = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-xcworkspace-'));
+            try {
+                for (const [dir, name, deps] of [['App', 'App', ['Core']], ['Core', 'Core', []]] as const) {
+                    fs.mkdirSync(path.join(root, dir, `${name}.xcodeproj`), { recursive: true });
+                    fs.writeFileSync(path.join(root, dir, `${name}.xcodeproj`, 'project.pbxproj'), makePbxproj(name, [...deps]));
+                }
+                fs.mkdirSync(path.join(root, 'All.xcworkspace'));
+                fs.writeFileSync(path.join(root, 'All.xcworkspace', 'contents.xcworkspacedata'), `<Workspace version = "1.0">
+   <FileRef location = "group:App/App.xcodeproj"></FileRef>
+   <FileRef location = "group:Core/Core.xcodeproj"></FileRef>
+   <FileRef location = "group:Missing/Missing.xcodeproj"></FileRef>
+</Workspace>`);
+
+                const conversion = await convertXcworkspace(path.join(root, 'All.xcworkspace'));
+
+                assert.deepStrictEqual(conversion.files.map(file => path.relative(root, file.path).replace(/\\/g, '/')), [
+                    'App/CMakeLists.txt',
+                    'Core/CMakeLists.txt',
+                    'CMakeLists.txt'
+                ]);
+                assert.strictEqual(conversion.targetCount, 2);
+                assert.deepStrictEqual(conversion.skipped.map(item => item.name), ['Missing']);
+                assert.ok(conversion.files[0].content.includes('target_link_libraries(App PRIVATE\n    Core\n)'));
+                assert.ok(conversion.files[2].content.includes('add_subdirectory(App)\nadd_subdirectory(Core)'));
+            } finally {
+                fs.rmSync(root, { recursive: true, force: true });
+            }
+        });
+
+        it('should skip a project whose target names clash with an earlier project', async () => {
+            const root = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-xcworkspace-'));
+            try {
+                // Both projects define a target named Core
+                for (const dir of ['Core', 'Fork']) {
+                    fs.mkdirSync(path.join(root, dir, `${dir}.xcodeproj`), { recursive: true });
+                    fs.writeFileSync(path.join(root, dir, `${dir}.xcodeproj`, 'project.pbxproj'), makePbxproj('Core'));
+                }
+                fs.mkdirSync(path.join(root, 'All.xcworkspace'));
+                fs.writeFileSync(path.join(root, 'All.xcworkspace', 'contents.xcworkspacedata'), `<Workspace version = "1.0">
+   <FileRef location = "group:Core/Core.xcodeproj"></FileRef>
+   <FileRef location = "group:Fork/Fork.xcodeproj"></FileRef>
+</Workspace>`);
+
+                const conversion = await convertXcworkspace(path.join(root, 'All.xcworkspace'));
+
+                assert.deepStrictEqual(conversion.files.map(file => path.relative(root, file.path).replace(/\\/g, '/')), [
+                    'Core/CMakeLists.txt',
+                    'CMakeLists.txt'
+                ]);
+                assert.strictEqual(conversion.targetCount, 1);
+                assert.deepStrictEqual(conversion.skipped.map(item => item.name), ['Fork']);
+                assert.ok(conversion.skipped[0].reason.includes('Core (Core)'));
+                assert.ok(!conversion.files[1].content.includes('add_subdirectory(Fork)'));
+            } finally {
+                fs.rmSync(root, { recursive: true, force: true });
+            }
+        });
+    });
+});
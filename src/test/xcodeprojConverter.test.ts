@@ -0,0 +1,140 @@
+/**
+ * Tests for converting every native target of an Xcode project
+ */
+
+import * as assert from 'assert';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { parseXcodeproj, parseXcodeprojTargets } from '../parsers/xcodeprojParser';
+import { convertXcodeproj, planXcodeTargets } from '../services/xcodeprojConverter';
+import { WorkerPoolCancelledError } from '../utils/workerPool';
+
+/**
+ * App depending on Core (framework, by name) and Util (static library, via
+ * its proxy), plus a test bundle depending on App and a target of another project
+ */
+const PBXPROJ = `// !$*UTF8*$!
+{
+	objects = {
+		PROJ /* Project object */ = { isa = PBXProject; targets = ( APP, CORE, UTIL, TESTS ); };
+		APP = {
+			isa = PBXNativeTarget;
+			buildConfigurationList = APPCL;
+			buildPhases = ( APPSRC, APPFW );
+			dependencies = ( DEPCORE, DEPUTIL );
+			name = App;
+			productType = "com.apple.product-type.tool";
+		};
+		CORE = {
+			isa = PBXNativeTarget;
+			buildPhases = ( CORESRC );
+			name = Core;
+			productType = "com.apple.product-type.framework";
+		};
+		UTIL = {
+			isa = PBXNativeTarget;
+			buildPhases = ( );
+			name = Util;
+			productType = "com.apple.product-type.library.static";
+		};
+		TESTS = {
+			isa = PBXNativeTarget;
+			buildPhases = ( );
+			dependencies = ( DEPAPP, DEPREMOTE );
+			name = AppTests;
+			productType = "com.apple.product-type.bundle.unit-test";
+		};
+		APPSRC = { isa = PBXSourcesBuildPhase; files = ( BF1 ); };
+		APPFW = { isa = PBXFrameworksBuildPhase; files = ( BF2, BF3, BF4 ); };
+		CORESRC = { isa = PBXSourcesBuildPhase; files = ( BF5 ); };
+		BF1 = { isa = PBXBuildFile; fileRef = FR1; };
+		BF2 = { isa = PBXBuildFile; fileRef = FR2; };
+		BF3 = { isa = PBXBuildFile; fileRef = FR3; };
+		BF4 = { isa = PBXBuildFile; fileRef = FR4; };
+		BF5 = { isa = PBXBuildFile; fileRef = FR5; };
+		FR1 = { isa = PBXFileReference; path = main.cpp; };
+		FR2 = { isa = PBXFileReference; path = Core.framework; };
+		FR3 = { isa = PBXFileReference; path = libUtil.a; };
+		FR4 = { isa = PBXFileReference; path = Foundation.framework; };
+		FR5 = { isa = PBXFileReference; path = core.cpp; };
+		DEPCORE = { isa = PBXTargetDependency; name = Core; target = CORE; };
+		DEPUTIL = { isa = PBXTargetDependency; target = UTIL; targetProxy = PROXYUTIL; };
+		PROXYUTIL = { isa = PBXContainerItemProxy; remoteGlobalIDString = UTIL; };
+		DEPAPP = { isa = PBXTargetDependency; name = App; };
+		DEPREMOTE = { isa = PBXTargetDependency; name = Remote; };
+		APPCL = { isa = XCConfigurationList; buildConfigurations = ( APPDBG ); };
+		APPDBG = {
+			isa = XCBuildConfiguration;
+			buildSettings = { ARCHS = arm64; MACOSX_DEPLOYMENT_TARGET = 12.0; };
+			name = Debug;
+		};
+	};
+	rootObject = PROJ;
+}`;
+
+describe('Xcode Project Converter', () => {
+    it('should parse every native target in project order', () => {
+        const projects = parseXcodeprojTargets(PBXPROJ, '/src/Game.xcodeproj');
+        assert.deepStrictEqual(projects.map(project => project.name), ['App', 'Core', 'Util', 'AppTests']);
+        assert.deepStrictEqual(projects[0].targetDependencies, ['Core', 'Util']);
+        assert.deepStrictEqual(projects[3].targetDependencies, ['App', 'Remote']);
+        assert.strictEqual(parseXcodeproj(PBXPROJ, '/src/Game.xcodeproj').name, 'App');
+
+        const tasks = planXcodeTargets(projects);
+        assert.deepStrictEqual(tasks[3].targets.dependencyTargets, [{ name: 'App', type: 'Application' }, undefined]);
+    });
+
+    describe('convertXcodeproj', () => {
+        let root: string;
+
+        beforeEach(() => {
+            root = fs.mkdtempSync(path.join(os.tmpdir(), 'cmake-companion-xcode-'));
+            fs.mkdirSync(path.join(root, 'Game.xcodeproj'));
+            fs.writeFileSync(path.join(root, 'Game.xcodeproj', 'project.pbxproj'), PBXPROJ);
+        });
+
+        afterEach(() => {
+            fs.rmSync(root, { recursive: true, force: true });
+        });
+
+        it('should generate one section per target with dependency edges', async () => {
+            const conversion = await convertXcodeproj(path.join(root, 'Game.xcodeproj'));
+            const content = conversion.content;
+            assert.strictEqual(conversion.path, path.join(root, 'CMakeLists.txt'));
+
+            // Build-wide settings once, before project()
+            assert.ok(content.startsWith('cmake_minimum_required(VERSION 3.14)\n'));
+            assert.ok(content.indexOf('set(CMAKE_OSX_ARCHITECTURES arm64)') < content.indexOf('project(Game)'));
+            assert.strictEqual(content.match(/CMAKE_OSX_DEPLOYMENT_TARGET/g)?.length, 1);
+            assert.ok(!content.includes('PROJECT_NAME'));
+
+            // Targets in order, each named explicitly
+            const sections = ['# Target: App', '# Target: Core', '# Target: Util', '# Target: AppTests'].map(s => content.indexOf(s));
+            assert.deepStrictEqual([...sections].sort((a, b) => a - b), sections);
+            assert.ok(content.includes('add_executable(App ${SOURCES})'));
+            assert.ok(content.includes('add_library(Core SHARED ${SOURCES})'));
+
+            // Products of linked targets are not linked again as system libraries
+            assert.ok(content.includes('target_link_libraries(App PRIVATE\n    -framework Foundation\n)'));
+            assert.ok(content.includes('target_link_libraries(App PRIVATE\n    Core\n    Util\n)'));
+            assert.ok(content.includes('add_dependencies(AppTests App)\n# Dependency not converted: Remote'));
+        });
+
+        it('should keep single-target projects unchanged and stop when cancelled', async () => {
+            const single = PBXPROJ.replace('targets = ( APP, CORE, UTIL, TESTS )', 'targets = ( UTIL )')
+                .replace(/\t\t(APP|CORE|TESTS) = \{\n\t\t\tisa = PBXNativeTarget;/g, '\t\t$1 = {\n\t\t\tisa = PBXAggregateTarget;');
+            fs.writeFileSync(path.join(root, 'Game.xcodeproj', 'project.pbxproj'), single);
+            const conversion = await convertXcodeproj(path.join(root, 'Game.xcodeproj'));
+            assert.deepStrictEqual(conversion.projects.map(project => project.name), ['Util']);
+            assert.ok(conversion.content.includes('project(Util)\n'));
+            assert.ok(conversion.content.includes('add_library(${PROJECT_NAME} STATIC lib.cpp)'));
+
+            fs.writeFileSync(path.join(root, 'Game.xcodeproj', 'project.pbxproj'), PBXPROJ);
+            await assert.rejects(
+                convertXcodeproj(path.join(root, 'Game.xcodeproj'), { token: { isCancellationRequested: true } }),
+                WorkerPoolCancelledError
+            );
+        });
+    });
+});
@@ -983,5 +983,40 @@ describe('Xcodeproj Parser', () => {
             assert.strictEqual(project.configurations!.Debug?.treatWarningsAsErrors, true);
             assert.strictEqual(project.configurations!.Release?.deadCodeStripping, true);
         });
+
+        it('should handle braces in quoted values and objects without comments', () => {
+            const content = `// !$*UTF8*$!
+{
+	objects = {
+		T1 = {
+			isa = PBXNativeTarget;
+			buildConfigurationList = L1;
+			buildPhases = ( S1 );
+			name = "My App";
+			productType = "com.apple.product-type.tool";
+		};
+		S1 = {
+			isa = PBXShellScriptBuildPhase;
+			shellPath = /bin/sh;
+			shellScript = "if true; then { echo \\"}\\"; }; fi";
+		};
+		C1 = {
+			isa = XCBuildConfiguration;
+			buildSettings = {
+				GCC_PREPROCESSOR_DEFINITIONS = "NAME=\\"{x}\\"";
+				VALID_ARCHS = "i386";
+				ARCHS = arm64;
+			};
+			name = Debug;
+		};
+		L1 = { isa = XCConfigurationList; buildConfigurations = ( C1 ); };
+	};
+}`;
+            const project = parseXcodeproj(content, '/path/to/MyApp.xcodeproj');
+            assert.strictEqual(project.name, 'My App');
+            assert.strictEqual(project.shellScriptPhases![0].shellScript, 'if true; then { echo "}"; }; fi');
+            assert.deepStrictEqual(project.configurations!.Debug.preprocessorDefinitions, ['NAME="{x}"']);
+            assert.strictEqual(project.architecture, 'arm64');
+        });
     });
 });
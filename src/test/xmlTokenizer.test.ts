@@ -0,0 +1,43 @@
+/**
+ * Tests for the streaming XML tokenizer
+ */
+
+import * as assert from 'assert';
+import { tokenizeXml, parseXmlAttributes } from '../parsers/xmlTokenizer';
+
+function tokens(content: string): string[] {
+    const result: string[] = [];
+    tokenizeXml(content, {
+        onOpenTag: (name, attributes, selfClosing) =>
+            result.push(`<${name}${Object.entries(attributes).map(([k, v]) => ` ${k}=${v}`).join('')}${selfClosing ? '/' : ''}>`),
+        onCloseTag: (name) => result.push(`</${name}>`),
+        onText: (text, cdata) => {
+            if (text.trim()) {
+                result.push(cdata ? `cdata:${text}` : `text:${text.trim()}`);
+            }
+        }
+    });
+    return result;
+}
+
+describe('XML Tokenizer', () => {
+    it('should report tags, attributes and text in document order', () => {
+        assert.deepStrictEqual(tokens('<?xml version="1.0"?><A x="1" y=\'a>b\'><B/>t &amp; u</A>'), [
+            '<A x=1 y=a>b>',
+            '<B/>',
+            'text:t &amp; u',
+            '</A>'
+        ]);
+    });
+
+    it('should skip comments and unwrap CDATA', () => {
+        assert.deepStrictEqual(tokens('<A><!-- <B/> --><![CDATA[<raw>]]></A>'), ['<A>', 'cdata:<raw>', '</A>']);
+    });
+
+    it('should keep slashes inside attribute values', () => {
+        assert.deepStrictEqual(parseXmlAttributes(' Include="a/b.cpp" Condition="\'$(P)\'==\'x64\'"'), {
+            Include: 'a/b.cpp',
+            Condition: "'$(P)'=='x64'"
+        });
+    });
+});
@@ -3,7 +3,7 @@
  * These functions contain no vscode dependencies and can be tested directly.
  */
 
-import { parseVariables } from '../parsers';
+import { parseVariables, parseCommands, CMakeCommand } from '../parsers';
 import { isBuiltInVariable } from './cmakeBuiltins';
 
 /**
@@ -47,6 +47,79 @@ const DEPRECATED_REGEXES = Array.from(DEPRECATED_COMMANDS.entries()).map(([cmd,
     replacement
 }));
 
+/**
+ * Build-performance checks
+ */
+export type BuildPerformanceCheck =
+    | 'glob-recurse-source-root'
+    | 'configure-depends'
+    | 'configure-time-process'
+    | 'duplicate-find-package'
+    | 'global-include-directories'
+    | 'large-target-without-pch';
+
+export type BuildPerformanceSeverity = 'error' | 'warning' | 'information' | 'hint' | 'off';
+
+/**
+ * Default severity of each build-performance check
+ */
+export const BUILD_PERFORMANCE_DEFAULTS: Record<BuildPerformanceCheck, BuildPerformanceSeverity> = {
+    'glob-recurse-source-root': 'warning',
+    'configure-depends': 'warning',
+    'configure-time-process': 'information',
+    'duplicate-find-package': 'information',
+    'global-include-directories': 'information',
+    'large-target-without-pch': 'hint',
+};
+
+/**
+ * Default number of sources above which a target should use PCH or a unity build
+ */
+export const DEFAULT_LARGE_TARGET_SOURCES = 50;
+
+/**
+ * Variables that point at the top of the source tree
+ */
+const SOURCE_ROOT_PREFIX = /^\$\{(?:CMAKE_SOURCE_DIR|PROJECT_SOURCE_DIR|[A-Za-z0-9_]+_SOURCE_DIR)\}\/?/;
+
+/**
+ * Variables that point at the directory of the current CMakeLists.txt
+ */
+const CURRENT_SOURCE_PREFIX = /^\$\{(?:CMAKE_CURRENT_SOURCE_DIR|CMAKE_CURRENT_LIST_DIR)\}\/?/;
+
+/**
+ * Non-source keywords in add_library()/add_executable()
+ */
+const TARGET_KEYWORDS = new Set([
+    'STATIC', 'SHARED', 'MODULE', 'OBJECT', 'INTERFACE', 'UNKNOWN',
+    'IMPORTED', 'GLOBAL', 'ALIAS', 'EXCLUDE_FROM_ALL', 'WIN32', 'MACOSX_BUNDLE'
+]);
+
+/**
+ * Values CMake treats as true in UNITY_BUILD / CMAKE_UNITY_BUILD
+ */
+const TRUE_CONSTANT = /^(ON|TRUE|YES|Y|1)$/i;
+
+export interface BuildPerformanceIssue {
+    check: BuildPerformanceCheck;
+    /** 0-based line of the command */
+    line: number;
+    /** Start index of the flagged text */
+    startIndex: number;
+    /** End index of the flagged text */
+    endIndex: number;
+    message: string;
+}
+
+export interface BuildPerformanceOptions {
+    /** Whether the file is the top-level CMakeLists.txt (relative globs then cover the whole tree) */
+    isSourceRoot?: boolean;
+    /** Source count at which a target needs PCH or UNITY_BUILD */
+    largeTargetSources?: number;
+    /** Number of items in a list variable, used to count sources given as ${VAR} */
+    getListLength?: (name: string) => number | undefined;
+}
+
 export interface UndefinedVariableInfo {
     name: string;
     startIndex: number;
@@ -236,3 +309,202 @@ export function findDeprecatedCommands(text: string): DeprecatedCommandInfo[] {
 
     return deprecated;
 }
+
+/**
+ * Merge user severity overrides with the defaults, ignoring unknown checks and values
+ * @param overrides Map of check id to severity (e.g. from settings)
+ */
+export function resolveBuildPerformanceSeverities(
+    overrides: Record<string, string> = {}
+): Record<BuildPerformanceCheck, BuildPerformanceSeverity> {
+    const result = { ...BUILD_PERFORMANCE_DEFAULTS };
+    const valid = new Set<string>(['error', 'warning', 'information', 'hint', 'off']);
+    for (const [check, severity] of Object.entries(overrides)) {
+        if (check in result && valid.has(severity)) {
+            result[check as BuildPerformanceCheck] = severity as BuildPerformanceSeverity;
+        }
+    }
+    return result;
+}
+
+/**
+ * Find constructs that slow down configure or build times
+ * Works on the command list from a single parse, so the cost is linear in the file size.
+ * @param text The file content
+ * @param options Check options
+ */
+export function findBuildPerformanceIssues(
+    text: string,
+    options: BuildPerformanceOptions = {}
+): BuildPerformanceIssue[] {
+    const issues: BuildPerformanceIssue[] = [];
+    const threshold = options.largeTargetSources ?? DEFAULT_LARGE_TARGET_SOURCES;
+
+    // Open block ids; else()/elseif() start a new block so branches don't count as repeats
+    const openBlocks: number[] = [0];
+    const openSet = new Set<number>([0]);
+    let nextBlock = 1;
+    const packages = new Map<string, { block: number; line: number }>();
+
+    // Targets with many sources, and targets (or the whole directory) with PCH / unity builds
+    const largeTargets: Array<{ name: string; command: CMakeCommand; count: number }> = [];
+    const acceleratedTargets = new Set<string>();
+    let directoryAccelerated = false;
+
+    const flag = (command: CMakeCommand, check: BuildPerformanceCheck, message: string) => {
+        issues.push({
+            check,
+            line: command.line,
+            startIndex: command.startIndex,
+            endIndex: command.startIndex + command.name.length,
+            message
+        });
+    };
+
+    for (const command of parseCommands(text)) {
+        const name = command.name.toLowerCase();
+        const args = command.arguments.map(a => a.value);
+
+        switch (name) {
+            case 'if':
+            case 'foreach':
+            case 'while':
+            case 'function':
+            case 'macro':
+            case 'block':
+                openBlocks.push(nextBlock);
+                openSet.add(nextBlock++);
+                break;
+            case 'elseif':
+            case 'else':
+                openSet.delete(openBlocks[openBlocks.length - 1]);
+                openBlocks[openBlocks.length - 1] = nextBlock;
+                openSet.add(nextBlock++);
+                break;
+            case 'endif':
+            case 'endforeach':
+            case 'endwhile':
+            case 'endfunction':
+            case 'endmacro':
+            case 'endblock':
+                if (openBlocks.length > 1) {
+                    openSet.delete(openBlocks.pop() as number);
+                }
+                break;
+            case 'file': {
+                const mode = args[0]?.toUpperCase();
+                if (mode !== 'GLOB' && mode !== 'GLOB_RECURSE') {
+                    break;
+                }
+                const recursive = mode === 'GLOB_RECURSE';
+                const upper = args.map(a => a.toUpperCase());
+                const patterns: string[] = [];
+                for (let i = 2; i < args.length; i++) {
+                    if (upper[i] === 'RELATIVE' || upper[i] === 'LIST_DIRECTORIES') {
+                        i++;
+                    } else if (upper[i] !== 'CONFIGURE_DEPENDS' && upper[i] !== 'FOLLOW_SYMLINKS') {
+                        patterns.push(args[i]);
+                    }
+                }
+                const overRoot = patterns.some(p => {
+                    const current = CURRENT_SOURCE_PREFIX.exec(p);
+                    const rooted = current ? null : SOURCE_ROOT_PREFIX.exec(p);
+                    if (rooted) {
+                        return !p.substring(rooted[0].length).includes('/');
+                    }
+                    // Relative patterns are evaluated in the current source directory
+                    const relative = current ? p.substring(current[0].length) : p;
+                    return options.isSourceRoot === true && !relative.includes('/') && !relative.startsWith('$');
+                });
+                if (recursive && overRoot) {
+                    flag(command, 'glob-recurse-source-root',
+                        'file(GLOB_RECURSE) over the source root walks the whole tree (including build and VCS directories) at configure time; glob a sources subdirectory or list files explicitly');
+                }
+                if (upper.includes('CONFIGURE_DEPENDS') && (recursive || overRoot)) {
+                    flag(command, 'configure-depends',
+                        'CONFIGURE_DEPENDS re-runs this glob on every build; avoid it for recursive or top-level globs');
+                }
+                break;
+            }
+            case 'execute_process':
+                flag(command, 'configure-time-process',
+                    'execute_process() runs on every configure; cache its result or move the work to add_custom_command()');
+                break;
+            case 'find_package': {
+                const pkg = args[0];
+                if (!pkg) {
+                    break;
+                }
+                const previous = packages.get(pkg);
+                if (previous && openSet.has(previous.block)) {
+                    flag(command, 'duplicate-find-package',
+                        `find_package(${pkg}) was already called on line ${previous.line + 1}; repeated searches slow down configure`);
+                } else {
+                    packages.set(pkg, { block: openBlocks[openBlocks.length - 1], line: command.line });
+                }
+                break;
+            }
+            case 'include_directories':
+                flag(command, 'global-include-directories',
+                    'include_directories() adds search paths to every target in this directory, widening header dependencies; use target_include_directories()');
+                break;
+            case 'add_library':
+            case 'add_executable': {
+                if (!args[0] || args.slice(1).some(a => a === 'IMPORTED' || a === 'ALIAS' || a === 'INTERFACE')) {
+                    break;
+                }
+                let count = 0;
+                for (const arg of args.slice(1)) {
+                    if (TARGET_KEYWORDS.has(arg)) {
+                        continue;
+                    }
+                    const variable = /^\$\{([A-Za-z0-9_]+)\}$/.exec(arg);
+                    count += variable ? options.getListLength?.(variable[1]) ?? 1 : 1;
+                }
+                if (count >= threshold) {
+                    largeTargets.push({ name: args[0], command, count });
+                }
+                break;
+            }
+            case 'target_precompile_headers':
+                if (args[0]) {
+                    acceleratedTargets.add(args[0]);
+                }
+                break;
+            case 'set_target_properties':
+            case 'set_property': {
+                const upper = args.map(a => a.toUpperCase());
+                const property = upper.indexOf('UNITY_BUILD');
+                if (property < 0 || !TRUE_CONSTANT.test(args[property + 1] ?? '')) {
+                    break;
+                }
+                // set_target_properties(a b PROPERTIES ...) / set_property(TARGET a b PROPERTY ...)
+                const start = name === 'set_property' ? upper.indexOf('TARGET') + 1 : 0;
+                const stop = upper.indexOf(name === 'set_property' ? 'PROPERTY' : 'PROPERTIES');
+                if (start > 0 || name === 'set_target_properties') {
+                    for (let i = start; i < (stop < 0 ? args.length : stop); i++) {
+                        acceleratedTargets.add(args[i]);
+                    }
+                }
+                break;
+            }
+            case 'set':
+                if (args[0] === 'CMAKE_UNITY_BUILD' && TRUE_CONSTANT.test(args[1] ?? '')) {
+                    directoryAccelerated = true;
+                }
+                break;
+        }
+    }
+
+    if (!directoryAccelerated) {
+        for (const target of largeTargets) {
+            if (!acceleratedTargets.has(target.name)) {
+                flag(target.command, 'large-target-without-pch',
+                    `Target '${target.name}' has ${target.count} sources but no target_precompile_headers() or UNITY_BUILD`);
+            }
+        }
+    }
+    issues.sort((a, b) => a.startIndex - b.startIndex);
+
+    return issues;
+}
@@ -0,0 +1,227 @@
+/**
+ * Line-level diff utilities
+ * Myers' O(ND) difference algorithm, used to turn a formatted document into
+ * minimal line edits. These functions contain no vscode dependencies.
+ */
+
+/**
+ * A block of changed lines: old[oldStart, oldEnd) is replaced by new[newStart, newEnd)
+ */
+export interface LineDiffHunk {
+    oldStart: number;
+    oldEnd: number;
+    newStart: number;
+    newEnd: number;
+}
+
+/**
+ * A text replacement expressed in line/character positions of the old text
+ */
+export interface LineTextEdit {
+    startLine: number;
+    startCharacter: number;
+    endLine: number;
+    endCharacter: number;
+    newText: string;
+}
+
+/**
+ * Edit distance above which diffLines() stops searching and reports the
+ * remaining middle section as one hunk. Bounds memory to O(MAX_EDIT_DISTANCE^2).
+ */
+export const MAX_EDIT_DISTANCE = 2000;
+
+/**
+ * Compute the changed line blocks between two line arrays
+ * Common prefix and suffix are stripped first, so the cost of the Myers
+ * search depends only on the size of the changed region.
+ * @param oldLines Original lines
+ * @param newLines New lines
+ * @param maxEditDistance Search bound (see MAX_EDIT_DISTANCE)
+ * @returns Hunks in ascending order
+ */
+export function diffLines(
+    oldLines: readonly string[],
+    newLines: readonly string[],
+    maxEditDistance = MAX_EDIT_DISTANCE
+): LineDiffHunk[] {
+    let start = 0;
+    let oldEnd = oldLines.length;
+    let newEnd = newLines.length;
+    while (start < oldEnd && start < newEnd && oldLines[start] === newLines[start]) {
+        start++;
+    }
+    while (oldEnd > start && newEnd > start && oldLines[oldEnd - 1] === newLines[newEnd - 1]) {
+        oldEnd--;
+        newEnd--;
+    }
+    if (start === oldEnd && start === newEnd) {
+        return [];
+    }
+    if (start === oldEnd || start === newEnd) {
+        return [{ oldStart: start, oldEnd, newStart: start, newEnd }];
+    }
+
+    // Intern lines so the search compares integers
+    const ids = new Map<string, number>();
+    const intern = (lines: readonly string[], from: number, to: number): Int32Array => {
+        const result = new Int32Array(to - from);
+        for (let i = from; i < to; i++) {
+            let id = ids.get(lines[i]);
+            if (id === undefined) {
+                id = ids.size;
+                ids.set(lines[i], id);
+            }
+            result[i - from] = id;
+        }
+        return result;
+    };
+    const a = intern(oldLines, start, oldEnd);
+    const b = intern(newLines, start, newEnd);
+
+    const matches = myersMatches(a, b, maxEditDistance);
+    if (!matches) {
+        return [{ oldStart: start, oldEnd, newStart: start, newEnd }];
+    }
+
+    // Turn the matched pairs into hunks between them
+    const hunks: LineDiffHunk[] = [];
+    let i = 0;
+    let j = 0;
+    const flush = (toI: number, toJ: number) => {
+        if (toI > i || toJ > j) {
+            hunks.push({ oldStart: start + i, oldEnd: start + toI, newStart: start + j, newEnd: start + toJ });
+        }
+    };
+    for (const [mi, mj] of matches) {
+        flush(mi, mj);
+        i = mi + 1;
+        j = mj + 1;
+    }
+    flush(a.length, b.length);
+    return hunks;
+}
+
+/**
+ * Myers greedy search for a shortest edit script
+ * @returns Matched index pairs in ascending order, or null if the edit distance exceeds the bound
+ */
+function myersMatches(a: Int32Array, b: Int32Array, maxEditDistance: number): Array<[number, number]> | null {
+    const n = a.length;
+    const m = b.length;
+    const max = Math.min(n + m, maxEditDistance);
+    const offset = max + 1;
+    const v = new Int32Array(2 * max + 3);
+    const trace: Int32Array[] = [];
+
+    let found = -1;
+    for (let d = 0; d <= max && found < 0; d++) {
+        for (let k = -d; k <= d; k += 2) {
+            let x: number;
+            if (k === -d || (k !== d && v[offset + k - 1] < v[offset + k + 1])) {
+                x = v[offset + k + 1];
+            } else {
+                x = v[offset + k - 1] + 1;
+            }
+            let y = x - k;
+            while (x < n && y < m && a[x] === b[y]) {
+                x++;
+                y++;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                found = d;
+                break;
+            }
+        }
+        // Keep only the diagonals reachable at this step
+        trace.push(v.slice(offset - d, offset + d + 1));
+    }
+    if (found < 0) {
+        return null;
+    }
+
+    // Walk the trace backwards collecting diagonal (matching) moves
+    const matches: Array<[number, number]> = [];
+    let x = n;
+    let y = m;
+    for (let d = found; d > 0; d--) {
+        const prev = trace[d - 1];
+        const at = (k: number) => prev[k + d - 1];
+        const k = x - y;
+        const prevK = (k === -d || (k !== d && at(k - 1) < at(k + 1))) ? k + 1 : k - 1;
+        const prevX = at(prevK);
+        const prevY = prevX - prevK;
+        // Snake after the edit move
+        while (x > prevX && y > prevY) {
+            x--;
+            y--;
+            matches.push([x, y]);
+        }
+        x = prevX;
+        y = prevY;
+    }
+    // Leading snake from the origin
+    while (x > 0 && y > 0) {
+        x--;
+        y--;
+        matches.push([x, y]);
+    }
+    return matches.reverse();
+}
+
+/**
+ * Convert line hunks into text edits against the old text
+ * Edits are returned in document order and do not overlap.
+ * @param oldLines Lines of the old text (without line terminators)
+ * @param newLines Lines of the new text
+ * @param eol Line terminator to use in inserted text
+ */
+export function computeLineEdits(
+    oldLines: readonly string[],
+    newLines: readonly string[],
+    eol = '\n'
+): LineTextEdit[] {
+    const edits: LineTextEdit[] = [];
+    const lastLine = oldLines.length - 1;
+
+    for (const hunk of diffLines(oldLines, newLines)) {
+        const inserted = newLines.slice(hunk.newStart, hunk.newEnd).join(eol);
+
+        if (hunk.oldEnd > hunk.oldStart && hunk.newEnd > hunk.newStart) {
+            // Replace whole lines, leaving the surrounding terminators untouched
+            const endLine = hunk.oldEnd - 1;
+            edits.push({
+                startLine: hunk.oldStart,
+                startCharacter: 0,
+                endLine,
+                endCharacter: oldLines[endLine].length,
+                newText: inserted
+            });
+        } else if (hunk.oldEnd > hunk.oldStart) {
+            // Delete lines together with one adjacent line terminator
+            if (hunk.oldEnd <= lastLine) {
+                edits.push({ startLine: hunk.oldStart, startCharacter: 0, endLine: hunk.oldEnd, endCharacter: 0, newText: '' });
+            } else if (hunk.oldStart > 0) {
+                edits.push({
+                    startLine: hunk.oldStart - 1,
+                    startCharacter: oldLines[hunk.oldStart - 1].length,
+                    endLine: lastLine,
+                    endCharacter: oldLines[lastLine].length,
+                    newText: ''
+                });
+            } else {
+                edits.push({ startLine: 0, startCharacter: 0, endLine: lastLine, endCharacter: oldLines[lastLine].length, newText: '' });
+            }
+        } else if (hunk.oldStart <= lastLine) {
+            // Insert lines before an existing line
+            edits.push({ startLine: hunk.oldStart, startCharacter: 0, endLine: hunk.oldStart, endCharacter: 0, newText: inserted + eol });
+        } else {
+            // Append lines after the last line
+            const end = oldLines[lastLine].length;
+            edits.push({ startLine: lastLine, startCharacter: end, endLine: lastLine, endCharacter: end, newText: eol + inserted });
+        }
+    }
+
+    return edits;
+}
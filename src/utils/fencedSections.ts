@@ -0,0 +1,272 @@
+/**
+ * Fenced generated sections
+ * Generated CMake can be wrapped in named sections:
+ *
+ *     # cmake-companion begin sources
+ *     set(SOURCES ...)
+ *     # cmake-companion end sources 1f3a9c0b2d4e
+ *
+ * The end fence records a hash of the lines between the fences as they were
+ * generated. On re-conversion mergeFencedSections replaces a section only if
+ * the new output differs and the section was not edited since (its content
+ * still matches its hash); edited sections and text outside fences are kept.
+ */
+
+import * as crypto from 'crypto';
+import { LineWriter } from './lineWriter';
+
+const FENCE_PREFIX = '# cmake-companion ';
+const BEGIN_REGEX = /^# cmake-companion begin ([\w-]+)\s*$/;
+const END_REGEX = /^# cmake-companion end ([\w-]+) ([0-9a-f]+)\s*$/;
+
+/**
+ * Hash of a section's lines
+ */
+function hashLines(lines: readonly string[]): string {
+    const hash = crypto.createHash('sha1');
+    lines.forEach((line, index) => {
+        if (index > 0) {
+            hash.update('\n');
+        }
+        hash.update(line);
+    });
+    return hash.digest('hex').substring(0, 12);
+}
+
+/**
+ * Wraps a writer and fences each section a generator marks with section()
+ * A section's fences are only written if it has lines. Blank lines ending a
+ * section are written after its end fence, as separators. The hash is in the
+ * end fence, so sections stream through without being buffered.
+ */
+export class FencedLineWriter implements LineWriter {
+    private readonly inner: LineWriter;
+    private current: string | undefined;
+    private hash: crypto.Hash | undefined;
+    private blankLines = 0;
+    private started = false;
+
+    constructor(inner: LineWriter) {
+        this.inner = inner;
+    }
+
+    /**
+     * Start a section; lines until the next section() or close() belong to it
+     */
+    section(name: string): void {
+        this.closeSection();
+        this.current = name;
+    }
+
+    push(...lines: string[]): void {
+        for (const line of lines) {
+            if (this.current === undefined) {
+                this.inner.push(line);
+            } else if (line === '') {
+                this.blankLines++;
+            } else {
+                if (!this.hash) {
+                    this.inner.push(`${FENCE_PREFIX}begin ${this.current}`);
+                    this.hash = crypto.createHash('sha1');
+                }
+                for (; this.blankLines > 0; this.blankLines--) {
+                    this.pushBody('');
+                }
+                this.pushBody(line);
+            }
+        }
+    }
+
+    /**
+     * End the last section
+     */
+    close(): void {
+        this.closeSection();
+    }
+
+    private pushBody(line: string): void {
+        if (this.started) {
+            this.hash!.update('\n');
+        }
+        this.hash!.update(line);
+        this.started = true;
+        this.inner.push(line);
+    }
+
+    private closeSection(): void {
+        if (this.hash) {
+            this.inner.push(`${FENCE_PREFIX}end ${this.current} ${this.hash.digest('hex').substring(0, 12)}`);
+        }
+        for (; this.blankLines > 0; this.blankLines--) {
+            this.inner.push('');
+        }
+        this.current = undefined;
+        this.hash = undefined;
+        this.started = false;
+    }
+}
+
+interface TextSegment {
+    kind: 'text';
+    lines: string[];
+}
+
+interface SectionSegment {
+    kind: 'section';
+    name: string;
+    /** Hash recorded in the end fence */
+    hash: string;
+    /** Lines between the fences */
+    body: string[];
+}
+
+type Segment = TextSegment | SectionSegment;
+
+/**
+ * Split a file into fenced sections and the text around them
+ * A begin fence without a matching end fence is treated as text.
+ */
+function parseSegments(lines: readonly string[]): Segment[] {
+    const segments: Segment[] = [];
+    const addText = (line: string) => {
+        const last = segments[segments.length - 1];
+        if (last?.kind === 'text') {
+            last.lines.push(line);
+        } else {
+            segments.push({ kind: 'text', lines: [line] });
+        }
+    };
+    for (let i = 0; i < lines.length; i++) {
+        const begin = BEGIN_REGEX.exec(lines[i]);
+        let end = -1;
+        if (begin) {
+            for (let j = i + 1; j < lines.length && end < 0; j++) {
+                if (BEGIN_REGEX.test(lines[j])) {
+                    break;
+                }
+                const match = END_REGEX.exec(lines[j]);
+                if (match && match[1] === begin[1]) {
+                    end = j;
+                }
+            }
+        }
+        if (!begin || end < 0) {
+            addText(lines[i]);
+            continue;
+        }
+        segments.push({ kind: 'section', name: begin[1], hash: END_REGEX.exec(lines[end])![2], body: lines.slice(i + 1, end) });
+        i = end;
+    }
+    return segments;
+}
+
+/**
+ * Whether text contains fenced sections
+ */
+export function hasFencedSections(text: string): boolean {
+    return parseSegments(text.split(/\r?\n/)).some(segment => segment.kind === 'section');
+}
+
+export interface FencedMergeResult {
+    content: string;
+    /** Sections replaced, added or removed, in file order */
+    updated: string[];
+    /** Edited sections kept although the generated content changed */
+    kept: string[];
+}
+
+function isBlank(segment: Segment | undefined): boolean {
+    return segment?.kind === 'text' && segment.lines.every(line => line.trim() === '');
+}
+
+function renderSection(segment: SectionSegment): string[] {
+    return [`${FENCE_PREFIX}begin ${segment.name}`, ...segment.body, `${FENCE_PREFIX}end ${segment.name} ${segment.hash}`];
+}
+
+/**
+ * Merge newly generated fenced output into an existing file
+ * - A section whose content still matches its hash is replaced if the
+ *   generated one differs, and removed if it is no longer generated
+ * - An edited section is left alone
+ * - New sections are inserted after the section that precedes them in the
+ *   generated output
+ * - Text outside fences is kept as it is
+ * @param existing Current file content
+ * @param generated Output of a FencedLineWriter
+ */
+export function mergeFencedSections(existing: string, generated: string): FencedMergeResult {
+    const eol = existing.includes('\r\n') ? '\r\n' : '\n';
+    const current = parseSegments(existing.split(/\r?\n/));
+    const next = parseSegments(generated.split(/\r?\n/));
+    const nextSections = new Map<string, SectionSegment>();
+    for (const segment of next) {
+        if (segment.kind === 'section' && !nextSections.has(segment.name)) {
+            nextSections.set(segment.name, segment);
+        }
+    }
+
+    const updated: string[] = [];
+    const kept: string[] = [];
+    const result: Segment[] = [];
+    const placed = new Set<string>();
+    for (let i = 0; i < current.length; i++) {
+        const segment = current[i];
+        if (segment.kind === 'text' || placed.has(segment.name)) {
+            result.push(segment);
+            continue;
+        }
+        placed.add(segment.name);
+        const replacement = nextSections.get(segment.name);
+        if (hashLines(segment.body) !== segment.hash) {
+            if (replacement?.hash !== segment.hash) {
+                kept.push(segment.name);
+            }
+            result.push(segment);
+        } else if (!replacement) {
+            updated.push(segment.name);
+            // Drop the separator that followed the removed section
+            if (isBlank(current[i + 1]) && (result.length === 0 || isBlank(result[result.length - 1]))) {
+                i++;
+            }
+        } else {
+            if (replacement.hash !== segment.hash) {
+                updated.push(segment.name);
+            }
+            result.push(replacement);
+        }
+    }
+
+    // Sections generated for the first time, each with the separator after it
+    let previous: string | undefined;
+    next.forEach((segment, index) => {
+        if (segment.kind !== 'section') {
+            return;
+        }
+        if (!placed.has(segment.name)) {
+            placed.add(segment.name);
+            updated.push(segment.name);
+            const inserted: Segment[] = isBlank(next[index + 1]) ? [segment, next[index + 1]] : [segment];
+            let at: number;
+            if (previous !== undefined) {
+                // The previous generated section is always in the result by now
+                at = result.findIndex(item => item.kind === 'section' && item.name === previous) + 1;
+                if (isBlank(result[at])) {
+                    at++;
+                }
+            } else {
+                at = result.findIndex(item => item.kind === 'section');
+                if (at < 0) {
+                    at = result.length;
+                }
+            }
+            result.splice(at, 0, ...inserted);
+        }
+        previous = segment.name;
+    });
+
+    const lines: string[] = [];
+    for (const segment of result) {
+        lines.push(...(segment.kind === 'text' ? segment.lines : renderSection(segment)));
+    }
+    return { content: lines.join(eol), updated, kept };
+}
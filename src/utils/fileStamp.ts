@@ -0,0 +1,47 @@
+/**
+ * File stamps
+ * Modification time and size of a file on disk, recorded when a cache parses
+ * it so the cache can tell later whether the file changed.
+ */
+
+import * as fs from 'fs';
+
+export interface FileStamp {
+    path: string;
+    /** -1 when the file did not exist */
+    mtimeMs: number;
+    size: number;
+}
+
+/**
+ * Stamp a file as it is now
+ * @returns undefined if the file does not exist or cannot be read
+ */
+export function stampFile(filePath: string): FileStamp | undefined {
+    try {
+        const stat = fs.statSync(filePath);
+        return { path: filePath, mtimeMs: stat.mtimeMs, size: stat.size };
+    } catch {
+        return undefined;
+    }
+}
+
+/**
+ * Stamp a file, recording it as missing if it does not exist, so a file that
+ * appears later invalidates the cache entry
+ */
+export function stampFileOrMissing(filePath: string): FileStamp {
+    return stampFile(filePath) ?? { path: filePath, mtimeMs: -1, size: -1 };
+}
+
+/**
+ * Whether a file is still as it was when stamped; a file that was missing
+ * must still be missing
+ */
+export function isStampUnchanged(stamp: FileStamp): boolean {
+    const current = stampFile(stamp.path);
+    if (!current) {
+        return stamp.mtimeMs === -1;
+    }
+    return current.mtimeMs === stamp.mtimeMs && current.size === stamp.size;
+}
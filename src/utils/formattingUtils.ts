@@ -3,6 +3,9 @@
  * These functions contain no vscode dependencies and can be tested directly.
  */
 
+import { parseCommands, CMakeCommand } from '../parsers';
+import { isWrapGroupKeyword, packLines } from './wrapUtils';
+
 /**
  * Supported formatting style presets
  */
@@ -295,104 +298,447 @@ export function formatLine(
 }
 
 /**
- * Wrap long lines based on maxLineLength
+ * Get indentation from the start of a line
+ */
+export function getIndentation(line: string): string {
+    const match = line.match(/^(\s*)/);
+    return match ? match[1] : '';
+}
+
+/**
+ * Join argument texts on one line, keeping nested parentheses tight: "A AND (B OR C)"
+ */
+function joinArgumentTexts(args: readonly string[], options: CMakeFormattingOptions): string {
+    let result = '';
+    for (let i = 0; i < args.length; i++) {
+        if (i > 0) {
+            const tight = (args[i - 1] === '(' && !options.spaceAfterOpenParen)
+                || (args[i] === ')' && !options.spaceBeforeCloseParen);
+            if (!tight) {
+                result += ' ';
+            }
+        }
+        result += args[i];
+    }
+    return result;
+}
+
+interface ArgumentUnit {
+    text: string;
+    startIndex: number;
+    endIndex: number;
+    /** Line of the unit's last argument */
+    endLine: number;
+}
+
+/**
+ * Group a command's arguments into units with their source spans
  */
-export function wrapLineIfNeeded(
-    formattedLine: string,
+function collectArgumentUnits(text: string, command: CMakeCommand, options: CMakeFormattingOptions): ArgumentUnit[] {
+    const units: ArgumentUnit[] = [];
+    let group: string[] | null = null;
+    let groupStart = 0;
+    let depth = 0;
+
+    for (const arg of command.arguments) {
+        const raw = text.substring(arg.startIndex, arg.endIndex);
+        const isParen = arg.kind === 'unquoted' && (raw === '(' || raw === ')');
+        if (isParen && raw === '(') {
+            if (depth++ === 0) {
+                group = [];
+                groupStart = arg.startIndex;
+            }
+            group!.push(raw);
+        } else if (isParen && depth > 0) {
+            group!.push(raw);
+            if (--depth === 0) {
+                units.push({ text: joinArgumentTexts(group!, options), startIndex: groupStart, endIndex: arg.endIndex, endLine: arg.line });
+                group = null;
+            }
+        } else if (group) {
+            group.push(raw);
+        } else {
+            units.push({ text: raw, startIndex: arg.startIndex, endIndex: arg.endIndex, endLine: arg.line });
+        }
+    }
+    if (group) {
+        const last = command.arguments[command.arguments.length - 1];
+        units.push({ text: joinArgumentTexts(group, options), startIndex: groupStart, endIndex: last.endIndex, endLine: last.line });
+    }
+
+    return units;
+}
+
+/**
+ * Get the arguments of a command as source text units
+ * A parenthesized group (e.g. in if() conditions) is kept together as one unit.
+ */
+export function getArgumentUnits(text: string, command: CMakeCommand, options: CMakeFormattingOptions): string[] {
+    return collectArgumentUnits(text, command, options).map(unit => unit.text);
+}
+
+/**
+ * An argument unit or comment to lay out
+ */
+export interface LayoutUnit {
+    text: string;
+    /** Line comment: nothing may follow it on its line */
+    lineComment?: boolean;
+    /** Comment that started its own line in the source */
+    ownLine?: boolean;
+}
+
+/**
+ * Get the argument units and comments of a command in source order
+ * @returns The units, or null when a comment cannot be moved safely (inside a
+ *          parenthesized group, or a bracket comment spanning lines)
+ */
+export function getLayoutUnits(text: string, command: CMakeCommand, options: CMakeFormattingOptions): LayoutUnit[] | null {
+    const argumentUnits = collectArgumentUnits(text, command, options);
+    const units: LayoutUnit[] = [];
+    let previousLine = command.line;
+    let a = 0;
+
+    for (const comment of command.comments) {
+        while (a < argumentUnits.length && argumentUnits[a].startIndex < comment.startIndex) {
+            if (argumentUnits[a].endIndex > comment.startIndex || comment.text.includes('\n')) {
+                return null;
+            }
+            units.push({ text: argumentUnits[a].text });
+            previousLine = argumentUnits[a].endLine;
+            a++;
+        }
+        if (comment.text.includes('\n')) {
+            return null;
+        }
+        units.push({
+            text: comment.text.trimEnd(),
+            lineComment: !comment.text.startsWith('#['),
+            ownLine: comment.line > previousLine
+        });
+        previousLine = comment.line;
+    }
+    for (; a < argumentUnits.length; a++) {
+        units.push({ text: argumentUnits[a].text });
+    }
+
+    return units;
+}
+
+/**
+ * Cased command name
+ */
+function formatCommandName(name: string, options: CMakeFormattingOptions): string {
+    return options.uppercaseCommands ? name.toUpperCase() : name.toLowerCase();
+}
+
+/**
+ * Lay out a command's units, wrapping when the line exceeds maxLineLength
+ * Wrapped commands start a line at each keyword group (PUBLIC/PRIVATE,
+ * SOURCES, COMMAND, ...) and pack each group optimally into as few lines as
+ * fit: positional arguments continue the command line, group continuations
+ * are indented one level deeper. Comments stay after the unit they followed,
+ * and comments that had their own line keep it.
+ * @returns Output lines including indentation
+ */
+export function layoutCommand(
+    name: string,
+    units: readonly (string | LayoutUnit)[],
     indentLevel: number,
     options: CMakeFormattingOptions
 ): string[] {
-    if (options.maxLineLength <= 0 || formattedLine.length <= options.maxLineLength) {
-        return [formattedLine];
+    const baseIndent = createIndent(indentLevel, options);
+    const open = options.spaceAfterOpenParen ? '( ' : '(';
+    const close = options.spaceBeforeCloseParen ? ' )' : ')';
+    const layoutUnits = units.map(unit => typeof unit === 'string' ? { text: unit } as LayoutUnit : unit);
+
+    if (layoutUnits.length === 0) {
+        const empty = options.spaceAfterOpenParen || options.spaceBeforeCloseParen ? '( )' : '()';
+        return [`${baseIndent}${name}${empty}`];
+    }
+
+    const forcedBreak = layoutUnits.some(unit => unit.lineComment || unit.ownLine);
+    if (!forcedBreak) {
+        const single = `${baseIndent}${name}${open}${layoutUnits.map(unit => unit.text).join(' ')}${close}`;
+        if (options.maxLineLength <= 0 || single.length <= options.maxLineLength || layoutUnits.length <= 1) {
+            return [single];
+        }
     }
 
-    const trimmed = formattedLine.trim();
-    if (!trimmed || trimmed.startsWith('#')) {
-        return [formattedLine];
+    // Items to pack: comments that shared a line with the previous unit are
+    // glued to it, so re-formatting the output gives the same layout
+    interface Item { text: string; breakAfter: boolean; ownLine: boolean; keyword: boolean }
+    const items: Item[] = [];
+    let argumentIndex = 0;
+    for (const unit of layoutUnits) {
+        const isComment = unit.lineComment !== undefined;
+        const previous = items[items.length - 1];
+        if (isComment && !unit.ownLine && previous && !previous.breakAfter) {
+            previous.text += ' ' + unit.text;
+            previous.breakAfter = !!unit.lineComment;
+            continue;
+        }
+        if (unit.ownLine && previous) {
+            previous.breakAfter = true;
+        }
+        items.push({
+            text: unit.text,
+            breakAfter: !!unit.lineComment,
+            ownLine: !!unit.ownLine,
+            keyword: !isComment && isWrapGroupKeyword(name, argumentIndex++, unit.text)
+        });
     }
 
-    if (containsCommentOutsideString(trimmed)) {
-        return [formattedLine];
+    // Compact style: ')' follows the last unit unless a line comment ends it
+    const last = items[items.length - 1];
+    const closeOnOwnLine = options.danglingParenthesis || last.breakAfter;
+    if (!closeOnOwnLine) {
+        last.text += close;
+    }
+
+    const width = options.maxLineLength > 0 ? options.maxLineLength : Infinity;
+    const continuationIndent = createIndent(indentLevel + 1, options);
+    const groupIndent = createIndent(indentLevel + 2, options);
+    const pack = (group: Item[], lineWidth: number, firstWidth: number) => packLines(
+        group.map(item => item.text), lineWidth, firstWidth, index => group[index].breakAfter
+    );
+
+    // Positional arguments before the first keyword continue the command line
+    let groupStart = 0;
+    while (groupStart < items.length && !items[groupStart].keyword) {
+        groupStart++;
+    }
+    const head = items.slice(0, groupStart);
+    const header = `${baseIndent}${name}(`;
+    const wrapped: string[] = [];
+    const headerWidth = width - header.length - open.length + 1;
+    if (head.length > 0 && !head[0].ownLine && head[0].text.length <= headerWidth) {
+        const lines = pack(head, width - continuationIndent.length, headerWidth);
+        wrapped.push(header + open.substring(1) + lines[0]);
+        for (const line of lines.slice(1)) {
+            wrapped.push(continuationIndent + line);
+        }
+    } else {
+        wrapped.push(header);
+        for (const line of pack(head, width - continuationIndent.length, width - continuationIndent.length)) {
+            wrapped.push(continuationIndent + line);
+        }
     }
 
-    const commandMatch = trimmed.match(/^([a-zA-Z_][a-zA-Z0-9_]*)\((.*)\)$/);
-    if (!commandMatch) {
-        return [formattedLine];
+    // Each keyword group starts its own line
+    while (groupStart < items.length) {
+        let groupEnd = groupStart + 1;
+        while (groupEnd < items.length && !items[groupEnd].keyword) {
+            groupEnd++;
+        }
+        const lines = pack(items.slice(groupStart, groupEnd), width - groupIndent.length, width - continuationIndent.length);
+        wrapped.push(continuationIndent + lines[0]);
+        for (const line of lines.slice(1)) {
+            wrapped.push(groupIndent + line);
+        }
+        groupStart = groupEnd;
     }
 
-    const command = commandMatch[1];
-    const argsString = commandMatch[2].trim();
-    if (!argsString) {
-        return [formattedLine];
+    if (closeOnOwnLine) {
+        wrapped.push(`${baseIndent})`);
     }
+    return wrapped;
+}
 
-    const args = splitArguments(argsString);
-    if (args.length <= 1) {
-        return [formattedLine];
+/**
+ * Re-indent a multi-line command whose layout must be kept (multi-line
+ * arguments or comments, or no line limit to re-flow against)
+ * Lines inside multi-line quoted/bracket arguments and bracket comments are copied verbatim.
+ */
+function reindentCommand(
+    text: string,
+    command: CMakeCommand,
+    indentLevel: number,
+    options: CMakeFormattingOptions
+): string[] {
+    const raw = text.substring(command.startIndex, command.endIndex).replace(/\r\n/g, '\n');
+    const lines = raw.split('\n');
+
+    // Relative lines that start inside a multi-line token
+    const verbatim = new Set<number>();
+    const spans = [...command.arguments, ...command.comments];
+    for (const span of spans) {
+        let line = span.line - command.line;
+        for (let i = span.startIndex; i < span.endIndex; i++) {
+            if (text.charCodeAt(i) === 10) {
+                verbatim.add(++line);
+            }
+        }
     }
 
     const baseIndent = createIndent(indentLevel, options);
     const continuationIndent = createIndent(indentLevel + 1, options);
-    const wrapped: string[] = [];
+    const first = lines[0].replace(/^[A-Za-z_][A-Za-z0-9_]*\s*/, formatCommandName(command.name, options));
+    const result = [baseIndent + first.trimEnd()];
 
-    wrapped.push(`${baseIndent}${command}(`);
-    if (options.danglingParenthesis) {
-        // Dangling style: each arg on its own line, ')' on a separate line
-        for (const arg of args) {
-            wrapped.push(`${continuationIndent}${arg}`);
+    for (let i = 1; i < lines.length; i++) {
+        if (verbatim.has(i)) {
+            result.push(lines[i]);
+            continue;
         }
-        wrapped.push(`${baseIndent})`);
-    } else {
-        // Compact style: each arg on its own line, ')' after the last arg
-        for (let i = 0; i < args.length - 1; i++) {
-            wrapped.push(`${continuationIndent}${args[i]}`);
+        const trimmed = lines[i].trim();
+        if (!trimmed) {
+            result.push('');
+        } else if (trimmed.startsWith(')')) {
+            result.push(baseIndent + trimmed);
+        } else {
+            result.push(continuationIndent + trimmed);
         }
-        wrapped.push(`${continuationIndent}${args[args.length - 1]})`); 
     }
 
-    return wrapped;
+    return result;
 }
 
 /**
- * Get indentation from the start of a line
+ * Pretty-print a single command
+ * Single-line commands are rebuilt from their arguments; multi-line commands
+ * are re-flowed when a line limit is set and nothing inside would be lost.
+ * @returns Output lines including indentation
  */
-export function getIndentation(line: string): string {
-    const match = line.match(/^(\s*)/);
-    return match ? match[1] : '';
+export function formatCommandNode(
+    text: string,
+    command: CMakeCommand,
+    indentLevel: number,
+    options: CMakeFormattingOptions
+): string[] {
+    const multiLine = command.line !== command.endLine;
+    const canReflow = command.closed
+        && command.arguments.every(arg => !text.substring(arg.startIndex, arg.endIndex).includes('\n'));
+
+    if (canReflow && (!multiLine || options.maxLineLength > 0)) {
+        const units = getLayoutUnits(text, command, options);
+        if (units) {
+            return layoutCommand(formatCommandName(command.name, options), units, indentLevel, options);
+        }
+    }
+    return reindentCommand(text, command, indentLevel, options);
 }
 
 /**
- * Format an entire CMake document
+ * Format an entire CMake document into lines
+ * Pretty-prints from the command list produced by parseCommands: block
+ * commands drive indentation, commands are rebuilt from their arguments,
+ * and comments and blank lines are kept in place.
+ * @param text The text to format (a whole document, or whole commands from it)
+ * @param options Formatting options
+ * @param initialIndent Block depth at the start of the text
  */
-export function formatCMakeDocument(text: string, options: CMakeFormattingOptions): string {
-    const lines = text.split('\n');
-    let indentLevel = 0;
-    const formattedLines: string[] = [];
-    
-    for (let i = 0; i < lines.length; i++) {
-        const line = lines[i];
-        const trimmedLine = line.trim();
-        
-        if (!trimmedLine) {
-            formattedLines.push('');
+export function formatCMakeLines(text: string, options: CMakeFormattingOptions, initialIndent = 0): string[] {
+    const lines = text.split('\n').map(line => line.endsWith('\r') ? line.slice(0, -1) : line);
+    const lineStarts: number[] = [0];
+    for (let i = 0; i < text.length; i++) {
+        if (text.charCodeAt(i) === 10) {
+            lineStarts.push(i + 1);
+        }
+    }
+    const lineEnd = (line: number) => line + 1 < lineStarts.length ? lineStarts[line + 1] - 1 : text.length;
+
+    const commands = parseCommands(text);
+    const output: string[] = [];
+    let indentLevel = initialIndent;
+    let next = 0;
+
+    for (let line = 0; line < lines.length; line++) {
+        // Commands swallowed by a verbatim region were already copied as written
+        while (next < commands.length && commands[next].line < line) {
+            next++;
+        }
+        if (next >= commands.length || commands[next].line !== line) {
+            const trimmed = lines[line].trim();
+            if (!trimmed) {
+                output.push('');
+                continue;
+            }
+            // Multi-line bracket comment: keep its body verbatim
+            const bracket = /^#\[(=*)\[/.exec(trimmed);
+            if (bracket) {
+                const close = `]${bracket[1]}]`;
+                const endIndex = text.indexOf(close, lineStarts[line] + lines[line].indexOf('#'));
+                let endLine = line;
+                while (endIndex >= 0 && endLine + 1 < lineStarts.length && lineStarts[endLine + 1] <= endIndex) {
+                    endLine++;
+                }
+                if (endIndex < 0) {
+                    endLine = lines.length - 1;
+                }
+                output.push(createIndent(indentLevel, options) + trimmed);
+                for (let i = line + 1; i <= endLine; i++) {
+                    output.push(lines[i]);
+                }
+                line = endLine;
+                continue;
+            }
+            output.push(formatLine(trimmed, indentLevel, options));
             continue;
         }
-        
-        const commandMatch = trimmedLine.match(/^([a-zA-Z_][a-zA-Z0-9_]*)\s*\(/i);
-        const commandName = commandMatch ? commandMatch[1].toLowerCase() : null;
-        
-        if (commandName && INDENT_DECREASE_COMMANDS.has(commandName)) {
+
+        // Collect the commands of this logical line (following commands that
+        // start on the line where a multi-line command ends)
+        const group: CMakeCommand[] = [];
+        let endLine = line;
+        while (next < commands.length && commands[next].line <= endLine) {
+            group.push(commands[next]);
+            endLine = Math.max(endLine, commands[next].endLine);
+            next++;
+        }
+
+        const firstName = group[0].name.toLowerCase();
+        if (INDENT_DECREASE_COMMANDS.has(firstName)) {
             indentLevel = Math.max(0, indentLevel - 1);
         }
-        
-        const formattedLine = formatLine(trimmedLine, indentLevel, options);
-        const wrappedLines = wrapLineIfNeeded(formattedLine, indentLevel, options);
-        formattedLines.push(...wrappedLines);
-        
-        if (commandName && INDENT_INCREASE_COMMANDS.has(commandName)) {
-            indentLevel++;
+        const lineIndent = indentLevel;
+
+        // Text between and around commands (comments) is appended with a single space
+        const pieces: string[][] = [];
+        let cursor = lineStarts[line];
+        for (let i = 0; i < group.length; i++) {
+            const command = group[i];
+            const gap = text.substring(cursor, command.startIndex).trim();
+            if (gap) {
+                pieces.push([gap]);
+            }
+            pieces.push(formatCommandNode(text, command, lineIndent, options));
+            cursor = command.endIndex;
+
+            const name = command.name.toLowerCase();
+            if (i > 0 && INDENT_DECREASE_COMMANDS.has(name)) {
+                indentLevel = Math.max(0, indentLevel - 1);
+            }
+            if (INDENT_INCREASE_COMMANDS.has(name)) {
+                indentLevel++;
+            }
         }
+        const trailing = text.substring(cursor, Math.max(cursor, lineEnd(endLine))).trim();
+        if (trailing) {
+            pieces.push([trailing]);
+        }
+
+        const start = output.length;
+        for (const piece of pieces) {
+            if (output.length === start) {
+                output.push(...piece);
+                continue;
+            }
+            output[output.length - 1] += ' ' + piece[0].trimStart();
+            output.push(...piece.slice(1));
+        }
+        if (output.length === start) {
+            output.push('');
+        }
+        line = endLine;
     }
-    
-    return formattedLines.join('\n');
+
+    return output;
+}
+
+/**
+ * Format an entire CMake document
+ */
+export function formatCMakeDocument(text: string, options: CMakeFormattingOptions): string {
+    return formatCMakeLines(text, options).join('\n');
 }
@@ -0,0 +1,431 @@
+/**
+ * Incremental indentation model for CMake documents
+ * Keeps per-line lexer state and block-depth deltas in an implicit treap with
+ * subtree sums, so the block depth at any line is a prefix sum computed in
+ * O(log n) and an edit only re-scans the lines it touched.
+ * These functions contain no vscode dependencies and can be tested directly.
+ */
+
+import { INDENT_INCREASE_COMMANDS, INDENT_DECREASE_COMMANDS } from './formattingUtils';
+
+/**
+ * Lexer state at the start of a line outside of any command
+ */
+export const TOP_LEVEL_STATE = 'n0:0';
+
+export interface LineIndentInfo {
+    /** Lexer state at the start of the line (TOP_LEVEL_STATE outside commands) */
+    entryState: string;
+    /** Net block depth change of the commands starting on this line */
+    delta: number;
+    /** Whether the first command on the line closes a block (endif, else, ...) */
+    leadingDecrease: boolean;
+    /** Lowercased name of the first command starting on the line */
+    firstCommand?: string;
+}
+
+/**
+ * Match the opening of a bracket (e.g. "[[" or "[==[") at a position
+ * @returns Number of '=' characters, or -1 if there is no bracket opening
+ */
+function bracketLevelAt(text: string, index: number): number {
+    if (text[index] !== '[') {
+        return -1;
+    }
+    let i = index + 1;
+    while (text[i] === '=') {
+        i++;
+    }
+    return text[i] === '[' ? i - index - 1 : -1;
+}
+
+/**
+ * Scan one line starting in the given lexer state
+ * States: n (top level), a (inside a command), q (quoted argument),
+ * b (bracket argument), c (bracket comment), each with a bracket level and
+ * the parenthesis depth of the enclosing command.
+ * @param line The line text (without terminator)
+ * @param entryState Lexer state at the start of the line
+ * @returns The line's indentation info and the state at the end of the line
+ */
+export function scanLine(line: string, entryState: string): { info: LineIndentInfo; exitState: string } {
+    let mode = entryState[0];
+    const separator = entryState.indexOf(':');
+    let level = parseInt(entryState.substring(1, separator), 10);
+    let depth = parseInt(entryState.substring(separator + 1), 10);
+
+    const info: LineIndentInfo = { entryState, delta: 0, leadingDecrease: false };
+    const length = line.length;
+    let i = 0;
+
+    while (i < length) {
+        if (mode === 'q') {
+            while (i < length && line[i] !== '"') {
+                i += line[i] === '\\' ? 2 : 1;
+            }
+            if (i < length) {
+                mode = 'a';
+                i++;
+            }
+        } else if (mode === 'b' || mode === 'c') {
+            const close = ']' + '='.repeat(level) + ']';
+            const end = line.indexOf(close, i);
+            if (end < 0) {
+                i = length;
+            } else {
+                mode = mode === 'c' && depth === 0 ? 'n' : 'a';
+                level = 0;
+                i = end + close.length;
+            }
+        } else if (mode === 'n') {
+            const ch = line[i];
+            if (ch === '#') {
+                const open = bracketLevelAt(line, i + 1);
+                if (open < 0) {
+                    break;
+                }
+                mode = 'c';
+                level = open;
+                i += open + 3;
+            } else if (/[A-Za-z_]/.test(ch)) {
+                const start = i;
+                while (i < length && /[A-Za-z0-9_]/.test(line[i])) {
+                    i++;
+                }
+                let j = i;
+                while (j < length && (line[j] === ' ' || line[j] === '\t')) {
+                    j++;
+                }
+                if (line[j] === '(') {
+                    const name = line.substring(start, i).toLowerCase();
+                    const first = info.firstCommand === undefined;
+                    if (first) {
+                        info.firstCommand = name;
+                    }
+                    if (INDENT_DECREASE_COMMANDS.has(name)) {
+                        info.delta--;
+                        info.leadingDecrease = info.leadingDecrease || first;
+                    }
+                    if (INDENT_INCREASE_COMMANDS.has(name)) {
+                        info.delta++;
+                    }
+                    mode = 'a';
+                    depth = 1;
+                    i = j + 1;
+                }
+            } else {
+                i++;
+            }
+        } else {
+            const ch = line[i];
+            if (ch === '#') {
+                const open = bracketLevelAt(line, i + 1);
+                if (open < 0) {
+                    break;
+                }
+                mode = 'c';
+                level = open;
+                i += open + 3;
+            } else if (ch === '"') {
+                mode = 'q';
+                i++;
+            } else if (ch === '[' && bracketLevelAt(line, i) >= 0) {
+                level = bracketLevelAt(line, i);
+                mode = 'b';
+                i += level + 2;
+            } else if (ch === '(') {
+                depth++;
+                i++;
+            } else if (ch === ')') {
+                if (--depth === 0) {
+                    mode = 'n';
+                }
+                i++;
+            } else {
+                i += ch === '\\' ? 2 : 1;
+            }
+        }
+    }
+
+    return { info, exitState: `${mode}${level}:${depth}` };
+}
+
+interface TreapNode {
+    info: LineIndentInfo;
+    priority: number;
+    left: TreapNode | null;
+    right: TreapNode | null;
+    /** Number of lines in the subtree */
+    size: number;
+    /** Sum of deltas in the subtree */
+    sum: number;
+}
+
+function createNode(info: LineIndentInfo): TreapNode {
+    return { info, priority: Math.random(), left: null, right: null, size: 1, sum: info.delta };
+}
+
+function update(node: TreapNode): void {
+    node.size = 1 + (node.left ? node.left.size : 0) + (node.right ? node.right.size : 0);
+    node.sum = node.info.delta + (node.left ? node.left.sum : 0) + (node.right ? node.right.sum : 0);
+}
+
+/**
+ * Build a treap from nodes in line order in O(n) (Cartesian tree construction)
+ */
+function buildTreap(nodes: TreapNode[]): TreapNode | null {
+    const stack: TreapNode[] = [];
+    for (const node of nodes) {
+        let last: TreapNode | null = null;
+        while (stack.length > 0 && stack[stack.length - 1].priority < node.priority) {
+            last = stack.pop()!;
+            update(last);
+        }
+        node.left = last;
+        if (stack.length > 0) {
+            stack[stack.length - 1].right = node;
+        }
+        stack.push(node);
+    }
+    while (stack.length > 1) {
+        update(stack.pop()!);
+    }
+    if (stack.length === 0) {
+        return null;
+    }
+    update(stack[0]);
+    return stack[0];
+}
+
+/**
+ * Split into the first `count` lines and the rest
+ */
+function split(node: TreapNode | null, count: number): [TreapNode | null, TreapNode | null] {
+    if (!node) {
+        return [null, null];
+    }
+    const leftSize = node.left ? node.left.size : 0;
+    if (count <= leftSize) {
+        const [a, b] = split(node.left, count);
+        node.left = b;
+        update(node);
+        return [a, node];
+    }
+    const [a, b] = split(node.right, count - leftSize - 1);
+    node.right = a;
+    update(node);
+    return [node, b];
+}
+
+function merge(a: TreapNode | null, b: TreapNode | null): TreapNode | null {
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (a.priority > b.priority) {
+        a.right = merge(a.right, b);
+        update(a);
+        return a;
+    }
+    b.left = merge(a, b.left);
+    update(b);
+    return b;
+}
+
+/**
+ * Per-document indentation model
+ */
+export class IndentModel {
+    private root: TreapNode | null = null;
+
+    /**
+     * Create a model for the given document lines
+     * @param lines Document lines (without terminators)
+     */
+    constructor(lines: readonly string[] = ['']) {
+        this.root = buildTreap(this.scanLines(lines, 0, lines.length, TOP_LEVEL_STATE).map(createNode));
+    }
+
+    /**
+     * Create a model from document text
+     */
+    static fromText(text: string): IndentModel {
+        return new IndentModel(text.split(/\r?\n/));
+    }
+
+    /**
+     * Number of lines in the model
+     */
+    get lineCount(): number {
+        return this.root ? this.root.size : 0;
+    }
+
+    private scanLines(lines: readonly string[], from: number, to: number, state: string): LineIndentInfo[] {
+        const infos: LineIndentInfo[] = [];
+        for (let i = from; i < to; i++) {
+            const { info, exitState } = scanLine(lines[i], state);
+            infos.push(info);
+            state = exitState;
+        }
+        return infos;
+    }
+
+    private nodeAt(line: number): TreapNode {
+        let node = this.root;
+        let index = line;
+        while (node) {
+            const leftSize = node.left ? node.left.size : 0;
+            if (index < leftSize) {
+                node = node.left;
+            } else if (index === leftSize) {
+                return node;
+            } else {
+                index -= leftSize + 1;
+                node = node.right;
+            }
+        }
+        throw new RangeError(`Line ${line} is out of range`);
+    }
+
+    /**
+     * Replace the info of a line and fix subtree sums along the path
+     */
+    private setInfo(line: number, info: LineIndentInfo): void {
+        const path: TreapNode[] = [];
+        let node = this.root;
+        let index = line;
+        while (node) {
+            path.push(node);
+            const leftSize = node.left ? node.left.size : 0;
+            if (index < leftSize) {
+                node = node.left;
+            } else if (index === leftSize) {
+                node.info = info;
+                break;
+            } else {
+                index -= leftSize + 1;
+                node = node.right;
+            }
+        }
+        for (let i = path.length - 1; i >= 0; i--) {
+            update(path[i]);
+        }
+    }
+
+    /**
+     * Get the indentation info of a line
+     */
+    getLineInfo(line: number): LineIndentInfo {
+        return this.nodeAt(line).info;
+    }
+
+    /**
+     * Block depth at the start of a line (sum of the deltas of all previous lines)
+     */
+    getDepthBefore(line: number): number {
+        let node = this.root;
+        let remaining = line;
+        let sum = 0;
+        while (node && remaining > 0) {
+            const leftSize = node.left ? node.left.size : 0;
+            if (remaining <= leftSize) {
+                node = node.left;
+            } else {
+                sum += (node.left ? node.left.sum : 0) + node.info.delta;
+                remaining -= leftSize + 1;
+                node = node.right;
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * Indent level for the first command on a line (end*() and else() outdent)
+     */
+    getIndentLevel(line: number): number {
+        const depth = this.getDepthBefore(line) - (this.getLineInfo(line).leadingDecrease ? 1 : 0);
+        return Math.max(0, depth);
+    }
+
+    /**
+     * Indent level the formatter gives a line: block depth for lines starting
+     * a command, one more for argument lines inside a multi-line command
+     * @param line The line number
+     * @param text The line's text, used to keep a leading ')' at command level
+     * @returns The level, or undefined inside multi-line strings and bracket
+     *          arguments/comments, which are kept verbatim
+     */
+    getExpectedIndentLevel(line: number, text: string): number | undefined {
+        const entryState = this.getLineInfo(line).entryState;
+        if (entryState === TOP_LEVEL_STATE) {
+            return this.getIndentLevel(line);
+        }
+        if (entryState[0] !== 'a') {
+            return undefined;
+        }
+        const commandLevel = this.getIndentLevel(this.findCommandStart(line));
+        return text.trimStart().startsWith(')') ? commandLevel : commandLevel + 1;
+    }
+
+    /**
+     * Whether a line starts outside of any command, string or bracket comment
+     */
+    isTopLevel(line: number): boolean {
+        return this.getLineInfo(line).entryState === TOP_LEVEL_STATE;
+    }
+
+    /**
+     * First line of the command (or bracket comment) containing a line
+     */
+    findCommandStart(line: number): number {
+        while (line > 0 && !this.isTopLevel(line)) {
+            line--;
+        }
+        return line;
+    }
+
+    /**
+     * Last line of the command (or bracket comment) containing a line
+     */
+    findCommandEnd(line: number): number {
+        while (line + 1 < this.lineCount && !this.isTopLevel(line + 1)) {
+            line++;
+        }
+        return line;
+    }
+
+    /**
+     * Apply an edit that replaced lines [startLine, oldEndLine] with newLineCount lines
+     * Re-scans the new lines, then continues only while the lexer state at the
+     * next line start differs from what was stored (e.g. an opened string).
+     * @param startLine First line touched by the edit
+     * @param oldEndLine Last line touched by the edit, before the edit
+     * @param newLineCount Number of lines the touched region has after the edit
+     * @param getLine Returns the text of a line after the edit
+     */
+    applyEdit(startLine: number, oldEndLine: number, newLineCount: number, getLine: (line: number) => string): void {
+        const entryState = startLine < this.lineCount ? this.getLineInfo(startLine).entryState : TOP_LEVEL_STATE;
+
+        const [before, rest] = split(this.root, startLine);
+        const [, after] = split(rest, oldEndLine - startLine + 1);
+        const placeholders: TreapNode[] = [];
+        for (let i = 0; i < newLineCount; i++) {
+            placeholders.push(createNode({ entryState, delta: 0, leadingDecrease: false }));
+        }
+        this.root = merge(merge(before, buildTreap(placeholders)), after);
+
+        let state = entryState;
+        const editEnd = startLine + newLineCount;
+        const lineCount = this.lineCount;
+        for (let line = startLine; line < lineCount; line++) {
+            if (line >= editEnd && this.getLineInfo(line).entryState === state) {
+                break;
+            }
+            const { info, exitState } = scanLine(getLine(line), state);
+            this.setInfo(line, info);
+            state = exitState;
+        }
+    }
+}
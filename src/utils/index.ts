@@ -7,5 +7,14 @@ export * from './cmakeBuiltins';
 export * from './completionUtils';
 export * from './definitionUtils';
 export * from './diagnosticUtils';
+export * from './diffUtils';
 export * from './foldingUtils';
 export * from './formattingUtils';
+export * from './indentModel';
+export * from './persistentList';
+export * from './wrapUtils';
+export * from './lintUtils';
+export * from './lineWriter';
+export * from './fencedSections';
+export * from './latencyHistogram';
+export * from './memoryEstimate';
@@ -0,0 +1,121 @@
+/**
+ * Latency histogram
+ * Log-linear buckets in the style of HdrHistogram: exact below 128 µs, then
+ * 64 buckets per power of two, so any recorded value is reported within
+ * about 1.6%. Recording is O(1) and memory grows with the log of the
+ * largest value, never with the number of samples.
+ */
+
+/**
+ * Sub-buckets per power of two (6 bits of precision)
+ */
+const SUB_BUCKETS = 64;
+
+/**
+ * Bucket of a value in microseconds
+ */
+function bucketIndex(micros: number): number {
+    if (micros < 2 * SUB_BUCKETS) {
+        return micros;
+    }
+    const shift = Math.floor(Math.log2(micros)) - Math.log2(SUB_BUCKETS);
+    return SUB_BUCKETS * shift + Math.floor(micros / 2 ** shift);
+}
+
+/**
+ * Middle of a bucket in microseconds
+ */
+function bucketValue(index: number): number {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    const shift = Math.floor(index / SUB_BUCKETS) - 1;
+    const width = 2 ** shift;
+    return (index - SUB_BUCKETS * shift) * width + (width - 1) / 2;
+}
+
+export class LatencyHistogram {
+    private counts: number[] = [];
+    private total = 0;
+    private sum = 0;
+    private minValue = Infinity;
+    private maxValue = 0;
+
+    /**
+     * Record a duration
+     * @param ms Milliseconds, recorded with microsecond resolution
+     */
+    record(ms: number): void {
+        const micros = Math.max(0, Math.round(ms * 1000));
+        const index = bucketIndex(micros);
+        while (this.counts.length <= index) {
+            this.counts.push(0);
+        }
+        this.counts[index]++;
+        this.total++;
+        this.sum += micros;
+        this.minValue = Math.min(this.minValue, micros);
+        this.maxValue = Math.max(this.maxValue, micros);
+    }
+
+    /**
+     * Add another histogram's values to this one
+     */
+    merge(other: LatencyHistogram): void {
+        other.counts.forEach((count, index) => {
+            while (this.counts.length <= index) {
+                this.counts.push(0);
+            }
+            this.counts[index] += count;
+        });
+        this.total += other.total;
+        this.sum += other.sum;
+        this.minValue = Math.min(this.minValue, other.minValue);
+        this.maxValue = Math.max(this.maxValue, other.maxValue);
+    }
+
+    get count(): number {
+        return this.total;
+    }
+
+    /**
+     * Value at a percentile (0-100) in milliseconds; 0 when empty
+     */
+    percentile(p: number): number {
+        if (this.total === 0) {
+            return 0;
+        }
+        const rank = Math.max(1, Math.ceil((p / 100) * this.total));
+        let seen = 0;
+        for (let index = 0; index < this.counts.length; index++) {
+            seen += this.counts[index];
+            if (seen >= rank) {
+                // Never report beyond the values actually recorded
+                return Math.min(this.maxValue, Math.max(this.minValue, bucketValue(index))) / 1000;
+            }
+        }
+        return this.maxValue / 1000;
+    }
+
+    /**
+     * Mean in milliseconds; 0 when empty
+     */
+    mean(): number {
+        return this.total === 0 ? 0 : this.sum / this.total / 1000;
+    }
+
+    /**
+     * Largest value in milliseconds; 0 when empty
+     */
+    max(): number {
+        return this.maxValue / 1000;
+    }
+
+    clear(): void {
+        this.counts = [];
+        this.total = 0;
+        this.sum = 0;
+        this.minValue = Infinity;
+        this.maxValue = 0;
+    }
+}
@@ -0,0 +1,124 @@
+/**
+ * Line writers for generated files
+ * Generators push lines to a LineWriter instead of collecting them in an
+ * array and joining it, so the output is built (or written) once. Lines are
+ * separated by '\n' with no newline after the last one, which is exactly what
+ * `lines.join('\n')` produced.
+ */
+
+import { Writable } from 'stream';
+
+/**
+ * Size at which buffered text is moved out as one chunk
+ */
+const CHUNK_SIZE = 64 * 1024;
+
+export interface LineWriter {
+    /**
+     * Append lines
+     */
+    push(...lines: string[]): void;
+    /**
+     * Start a named section of the output (see FencedLineWriter); ignored by plain writers
+     */
+    section?(name: string): void;
+}
+
+/**
+ * Collects text into chunks of about CHUNK_SIZE characters
+ */
+abstract class ChunkedLineWriter implements LineWriter {
+    private buffer = '';
+    private started = false;
+
+    push(...lines: string[]): void {
+        for (const line of lines) {
+            if (this.started) {
+                this.buffer += '\n';
+            }
+            this.buffer += line;
+            this.started = true;
+        }
+        if (this.buffer.length >= CHUNK_SIZE) {
+            this.flush();
+        }
+    }
+
+    /**
+     * Hand the buffered text to emitChunk
+     */
+    protected flush(): void {
+        if (this.buffer.length > 0) {
+            this.emitChunk(this.buffer);
+            this.buffer = '';
+        }
+    }
+
+    protected abstract emitChunk(chunk: string): void;
+}
+
+/**
+ * Builds the output as a string
+ */
+export class StringLineWriter extends ChunkedLineWriter {
+    private readonly chunks: string[] = [];
+
+    toString(): string {
+        this.flush();
+        if (this.chunks.length > 1) {
+            // Keep a single chunk so repeated calls do not join again
+            this.chunks.splice(0, this.chunks.length, this.chunks.join(''));
+        }
+        return this.chunks[0] ?? '';
+    }
+
+    protected emitChunk(chunk: string): void {
+        this.chunks.push(chunk);
+    }
+}
+
+/**
+ * Writes the output to a stream, such as fs.createWriteStream(path)
+ * Chunks are written as they fill; end() writes the rest and waits until the
+ * stream has finished.
+ */
+export class StreamLineWriter extends ChunkedLineWriter {
+    private readonly stream: Writable;
+    private error: Error | undefined;
+
+    constructor(stream: Writable) {
+        super();
+        this.stream = stream;
+        this.stream.on('error', (error: Error) => {
+            this.error = error;
+        });
+    }
+
+    /**
+     * Flush, end the stream and wait for it to finish
+     * @throws The first error reported by the stream
+     */
+    end(): Promise<void> {
+        this.flush();
+        return new Promise((resolve, reject) => {
+            if (this.error) {
+                reject(this.error);
+                return;
+            }
+            this.stream.once('error', reject);
+            this.stream.end((error?: Error | null) => {
+                if (error ?? this.error) {
+                    reject(error ?? this.error);
+                } else {
+                    resolve();
+                }
+            });
+        });
+    }
+
+    protected emitChunk(chunk: string): void {
+        if (!this.error) {
+            this.stream.write(chunk, 'utf8');
+        }
+    }
+}
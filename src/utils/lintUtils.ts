@@ -0,0 +1,186 @@
+/**
+ * Editor-independent lint entry point
+ * Runs the diagnostic checks over a file's text and reports issues with
+ * line/column ranges, for use outside the extension host (CLI, server).
+ * These functions contain no vscode dependencies and can be tested directly.
+ */
+
+import {
+    findUndefinedVariables,
+    findUnmatchedBlocks,
+    findDeprecatedCommands,
+    findBuildPerformanceIssues,
+    resolveBuildPerformanceSeverities,
+    BuildPerformanceSeverity,
+    DEFAULT_LARGE_TARGET_SOURCES
+} from './diagnosticUtils';
+import { parsePaths } from '../parsers';
+
+export type LintSeverity = Exclude<BuildPerformanceSeverity, 'off'>;
+
+export interface LintIssue {
+    /** Rule id, matching the diagnostic code shown in the editor */
+    rule: string;
+    severity: LintSeverity;
+    message: string;
+    /** 0-based start line */
+    line: number;
+    /** 0-based start column */
+    column: number;
+    /** 0-based end line */
+    endLine: number;
+    /** 0-based end column */
+    endColumn: number;
+}
+
+/**
+ * Lint options, mirroring the cmake-companion.diagnostics.* settings
+ */
+export interface LintOptions {
+    undefinedVariables?: boolean;
+    unmatchedBlocks?: boolean;
+    deprecatedCommands?: boolean;
+    /** Severity overrides per build-performance check */
+    buildPerformance?: Record<string, string>;
+    largeTargetSources?: number;
+    /** Variables known to be defined elsewhere (cache, parent scopes) */
+    definedVariables?: Set<string>;
+    /** Number of items in a list variable, used to count target sources */
+    getListLength?: (name: string) => number | undefined;
+    /** Whether the file is the top-level CMakeLists.txt */
+    isSourceRoot?: boolean;
+    /**
+     * Whether a path expression exists, or undefined when it cannot be resolved
+     * Enables the path-not-found check (diagnostics.nonExistentPaths).
+     */
+    pathExists?: (expression: string) => boolean | undefined;
+}
+
+/**
+ * Convert string indices to 0-based line/column positions
+ */
+export class LineIndex {
+    private readonly text: string;
+    private lineStarts: number[] = [0];
+
+    constructor(text: string) {
+        this.text = text;
+        for (let i = 0; i < text.length; i++) {
+            if (text.charCodeAt(i) === 10) {
+                this.lineStarts.push(i + 1);
+            }
+        }
+    }
+
+    get lineCount(): number {
+        return this.lineStarts.length;
+    }
+
+    /**
+     * Position of a string index
+     */
+    positionAt(index: number): { line: number; column: number } {
+        let low = 0;
+        let high = this.lineStarts.length - 1;
+        while (low < high) {
+            const mid = (low + high + 1) >> 1;
+            if (this.lineStarts[mid] <= index) {
+                low = mid;
+            } else {
+                high = mid - 1;
+            }
+        }
+        return { line: low, column: index - this.lineStarts[low] };
+    }
+
+    /**
+     * String index of a position
+     */
+    offsetAt(line: number, column: number): number {
+        if (line >= this.lineStarts.length) {
+            return this.text.length;
+        }
+        return Math.min(this.lineStarts[line] + column, this.text.length);
+    }
+
+    /**
+     * Text of a line without its terminator
+     */
+    lineText(line: number): string {
+        const start = this.lineStarts[line];
+        const end = line + 1 < this.lineStarts.length ? this.lineStarts[line + 1] - 1 : this.text.length;
+        return this.text.substring(start, end).replace(/\r$/, '');
+    }
+}
+
+/**
+ * Run the enabled checks over a file
+ * Severities and messages match the editor diagnostics.
+ * @param text The file content
+ * @param options Which checks to run
+ * @returns Issues sorted by position
+ */
+export function lintCMakeText(text: string, options: LintOptions = {}): LintIssue[] {
+    const index = new LineIndex(text);
+    const issues: LintIssue[] = [];
+    const push = (rule: string, severity: LintSeverity, message: string, start: number, end: number) => {
+        const from = index.positionAt(start);
+        const to = index.positionAt(end);
+        issues.push({ rule, severity, message, line: from.line, column: from.column, endLine: to.line, endColumn: to.column });
+    };
+    const wholeLine = (line: number) => ({
+        start: index.offsetAt(line, 0),
+        end: index.offsetAt(line, 0) + index.lineText(line).length
+    });
+
+    if (options.undefinedVariables ?? true) {
+        for (const variable of findUndefinedVariables(text, options.definedVariables ?? new Set())) {
+            push('undefined-variable', 'warning', `Undefined variable: ${variable.name}`, variable.startIndex, variable.endIndex);
+        }
+    }
+
+    if (options.unmatchedBlocks ?? true) {
+        for (const error of findUnmatchedBlocks(text)) {
+            const { start, end } = wholeLine(error.line);
+            push('unmatched-block', 'error', `Unmatched '${error.blockName}' - missing '${error.expectedPair}'`, start, end);
+        }
+    }
+
+    if (options.deprecatedCommands ?? true) {
+        for (const result of findDeprecatedCommands(text)) {
+            const { start, end } = wholeLine(result.line);
+            const column = index.lineText(result.line).toLowerCase().indexOf(result.command);
+            const message = `'${result.command}' is deprecated. Consider using '${result.replacement}' instead.`;
+            if (column >= 0) {
+                push('deprecated-command', 'hint', message, start + column, start + column + result.command.length);
+            } else {
+                push('deprecated-command', 'hint', message, start, end);
+            }
+        }
+    }
+
+    const severities = resolveBuildPerformanceSeverities(options.buildPerformance);
+    if (Object.values(severities).some(severity => severity !== 'off')) {
+        const performanceIssues = findBuildPerformanceIssues(text, {
+            isSourceRoot: options.isSourceRoot,
+            largeTargetSources: options.largeTargetSources ?? DEFAULT_LARGE_TARGET_SOURCES,
+            getListLength: options.getListLength
+        });
+        for (const issue of performanceIssues) {
+            const severity = severities[issue.check];
+            if (severity !== 'off') {
+                push(issue.check, severity, issue.message, issue.startIndex, issue.endIndex);
+            }
+        }
+    }
+
+    if (options.pathExists) {
+        for (const pathMatch of parsePaths(text)) {
+            if (options.pathExists(pathMatch.fullPath) === false) {
+                push('path-not-found', 'warning', `Path does not exist: ${pathMatch.fullPath}`, pathMatch.startIndex, pathMatch.endIndex);
+            }
+        }
+    }
+
+    return issues.sort((a, b) => a.line - b.line || a.column - b.column);
+}
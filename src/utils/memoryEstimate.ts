@@ -0,0 +1,96 @@
+/**
+ * Memory estimates
+ * Approximate retained sizes of JavaScript values, close enough to compare
+ * caches with each other and to drive eviction, without a heap snapshot.
+ * Figures follow V8's 64-bit layout loosely: headers, 8-byte slots,
+ * one-byte strings for Latin-1 text and two-byte strings otherwise.
+ */
+
+export interface MemoryUsage {
+    /** Entries held (map entries, list items, ...) */
+    entries: number;
+    /** Approximate bytes held */
+    bytes: number;
+}
+
+const STRING_HEADER = 16;
+const OBJECT_HEADER = 24;
+const SLOT = 8;
+/** Hash table overhead per Map or Set entry */
+const TABLE_ENTRY = 24;
+
+const TWO_BYTE_REGEX = /[^\u0000-\u00ff]/;
+
+/**
+ * Approximate size of a string
+ */
+export function estimateStringBytes(text: string): number {
+    return STRING_HEADER + (TWO_BYTE_REGEX.test(text) ? 2 * text.length : text.length);
+}
+
+/**
+ * Approximate size of a value and everything it references
+ * Objects reached twice are counted once; functions are not counted.
+ * @param seen Objects already counted, to share across several calls
+ */
+export function estimateBytes(value: unknown, seen: WeakSet<object> = new WeakSet()): number {
+    switch (typeof value) {
+        case 'string':
+            return estimateStringBytes(value);
+        case 'number':
+        case 'bigint':
+            return SLOT;
+        case 'object':
+            break;
+        default:
+            return 0;
+    }
+    if (value === null || seen.has(value)) {
+        return 0;
+    }
+    seen.add(value);
+
+    let bytes = OBJECT_HEADER;
+    if (value instanceof Map) {
+        for (const [key, item] of value) {
+            bytes += TABLE_ENTRY + estimateBytes(key, seen) + estimateBytes(item, seen);
+        }
+    } else if (value instanceof Set) {
+        for (const item of value) {
+            bytes += TABLE_ENTRY + estimateBytes(item, seen);
+        }
+    } else if (Array.isArray(value)) {
+        bytes += SLOT * value.length;
+        for (const item of value) {
+            bytes += estimateBytes(item, seen);
+        }
+    } else if (ArrayBuffer.isView(value)) {
+        bytes += value.byteLength;
+    } else {
+        // Property names are usually shared, so only slots are counted
+        for (const key of Object.keys(value)) {
+            bytes += SLOT + estimateBytes((value as Record<string, unknown>)[key], seen);
+        }
+    }
+    return bytes;
+}
+
+/**
+ * Entries and estimated size of a Map or Set
+ */
+export function estimateCollection(collection: ReadonlyMap<unknown, unknown> | ReadonlySet<unknown>): MemoryUsage {
+    return { entries: collection.size, bytes: estimateBytes(collection) };
+}
+
+/**
+ * Format a byte count with a binary unit
+ */
+export function formatBytes(bytes: number): string {
+    if (bytes < 1024) {
+        return `${bytes} B`;
+    }
+    if (bytes < 1024 * 1024) {
+        return `${(bytes / 1024).toFixed(1)} KB`;
+    }
+    return `${(bytes / (1024 * 1024)).toFixed(1)} MB`;
+}
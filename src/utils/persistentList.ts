@@ -0,0 +1,119 @@
+/**
+ * Persistent (immutable, structurally shared) list for CMake list values
+ * Appending creates a new list that shares all existing items with its parent,
+ * so building a list with many list(APPEND ...) calls costs O(total items)
+ * instead of re-joining and re-splitting a ';' string on every call.
+ */
+
+export class PersistentList {
+    /** The empty list */
+    static readonly EMPTY = new PersistentList(null, [], 0);
+
+    /** Previous version this list extends (null once flattened) */
+    private parent: PersistentList | null;
+
+    /** Items added on top of the parent (all items once flattened) */
+    private chunk: readonly string[];
+
+    /** Cached ';'-joined representation */
+    private joined: string | undefined;
+
+    /** Number of items */
+    readonly length: number;
+
+    private constructor(parent: PersistentList | null, chunk: readonly string[], length: number) {
+        this.parent = parent;
+        this.chunk = chunk;
+        this.length = length;
+    }
+
+    /**
+     * Create a list from items
+     * @param items The list items (copied)
+     */
+    static from(items: readonly string[]): PersistentList {
+        return items.length === 0 ? PersistentList.EMPTY : new PersistentList(null, Object.freeze(items.slice()), items.length);
+    }
+
+    /**
+     * Create a list from a CMake ';'-separated string, dropping empty elements
+     * @param value The CMake list string
+     */
+    static fromString(value: string): PersistentList {
+        return PersistentList.from(value.split(';').filter(item => item.length > 0));
+    }
+
+    /**
+     * Return a new list with items appended; this list is left unchanged
+     * @param items Items to append
+     */
+    append(items: readonly string[]): PersistentList {
+        if (items.length === 0) {
+            return this;
+        }
+        if (this.length === 0) {
+            return PersistentList.from(items);
+        }
+        return new PersistentList(this, Object.freeze(items.slice()), this.length + items.length);
+    }
+
+    /**
+     * Get all items. The first call flattens the version chain; the result
+     * is cached and shared with callers, so it must not be mutated.
+     */
+    toArray(): readonly string[] {
+        if (this.parent === null) {
+            return this.chunk;
+        }
+
+        // Walk up to the nearest flattened ancestor, then replay the chunks
+        const pending: Array<readonly string[]> = [];
+        let node: PersistentList = this;
+        while (node.parent !== null) {
+            pending.push(node.chunk);
+            node = node.parent;
+        }
+        const items = node.chunk.slice();
+        for (let i = pending.length - 1; i >= 0; i--) {
+            for (const item of pending[i]) {
+                items.push(item);
+            }
+        }
+
+        // Flatten so the chain of intermediate versions can be collected
+        this.chunk = Object.freeze(items);
+        this.parent = null;
+        return this.chunk;
+    }
+
+    /**
+     * Get the item at an index (negative indices count from the end)
+     */
+    get(index: number): string | undefined {
+        const normalized = index < 0 ? this.length + index : index;
+        if (normalized < 0 || normalized >= this.length) {
+            return undefined;
+        }
+        return this.toArray()[normalized];
+    }
+
+    /**
+     * Join items with a separator; the ';' form is cached
+     */
+    join(separator = ';'): string {
+        if (separator !== ';') {
+            return this.toArray().join(separator);
+        }
+        if (this.joined === undefined) {
+            this.joined = this.toArray().join(';');
+        }
+        return this.joined;
+    }
+
+    /**
+     * CMake string representation (';'-separated)
+     */
+    toString(): string {
+        return this.join(';');
+    }
+}
@@ -0,0 +1,141 @@
+/**
+ * Worker thread pool
+ * Hands out batches of tasks to worker threads as they become idle, so large
+ * and small tasks balance out across threads. Used by the CLI and by
+ * solution conversion.
+ */
+
+import { Worker, parentPort } from 'worker_threads';
+
+/**
+ * Tasks sent to a worker per message
+ */
+export const BATCH_SIZE = 16;
+
+/**
+ * Cancellation check; vscode.CancellationToken satisfies it
+ */
+export interface PoolCancellationToken {
+    readonly isCancellationRequested: boolean;
+}
+
+export interface WorkerPoolOptions {
+    /** Maximum number of threads */
+    jobs: number;
+    /** Passed to every worker as workerData */
+    data?: unknown;
+    /** Tasks sent per message (default BATCH_SIZE) */
+    batchSize?: number;
+    /** Called after each batch with the number of finished tasks */
+    onProgress?: (finished: number, total: number) => void;
+    /** Checked between batches; the pool stops and rejects with WorkerPoolCancelledError */
+    token?: PoolCancellationToken;
+}
+
+export class WorkerPoolCancelledError extends Error {
+    constructor() {
+        super('Cancelled');
+        this.name = 'WorkerPoolCancelledError';
+    }
+}
+
+/**
+ * Process tasks on worker threads
+ * @param workerFile Script that calls serveWorkerTasks
+ * @param tasks Tasks to process; they must be structured-cloneable
+ * @returns Results in task order
+ */
+export function runWorkerPool<T, R>(workerFile: string, tasks: readonly T[], options: WorkerPoolOptions): Promise<R[]> {
+    const results: R[] = new Array(tasks.length);
+    const batchSize = options.batchSize ?? BATCH_SIZE;
+    const batchCount = Math.ceil(tasks.length / batchSize);
+    const threadCount = Math.min(options.jobs, batchCount);
+    if (threadCount === 0) {
+        return Promise.resolve(results);
+    }
+
+    return new Promise((resolve, reject) => {
+        const workers: Worker[] = [];
+        let nextBatch = 0;
+        let finished = 0;
+        let settled = false;
+
+        const stop = () => {
+            for (const worker of workers) {
+                void worker.terminate();
+            }
+        };
+
+        const fail = (error: Error) => {
+            if (!settled) {
+                settled = true;
+                stop();
+                reject(error);
+            }
+        };
+
+        const dispatch = (worker: Worker, pending: { start: number; busy: boolean; retired: boolean }) => {
+            if (nextBatch >= batchCount) {
+                return false;
+            }
+            pending.start = nextBatch * batchSize;
+            pending.busy = true;
+            worker.postMessage(tasks.slice(pending.start, pending.start + batchSize));
+            nextBatch++;
+            return true;
+        };
+
+        for (let i = 0; i < threadCount; i++) {
+            const worker = new Worker(workerFile, { workerData: options.data });
+            const pending = { start: 0, busy: false, retired: false };
+            workers.push(worker);
+
+            worker.on('message', (batch: R[]) => {
+                if (settled) {
+                    return;
+                }
+                pending.busy = false;
+                for (let j = 0; j < batch.length; j++) {
+                    results[pending.start + j] = batch[j];
+                }
+                finished += batch.length;
+                options.onProgress?.(finished, tasks.length);
+                if (finished === tasks.length) {
+                    settled = true;
+                    stop();
+                    resolve(results);
+                } else if (options.token?.isCancellationRequested) {
+                    fail(new WorkerPoolCancelledError());
+                } else if (!dispatch(worker, pending)) {
+                    pending.retired = true;
+                    void worker.terminate();
+                }
+            });
+            worker.on('error', fail);
+            // Workers only exit when the pool terminates them; any other exit
+            // (process.exit, a crash during setup, the thread being killed) loses its batch
+            worker.on('exit', (code) => {
+                if (!pending.retired) {
+                    fail(new Error(pending.busy
+                        ? `Worker exited with code ${code} before finishing its batch`
+                        : `Worker exited with code ${code}`));
+                }
+            });
+            dispatch(worker, pending);
+        }
+    });
+}
+
+/**
+ * Worker side of runWorkerPool: answer each batch with the handler's results
+ * Call once from the worker script.
+ */
+export function serveWorkerTasks<T, R>(handler: (task: T) => R | Promise<R>): void {
+    parentPort!.on('message', async (batch: T[]) => {
+        const results: R[] = [];
+        for (const task of batch) {
+            results.push(await handler(task));
+        }
+        parentPort!.postMessage(results);
+    });
+}
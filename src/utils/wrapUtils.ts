@@ -0,0 +1,131 @@
+/**
+ * Line wrapping utilities for the formatter
+ * Chooses break points in argument lists by dynamic programming (optimal fit).
+ * These functions contain no vscode dependencies and can be tested directly.
+ */
+
+/**
+ * Keywords that start a new line when a command is wrapped
+ */
+export const WRAP_GROUP_KEYWORDS = new Set([
+    'PUBLIC', 'PRIVATE', 'INTERFACE',
+    'SOURCES', 'COMMAND', 'DEPENDS', 'OUTPUT', 'BYPRODUCTS', 'ARGS',
+    'WORKING_DIRECTORY', 'COMMENT', 'MAIN_DEPENDENCY', 'IMPLICIT_DEPENDS',
+    'TARGETS', 'FILES', 'PROGRAMS', 'DIRECTORY', 'DESTINATION', 'EXPORT',
+    'PROPERTIES', 'COMPONENTS', 'OPTIONAL_COMPONENTS',
+    'NAMES', 'HINTS', 'PATHS', 'PATH_SUFFIXES', 'CONFIGURATIONS'
+]);
+
+/**
+ * Commands whose arguments are values and variable names only; a value such
+ * as SOURCES in set(SOURCES a.cpp) is not a keyword there
+ */
+const NO_GROUP_COMMANDS = new Set(['set', 'unset', 'option', 'list', 'string', 'math', 'separate_arguments']);
+
+/**
+ * Argument that names a variable in commands that otherwise have keyword groups,
+ * e.g. file(GLOB SOURCES ...) and foreach(FILES IN LISTS ...)
+ */
+const VARIABLE_ARGUMENT_INDEX: Record<string, number> = {
+    file: 1,
+    foreach: 0
+};
+
+/**
+ * Whether an argument starts a new line when a command is wrapped
+ * @param command Command name, in any case
+ * @param index Position of the argument among the command's arguments
+ * @param text Argument text
+ */
+export function isWrapGroupKeyword(command: string, index: number, text: string): boolean {
+    const name = command.toLowerCase();
+    return WRAP_GROUP_KEYWORDS.has(text) && !NO_GROUP_COMMANDS.has(name) && VARIABLE_ARGUMENT_INDEX[name] !== index;
+}
+
+export interface WrapItem {
+    /** Width of the item in characters */
+    width: number;
+    /** Force a line break after the item (e.g. a line comment) */
+    breakAfter?: boolean;
+}
+
+/**
+ * Choose line breaks for items separated by single spaces
+ * Minimizes the number of lines first, then the sum of squared unused width
+ * of every line not ending the list or a forced break, so lines come out
+ * evenly filled. Only lines that fit are considered, which bounds the inner
+ * loop by the line width: O(n·w), linear in the item count for a fixed width.
+ * An item wider than the line gets a line of its own.
+ * @param items Items in order
+ * @param width Width available on each line
+ * @param firstWidth Width available on the first line (defaults to width)
+ * @returns Start index of each line, in order (empty for no items)
+ */
+export function breakLines(items: readonly WrapItem[], width: number, firstWidth = width): number[] {
+    const count = items.length;
+    if (count === 0) {
+        return [];
+    }
+
+    // Best layout of items[i..] with a line starting at i, computed backwards
+    const lines = new Array<number>(count + 1).fill(0);
+    const ragged = new Array<number>(count + 1).fill(0);
+    const next = new Array<number>(count + 1).fill(count);
+
+    for (let i = count - 1; i >= 0; i--) {
+        const available = i === 0 ? firstWidth : width;
+        let bestLines = Infinity;
+        let bestRagged = Infinity;
+        let bestNext = i + 1;
+        let used = -1;
+
+        for (let j = i; j < count; j++) {
+            used += items[j].width + 1;
+            if (used > available && j > i) {
+                break;
+            }
+            const end = j + 1;
+            const slack = available - used;
+            const lineCost = end === count || items[j].breakAfter || slack < 0 ? 0 : slack * slack;
+            const totalLines = 1 + lines[end];
+            const totalRagged = lineCost + ragged[end];
+            if (totalLines < bestLines || (totalLines === bestLines && totalRagged < bestRagged)) {
+                bestLines = totalLines;
+                bestRagged = totalRagged;
+                bestNext = end;
+            }
+            if (items[j].breakAfter) {
+                break;
+            }
+        }
+
+        lines[i] = bestLines;
+        ragged[i] = bestRagged;
+        next[i] = bestNext;
+    }
+
+    const starts: number[] = [];
+    for (let i = 0; i < count; i = next[i]) {
+        starts.push(i);
+    }
+    return starts;
+}
+
+/**
+ * Pack texts into lines using breakLines
+ * @param texts Item texts
+ * @param width Width available on each line
+ * @param firstWidth Width available on the first line
+ * @param breakAfter Returns whether a line must end after an item
+ * @returns Lines of space-joined texts
+ */
+export function packLines(
+    texts: readonly string[],
+    width: number,
+    firstWidth = width,
+    breakAfter: (index: number) => boolean = () => false
+): string[] {
+    const items = texts.map((text, index) => ({ width: text.length, breakAfter: breakAfter(index) }));
+    const starts = breakLines(items, width, firstWidth);
+    return starts.map((start, i) => texts.slice(start, i + 1 < starts.length ? starts[i + 1] : texts.length).join(' '));
+}